@@ -0,0 +1,102 @@
+﻿using Sttify.Corelib.Batch;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Engine.Vosk;
+
+namespace Sttify.Cli;
+
+/// <summary>
+/// Transcribes recordings offline with <see cref="BatchTranscriber"/>: the Vosk model is loaded once
+/// and every worker decodes with its own recognizer. Progress and the summary go to stderr.
+/// </summary>
+public sealed class BatchHost
+{
+    private readonly CliOptions _options;
+
+    public BatchHost(CliOptions options)
+    {
+        _options = options ?? throw new ArgumentNullException(nameof(options));
+    }
+
+    public async Task<int> RunAsync(CancellationToken cancellationToken)
+    {
+        var vosk = await LoadVoskSettingsAsync();
+        if (string.IsNullOrEmpty(vosk.ModelPath) || !Directory.Exists(vosk.ModelPath))
+            throw new DirectoryNotFoundException($"Vosk model not found at '{vosk.ModelPath}'; pass one with --model");
+
+        var inputs = BatchTranscriber.ExpandInputs(_options.BatchInputs);
+        if (inputs.Count == 0)
+        {
+            await Console.Error.WriteLineAsync("sttify-cli: no WAV or PCM files to transcribe");
+            return 2;
+        }
+
+        VoskNativeModel.SetLogLevel(0);
+        using var model = new VoskNativeModel(vosk.ModelPath);
+        IBatchDecoder CreateDecoder() => new VoskBatchDecoder(model, vosk.Language);
+        var transcriber = new BatchTranscriber(CreateDecoder, new BatchTranscriptionSettings
+        {
+            MaxWorkers = _options.Workers,
+            OutputDirectory = _options.OutputDirectory ?? ""
+        });
+
+        if (_options.SplitOnSilence)
+            return await RunSegmentedAsync(transcriber, CreateDecoder, inputs, cancellationToken);
+
+        var report = await transcriber.TranscribeAsync(inputs, cancellationToken);
+
+        foreach (var file in report.Files)
+        {
+            await Console.Error.WriteLineAsync(file.Succeeded
+                ? $"{file.InputPath}: {file.AudioDuration.TotalSeconds:F1}s audio, {file.Utterances} utterances, RTF {file.RealTimeFactor:F3} -> {file.OutputPath}"
+                : $"{file.InputPath}: failed: {file.Error}");
+        }
+
+        await Console.Error.WriteLineAsync(
+            $"{report.Files.Count} files, {report.AudioDuration.TotalSeconds:F1}s audio in {report.WallTime.TotalSeconds:F1}s " +
+            $"on {report.Workers} workers: RTF {report.RealTimeFactor:F3}, speedup {report.Speedup:F2}x " +
+            $"({report.ParallelEfficiency:P0} per worker)");
+
+        return report.FailedFiles == 0 ? 0 : 1;
+    }
+
+    // One recording at a time, each split at pauses and decoded on all workers
+    private async Task<int> RunSegmentedAsync(BatchTranscriber batch, Func<IBatchDecoder> createDecoder, List<string> inputs, CancellationToken cancellationToken)
+    {
+        var transcriber = new SegmentedTranscriber(createDecoder, new SegmentedTranscriptionSettings { MaxWorkers = _options.Workers });
+        var failed = 0;
+        foreach (var input in inputs)
+        {
+            try
+            {
+                var report = await transcriber.TranscribeFileAsync(input, cancellationToken);
+                var outputPath = batch.GetOutputPath(input);
+                TranscriptWriter.WriteFile(outputPath, report.Transcript);
+
+                await Console.Error.WriteLineAsync(
+                    $"{input}: {report.AudioDuration.TotalSeconds:F1}s audio in {report.Segments} segments " +
+                    $"(longest {report.LongestSegment.TotalSeconds:F1}s), {report.WallTime.TotalSeconds:F1}s on {report.Workers} workers: " +
+                    $"RTF {report.RealTimeFactor:F3}, speedup {report.Speedup:F2}x -> {outputPath}");
+            }
+            catch (Exception ex) when (ex is not OperationCanceledException)
+            {
+                failed++;
+                await Console.Error.WriteLineAsync($"{input}: failed: {ex.Message}");
+            }
+        }
+
+        return failed == 0 ? 0 : 1;
+    }
+
+    private async Task<VoskEngineSettings> LoadVoskSettingsAsync()
+    {
+        using var provider = new SettingsProvider(_options.ConfigPath ?? SettingsProvider.GetDefaultConfigPath(), watchForChanges: false);
+        var settings = await provider.GetSettingsAsync();
+
+        if (!string.IsNullOrEmpty(_options.ModelPath))
+        {
+            settings.Engine.Vosk.ModelPath = _options.ModelPath;
+        }
+
+        return settings.Engine.Vosk;
+    }
+}
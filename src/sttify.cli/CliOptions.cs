@@ -0,0 +1,121 @@
+﻿namespace Sttify.Cli;
+
+/// <summary>
+/// Command line for the headless host. Anything not given here comes from the settings file.
+/// </summary>
+public sealed class CliOptions
+{
+    public const string StandardInput = "-";
+
+    public string? ConfigPath { get; private set; }
+    public string Input { get; private set; } = StandardInput; // "-" = stdin, a file/FIFO path, or a pipe:/unix: source
+    public string? Profile { get; private set; }
+    public string? ModelPath { get; private set; }
+    public string? OutputPath { get; private set; } // null = stdout
+    public bool IncludeTimestamp { get; private set; }
+    public bool ShowPartials { get; private set; } // Partials go to stderr so stdout stays one final per line
+    public int ChunkMs { get; private set; } = 100;
+    public bool Realtime { get; private set; } // Pace file input at 1x so streaming engines see live-rate audio
+    public List<string> BatchInputs { get; } = new(); // Files or directories to transcribe offline instead of streaming
+    public int Workers { get; private set; } // 0 = one per core
+    public string? OutputDirectory { get; private set; } // null = next to each recording
+    public bool SplitOnSilence { get; private set; } // Parallelize within each recording instead of across them
+    public bool ShowHelp { get; private set; }
+
+    public bool IsBatch => BatchInputs.Count > 0;
+
+    public static string Usage => """
+        Usage: sttify-cli [options]
+
+          -i, --input <source>     - for stdin (default), a PCM/WAV file or FIFO path, pipe:<name> or
+                                   unix:<socket>; raw input may add ?rate=48000&channels=2&format=s16le
+          -c, --config <path>      Settings file (default: the desktop app's config.json)
+          -e, --engine <profile>   Engine profile override, e.g. vosk, hybrid, cloud
+          -m, --model <path>       Vosk model directory override
+          -o, --output <path>      Append finals to a file instead of stdout
+              --timestamps         Prefix each final with a timestamp
+              --partials           Print partial results to stderr
+              --chunk-ms <ms>      Frame size pushed to the engine (default 100)
+              --realtime           Feed input at playback speed instead of as fast as it can be read
+          -b, --batch <path>       Transcribe a WAV/PCM file, or every one in a directory, to JSON with
+                                   word timings; repeatable. Uses the Vosk model only
+              --workers <n>        Batch decoding threads (default: one per core)
+              --output-dir <dir>   Write batch transcripts here instead of next to each recording
+              --split              Split each batch recording at pauses and decode the pieces in
+                                   parallel; for a few long recordings rather than many short ones
+          -h, --help               Show this help
+        """;
+
+    public static CliOptions Parse(IReadOnlyList<string> args)
+    {
+        var options = new CliOptions();
+
+        for (int i = 0; i < args.Count; i++)
+        {
+            var arg = args[i];
+            switch (arg)
+            {
+                case "-i" or "--input":
+                    options.Input = RequireValue(args, ref i);
+                    break;
+                case "-c" or "--config":
+                    options.ConfigPath = RequireValue(args, ref i);
+                    break;
+                case "-e" or "--engine":
+                    options.Profile = RequireValue(args, ref i);
+                    break;
+                case "-m" or "--model":
+                    options.ModelPath = RequireValue(args, ref i);
+                    break;
+                case "-o" or "--output":
+                    options.OutputPath = RequireValue(args, ref i);
+                    break;
+                case "--timestamps":
+                    options.IncludeTimestamp = true;
+                    break;
+                case "--partials":
+                    options.ShowPartials = true;
+                    break;
+                case "--realtime":
+                    options.Realtime = true;
+                    break;
+                case "--chunk-ms":
+                    var value = RequireValue(args, ref i);
+                    if (!int.TryParse(value, out var chunkMs) || chunkMs < 10 || chunkMs > 1000)
+                        throw new ArgumentException($"--chunk-ms must be between 10 and 1000, got '{value}'");
+                    options.ChunkMs = chunkMs;
+                    break;
+                case "-b" or "--batch":
+                    options.BatchInputs.Add(RequireValue(args, ref i));
+                    break;
+                case "--workers":
+                    var workersValue = RequireValue(args, ref i);
+                    if (!int.TryParse(workersValue, out var workers) || workers < 1)
+                        throw new ArgumentException($"--workers must be a positive number, got '{workersValue}'");
+                    options.Workers = workers;
+                    break;
+                case "--output-dir":
+                    options.OutputDirectory = RequireValue(args, ref i);
+                    break;
+                case "--split":
+                    options.SplitOnSilence = true;
+                    break;
+                case "-h" or "--help":
+                    options.ShowHelp = true;
+                    break;
+                default:
+                    throw new ArgumentException($"Unknown option '{arg}'");
+            }
+        }
+
+        return options;
+    }
+
+    private static string RequireValue(IReadOnlyList<string> args, ref int index)
+    {
+        if (index + 1 >= args.Count)
+            throw new ArgumentException($"Option '{args[index]}' requires a value");
+
+        return args[++index];
+    }
+}
@@ -0,0 +1,217 @@
+﻿using System.Diagnostics;
+using System.Threading.Channels;
+using Sttify.Corelib.Audio;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Diagnostics;
+using Sttify.Corelib.Engine;
+using Sttify.Corelib.Output;
+
+namespace Sttify.Cli;
+
+/// <summary>
+/// Runs one engine over a <see cref="PcmStreamAudioSource"/> and writes finals through a <see cref="StreamSink"/>. No WPF,
+/// DI container, audio device or plugin loading is involved, so the host trims and compiles with
+/// NativeAOT and starts in the time it takes to load settings and the engine.
+/// </summary>
+public sealed class HeadlessHost
+{
+    private readonly Channel<string> _finals = Channel.CreateUnbounded<string>(new UnboundedChannelOptions { SingleReader = true });
+    private readonly CliOptions _options;
+    private readonly Stopwatch _sinceMain;
+    private readonly TimeSpan _processStartToMain;
+
+    private long _engineReadyTicks;
+    private int _errorCount;
+    private long _firstResultTicks;
+    private string _profile = "";
+
+    public HeadlessHost(CliOptions options, Stopwatch sinceMain, TimeSpan processStartToMain)
+    {
+        _options = options ?? throw new ArgumentNullException(nameof(options));
+        _sinceMain = sinceMain ?? throw new ArgumentNullException(nameof(sinceMain));
+        _processStartToMain = processStartToMain;
+    }
+
+    public async Task<int> RunAsync(CancellationToken cancellationToken)
+    {
+        var settings = await LoadSettingsAsync();
+        _profile = settings.Engine.Profile;
+
+        using var sink = new StreamSink(new StreamSinkSettings
+        {
+            OutputType = _options.OutputPath == null ? StreamOutputType.StandardOutput : StreamOutputType.File,
+            FilePath = _options.OutputPath ?? "",
+            IncludeTimestamp = _options.IncludeTimestamp
+        });
+
+        using var engine = SttEngineFactory.CreateEngine(settings.Engine);
+        engine.OnPartial += OnPartial;
+        engine.OnFinal += OnFinal;
+        engine.OnError += OnError;
+
+        var writerTask = WriteFinalsAsync(sink);
+        try
+        {
+            await engine.StartAsync(cancellationToken);
+            Interlocked.Exchange(ref _engineReadyTicks, _sinceMain.ElapsedTicks);
+
+            await RunSourceAsync(engine, cancellationToken);
+        }
+        catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+        {
+            // Ctrl+C: stop below so the engine still flushes its last final
+        }
+        finally
+        {
+            await engine.StopAsync(CancellationToken.None);
+            engine.OnPartial -= OnPartial;
+            engine.OnFinal -= OnFinal;
+            engine.OnError -= OnError;
+
+            _finals.Writer.TryComplete();
+            await writerTask;
+        }
+
+        if (Interlocked.Read(ref _firstResultTicks) == 0)
+        {
+            ReportStartup(0);
+        }
+
+        return _errorCount == 0 ? 0 : 1;
+    }
+
+    private async Task<SttifySettings> LoadSettingsAsync()
+    {
+        // A missing config file is written with defaults, which gives servers a template to edit
+        using var provider = new SettingsProvider(_options.ConfigPath ?? SettingsProvider.GetDefaultConfigPath(), watchForChanges: false);
+        var settings = await provider.GetSettingsAsync();
+
+        if (!string.IsNullOrEmpty(_options.Profile))
+        {
+            settings.Engine.Profile = _options.Profile;
+        }
+
+        if (!string.IsNullOrEmpty(_options.ModelPath))
+        {
+            settings.Engine.Vosk.ModelPath = _options.ModelPath;
+        }
+
+        return settings;
+    }
+
+    private async Task RunSourceAsync(ISttEngine engine, CancellationToken cancellationToken)
+    {
+        var address = PcmSourceAddress.Parse(ToSourceAddress(_options.Input));
+        using var source = new PcmStreamAudioSource(address, _options.Realtime);
+        source.OnFrame += (_, e) => engine.PushAudio(e.AudioData.Span);
+        source.OnError += (_, e) =>
+        {
+            Interlocked.Increment(ref _errorCount);
+            Console.Error.WriteLine($"sttify-cli: {e.Message}: {e.Exception.Message}");
+        };
+
+        await source.StartAsync(new AudioCaptureSettings { FrameIntervalMs = _options.ChunkMs, HistoryMs = 0 }, cancellationToken);
+        try
+        {
+            // Ends at EOF for stdin and files; pipes and sockets keep serving writers until Ctrl+C
+            await source.Completion.WaitAsync(cancellationToken);
+        }
+        finally
+        {
+            await source.StopAsync();
+        }
+    }
+
+    /// <summary>
+    /// Plain paths are files or FIFOs; anything with a source scheme is passed through.
+    /// </summary>
+    private static string ToSourceAddress(string input)
+    {
+        if (input == CliOptions.StandardInput ||
+            input.StartsWith("stdin", StringComparison.Ordinal) ||
+            input.StartsWith("file:", StringComparison.OrdinalIgnoreCase) ||
+            input.StartsWith("pipe:", StringComparison.OrdinalIgnoreCase) ||
+            input.StartsWith("unix:", StringComparison.OrdinalIgnoreCase))
+        {
+            return input;
+        }
+
+        // A FIFO path is opened like a file; unlike pipe: it is read once rather than per writer
+        return "file:" + input;
+    }
+
+    private async Task WriteFinalsAsync(StreamSink sink)
+    {
+        await foreach (var text in _finals.Reader.ReadAllAsync())
+        {
+            try
+            {
+                await sink.SendAsync(text);
+            }
+            catch (Exception ex)
+            {
+                Interlocked.Increment(ref _errorCount);
+                await Console.Error.WriteLineAsync($"sttify-cli: output failed: {ex.Message}");
+            }
+        }
+    }
+
+    private void OnPartial(object? sender, PartialRecognitionEventArgs e)
+    {
+        MarkFirstResult();
+        if (_options.ShowPartials && !string.IsNullOrEmpty(e.Text))
+        {
+            Console.Error.WriteLine($"… {e.Text}");
+        }
+    }
+
+    private void OnFinal(object? sender, FinalRecognitionEventArgs e)
+    {
+        MarkFirstResult();
+        if (!string.IsNullOrWhiteSpace(e.Text))
+        {
+            _finals.Writer.TryWrite(e.Text);
+        }
+    }
+
+    private void OnError(object? sender, SttErrorEventArgs e)
+    {
+        Interlocked.Increment(ref _errorCount);
+        Console.Error.WriteLine($"sttify-cli: engine error: {e.Exception.Message}");
+    }
+
+    private void MarkFirstResult()
+    {
+        var now = _sinceMain.ElapsedTicks;
+        if (Interlocked.CompareExchange(ref _firstResultTicks, now, 0) == 0)
+        {
+            ReportStartup(now);
+        }
+    }
+
+    /// <summary>
+    /// Cold start is process launch to the first partial, or the first final for engines without
+    /// partials. Reported as soon as it is known so long-running stdin sessions see it too.
+    /// </summary>
+    private void ReportStartup(long firstResultTicks)
+    {
+        var processToMain = _processStartToMain.TotalMilliseconds;
+        var engineReady = TicksToMs(Interlocked.Read(ref _engineReadyTicks));
+        double? firstResult = firstResultTicks == 0 ? null : TicksToMs(firstResultTicks);
+
+        Console.Error.WriteLine(firstResult is { } first
+            ? $"sttify-cli: {processToMain:F0} ms to main, {engineReady:F0} ms to engine ready, {processToMain + first:F0} ms cold start to first result"
+            : $"sttify-cli: {processToMain:F0} ms to main, {engineReady:F0} ms to engine ready, no recognition result");
+
+        Telemetry.LogEvent("HeadlessStartup", new
+        {
+            Profile = _profile,
+            ProcessStartToMainMs = processToMain,
+            MainToEngineReadyMs = engineReady,
+            MainToFirstResultMs = firstResult,
+            ColdStartToFirstResultMs = processToMain + firstResult
+        });
+    }
+
+    private static double TicksToMs(long stopwatchTicks) => stopwatchTicks * 1000.0 / Stopwatch.Frequency;
+}
@@ -0,0 +1,61 @@
+﻿using System.Diagnostics;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Cli;
+
+internal static class Program
+{
+    public static async Task<int> Main(string[] args)
+    {
+        var sinceMain = Stopwatch.StartNew();
+        var processStartToMain = DateTime.Now - Process.GetCurrentProcess().StartTime;
+
+        CliOptions options;
+        try
+        {
+            options = CliOptions.Parse(args);
+        }
+        catch (ArgumentException ex)
+        {
+            await Console.Error.WriteLineAsync($"sttify-cli: {ex.Message}");
+            await Console.Error.WriteLineAsync(CliOptions.Usage);
+            return 2;
+        }
+
+        if (options.ShowHelp)
+        {
+            Console.WriteLine(CliOptions.Usage);
+            return 0;
+        }
+
+        // stdout carries the transcript, so logs only go to the rolling file
+        Telemetry.Initialize(new TelemetrySettings { EnableConsoleLogging = false });
+
+        using var cancellation = new CancellationTokenSource();
+        Console.CancelKeyPress += (_, e) =>
+        {
+            // First Ctrl+C stops reading and flushes the engine; a second one terminates
+            e.Cancel = !cancellation.IsCancellationRequested;
+            cancellation.Cancel();
+        };
+
+        try
+        {
+            if (options.IsBatch)
+                return await new BatchHost(options).RunAsync(cancellation.Token);
+
+            var host = new HeadlessHost(options, sinceMain, processStartToMain);
+            return await host.RunAsync(cancellation.Token);
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogError("HeadlessHostFailed", ex);
+            await Console.Error.WriteLineAsync($"sttify-cli: {ex.Message}");
+            return 1;
+        }
+        finally
+        {
+            Telemetry.Shutdown();
+        }
+    }
+}
@@ -0,0 +1,279 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using System.Text.Json;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Learns how long a speaker pauses without having finished, per application context, and
+/// recommends the shortest silence timeout that keeps premature cut-offs under a target rate.
+/// Pauses are kept in exponentially decayed histograms so the profile follows the user over time.
+/// </summary>
+public class AdaptiveEndpointProfile
+{
+    public const string DefaultContext = "default";
+
+    private readonly Dictionary<string, PauseHistogram> _contexts = new(StringComparer.OrdinalIgnoreCase);
+    private readonly object _lockObject = new();
+    private readonly AdaptiveEndpointSettings _settings;
+
+    public AdaptiveEndpointProfile(AdaptiveEndpointSettings? settings = null)
+    {
+        _settings = settings ?? new AdaptiveEndpointSettings();
+    }
+
+    public AdaptiveEndpointSettings Settings => _settings;
+
+    public static string GetDefaultProfilePath()
+    {
+        var appDataPath = Environment.GetFolderPath(Environment.SpecialFolder.ApplicationData);
+        return Path.Combine(appDataPath, "sttify", "endpoint-profile.json");
+    }
+
+    /// <summary>
+    /// Records a pause after which the speaker carried on. Pauses are also added to the default
+    /// context so new applications start from the user's overall behaviour. An unconfirmed pause
+    /// (a gap after an endpoint with no sign of a cut-off, usually just the gap between sentences)
+    /// only counts with <see cref="AdaptiveEndpointSettings.UnconfirmedPauseWeight"/>.
+    /// </summary>
+    public void RecordPause(string? context, TimeSpan pause, bool confirmed = true)
+    {
+        var weight = confirmed ? 1.0 : _settings.UnconfirmedPauseWeight;
+        if (pause <= TimeSpan.Zero || weight <= 0)
+            return;
+
+        var pauseMs = pause.TotalMilliseconds;
+        lock (_lockObject)
+        {
+            GetOrCreate(DefaultContext).Add(pauseMs, weight, _settings.DecayFactor);
+
+            if (!string.IsNullOrEmpty(context) && !string.Equals(context, DefaultContext, StringComparison.OrdinalIgnoreCase))
+            {
+                GetOrCreate(context).Add(pauseMs, weight, _settings.DecayFactor);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Shortest timeout (plus safety margin) for which the learned share of pauses exceeding it is
+    /// at most <see cref="AdaptiveEndpointSettings.TargetCutoffRate"/>. Falls back to the default
+    /// context, then to <paramref name="fallbackMs"/>, until enough pauses have been observed.
+    /// </summary>
+    public int GetSilenceTimeoutMs(string? context, int fallbackMs)
+    {
+        lock (_lockObject)
+        {
+            if (!string.IsNullOrEmpty(context) &&
+                _contexts.TryGetValue(context, out var contextHistogram) &&
+                contextHistogram.Observations >= _settings.MinObservations)
+            {
+                return Recommend(contextHistogram);
+            }
+
+            if (_contexts.TryGetValue(DefaultContext, out var defaultHistogram) &&
+                defaultHistogram.Observations >= _settings.MinObservations)
+            {
+                return Recommend(defaultHistogram);
+            }
+        }
+
+        return fallbackMs;
+    }
+
+    public int GetObservationCount(string? context)
+    {
+        lock (_lockObject)
+        {
+            return _contexts.TryGetValue(context ?? DefaultContext, out var histogram) ? histogram.Observations : 0;
+        }
+    }
+
+    [ExcludeFromCodeCoverage] // File system I/O
+    public static AdaptiveEndpointProfile Load(string path, AdaptiveEndpointSettings? settings = null)
+    {
+        var profile = new AdaptiveEndpointProfile(settings);
+        if (!File.Exists(path))
+            return profile;
+
+        try
+        {
+            var data = JsonSerializer.Deserialize(File.ReadAllText(path), EndpointProfileJsonContext.Default.EndpointProfileData);
+            if (data?.Contexts != null)
+            {
+                foreach (var (context, histogramData) in data.Contexts)
+                {
+                    var histogram = PauseHistogram.FromData(histogramData, profile._settings);
+                    if (histogram != null)
+                    {
+                        profile._contexts[context] = histogram;
+                    }
+                }
+            }
+        }
+        catch (Exception ex) when (ex is IOException or JsonException or UnauthorizedAccessException)
+        {
+            // A corrupt profile only costs us what was learned; start fresh
+            Telemetry.LogError("EndpointProfileLoadFailed", ex, new { Path = path });
+        }
+
+        return profile;
+    }
+
+    [ExcludeFromCodeCoverage] // File system I/O
+    public void Save(string path)
+    {
+        EndpointProfileData data;
+        lock (_lockObject)
+        {
+            data = new EndpointProfileData
+            {
+                Contexts = _contexts.ToDictionary(kv => kv.Key, kv => kv.Value.ToData(), StringComparer.OrdinalIgnoreCase)
+            };
+        }
+
+        try
+        {
+            Directory.CreateDirectory(Path.GetDirectoryName(path)!);
+
+            // Write-then-move so a crash never leaves a truncated profile
+            var tempPath = path + ".tmp";
+            File.WriteAllText(tempPath, JsonSerializer.Serialize(data, EndpointProfileJsonContext.Default.EndpointProfileData));
+            File.Move(tempPath, path, true);
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            Telemetry.LogError("EndpointProfileSaveFailed", ex, new { Path = path });
+        }
+    }
+
+    private PauseHistogram GetOrCreate(string context)
+    {
+        if (!_contexts.TryGetValue(context, out var histogram))
+        {
+            histogram = new PauseHistogram(_settings.BinWidthMs, _settings.MaxTimeoutMs);
+            _contexts[context] = histogram;
+        }
+        return histogram;
+    }
+
+    private int Recommend(PauseHistogram histogram)
+    {
+        var quantileMs = histogram.GetUpperQuantileMs(_settings.TargetCutoffRate);
+        var timeout = quantileMs + _settings.SafetyMarginMs;
+        return Math.Clamp(timeout, _settings.MinTimeoutMs, _settings.MaxTimeoutMs);
+    }
+
+    private sealed class PauseHistogram
+    {
+        private readonly double[] _bins;
+        private readonly int _binWidthMs;
+        private double _observedWeight;
+        private double _overflow;
+        private double _totalWeight;
+
+        public PauseHistogram(int binWidthMs, int rangeMs)
+        {
+            _binWidthMs = Math.Max(1, binWidthMs);
+            _bins = new double[Math.Max(1, (rangeMs + _binWidthMs - 1) / _binWidthMs)];
+        }
+
+        // Undecayed, so down-weighted samples alone never make the histogram look trustworthy
+        public int Observations => (int)_observedWeight;
+
+        public void Add(double pauseMs, double weight, double decayFactor)
+        {
+            // Age existing evidence so recent behaviour dominates
+            if (decayFactor < 1.0)
+            {
+                for (int i = 0; i < _bins.Length; i++)
+                {
+                    _bins[i] *= decayFactor;
+                }
+                _overflow *= decayFactor;
+                _totalWeight *= decayFactor;
+            }
+
+            var bin = (int)(pauseMs / _binWidthMs);
+            if (bin < _bins.Length)
+                _bins[bin] += weight;
+            else
+                _overflow += weight;
+
+            _totalWeight += weight;
+            _observedWeight += weight;
+        }
+
+        /// <summary>
+        /// Smallest bin edge T such that the weight of pauses longer than T is at most rate * total.
+        /// </summary>
+        public int GetUpperQuantileMs(double rate)
+        {
+            var allowed = Math.Max(0.0, rate) * _totalWeight;
+            var tail = _overflow;
+            if (tail > allowed)
+                return _bins.Length * _binWidthMs;
+
+            for (int i = _bins.Length - 1; i >= 0; i--)
+            {
+                if (tail + _bins[i] > allowed)
+                    return (i + 1) * _binWidthMs;
+                tail += _bins[i];
+            }
+
+            return 0;
+        }
+
+        public PauseHistogramData ToData() => new()
+        {
+            BinWidthMs = _binWidthMs,
+            Bins = (double[])_bins.Clone(),
+            Overflow = _overflow,
+            Observations = Observations
+        };
+
+        public static PauseHistogram? FromData(PauseHistogramData data, AdaptiveEndpointSettings settings)
+        {
+            // Profiles written with a different bin layout are discarded rather than resampled
+            if (data.BinWidthMs != settings.BinWidthMs || data.Bins == null)
+                return null;
+
+            var histogram = new PauseHistogram(settings.BinWidthMs, settings.MaxTimeoutMs);
+            if (data.Bins.Length != histogram._bins.Length)
+                return null;
+
+            Array.Copy(data.Bins, histogram._bins, data.Bins.Length);
+            histogram._overflow = data.Overflow;
+            histogram._totalWeight = data.Bins.Sum() + data.Overflow;
+            histogram._observedWeight = data.Observations;
+            return histogram;
+        }
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple configuration class with no business logic
+public class AdaptiveEndpointSettings
+{
+    public double TargetCutoffRate { get; set; } = 0.05; // Max share of mid-utterance pauses allowed to end an utterance
+    public int MinTimeoutMs { get; set; } = 300;
+    public int MaxTimeoutMs { get; set; } = 2000;
+    public int SafetyMarginMs { get; set; } = 100;
+    public int MinObservations { get; set; } = 20; // Pauses needed before the learned value is trusted
+    public double DecayFactor { get; set; } = 0.995; // Per-observation weight decay (~200 pause memory)
+    public int BinWidthMs { get; set; } = 50;
+    public double UnconfirmedPauseWeight { get; set; } = 0.05; // Weight of post-endpoint gaps without cut-off evidence
+}
+
+[ExcludeFromCodeCoverage] // Serialization DTO
+public class EndpointProfileData
+{
+    public Dictionary<string, PauseHistogramData> Contexts { get; set; } = new();
+}
+
+[ExcludeFromCodeCoverage] // Serialization DTO
+public class PauseHistogramData
+{
+    public int BinWidthMs { get; set; }
+    public double[]? Bins { get; set; }
+    public double Overflow { get; set; }
+    public int Observations { get; set; }
+}
@@ -1,4 +1,5 @@
 ﻿using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Collections;
 using Sttify.Corelib.Diagnostics;
 
 namespace Sttify.Corelib.Audio;
@@ -10,11 +11,12 @@ public class AudioCapture : IDisposable
     private const int MaxRestartAttempts = 1; // simple lightweight recovery
     private readonly object _lockObject = new();
     private bool _disposed;
+    private AudioHistoryRing? _history;
     private bool _isCapturing;
     private AudioCaptureSettings? _lastSettings;
     private int _restartAttempts;
 
-    private WasapiAudioCapture? _wasapiCapture;
+    private IAudioSource? _source;
 
     public bool IsCapturing
     {
@@ -27,6 +29,12 @@ public class AudioCapture : IDisposable
         }
     }
 
+    /// <summary>
+    /// Recent captured PCM (post-conversion), used to replay speech that preceded a PTT press or
+    /// wake word. Null until capture has been started.
+    /// </summary>
+    public AudioHistoryRing? History => _history;
+
     public void Dispose()
     {
         Dispose(true);
@@ -61,11 +69,12 @@ public class AudioCapture : IDisposable
         try
         {
             _lastSettings = settings;
-            _wasapiCapture = new WasapiAudioCapture();
-            _wasapiCapture.OnFrame += OnWasapiFrame;
-            _wasapiCapture.OnError += OnWasapiError;
+            EnsureHistory(settings);
+            _source = CreateSource(settings);
+            _source.OnFrame += OnSourceFrame;
+            _source.OnError += OnSourceError;
 
-            await _wasapiCapture.StartAsync(settings, cancellationToken);
+            await _source.StartAsync(settings, cancellationToken);
 
             lock (_lockObject)
             {
@@ -90,22 +99,56 @@ public class AudioCapture : IDisposable
             _isCapturing = false;
         }
 
-        if (_wasapiCapture != null)
+        if (_source != null)
         {
-            await _wasapiCapture.StopAsync();
-            _wasapiCapture.OnFrame -= OnWasapiFrame;
-            _wasapiCapture.OnError -= OnWasapiError;
-            _wasapiCapture.Dispose();
-            _wasapiCapture = null;
+            await _source.StopAsync();
+            _source.OnFrame -= OnSourceFrame;
+            _source.OnError -= OnSourceError;
+            _source.Dispose();
+            _source = null;
         }
     }
 
-    private void OnWasapiFrame(object? sender, AudioFrameEventArgs e)
+    /// <summary>
+    /// The capture device by default; <see cref="AudioCaptureSettings.Source"/> selects a raw PCM
+    /// stream instead (stdin, file, named pipe or UNIX socket), e.g. on servers without audio devices.
+    /// </summary>
+    private static IAudioSource CreateSource(AudioCaptureSettings settings)
+    {
+        if (string.IsNullOrWhiteSpace(settings.Source))
+            return new WasapiAudioCapture();
+
+        return new PcmStreamAudioSource(PcmSourceAddress.Parse(settings.Source));
+    }
+
+    private void OnSourceFrame(object? sender, AudioFrameEventArgs e)
     {
         OnFrame?.Invoke(this, e);
+
+        // Record after delivery so handlers see history that ends just before the current frame
+        _history?.Write(e.AudioData.Span);
+    }
+
+    private void EnsureHistory(AudioCaptureSettings settings)
+    {
+        if (settings.HistoryMs <= 0)
+        {
+            _history = null;
+            return;
+        }
+
+        var blockAlign = settings.Channels * settings.BitsPerSample / 8;
+        var capacity = settings.SampleRate * blockAlign * settings.HistoryMs / 1000;
+        if (_history != null && _history.Capacity == capacity - capacity % blockAlign)
+        {
+            _history.Clear();
+            return;
+        }
+
+        _history = new AudioHistoryRing(capacity, blockAlign);
     }
 
-    private void OnWasapiError(object? sender, AudioErrorEventArgs e)
+    private void OnSourceError(object? sender, AudioErrorEventArgs e)
     {
         AsyncHelper.FireAndForget(async () =>
         {
@@ -117,16 +160,18 @@ public class AudioCapture : IDisposable
             Telemetry.LogError("WasapiAudioError", e.Exception, new
             {
                 Component = ComponentName,
-                e.Message
+                e.Message,
+                _lastSettings?.Source
             });
 
-            if (IsTransientAudioError(e.Exception))
+            // Stream sources wait for their next writer themselves; only devices are restarted here
+            if (sender is WasapiAudioCapture && IsTransientAudioError(e.Exception))
             {
                 await AttemptAudioRecoveryAsync().ConfigureAwait(false);
             }
 
             OnError?.Invoke(this, e);
-        }, nameof(OnWasapiError));
+        }, nameof(OnSourceError));
     }
 
     private static bool IsTransientAudioError(Exception exception)
@@ -224,10 +269,15 @@ public class AudioCaptureSettings
     public int Channels { get; set; } = 1;
     public int BitsPerSample { get; set; } = 16;
     public int BufferSize { get; set; } = 3200;
-    public int FrameIntervalMs { get; set; } = 100;
+    public int FrameIntervalMs { get; set; } = 100; // Frame length raised to handlers; 10, 20 or 30 ms for low-latency VAD and partials
+    public int HistoryMs { get; set; } = 1000; // Pre-roll history retained for late utterance starts (0 = disabled)
     public string? DeviceId { get; init; }
+    public string? Source { get; init; } // Null/empty = capture device; else stdin, file:, pipe: or unix: (see PcmSourceAddress)
 }
 
+/// <summary>
+/// One capture frame. <see cref="AudioData"/> is only valid during the handler; sources reuse the buffer.
+/// </summary>
 [ExcludeFromCodeCoverage] // Simple data container EventArgs class
 public class AudioFrameEventArgs : EventArgs
 {
@@ -1,6 +1,5 @@
-﻿using System.Buffers;
+﻿using System.Diagnostics.CodeAnalysis;
 using NAudio.Wave;
-using NAudio.Wave.SampleProviders;
 
 namespace Sttify.Corelib.Audio;
 
@@ -10,6 +9,10 @@ public static class AudioConverter
     private const int TargetBitsPerSample = 16;
     private const int TargetChannels = 1;
 
+    /// <summary>
+    /// Converts a complete recording to 16kHz mono 16-bit. Throws when the format cannot be read
+    /// rather than returning audio the recognizer would misinterpret.
+    /// </summary>
     public static byte[] ConvertToVoskFormat(ReadOnlySpan<byte> audioData, WaveFormat sourceFormat)
     {
         if (audioData.IsEmpty)
@@ -23,64 +26,8 @@ public static class AudioConverter
             return audioData.ToArray();
         }
 
-        try
-        {
-            // Use array pool for temporary buffer to avoid allocation
-            var pool = ArrayPool<byte>.Shared;
-            var tempBuffer = pool.Rent(audioData.Length);
-            try
-            {
-                audioData.CopyTo(tempBuffer);
-
-                using var sourceStream = new MemoryStream(tempBuffer, 0, audioData.Length);
-                using var sourceProvider = new RawSourceWaveStream(sourceStream, sourceFormat);
-
-                // Convert to ISampleProvider for processing
-                ISampleProvider sampleProvider = sourceProvider.ToSampleProvider();
-
-                // Convert to mono if necessary
-                if (sourceFormat.Channels > 1)
-                {
-                    sampleProvider = sampleProvider.ToMono();
-                }
-
-                // Resample if necessary
-                if (sourceFormat.SampleRate != TargetSampleRate)
-                {
-                    sampleProvider = new WdlResamplingSampleProvider(sampleProvider, TargetSampleRate);
-                }
-
-                // Convert back to wave format (16-bit PCM)
-                var waveProvider = new SampleToWaveProvider16(sampleProvider);
-
-                using var outputStream = new MemoryStream();
-                var readBuffer = pool.Rent(4096);
-                try
-                {
-                    int bytesRead;
-                    while ((bytesRead = waveProvider.Read(readBuffer, 0, readBuffer.Length)) > 0)
-                    {
-                        outputStream.Write(readBuffer, 0, bytesRead);
-                    }
-                }
-                finally
-                {
-                    pool.Return(readBuffer);
-                }
-
-                return outputStream.ToArray();
-            }
-            finally
-            {
-                pool.Return(tempBuffer);
-            }
-        }
-        catch (Exception ex)
-        {
-            System.Diagnostics.Debug.WriteLine($"Audio conversion failed: {ex.Message}");
-            // Return original data if conversion fails
-            return audioData.ToArray();
-        }
+        // A one-off buffer; streams keep a StreamingAudioConverter so the resampler state carries over
+        return new StreamingAudioConverter(sourceFormat).Convert(audioData).ToArray();
     }
 
     public static byte[] ConvertToVoskFormat(byte[] audioData, WaveFormat sourceFormat)
@@ -100,6 +47,35 @@ public static class AudioConverter
                format.Channels == TargetChannels;
     }
 
+    /// <summary>
+    /// Reads a recording as 16kHz mono 16-bit PCM. WAV files in any format are converted; raw
+    /// <c>.pcm</c>/<c>.raw</c> files are assumed to be in that format already. Returns null for
+    /// other extensions.
+    /// </summary>
+    [ExcludeFromCodeCoverage] // File system I/O
+    public static byte[]? ReadFileAsVoskPcm(string path)
+    {
+        switch (Path.GetExtension(path).ToLowerInvariant())
+        {
+            case ".wav":
+                using (var reader = new WaveFileReader(path))
+                using (var buffer = new MemoryStream())
+                {
+                    reader.CopyTo(buffer);
+                    return IsVoskCompatible(reader.WaveFormat)
+                        ? buffer.ToArray()
+                        : ConvertToVoskFormat(buffer.ToArray(), reader.WaveFormat);
+                }
+
+            case ".pcm":
+            case ".raw":
+                return File.ReadAllBytes(path);
+
+            default:
+                return null;
+        }
+    }
+
     public static double CalculateAudioLevel(ReadOnlySpan<byte> audioData, WaveFormat format)
     {
         if (audioData.IsEmpty)
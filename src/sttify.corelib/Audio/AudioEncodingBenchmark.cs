@@ -0,0 +1,62 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Measures what FLAC upload costs and saves on a recording: encode time relative to the audio
+/// length, and the bytes (raw and base64, as JSON APIs send them) compared with PCM/WAV.
+/// </summary>
+public static class AudioEncodingBenchmark
+{
+    private const int BytesPerSample = 2;
+    private const int WavHeaderBytes = 44;
+
+    public static AudioEncodingResult Measure(byte[] pcm, int sampleRate = 16000, int iterations = 5)
+    {
+        ArgumentNullException.ThrowIfNull(pcm);
+        if (iterations <= 0)
+            throw new ArgumentOutOfRangeException(nameof(iterations), "At least one iteration is required");
+
+        // The first pass includes JIT compilation, so it is not timed
+        var flac = FlacEncoder.Encode(pcm, sampleRate);
+
+        var stopwatch = Stopwatch.StartNew();
+        for (int i = 0; i < iterations; i++)
+        {
+            flac = FlacEncoder.Encode(pcm, sampleRate);
+        }
+        stopwatch.Stop();
+
+        return new AudioEncodingResult
+        {
+            AudioDuration = TimeSpan.FromSeconds((double)pcm.Length / (BytesPerSample * sampleRate)),
+            WavBytes = WavHeaderBytes + pcm.Length,
+            FlacBytes = flac.Length,
+            EncodeTime = stopwatch.Elapsed / iterations
+        };
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class AudioEncodingResult
+{
+    public TimeSpan AudioDuration { get; set; }
+    public long WavBytes { get; set; }
+    public long FlacBytes { get; set; }
+    public TimeSpan EncodeTime { get; set; } // Average per encode of the whole recording
+
+    public double CompressionRatio => WavBytes > 0 ? (double)FlacBytes / WavBytes : 1.0;
+    public double BandwidthSavedPercent => (1.0 - CompressionRatio) * 100.0;
+    public long WavBase64Bytes => GetBase64Length(WavBytes);
+    public long FlacBase64Bytes => GetBase64Length(FlacBytes);
+
+    /// <summary>
+    /// Encode time as a fraction of the audio duration; 0.01 means 1% of one core in real time.
+    /// </summary>
+    public double RealTimeFactor => AudioDuration > TimeSpan.Zero ? EncodeTime / AudioDuration : 0.0;
+
+    public double FlacBitrateKbps => AudioDuration > TimeSpan.Zero ? FlacBytes * 8 / AudioDuration.TotalSeconds / 1000.0 : 0.0;
+
+    private static long GetBase64Length(long bytes) => (bytes + 2) / 3 * 4;
+}
@@ -1,12 +1,30 @@
-﻿using System.Collections.Concurrent;
-using System.Diagnostics.CodeAnalysis;
+﻿using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Collections;
 using Sttify.Corelib.Diagnostics;
 
 namespace Sttify.Corelib.Audio;
 
 public class EndpointDetector : IDisposable
 {
-    private readonly ConcurrentQueue<EndpointEvent> _eventHistory = new();
+    private const int AdaptiveUtteranceWindow = 5;
+    private static readonly TimeSpan EnergyTrendWindow = TimeSpan.FromMilliseconds(500);
+
+    // Per-frame energies inside EnergyTrendWindow, with a running sum (capture thread only)
+    private readonly RingBuffer<EnergySample> _recentEnergies;
+    private double _recentEnergySum;
+
+    // Last few completed utterances with running sums; written from the timer thread too
+    private readonly RingBuffer<UtteranceStats> _recentUtterances = new(AdaptiveUtteranceWindow);
+    private readonly object _statsLock = new();
+    private double _utteranceDurationSumMs;
+    private double _endSilenceSumMs;
+    private long _utteranceStartTicks; // 0 = no utterance seen yet
+
+    // Pause tracking for learned endpointing
+    private long _pauseStartTicks; // 0 = not in a pause
+    private long _lastEndpointVoiceTicks; // last voice before the previous endpoint, 0 = none
+    private long _lastEndpointTicks; // when the previous endpoint fired
+
     private readonly EndpointSettings _settings;
     private readonly Timer _timeoutTimer;
     private readonly VoiceActivityDetector _vad;
@@ -19,6 +37,7 @@ public class EndpointDetector : IDisposable
     {
         _settings = settings ?? new EndpointSettings();
         _vad = vad ?? new VoiceActivityDetector();
+        _recentEnergies = new RingBuffer<EnergySample>(Math.Max(1, _settings.MaxEventHistory));
         _sessionStartTime = DateTime.UtcNow;
         _lastActivityTime = DateTime.UtcNow;
 
@@ -41,6 +60,20 @@ public class EndpointDetector : IDisposable
 
     public TimeSpan TimeSinceLastActivity => DateTime.UtcNow - _lastActivityTime;
 
+    /// <summary>
+    /// The VAD's running noise floor in dBFS, for stages that adapt to the background level.
+    /// </summary>
+    public double NoiseFloorDb => _vad.CurrentNoiseFloor;
+
+    /// <summary>
+    /// Silence needed to end an utterance; can be retuned between utterances.
+    /// </summary>
+    public int SilenceTimeoutMs
+    {
+        get => _settings.SilenceTimeoutMs;
+        set => _settings.SilenceTimeoutMs = Math.Max(1, value);
+    }
+
     public void Dispose()
     {
         Dispose(true);
@@ -56,10 +89,6 @@ public class EndpointDetector : IDisposable
         {
             _timeoutTimer.Dispose();
             _vad.Dispose();
-            while (_eventHistory.TryDequeue(out _))
-            {
-                // Intentionally empty - clearing queue
-            }
         }
 
         _disposed = true;
@@ -69,6 +98,7 @@ public class EndpointDetector : IDisposable
     public event EventHandler<UtteranceEndedEventArgs>? OnUtteranceEnded;
     public event EventHandler<EndpointTriggeredEventArgs>? OnEndpointTriggered;
     public event EventHandler<SessionTimeoutEventArgs>? OnSessionTimeout;
+    public event EventHandler<PauseObservedEventArgs>? OnPauseObserved;
 
     public EndpointResult ProcessAudioFrame(ReadOnlySpan<byte> audioData, int sampleRate, int channels)
     {
@@ -88,14 +118,8 @@ public class EndpointDetector : IDisposable
             // Detect endpoints based on multiple criteria
             var endpointResult = AnalyzeForEndpoints(vadResult, timestamp);
 
-            // Record event history
-            RecordEvent(new EndpointEvent
-            {
-                Timestamp = timestamp,
-                Type = EndpointEventType.AudioProcessed,
-                VadResult = vadResult,
-                EndpointResult = endpointResult
-            });
+            // Record energy for the trend window (after analysis, so the trend excludes this frame)
+            RecordEnergy(timestamp, vadResult.Energy);
 
             return endpointResult;
         }
@@ -248,15 +272,11 @@ public class EndpointDetector : IDisposable
         if (IsInUtterance && vadResult.Energy < _settings.EnergyEndpointThreshold)
         {
             // Check recent energy trend
-            var recentEvents = GetRecentEvents(TimeSpan.FromMilliseconds(500));
-            var recentEnergies = recentEvents
-                .Where(e => e.VadResult != null)
-                .Select(e => e.VadResult!.Energy)
-                .ToArray();
+            TrimEnergyWindow(DateTime.UtcNow - EnergyTrendWindow);
 
-            if (recentEnergies.Length > 3)
+            if (_recentEnergies.Count > 3)
             {
-                var avgRecentEnergy = recentEnergies.Average();
+                var avgRecentEnergy = _recentEnergySum / _recentEnergies.Count;
                 if (avgRecentEnergy < _settings.EnergyEndpointThreshold)
                 {
                     result.HasEndpoint = true;
@@ -274,12 +294,17 @@ public class EndpointDetector : IDisposable
         var result = new EndpointResult { HasEndpoint = false };
 
         // Analyze speech patterns from previous utterances
-        var recentUtterances = GetRecentUtteranceStats();
-        if (recentUtterances.Count < 2)
-            return result;
+        double avgUtteranceLength;
+        double avgSilenceLength;
+        lock (_statsLock)
+        {
+            var count = _recentUtterances.Count;
+            if (count < 2)
+                return result;
 
-        var avgUtteranceLength = recentUtterances.Average(u => u.Duration.TotalMilliseconds);
-        var avgSilenceLength = recentUtterances.Average(u => u.EndSilence.TotalMilliseconds);
+            avgUtteranceLength = _utteranceDurationSumMs / count;
+            avgSilenceLength = _endSilenceSumMs / count;
+        }
 
         if (IsInUtterance)
         {
@@ -310,15 +335,25 @@ public class EndpointDetector : IDisposable
             IsInUtterance = true;
             UtteranceCount++;
 
-            var startEvent = new UtteranceStartedEventArgs(UtteranceCount, e.Confidence, e.Timestamp);
-            OnUtteranceStarted?.Invoke(this, startEvent);
+            Volatile.Write(ref _utteranceStartTicks, e.Timestamp.Ticks);
 
-            RecordEvent(new EndpointEvent
+            // Speech resuming shortly after an endpoint may mean that endpoint cut the speaker off, but
+            // most such gaps are just the pause between sentences. Only a resume that follows the
+            // endpoint almost immediately is taken as evidence of a cut-off.
+            var lastEndpointVoice = Interlocked.Exchange(ref _lastEndpointVoiceTicks, 0);
+            if (lastEndpointVoice != 0)
             {
-                Timestamp = e.Timestamp,
-                Type = EndpointEventType.UtteranceStarted,
-                Confidence = e.Confidence
-            });
+                var gap = TimeSpan.FromTicks(e.Timestamp.Ticks - lastEndpointVoice);
+                if (gap.TotalMilliseconds <= _settings.ContinuationWindowMs)
+                {
+                    var resumeDelay = TimeSpan.FromTicks(e.Timestamp.Ticks - Volatile.Read(ref _lastEndpointTicks));
+                    var likelyCutOff = resumeDelay.TotalMilliseconds <= _settings.PrematureResumeMs;
+                    OnPauseObserved?.Invoke(this, new PauseObservedEventArgs(gap, true, likelyCutOff));
+                }
+            }
+
+            var startEvent = new UtteranceStartedEventArgs(UtteranceCount, e.Confidence, e.Timestamp);
+            OnUtteranceStarted?.Invoke(this, startEvent);
 
             Telemetry.LogEvent("UtteranceStarted", new
             {
@@ -331,6 +366,16 @@ public class EndpointDetector : IDisposable
         {
             // Potential utterance end - will be confirmed by endpoint detection
             _lastActivityTime = e.Timestamp;
+            Volatile.Write(ref _pauseStartTicks, e.Timestamp.Ticks);
+        }
+        else if (e.IsActive && IsInUtterance)
+        {
+            // Speech resumed before the endpoint fired: a pause the speaker made mid-utterance
+            var pauseStart = Interlocked.Exchange(ref _pauseStartTicks, 0);
+            if (pauseStart != 0)
+            {
+                OnPauseObserved?.Invoke(this, new PauseObservedEventArgs(TimeSpan.FromTicks(e.Timestamp.Ticks - pauseStart), false, false));
+            }
         }
     }
 
@@ -375,6 +420,9 @@ public class EndpointDetector : IDisposable
         if (IsInUtterance)
         {
             IsInUtterance = false;
+            Volatile.Write(ref _pauseStartTicks, 0);
+            Volatile.Write(ref _lastEndpointVoiceTicks, _lastActivityTime.Ticks);
+            Volatile.Write(ref _lastEndpointTicks, result.Timestamp.Ticks);
 
             var utteranceDuration = GetCurrentUtteranceDuration();
 
@@ -382,13 +430,7 @@ public class EndpointDetector : IDisposable
                 UtteranceCount, utteranceDuration, result.EndpointType, result.Confidence, result.Timestamp);
             OnUtteranceEnded?.Invoke(this, endEvent);
 
-            RecordEvent(new EndpointEvent
-            {
-                Timestamp = result.Timestamp,
-                Type = EndpointEventType.UtteranceEnded,
-                EndpointResult = result,
-                UtteranceDuration = utteranceDuration
-            });
+            RecordUtterance(result);
 
             Telemetry.LogEvent("UtteranceEnded", new
             {
@@ -470,59 +512,56 @@ public class EndpointDetector : IDisposable
 
     private TimeSpan GetCurrentUtteranceDuration()
     {
-        var startEvent = _eventHistory
-            .Where(e => e.Type == EndpointEventType.UtteranceStarted)
-            .OrderByDescending(e => e.Timestamp)
-            .FirstOrDefault();
-
-        return startEvent != null ? DateTime.UtcNow - startEvent.Timestamp : TimeSpan.Zero;
+        var startTicks = Volatile.Read(ref _utteranceStartTicks);
+        return startTicks != 0 ? DateTime.UtcNow - new DateTime(startTicks, DateTimeKind.Utc) : TimeSpan.Zero;
     }
 
-    private List<EndpointEvent> GetRecentEvents(TimeSpan timespan)
+    private void RecordEnergy(DateTime timestamp, double energy)
     {
-        var cutoff = DateTime.UtcNow - timespan;
-        return _eventHistory.Where(e => e.Timestamp >= cutoff).OrderByDescending(e => e.Timestamp).ToList();
+        TrimEnergyWindow(timestamp - EnergyTrendWindow);
+
+        if (_recentEnergies.Add(new EnergySample(timestamp.Ticks, energy), out var evicted))
+        {
+            _recentEnergySum -= evicted.Energy;
+        }
+        _recentEnergySum += energy;
     }
 
-    private List<UtteranceStats> GetRecentUtteranceStats()
+    private void TrimEnergyWindow(DateTime cutoff)
     {
-        var stats = new List<UtteranceStats>();
-        var events = _eventHistory.OrderByDescending(e => e.Timestamp).ToArray();
-
-        EndpointEvent? endEvent = null;
-        for (int i = 0; i < events.Length; i++)
+        var cutoffTicks = cutoff.Ticks;
+        while (_recentEnergies.Count > 0 && _recentEnergies.Oldest.TimestampTicks < cutoffTicks)
         {
-            var evt = events[i];
-
-            if (evt.Type == EndpointEventType.UtteranceEnded && endEvent == null)
-            {
-                endEvent = evt;
-            }
-            else if (evt.Type == EndpointEventType.UtteranceStarted && endEvent != null)
-            {
-                stats.Add(new UtteranceStats
-                {
-                    Duration = endEvent.Timestamp - evt.Timestamp,
-                    EndSilence = endEvent.EndpointResult?.SilenceDuration ?? TimeSpan.Zero
-                });
-
-                endEvent = null;
-                if (stats.Count >= 5)
-                    break; // Limit to recent utterances
-            }
+            _recentEnergySum -= _recentEnergies.RemoveOldest().Energy;
         }
 
-        return stats;
+        if (_recentEnergies.Count == 0)
+        {
+            // Drop accumulated floating-point drift whenever the window empties
+            _recentEnergySum = 0;
+        }
     }
 
-    private void RecordEvent(EndpointEvent evt)
+    private void RecordUtterance(EndpointResult result)
     {
-        _eventHistory.Enqueue(evt);
+        var startTicks = Volatile.Read(ref _utteranceStartTicks);
+        if (startTicks == 0)
+            return;
+
+        var stats = new UtteranceStats(
+            result.Timestamp - new DateTime(startTicks, DateTimeKind.Utc),
+            result.SilenceDuration ?? TimeSpan.Zero);
 
-        // Keep history manageable
-        while (_eventHistory.Count > _settings.MaxEventHistory)
+        lock (_statsLock)
         {
-            _eventHistory.TryDequeue(out _);
+            if (_recentUtterances.Add(stats, out var evicted))
+            {
+                _utteranceDurationSumMs -= evicted.Duration.TotalMilliseconds;
+                _endSilenceSumMs -= evicted.EndSilence.TotalMilliseconds;
+            }
+
+            _utteranceDurationSumMs += stats.Duration.TotalMilliseconds;
+            _endSilenceSumMs += stats.EndSilence.TotalMilliseconds;
         }
     }
 
@@ -535,7 +574,7 @@ public class EndpointDetector : IDisposable
             UtteranceCount = UtteranceCount,
             IsInUtterance = IsInUtterance,
             TimeSinceLastActivity = TimeSinceLastActivity,
-            EventHistoryCount = _eventHistory.Count,
+            EventHistoryCount = _recentEnergies.Count + _recentUtterances.Count,
             VadStatistics = _vad.GetStatistics()
         };
     }
@@ -548,9 +587,16 @@ public class EndpointDetector : IDisposable
         TotalSpeechDuration = 0;
         UtteranceCount = 0;
 
-        while (_eventHistory.TryDequeue(out _))
+        _recentEnergies.Clear();
+        _recentEnergySum = 0;
+        Volatile.Write(ref _utteranceStartTicks, 0);
+        Volatile.Write(ref _pauseStartTicks, 0);
+        Volatile.Write(ref _lastEndpointVoiceTicks, 0);
+        lock (_statsLock)
         {
-            // Intentionally empty - clearing queue
+            _recentUtterances.Clear();
+            _utteranceDurationSumMs = 0;
+            _endSilenceSumMs = 0;
         }
 
         _vad.Reset();
@@ -566,12 +612,17 @@ public class EndpointSettings
     public int MaxUtteranceDurationMs { get; set; } = 30000;
     public int MaxSessionDurationMs { get; set; } = 300000; // 5 minutes
     public int InactivityTimeoutMs { get; set; } = 10000;
-    public int MaxEventHistory { get; set; } = 1000;
+    public int MaxEventHistory { get; set; } = 1000; // Capacity of the per-frame energy ring
 
     public bool EnableEnergyEndpoint { get; set; } = true;
     public double EnergyEndpointThreshold { get; set; } = -40.0; // dB
 
     public bool EnableAdaptiveEndpoint { get; set; } = true;
+
+    // Speech resuming within this window after an endpoint is reported as a possible cut-off, and as a
+    // likely one only when it starts within PrematureResumeMs of the endpoint firing
+    public int ContinuationWindowMs { get; set; } = 1500;
+    public int PrematureResumeMs { get; set; } = 300;
 }
 
 [ExcludeFromCodeCoverage] // Simple data container class
@@ -587,20 +638,28 @@ public class EndpointResult
     public bool IsSessionTimeout { get; set; }
 }
 
-public class EndpointEvent
+internal readonly struct EnergySample
 {
-    public DateTime Timestamp { get; set; }
-    public EndpointEventType Type { get; set; }
-    public double Confidence { get; set; }
-    public VadResult? VadResult { get; set; }
-    public EndpointResult? EndpointResult { get; set; }
-    public TimeSpan? UtteranceDuration { get; set; }
+    public EnergySample(long timestampTicks, double energy)
+    {
+        TimestampTicks = timestampTicks;
+        Energy = energy;
+    }
+
+    public long TimestampTicks { get; }
+    public double Energy { get; }
 }
 
-public class UtteranceStats
+public readonly struct UtteranceStats
 {
-    public TimeSpan Duration { get; set; }
-    public TimeSpan EndSilence { get; set; }
+    public UtteranceStats(TimeSpan duration, TimeSpan endSilence)
+    {
+        Duration = duration;
+        EndSilence = endSilence;
+    }
+
+    public TimeSpan Duration { get; }
+    public TimeSpan EndSilence { get; }
 }
 
 [ExcludeFromCodeCoverage] // Diagnostic data container class
@@ -615,15 +674,6 @@ public class EndpointStatistics
     public VadStatistics? VadStatistics { get; set; }
 }
 
-public enum EndpointEventType
-{
-    AudioProcessed,
-    UtteranceStarted,
-    UtteranceEnded,
-    EndpointDetected,
-    Timeout
-}
-
 // Event argument classes
 [ExcludeFromCodeCoverage] // Simple data container EventArgs class
 public class UtteranceStartedEventArgs : EventArgs
@@ -670,6 +720,21 @@ public class EndpointTriggeredEventArgs : EventArgs
     public EndpointResult Result { get; }
 }
 
+[ExcludeFromCodeCoverage] // Simple data container EventArgs class
+public class PauseObservedEventArgs : EventArgs
+{
+    public PauseObservedEventArgs(TimeSpan duration, bool afterEndpoint, bool isLikelyCutOff)
+    {
+        Duration = duration;
+        AfterEndpoint = afterEndpoint;
+        IsLikelyCutOff = isLikelyCutOff;
+    }
+
+    public TimeSpan Duration { get; }
+    public bool AfterEndpoint { get; } // True when an endpoint had already fired before speech resumed
+    public bool IsLikelyCutOff { get; } // True when speech resumed right after that endpoint
+}
+
 [ExcludeFromCodeCoverage] // Simple data container EventArgs class
 public class SessionTimeoutEventArgs : EventArgs
 {
@@ -0,0 +1,15 @@
+﻿using System.Text.Json.Serialization;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Source-generated serializer for the learned endpoint profile, so it loads without reflection
+/// under trimming and NativeAOT.
+/// </summary>
+[JsonSourceGenerationOptions(
+    PropertyNamingPolicy = JsonKnownNamingPolicy.CamelCase,
+    WriteIndented = true)]
+[JsonSerializable(typeof(EndpointProfileData))]
+internal partial class EndpointProfileJsonContext : JsonSerializerContext
+{
+}
@@ -0,0 +1,415 @@
+﻿using System.Buffers;
+using System.Buffers.Binary;
+using System.Runtime.InteropServices;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Lossless FLAC encoder for 16-bit mono PCM using the fixed polynomial predictors and Rice-coded
+/// residuals. Frames are independent, so audio can be encoded as it arrives: write the stream header
+/// once, then one frame per block (only the final block may be shorter than <see cref="BlockSize"/>).
+/// </summary>
+public sealed class FlacEncoder
+{
+    public const int DefaultBlockSize = 4096;
+
+    private const int BitsPerSample = 16;
+    private const int MaxFixedOrder = 4;
+    private const int MaxPartitionOrder = 6;
+    private const int MaxRiceParameter = 14; // 15 is the escape code
+    private const int StreamHeaderSize = 42; // "fLaC" + metadata block header + STREAMINFO
+
+    private static readonly ushort[] Crc16Table = BuildCrc16Table();
+
+    private readonly byte[] _frameBuffer;
+    private readonly int[][] _residuals;
+    private readonly uint _sampleRateCode;
+    private long _frameNumber;
+
+    public FlacEncoder(int sampleRate = 16000, int blockSize = DefaultBlockSize)
+    {
+        if (sampleRate <= 0 || sampleRate >= 1 << 20)
+            throw new ArgumentOutOfRangeException(nameof(sampleRate));
+        if (blockSize < 16 || blockSize > ushort.MaxValue)
+            throw new ArgumentOutOfRangeException(nameof(blockSize), "Block size must be between 16 and 65535 samples");
+
+        SampleRate = sampleRate;
+        BlockSize = blockSize;
+        _sampleRateCode = GetSampleRateCode(sampleRate);
+
+        _residuals = new int[MaxFixedOrder + 1][];
+        for (int order = 0; order <= MaxFixedOrder; order++)
+        {
+            _residuals[order] = new int[blockSize];
+        }
+
+        // A verbatim subframe is the worst case, since any predictor that costs more is rejected
+        _frameBuffer = new byte[blockSize * (BitsPerSample / 8) + 32];
+    }
+
+    public int SampleRate { get; }
+    public int BlockSize { get; }
+    public long FramesEncoded => _frameNumber;
+
+    /// <summary>
+    /// Encodes a complete 16-bit little-endian PCM buffer as a standalone FLAC stream.
+    /// </summary>
+    public static byte[] Encode(ReadOnlySpan<byte> pcm, int sampleRate = 16000, int blockSize = DefaultBlockSize)
+    {
+        var samples = MemoryMarshal.Cast<byte, short>(pcm[..(pcm.Length & ~1)]);
+        var encoder = new FlacEncoder(sampleRate, blockSize);
+        var output = new ArrayBufferWriter<byte>(StreamHeaderSize + pcm.Length / 2);
+
+        encoder.WriteStreamHeader(output, samples.Length);
+        for (int offset = 0; offset < samples.Length; offset += blockSize)
+        {
+            encoder.EncodeFrame(samples.Slice(offset, Math.Min(blockSize, samples.Length - offset)), output);
+        }
+
+        return output.WrittenSpan.ToArray();
+    }
+
+    /// <summary>
+    /// Writes the stream marker and STREAMINFO block. Pass 0 samples when the length is not known yet.
+    /// </summary>
+    public void WriteStreamHeader(IBufferWriter<byte> output, long totalSamples = 0)
+    {
+        var span = output.GetSpan(StreamHeaderSize)[..StreamHeaderSize];
+        span.Clear();
+
+        "fLaC"u8.CopyTo(span);
+        span[4] = 0x80; // Last metadata block, type 0 (STREAMINFO)
+        span[7] = 34; // 24-bit block length
+
+        var info = span[8..];
+        BinaryPrimitives.WriteUInt16BigEndian(info, (ushort)BlockSize); // Minimum block size
+        BinaryPrimitives.WriteUInt16BigEndian(info[2..], (ushort)BlockSize); // Maximum block size
+        // Bytes 4-9: minimum/maximum frame size, zero = unknown
+
+        // 20-bit sample rate, 3-bit (channels - 1), 5-bit (bits per sample - 1), 36-bit total samples
+        var packed = ((ulong)SampleRate << 44) | ((ulong)(BitsPerSample - 1) << 36) | ((ulong)totalSamples & 0xF_FFFF_FFFFUL);
+        BinaryPrimitives.WriteUInt64BigEndian(info[10..], packed);
+        // Bytes 18-33: MD5 of the audio, zero = not computed
+
+        output.Advance(StreamHeaderSize);
+    }
+
+    public void EncodeFrame(ReadOnlySpan<short> samples, IBufferWriter<byte> output)
+    {
+        if (samples.IsEmpty || samples.Length > BlockSize)
+            throw new ArgumentOutOfRangeException(nameof(samples), $"Frames must hold 1 to {BlockSize} samples");
+
+        var writer = new BitWriter(_frameBuffer);
+        WriteFrameHeader(ref writer, samples.Length);
+        WriteSubframe(ref writer, samples);
+        writer.AlignToByte();
+        writer.WriteBits(Crc16(writer.WrittenSpan), 16);
+
+        output.Write(writer.WrittenSpan);
+        _frameNumber++;
+    }
+
+    private void WriteFrameHeader(ref BitWriter writer, int sampleCount)
+    {
+        writer.WriteBits(0b11111111111110, 14); // Sync code
+        writer.WriteBits(0, 1); // Reserved
+        writer.WriteBits(0, 1); // Fixed block size; the header carries the frame number
+        writer.WriteBits(0b0111, 4); // Block size as a 16-bit (n - 1) after the frame number
+        writer.WriteBits(_sampleRateCode, 4);
+        writer.WriteBits(0, 4); // Mono
+        writer.WriteBits(0b100, 3); // 16 bits per sample
+        writer.WriteBits(0, 1); // Reserved
+        WriteUtf8(ref writer, _frameNumber);
+        writer.WriteBits((uint)(sampleCount - 1), 16);
+        writer.WriteBits(Crc8(writer.WrittenSpan), 8);
+    }
+
+    private void WriteSubframe(ref BitWriter writer, ReadOnlySpan<short> samples)
+    {
+        var count = samples.Length;
+
+        // Silence between utterances is common and costs a single sample
+        if (samples[1..].IndexOfAnyExcept(samples[0]) < 0)
+        {
+            writer.WriteBits(0, 8); // Padding bit, type 000000 (CONSTANT), no wasted bits
+            writer.WriteSigned(samples[0], BitsPerSample);
+            return;
+        }
+
+        var bestOrder = -1;
+        var bestPartitionOrder = 0;
+        var bestBits = (long)count * BitsPerSample;
+
+        for (int order = 0; order <= Math.Min(MaxFixedOrder, count - 1); order++)
+        {
+            var residual = _residuals[order].AsSpan(0, count - order);
+            ComputeFixedResidual(samples, order, residual);
+
+            var bits = (long)order * BitsPerSample + EstimateResidualBits(residual, count, order, out var partitionOrder);
+            if (bits < bestBits)
+            {
+                bestBits = bits;
+                bestOrder = order;
+                bestPartitionOrder = partitionOrder;
+            }
+        }
+
+        if (bestOrder < 0)
+        {
+            writer.WriteBits(0b000001 << 1, 8); // VERBATIM
+            foreach (var sample in samples)
+            {
+                writer.WriteSigned(sample, BitsPerSample);
+            }
+            return;
+        }
+
+        writer.WriteBits((uint)(0b001000 | bestOrder) << 1, 8); // FIXED, predictor order in the low bits
+        for (int i = 0; i < bestOrder; i++)
+        {
+            writer.WriteSigned(samples[i], BitsPerSample); // Warm-up samples
+        }
+
+        WriteResidual(ref writer, _residuals[bestOrder].AsSpan(0, count - bestOrder), count, bestOrder, bestPartitionOrder);
+    }
+
+    private static void ComputeFixedResidual(ReadOnlySpan<short> x, int order, Span<int> residual)
+    {
+        for (int i = order; i < x.Length; i++)
+        {
+            residual[i - order] = order switch
+            {
+                0 => x[i],
+                1 => x[i] - x[i - 1],
+                2 => x[i] - 2 * x[i - 1] + x[i - 2],
+                3 => x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3],
+                _ => x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4]
+            };
+        }
+    }
+
+    /// <summary>
+    /// Picks the partition order with the smallest estimated size. The estimate never undercounts,
+    /// so a frame that beats the verbatim size here always fits the frame buffer.
+    /// </summary>
+    private static long EstimateResidualBits(ReadOnlySpan<int> residual, int sampleCount, int order, out int bestPartitionOrder)
+    {
+        var bestBits = long.MaxValue;
+        bestPartitionOrder = 0;
+
+        for (int partitionOrder = 0; partitionOrder <= MaxPartitionOrder; partitionOrder++)
+        {
+            if (!IsValidPartitionOrder(sampleCount, order, partitionOrder))
+                break;
+
+            var bits = 6L; // Coding method + partition order
+            var start = 0;
+            var partitionSize = sampleCount >> partitionOrder;
+            for (int partition = 0; partition < 1 << partitionOrder; partition++)
+            {
+                var length = partition == 0 ? partitionSize - order : partitionSize;
+                ChooseRiceParameter(residual.Slice(start, length), out var partitionBits);
+                bits += 4 + partitionBits;
+                start += length;
+            }
+
+            if (bits < bestBits)
+            {
+                bestBits = bits;
+                bestPartitionOrder = partitionOrder;
+            }
+        }
+
+        return bestBits;
+    }
+
+    private static bool IsValidPartitionOrder(int sampleCount, int order, int partitionOrder)
+    {
+        return partitionOrder == 0 ||
+               (sampleCount % (1 << partitionOrder) == 0 && sampleCount >> partitionOrder > order);
+    }
+
+    private static int ChooseRiceParameter(ReadOnlySpan<int> residual, out long bits)
+    {
+        ulong sum = 0;
+        foreach (var value in residual)
+        {
+            sum += ZigZag(value);
+        }
+
+        // Sum(u >> k) <= Sum(u) >> k, so this bound is exact or slightly high
+        var bestParameter = 0;
+        bits = long.MaxValue;
+        for (int parameter = 0; parameter <= MaxRiceParameter; parameter++)
+        {
+            var candidate = (long)residual.Length * (parameter + 1) + (long)(sum >> parameter);
+            if (candidate < bits)
+            {
+                bits = candidate;
+                bestParameter = parameter;
+            }
+        }
+
+        return bestParameter;
+    }
+
+    private static void WriteResidual(ref BitWriter writer, ReadOnlySpan<int> residual, int sampleCount, int order, int partitionOrder)
+    {
+        writer.WriteBits(0b00, 2); // Rice coding with 4-bit parameters
+        writer.WriteBits((uint)partitionOrder, 4);
+
+        var start = 0;
+        var partitionSize = sampleCount >> partitionOrder;
+        for (int partition = 0; partition < 1 << partitionOrder; partition++)
+        {
+            var length = partition == 0 ? partitionSize - order : partitionSize;
+            var slice = residual.Slice(start, length);
+            var parameter = ChooseRiceParameter(slice, out _);
+
+            writer.WriteBits((uint)parameter, 4);
+            foreach (var value in slice)
+            {
+                var folded = ZigZag(value);
+                writer.WriteUnary(folded >> parameter);
+                writer.WriteBits(folded, parameter);
+            }
+            start += length;
+        }
+    }
+
+    private static uint ZigZag(int value) => (uint)((value << 1) ^ (value >> 31));
+
+    private static void WriteUtf8(ref BitWriter writer, long value)
+    {
+        if (value < 0x80)
+        {
+            writer.WriteBits((uint)value, 8);
+            return;
+        }
+
+        var continuationBytes = value switch
+        {
+            < 0x800 => 1,
+            < 0x10000 => 2,
+            < 0x200000 => 3,
+            < 0x4000000 => 4,
+            < 0x80000000 => 5,
+            _ => 6
+        };
+
+        var lead = (0xFF00u >> (continuationBytes + 1)) & 0xFF;
+        writer.WriteBits(lead | (uint)(value >> (6 * continuationBytes)), 8);
+        for (int i = continuationBytes - 1; i >= 0; i--)
+        {
+            writer.WriteBits(0x80 | (uint)((value >> (6 * i)) & 0x3F), 8);
+        }
+    }
+
+    private static uint GetSampleRateCode(int sampleRate) => sampleRate switch
+    {
+        8000 => 0b0100,
+        16000 => 0b0101,
+        22050 => 0b0110,
+        24000 => 0b0111,
+        32000 => 0b1000,
+        44100 => 0b1001,
+        48000 => 0b1010,
+        96000 => 0b1011,
+        _ => 0b0000 // Taken from STREAMINFO
+    };
+
+    private static byte Crc8(ReadOnlySpan<byte> data)
+    {
+        uint crc = 0;
+        foreach (var b in data)
+        {
+            crc ^= b;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x80) != 0 ? (crc << 1) ^ 0x07 : crc << 1;
+            }
+        }
+        return (byte)crc;
+    }
+
+    private static ushort Crc16(ReadOnlySpan<byte> data)
+    {
+        ushort crc = 0;
+        foreach (var b in data)
+        {
+            crc = (ushort)((crc << 8) ^ Crc16Table[(crc >> 8) ^ b]);
+        }
+        return crc;
+    }
+
+    private static ushort[] BuildCrc16Table()
+    {
+        var table = new ushort[256];
+        for (int i = 0; i < table.Length; i++)
+        {
+            var crc = (uint)i << 8;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x8000) != 0 ? (crc << 1) ^ 0x8005 : crc << 1;
+            }
+            table[i] = (ushort)crc;
+        }
+        return table;
+    }
+
+    /// <summary>
+    /// MSB-first bit packer over the frame buffer.
+    /// </summary>
+    private ref struct BitWriter
+    {
+        private readonly Span<byte> _buffer;
+        private ulong _accumulator;
+        private int _pendingBits;
+        private int _position;
+
+        public BitWriter(Span<byte> buffer)
+        {
+            _buffer = buffer;
+            _accumulator = 0;
+            _pendingBits = 0;
+            _position = 0;
+        }
+
+        // Whole bytes only; call AlignToByte first when the frame ends mid-byte
+        public readonly ReadOnlySpan<byte> WrittenSpan => _buffer[.._position];
+
+        public void WriteBits(uint value, int count)
+        {
+            if (count == 0)
+                return;
+
+            _accumulator = (_accumulator << count) | (value & (uint)((1UL << count) - 1));
+            _pendingBits += count;
+            while (_pendingBits >= 8)
+            {
+                _pendingBits -= 8;
+                _buffer[_position++] = (byte)(_accumulator >> _pendingBits);
+            }
+        }
+
+        public void WriteSigned(int value, int count) => WriteBits((uint)value, count);
+
+        public void WriteUnary(uint zeros)
+        {
+            while (zeros >= 32)
+            {
+                WriteBits(0, 32);
+                zeros -= 32;
+            }
+            WriteBits(1, (int)zeros + 1);
+        }
+
+        public void AlignToByte()
+        {
+            if (_pendingBits > 0)
+            {
+                WriteBits(0, 8 - _pendingBits);
+            }
+        }
+    }
+}
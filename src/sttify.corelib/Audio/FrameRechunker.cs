@@ -0,0 +1,87 @@
+﻿namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Cuts PCM arriving in arbitrary buffer sizes (device callbacks, stream reads) into frames of
+/// exactly <see cref="FrameBytes"/>. The frame buffer is allocated once and reused, so a frame is
+/// only valid for the duration of the callback; handlers copy whatever they keep.
+/// </summary>
+public sealed class FrameRechunker
+{
+    public const int MinFrameMs = 10;
+    public const int MaxFrameMs = 1000;
+
+    private readonly int _blockAlign;
+    private readonly byte[] _frame;
+    private int _filled;
+
+    public FrameRechunker(int frameBytes, int blockAlign = 2)
+    {
+        if (blockAlign <= 0)
+            throw new ArgumentOutOfRangeException(nameof(blockAlign), "Block alignment must be positive");
+        if (frameBytes < blockAlign || frameBytes % blockAlign != 0)
+            throw new ArgumentOutOfRangeException(nameof(frameBytes), "Frame size must be a whole number of samples");
+
+        _blockAlign = blockAlign;
+        _frame = new byte[frameBytes];
+    }
+
+    public int FrameBytes => _frame.Length;
+    public int PendingBytes => _filled; // Carried over until the next write completes a frame
+
+    /// <summary>
+    /// Bytes in one frame of <paramref name="frameMs"/> at the given format. Frame lengths are
+    /// clamped to 10–1000 ms; 10, 20 and 30 ms keep VAD, endpointing and partials responsive.
+    /// </summary>
+    public static int GetFrameBytes(int sampleRate, int channels, int bitsPerSample, int frameMs)
+    {
+        var blockAlign = channels * bitsPerSample / 8;
+        var samples = (long)sampleRate * Math.Clamp(frameMs, MinFrameMs, MaxFrameMs) / 1000;
+        return (int)Math.Max(1, samples) * blockAlign;
+    }
+
+    /// <summary>
+    /// Appends <paramref name="data"/> and raises <paramref name="onFrame"/> for every frame it
+    /// completes. Returns the number of frames raised.
+    /// </summary>
+    public int Write(ReadOnlySpan<byte> data, Action<ReadOnlyMemory<byte>> onFrame)
+    {
+        ArgumentNullException.ThrowIfNull(onFrame);
+
+        var frames = 0;
+        while (!data.IsEmpty)
+        {
+            var count = Math.Min(data.Length, _frame.Length - _filled);
+            data[..count].CopyTo(_frame.AsSpan(_filled));
+            _filled += count;
+            data = data[count..];
+
+            if (_filled == _frame.Length)
+            {
+                _filled = 0;
+                onFrame(_frame);
+                frames++;
+            }
+        }
+
+        return frames;
+    }
+
+    /// <summary>
+    /// Raises the pending partial frame, if any whole samples are pending, and starts over. Used
+    /// when the stream ends so its tail is not held back.
+    /// </summary>
+    public bool Flush(Action<ReadOnlyMemory<byte>> onFrame)
+    {
+        ArgumentNullException.ThrowIfNull(onFrame);
+
+        var length = _filled - _filled % _blockAlign;
+        _filled = 0;
+        if (length == 0)
+            return false;
+
+        onFrame(_frame.AsMemory(0, length));
+        return true;
+    }
+
+    public void Reset() => _filled = 0;
+}
@@ -0,0 +1,103 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Compares capture frame sizes on a recording: per-frame processing cost against the latency a
+/// frame adds. Audio is fed in device-sized buffers through <see cref="FrameRechunker"/> into the
+/// stage under test, which defaults to the session's VAD and endpointing.
+/// </summary>
+public static class FrameSizeBenchmark
+{
+    private const int BytesPerSample = 2;
+    private const int DeviceBufferMs = 10; // WASAPI shared-mode period
+
+    public static IReadOnlyList<int> DefaultFrameSizesMs { get; } = [10, 20, 30, 100];
+
+    public static IReadOnlyList<FrameSizeResult> Measure(
+        byte[] pcm,
+        IReadOnlyList<int>? frameSizesMs = null,
+        Action<ReadOnlyMemory<byte>>? stage = null,
+        int sampleRate = 16000)
+    {
+        ArgumentNullException.ThrowIfNull(pcm);
+        if (sampleRate <= 0)
+            throw new ArgumentOutOfRangeException(nameof(sampleRate), "Sample rate must be positive");
+
+        var audioDuration = TimeSpan.FromSeconds((double)pcm.Length / (BytesPerSample * sampleRate));
+        var results = new List<FrameSizeResult>();
+
+        foreach (var frameMs in frameSizesMs ?? DefaultFrameSizesMs)
+        {
+            using var endpointDetector = stage == null ? new EndpointDetector() : null;
+            var frameStage = stage ?? (frame => endpointDetector!.ProcessAudioFrame(frame.Span, sampleRate, 1));
+
+            // The first pass includes JIT compilation, so it is not timed
+            Run(pcm, sampleRate, frameMs, frameStage, out _, out _);
+            endpointDetector?.Reset();
+
+            var frames = Run(pcm, sampleRate, frameMs, frameStage, out var processingTime, out var maxFrameTime);
+            results.Add(new FrameSizeResult
+            {
+                FrameMs = Math.Clamp(frameMs, FrameRechunker.MinFrameMs, FrameRechunker.MaxFrameMs),
+                AudioDuration = audioDuration,
+                Frames = frames,
+                ProcessingTime = processingTime,
+                MaxFrameTime = maxFrameTime
+            });
+        }
+
+        return results;
+    }
+
+    private static int Run(byte[] pcm, int sampleRate, int frameMs, Action<ReadOnlyMemory<byte>> stage,
+        out TimeSpan processingTime, out TimeSpan maxFrameTime)
+    {
+        var rechunker = new FrameRechunker(FrameRechunker.GetFrameBytes(sampleRate, 1, 16, frameMs));
+        var deviceBytes = FrameRechunker.GetFrameBytes(sampleRate, 1, 16, DeviceBufferMs);
+        long total = 0, max = 0;
+
+        void TimedStage(ReadOnlyMemory<byte> frame)
+        {
+            var start = Stopwatch.GetTimestamp();
+            stage(frame);
+            var elapsed = Stopwatch.GetTimestamp() - start;
+            total += elapsed;
+            max = Math.Max(max, elapsed);
+        }
+
+        var frames = 0;
+        for (int offset = 0; offset < pcm.Length; offset += deviceBytes)
+        {
+            frames += rechunker.Write(pcm.AsSpan(offset, Math.Min(deviceBytes, pcm.Length - offset)), TimedStage);
+        }
+
+        processingTime = Stopwatch.GetElapsedTime(0, total);
+        maxFrameTime = Stopwatch.GetElapsedTime(0, max);
+        return frames;
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class FrameSizeResult
+{
+    public int FrameMs { get; set; }
+    public TimeSpan AudioDuration { get; set; }
+    public int Frames { get; set; }
+    public TimeSpan ProcessingTime { get; set; } // Total across all frames
+    public TimeSpan MaxFrameTime { get; set; }
+
+    public TimeSpan MeanFrameTime => Frames > 0 ? ProcessingTime / Frames : TimeSpan.Zero;
+
+    /// <summary>
+    /// Processing time as a fraction of the audio duration; smaller frames pay per-call overhead more often.
+    /// </summary>
+    public double RealTimeFactor => AudioDuration > TimeSpan.Zero ? ProcessingTime / AudioDuration : 0.0;
+
+    /// <summary>
+    /// Longest a sample can wait before the stage has seen it: a full frame of buffering plus the
+    /// slowest frame's processing.
+    /// </summary>
+    public TimeSpan WorstCaseLatency => TimeSpan.FromMilliseconds(FrameMs) + MaxFrameTime;
+}
@@ -0,0 +1,17 @@
+﻿namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Producer of capture frames for <see cref="AudioCapture"/>. Frames are delivered as 16kHz mono
+/// 16-bit PCM of exactly <see cref="AudioCaptureSettings.FrameIntervalMs"/>, whatever the underlying
+/// device or stream format. Frame buffers are reused, so handlers copy any audio they keep.
+/// </summary>
+public interface IAudioSource : IDisposable
+{
+    event EventHandler<AudioFrameEventArgs>? OnFrame;
+    event EventHandler<AudioErrorEventArgs>? OnError;
+
+    bool IsCapturing { get; }
+
+    Task StartAsync(AudioCaptureSettings settings, CancellationToken cancellationToken = default);
+    Task StopAsync();
+}
@@ -0,0 +1,535 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using System.Numerics;
+using Sttify.Corelib.Collections;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Streaming spectral noise suppression for 16-bit mono PCM, run between capture and the engine.
+/// Audio is analysed in 50%-overlapping sqrt-Hann blocks; a per-bin noise spectrum is learned from
+/// blocks the broadband noise floor marks as noise-only, and each bin gets a Wiener-style gain
+/// <c>max(floor, 1 - k·N/P)</c> before overlap-add resynthesis. The FFT, gain and overlap-add
+/// kernels are written over <see cref="Vector{T}"/> so they use SIMD where the CPU has it.
+/// Output lags input by <see cref="LatencySamples"/> and always has the input's length.
+/// </summary>
+public sealed class NoiseSuppressor
+{
+    private const float Epsilon = 1e-10f;
+    private const double FloorRiseAlpha = 0.002; // Own floor tracker follows noise up slowly...
+    private const double FloorFallAlpha = 0.3; // ...and down quickly, like a minimum follower
+    private const int BypassCooldownBlocks = 100; // Blocks to stay bypassed before trying again
+
+    private readonly float[] _analysis; // Last FftSize input samples, newest at the end
+    private readonly int[] _bitReverse;
+    private readonly long _budgetTicksPerBlock;
+    private readonly int _fftSize;
+    private readonly float[] _fullGain; // Per-bin gains mirrored to all FftSize bins
+    private readonly float[] _gain;
+    private readonly float _gainFloor;
+    private readonly int _hop;
+    private readonly float[] _imag;
+    private readonly float[] _noise;
+    private readonly float[] _overlap; // Overlap-add accumulator
+    private readonly RingBuffer<short> _pending; // Resynthesized samples waiting to be returned
+    private readonly float[] _power;
+    private readonly float[] _real;
+    private readonly NoiseSuppressionSettings _settings;
+    private readonly float[] _twiddleImag; // Per-stage twiddles, stage of length L at offset L/2 - 1
+    private readonly float[] _twiddleReal;
+    private readonly float[] _window;
+
+    private int _bypassBlocksLeft;
+    private int _inputFill;
+    private bool _noiseLearned;
+    private int _overBudgetBlocks;
+    private double _trackedFloorDb = double.NaN;
+
+    public NoiseSuppressor(NoiseSuppressionSettings? settings = null)
+    {
+        _settings = settings ?? new NoiseSuppressionSettings();
+        if (_settings.FftSize < 64 || !BitOperations.IsPow2(_settings.FftSize))
+            throw new ArgumentOutOfRangeException(nameof(settings), "FFT size must be a power of two of at least 64");
+
+        _fftSize = _settings.FftSize;
+        _hop = _fftSize / 2;
+        var bins = _fftSize / 2 + 1;
+
+        _analysis = new float[_fftSize];
+        _real = new float[_fftSize];
+        _imag = new float[_fftSize];
+        _overlap = new float[_fftSize];
+        _fullGain = new float[_fftSize];
+        _power = new float[bins];
+        _noise = new float[bins];
+        _gain = new float[bins];
+        _gainFloor = (float)Math.Pow(10, -Math.Max(0, _settings.MaxAttenuationDb) / 20.0);
+        _pending = new RingBuffer<short>(2 * _hop);
+
+        // Periodic sqrt-Hann for analysis and synthesis: the squared windows sum to one at 50% overlap
+        _window = new float[_fftSize];
+        for (int i = 0; i < _fftSize; i++)
+        {
+            _window[i] = (float)Math.Sqrt(0.5 - 0.5 * Math.Cos(2.0 * Math.PI * i / _fftSize));
+        }
+
+        var bits = BitOperations.Log2((uint)_fftSize);
+        _bitReverse = new int[_fftSize];
+        for (int i = 0; i < _fftSize; i++)
+        {
+            _bitReverse[i] = (int)(ReverseBits((uint)i) >> (32 - bits));
+        }
+
+        _twiddleReal = new float[_fftSize - 1];
+        _twiddleImag = new float[_fftSize - 1];
+        for (int length = 2, offset = 0; length <= _fftSize; offset += length / 2, length *= 2)
+        {
+            for (int k = 0; k < length / 2; k++)
+            {
+                var angle = -2.0 * Math.PI * k / length;
+                _twiddleReal[offset + k] = (float)Math.Cos(angle);
+                _twiddleImag[offset + k] = (float)Math.Sin(angle);
+            }
+        }
+
+        var blockSeconds = (double)_hop / Math.Max(1, _settings.SampleRate);
+        _budgetTicksPerBlock = _settings.CpuBudgetPercent > 0
+            ? Math.Max(1, (long)(blockSeconds * Stopwatch.Frequency * _settings.CpuBudgetPercent / 100.0))
+            : 0;
+
+        Reset();
+    }
+
+    /// <summary>
+    /// Delay between a sample going in and its suppressed version coming out.
+    /// </summary>
+    public int LatencySamples => 2 * _hop;
+
+    /// <summary>
+    /// True while suppression is skipped because recent blocks exceeded the CPU budget; audio still
+    /// passes through with the same latency.
+    /// </summary>
+    public bool IsBypassed => _bypassBlocksLeft > 0;
+
+    public long ProcessedBlocks { get; private set; }
+    public long BypassedBlocks { get; private set; }
+
+    /// <summary>
+    /// Suppresses noise in <paramref name="input"/> (16-bit little-endian mono) into
+    /// <paramref name="output"/>, which must be the same length.
+    /// </summary>
+    /// <param name="noiseFloorDb">
+    /// Broadband noise floor in dBFS, e.g. <see cref="VoiceActivityDetector.CurrentNoiseFloor"/>;
+    /// NaN uses the suppressor's own tracker.
+    /// </param>
+    public void Process(ReadOnlySpan<byte> input, Span<byte> output, double noiseFloorDb = double.NaN)
+    {
+        if (output.Length != input.Length)
+            throw new ArgumentException("Output must be the same length as the input", nameof(output));
+
+        var sampleCount = input.Length / 2;
+        var written = 0;
+        for (int i = 0; i < sampleCount; i++)
+        {
+            var sample = (short)(input[i * 2] | (input[i * 2 + 1] << 8));
+            _analysis[_hop + _inputFill++] = sample / 32768f;
+
+            if (_inputFill == _hop)
+            {
+                ProcessBlock(noiseFloorDb);
+                _inputFill = 0;
+            }
+
+            // The pending queue starts with one hop of silence, so a sample is always ready
+            var value = _pending.RemoveOldest();
+            output[written++] = (byte)value;
+            output[written++] = (byte)(value >> 8);
+        }
+
+        output[written..].Clear(); // A trailing odd byte has no sample to carry
+    }
+
+    public void Reset()
+    {
+        Array.Clear(_analysis);
+        Array.Clear(_overlap);
+        Array.Clear(_noise);
+        _gain.AsSpan().Fill(1f);
+        _pending.Clear();
+        for (int i = 0; i < _hop; i++)
+        {
+            _pending.Add(0);
+        }
+
+        _inputFill = 0;
+        _noiseLearned = false;
+        _trackedFloorDb = double.NaN;
+        _bypassBlocksLeft = 0;
+        _overBudgetBlocks = 0;
+    }
+
+    private void ProcessBlock(double noiseFloorDb)
+    {
+        var start = Stopwatch.GetTimestamp();
+        ProcessedBlocks++;
+
+        // _analysis holds the previous hop followed by the new one
+        Multiply(_analysis, _window, _real);
+        Array.Clear(_imag);
+
+        if (_bypassBlocksLeft > 0)
+        {
+            _bypassBlocksLeft--;
+            BypassedBlocks++;
+        }
+        else
+        {
+            SuppressBlock(noiseFloorDb);
+        }
+
+        // Synthesis window and overlap-add; the first hop is now complete
+        MultiplyAdd(_real, _window, _overlap);
+        for (int i = 0; i < _hop; i++)
+        {
+            var scaled = Math.Round(_overlap[i] * 32768f);
+            _pending.Add((short)Math.Clamp(scaled, short.MinValue, short.MaxValue));
+        }
+
+        _overlap.AsSpan(_hop).CopyTo(_overlap);
+        _overlap.AsSpan(_hop).Clear();
+        _analysis.AsSpan(_hop).CopyTo(_analysis);
+
+        if (_budgetTicksPerBlock > 0 && _bypassBlocksLeft == 0)
+        {
+            CheckBudget(Stopwatch.GetTimestamp() - start);
+        }
+    }
+
+    private void SuppressBlock(double noiseFloorDb)
+    {
+        var blockDb = GetLevelDb(_analysis);
+        if (double.IsNaN(noiseFloorDb))
+        {
+            noiseFloorDb = TrackFloor(blockDb);
+        }
+
+        Fft(_real, _imag);
+        var bins = _power.Length;
+        Power(_real.AsSpan(0, bins), _imag.AsSpan(0, bins), _power);
+
+        if (blockDb < noiseFloorDb + _settings.NoiseGateMarginDb)
+        {
+            if (_noiseLearned)
+            {
+                Blend(_noise, _power, (float)_settings.NoiseAdaptation);
+            }
+            else
+            {
+                _power.CopyTo(_noise, 0);
+                _noiseLearned = true;
+            }
+        }
+
+        if (!_noiseLearned)
+        {
+            // Nothing to subtract yet: pass the windowed block through unchanged
+            Multiply(_analysis, _window, _real);
+            return;
+        }
+
+        UpdateGains((float)_settings.OverSubtraction, (float)_settings.GainSmoothing);
+
+        // Real input has a conjugate-symmetric spectrum, so bin k and N - k share a gain
+        _gain.CopyTo(_fullGain, 0);
+        for (int k = 1; k < _hop; k++)
+        {
+            _fullGain[_fftSize - k] = _gain[k];
+        }
+
+        // Inverse FFT as conj(FFT(conj(X))) / N; the output is real, so only the real part is kept
+        Multiply(_real, _fullGain, _real);
+        Multiply(_imag, _fullGain, _imag);
+        Scale(_imag, -1f);
+        Fft(_real, _imag);
+        Scale(_real, 1f / _fftSize);
+    }
+
+    private void CheckBudget(long elapsedTicks)
+    {
+        if (elapsedTicks <= _budgetTicksPerBlock)
+        {
+            _overBudgetBlocks = 0;
+            return;
+        }
+
+        // A single slow block is usually a context switch; only sustained overruns trip the bypass
+        if (++_overBudgetBlocks < 3)
+            return;
+
+        _overBudgetBlocks = 0;
+        _bypassBlocksLeft = BypassCooldownBlocks;
+        Telemetry.LogWarning("NoiseSuppressionOverBudget",
+            "Noise suppression exceeded its CPU budget and is bypassed for a while",
+            new
+            {
+                ElapsedMs = Stopwatch.GetElapsedTime(0, elapsedTicks).TotalMilliseconds,
+                BudgetMs = Stopwatch.GetElapsedTime(0, _budgetTicksPerBlock).TotalMilliseconds,
+                _settings.CpuBudgetPercent
+            });
+    }
+
+    private double TrackFloor(double blockDb)
+    {
+        if (double.IsNaN(_trackedFloorDb))
+        {
+            _trackedFloorDb = blockDb;
+        }
+        else
+        {
+            var alpha = blockDb < _trackedFloorDb ? FloorFallAlpha : FloorRiseAlpha;
+            _trackedFloorDb += alpha * (blockDb - _trackedFloorDb);
+        }
+
+        return _trackedFloorDb;
+    }
+
+    private static double GetLevelDb(ReadOnlySpan<float> samples)
+    {
+        // Same scale as the VAD: RMS in dB relative to full scale
+        var sum = Dot(samples, samples);
+        var rms = Math.Sqrt(sum / samples.Length);
+        return rms > 0 ? 20.0 * Math.Log10(rms) : -100.0;
+    }
+
+    private void UpdateGains(float overSubtraction, float smoothing)
+    {
+        var gainFloor = _gainFloor;
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            var one = Vector<float>.One;
+            var floor = new Vector<float>(gainFloor);
+            var over = new Vector<float>(overSubtraction);
+            var keep = new Vector<float>(smoothing);
+            var take = new Vector<float>(1f - smoothing);
+            var epsilon = new Vector<float>(Epsilon);
+            for (; i <= _gain.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                var power = new Vector<float>(_power, i);
+                var noise = new Vector<float>(_noise, i);
+                var gain = Vector.Max(floor, Vector.Min(one, one - over * noise / (power + epsilon)));
+                (keep * new Vector<float>(_gain, i) + take * gain).CopyTo(_gain, i);
+            }
+        }
+
+        for (; i < _gain.Length; i++)
+        {
+            var gain = Math.Clamp(1f - overSubtraction * _noise[i] / (_power[i] + Epsilon), gainFloor, 1f);
+            _gain[i] = smoothing * _gain[i] + (1f - smoothing) * gain;
+        }
+    }
+
+    /// <summary>
+    /// In-place radix-2 FFT over split real/imaginary arrays. Butterflies of a stage are contiguous
+    /// once the half-length reaches the vector width, which is where most of the work is.
+    /// </summary>
+    private void Fft(float[] real, float[] imag)
+    {
+        var n = real.Length;
+        for (int i = 0; i < n; i++)
+        {
+            var j = _bitReverse[i];
+            if (i < j)
+            {
+                (real[i], real[j]) = (real[j], real[i]);
+                (imag[i], imag[j]) = (imag[j], imag[i]);
+            }
+        }
+
+        for (int length = 2, offset = 0; length <= n; offset += length / 2, length *= 2)
+        {
+            var half = length / 2;
+            var twiddleReal = _twiddleReal.AsSpan(offset, half);
+            var twiddleImag = _twiddleImag.AsSpan(offset, half);
+            for (int start = 0; start < n; start += length)
+            {
+                Butterflies(
+                    real.AsSpan(start, half), imag.AsSpan(start, half),
+                    real.AsSpan(start + half, half), imag.AsSpan(start + half, half),
+                    twiddleReal, twiddleImag);
+            }
+        }
+    }
+
+    private static void Butterflies(Span<float> aReal, Span<float> aImag, Span<float> bReal, Span<float> bImag,
+        ReadOnlySpan<float> wReal, ReadOnlySpan<float> wImag)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            for (; i <= aReal.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                var xr = new Vector<float>(bReal[i..]);
+                var xi = new Vector<float>(bImag[i..]);
+                var wr = new Vector<float>(wReal[i..]);
+                var wi = new Vector<float>(wImag[i..]);
+                var vr = xr * wr - xi * wi;
+                var vi = xr * wi + xi * wr;
+                var ur = new Vector<float>(aReal[i..]);
+                var ui = new Vector<float>(aImag[i..]);
+                (ur + vr).CopyTo(aReal[i..]);
+                (ui + vi).CopyTo(aImag[i..]);
+                (ur - vr).CopyTo(bReal[i..]);
+                (ui - vi).CopyTo(bImag[i..]);
+            }
+        }
+
+        for (; i < aReal.Length; i++)
+        {
+            var vr = bReal[i] * wReal[i] - bImag[i] * wImag[i];
+            var vi = bReal[i] * wImag[i] + bImag[i] * wReal[i];
+            var ur = aReal[i];
+            var ui = aImag[i];
+            aReal[i] = ur + vr;
+            aImag[i] = ui + vi;
+            bReal[i] = ur - vr;
+            bImag[i] = ui - vi;
+        }
+    }
+
+    private static void Multiply(ReadOnlySpan<float> a, ReadOnlySpan<float> b, Span<float> result)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            for (; i <= a.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                (new Vector<float>(a[i..]) * new Vector<float>(b[i..])).CopyTo(result[i..]);
+            }
+        }
+
+        for (; i < a.Length; i++)
+        {
+            result[i] = a[i] * b[i];
+        }
+    }
+
+    private static void MultiplyAdd(ReadOnlySpan<float> a, ReadOnlySpan<float> b, Span<float> accumulator)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            for (; i <= a.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                (new Vector<float>(accumulator[i..]) + new Vector<float>(a[i..]) * new Vector<float>(b[i..])).CopyTo(accumulator[i..]);
+            }
+        }
+
+        for (; i < a.Length; i++)
+        {
+            accumulator[i] += a[i] * b[i];
+        }
+    }
+
+    private static void Power(ReadOnlySpan<float> real, ReadOnlySpan<float> imag, Span<float> power)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            for (; i <= real.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                var r = new Vector<float>(real[i..]);
+                var m = new Vector<float>(imag[i..]);
+                (r * r + m * m).CopyTo(power[i..]);
+            }
+        }
+
+        for (; i < real.Length; i++)
+        {
+            power[i] = real[i] * real[i] + imag[i] * imag[i];
+        }
+    }
+
+    private static void Blend(Span<float> target, ReadOnlySpan<float> source, float amount)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            var take = new Vector<float>(amount);
+            for (; i <= target.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                var current = new Vector<float>(target[i..]);
+                (current + take * (new Vector<float>(source[i..]) - current)).CopyTo(target[i..]);
+            }
+        }
+
+        for (; i < target.Length; i++)
+        {
+            target[i] += amount * (source[i] - target[i]);
+        }
+    }
+
+    private static void Scale(Span<float> values, float factor)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            var scale = new Vector<float>(factor);
+            for (; i <= values.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                (new Vector<float>(values[i..]) * scale).CopyTo(values[i..]);
+            }
+        }
+
+        for (; i < values.Length; i++)
+        {
+            values[i] *= factor;
+        }
+    }
+
+    private static double Dot(ReadOnlySpan<float> a, ReadOnlySpan<float> b)
+    {
+        int i = 0;
+        var sum = 0.0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            var vectorSum = Vector<float>.Zero;
+            for (; i <= a.Length - Vector<float>.Count; i += Vector<float>.Count)
+            {
+                vectorSum += new Vector<float>(a[i..]) * new Vector<float>(b[i..]);
+            }
+            sum = Vector.Sum(vectorSum);
+        }
+
+        for (; i < a.Length; i++)
+        {
+            sum += a[i] * b[i];
+        }
+
+        return sum;
+    }
+
+    private static uint ReverseBits(uint value)
+    {
+        value = ((value >> 1) & 0x55555555u) | ((value & 0x55555555u) << 1);
+        value = ((value >> 2) & 0x33333333u) | ((value & 0x33333333u) << 2);
+        value = ((value >> 4) & 0x0F0F0F0Fu) | ((value & 0x0F0F0F0Fu) << 4);
+        value = ((value >> 8) & 0x00FF00FFu) | ((value & 0x00FF00FFu) << 8);
+        return (value >> 16) | (value << 16);
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple configuration class with no business logic
+public class NoiseSuppressionSettings
+{
+    public bool Enabled { get; set; } = false;
+    public int SampleRate { get; set; } = 16000;
+    public int FftSize { get; set; } = 256; // 16ms blocks at 16kHz; latency is one block
+    public double OverSubtraction { get; set; } = 1.5; // Noise estimate multiplier; higher removes more noise and more speech
+    public double MaxAttenuationDb { get; set; } = 15.0; // Gain floor; limits musical noise and speech damage
+    public double GainSmoothing { get; set; } = 0.5; // Share of the previous block's gain kept per bin
+    public double NoiseGateMarginDb { get; set; } = 3.0; // Blocks within this margin of the noise floor update the noise spectrum
+    public double NoiseAdaptation { get; set; } = 0.1; // Per-block update rate of the noise spectrum
+    public double CpuBudgetPercent { get; set; } = 10.0; // Max processing time per block as % of its duration (0 = unlimited)
+}
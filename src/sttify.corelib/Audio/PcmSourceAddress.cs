@@ -0,0 +1,143 @@
+﻿using NAudio.Wave;
+
+namespace Sttify.Corelib.Audio;
+
+public enum PcmSourceKind
+{
+    StandardInput,
+    File,
+    NamedPipe,
+    UnixSocket
+}
+
+/// <summary>
+/// Where a raw PCM stream comes from and what format it is in, parsed from strings such as
+/// <c>stdin</c>, <c>file:/tmp/a.raw</c>, <c>pipe:sttify</c> or <c>unix:/run/sttify.sock?rate=48000&amp;channels=2</c>.
+/// The format defaults to 16kHz mono 16-bit and is overridden by a WAV header when the stream has one.
+/// </summary>
+public sealed class PcmSourceAddress
+{
+    private PcmSourceAddress(PcmSourceKind kind, string path, WaveFormat format)
+    {
+        Kind = kind;
+        Path = path;
+        Format = format;
+    }
+
+    public PcmSourceKind Kind { get; }
+    public string Path { get; } // Empty for stdin; pipe name on Windows, FIFO path elsewhere
+    public WaveFormat Format { get; }
+
+    /// <summary>
+    /// Pipes and sockets outlive a single writer: when one disconnects the source waits for the next.
+    /// </summary>
+    public bool AcceptsReconnects => Kind is PcmSourceKind.NamedPipe or PcmSourceKind.UnixSocket;
+
+    public static PcmSourceAddress Parse(string address)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(address);
+
+        var query = "";
+        var queryStart = address.IndexOf('?');
+        if (queryStart >= 0)
+        {
+            query = address[(queryStart + 1)..];
+            address = address[..queryStart];
+        }
+
+        PcmSourceKind kind;
+        string path;
+        if (address is "stdin" or "-")
+        {
+            kind = PcmSourceKind.StandardInput;
+            path = "";
+        }
+        else if (TryStripScheme(address, "file:", out path))
+        {
+            kind = PcmSourceKind.File;
+        }
+        else if (TryStripScheme(address, "pipe:", out path))
+        {
+            kind = PcmSourceKind.NamedPipe;
+        }
+        else if (TryStripScheme(address, "unix:", out path))
+        {
+            kind = PcmSourceKind.UnixSocket;
+        }
+        else
+        {
+            throw new ArgumentException($"Unsupported audio source '{address}'; expected stdin, file:, pipe: or unix:", nameof(address));
+        }
+
+        if (kind != PcmSourceKind.StandardInput && string.IsNullOrWhiteSpace(path))
+            throw new ArgumentException($"Audio source '{address}' has no path", nameof(address));
+
+        return new PcmSourceAddress(kind, path, ParseFormat(query));
+    }
+
+    public override string ToString() => Kind == PcmSourceKind.StandardInput ? "stdin" : $"{Kind}:{Path}";
+
+    private static bool TryStripScheme(string address, string scheme, out string path)
+    {
+        if (address.StartsWith(scheme, StringComparison.OrdinalIgnoreCase))
+        {
+            path = address[scheme.Length..];
+            return true;
+        }
+
+        path = "";
+        return false;
+    }
+
+    private static WaveFormat ParseFormat(string query)
+    {
+        int sampleRate = 16000, channels = 1, bits = 16;
+        var isFloat = false;
+
+        foreach (var pair in query.Split('&', StringSplitOptions.RemoveEmptyEntries))
+        {
+            var separator = pair.IndexOf('=');
+            var key = separator < 0 ? pair : pair[..separator];
+            var value = separator < 0 ? "" : pair[(separator + 1)..];
+
+            switch (key.ToLowerInvariant())
+            {
+                case "rate":
+                    sampleRate = ParseInRange(key, value, 8000, 192000);
+                    break;
+                case "channels":
+                    channels = ParseInRange(key, value, 1, 8);
+                    break;
+                case "bits":
+                    bits = ParseInRange(key, value, 8, 32);
+                    break;
+                case "format":
+                    // ffmpeg-style sample format names for the common cases
+                    (bits, isFloat) = value.ToLowerInvariant() switch
+                    {
+                        "s16le" => (16, false),
+                        "s24le" => (24, false),
+                        "s32le" => (32, false),
+                        "f32le" => (32, true),
+                        _ => throw new ArgumentException($"Unsupported sample format '{value}'")
+                    };
+                    break;
+                default:
+                    throw new ArgumentException($"Unknown audio source option '{key}'");
+            }
+        }
+
+        if (!isFloat && bits is not (8 or 16 or 24 or 32))
+            throw new ArgumentException($"Unsupported bit depth {bits}");
+
+        return isFloat ? WaveFormat.CreateIeeeFloatWaveFormat(sampleRate, channels) : new WaveFormat(sampleRate, bits, channels);
+    }
+
+    private static int ParseInRange(string key, string value, int min, int max)
+    {
+        if (!int.TryParse(value, out var result) || result < min || result > max)
+            throw new ArgumentException($"Audio source option '{key}' must be between {min} and {max}, got '{value}'");
+
+        return result;
+    }
+}
@@ -0,0 +1,380 @@
+﻿using System.Buffers.Binary;
+using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using System.IO.Pipes;
+using System.Net.Sockets;
+using NAudio.Wave;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Audio source reading raw PCM from stdin, a file, a named pipe (a FIFO outside Windows) or a
+/// UNIX domain socket, e.g. fed by <c>ffmpeg -f s16le</c> or <c>arecord -t raw</c>. Input is cut into
+/// frames of <see cref="AudioCaptureSettings.FrameIntervalMs"/> and converted to 16kHz mono 16-bit
+/// with a <see cref="StreamingAudioConverter"/> when the stream is in another format, then
+/// rechunked so every frame is exact. Only one frame is buffered, so latency is bounded by the
+/// frame interval.
+/// </summary>
+[ExcludeFromCodeCoverage] // Stream, pipe and socket I/O; format handling is covered through ProbeWaveHeaderAsync
+public class PcmStreamAudioSource : IAudioSource
+{
+    private readonly PcmSourceAddress _address;
+    private readonly Action<ReadOnlyMemory<byte>> _emitFrame;
+    private readonly object _lockObject = new();
+    private readonly bool _paceToRealTime;
+
+    private CancellationTokenSource? _cancellation;
+    private bool _isCapturing;
+    private Task _readTask = Task.CompletedTask;
+    private Socket? _socketListener;
+
+    /// <param name="paceToRealTime">Deliver file input at playback speed, as a live device would.</param>
+    public PcmStreamAudioSource(PcmSourceAddress address, bool paceToRealTime = false)
+    {
+        _address = address ?? throw new ArgumentNullException(nameof(address));
+        _paceToRealTime = paceToRealTime;
+        _emitFrame = frame => OnFrame?.Invoke(this, new AudioFrameEventArgs(frame));
+    }
+
+    public event EventHandler<AudioFrameEventArgs>? OnFrame;
+    public event EventHandler<AudioErrorEventArgs>? OnError;
+
+    public bool IsCapturing
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _isCapturing;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Completes when the input ends (stdin or file EOF) or the source is stopped.
+    /// </summary>
+    public Task Completion => _readTask;
+
+    public Task StartAsync(AudioCaptureSettings settings, CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(settings);
+
+        lock (_lockObject)
+        {
+            if (_isCapturing)
+                throw new InvalidOperationException("Audio capture is already running");
+
+            _isCapturing = true;
+            _cancellation = new CancellationTokenSource();
+            var frameIntervalMs = Math.Clamp(settings.FrameIntervalMs, FrameRechunker.MinFrameMs, FrameRechunker.MaxFrameMs);
+            var token = _cancellation.Token;
+            _readTask = Task.Run(() => ReadLoopAsync(frameIntervalMs, token), CancellationToken.None);
+        }
+
+        Telemetry.LogEvent("PcmSourceStarted", new
+        {
+            Source = _address.ToString(),
+            _address.Format.SampleRate,
+            _address.Format.Channels,
+            _address.Format.BitsPerSample
+        });
+        return Task.CompletedTask;
+    }
+
+    public async Task StopAsync()
+    {
+        CancellationTokenSource? cancellation;
+        lock (_lockObject)
+        {
+            cancellation = _cancellation;
+            _cancellation = null;
+        }
+
+        if (cancellation == null)
+            return;
+
+        await cancellation.CancelAsync();
+        // Unblocks a pending Accept on platforms where it ignores cancellation
+        _socketListener?.Dispose();
+
+        try
+        {
+            await _readTask.WaitAsync(TimeSpan.FromSeconds(2));
+        }
+        catch (TimeoutException)
+        {
+            // A FIFO open() still waiting for a writer cannot be interrupted; it ends when one connects
+            Telemetry.LogWarning("PcmSourceStopTimedOut", "Reader did not stop in time", new { Source = _address.ToString() });
+        }
+
+        cancellation.Dispose();
+    }
+
+    public void Dispose()
+    {
+        Dispose(true);
+        GC.SuppressFinalize(this);
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (disposing)
+        {
+            AsyncHelper.FireAndForget(() => StopAsync(), nameof(PcmStreamAudioSource) + ".Dispose");
+        }
+    }
+
+    private async Task ReadLoopAsync(int frameIntervalMs, CancellationToken cancellationToken)
+    {
+        try
+        {
+            do
+            {
+                await using var stream = await OpenAsync(cancellationToken);
+                await ReadStreamAsync(stream, frameIntervalMs, cancellationToken);
+                Telemetry.LogEvent("PcmSourceWriterDisconnected", new { Source = _address.ToString() });
+            }
+            while (_address.AcceptsReconnects && !cancellationToken.IsCancellationRequested);
+        }
+        catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+        {
+            // Stopped
+        }
+        catch (Exception ex) when ((ex is ObjectDisposedException or SocketException) && cancellationToken.IsCancellationRequested)
+        {
+            // Listener closed by StopAsync
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogError("PcmSourceReadFailed", ex, new { Source = _address.ToString() });
+            OnError?.Invoke(this, new AudioErrorEventArgs(ex, $"Failed to read audio from {_address}"));
+        }
+        finally
+        {
+            lock (_lockObject)
+            {
+                _isCapturing = false;
+            }
+
+            if (_address.Kind == PcmSourceKind.UnixSocket)
+            {
+                _socketListener?.Dispose();
+                _socketListener = null;
+                TryDeleteSocketFile(_address.Path);
+            }
+        }
+    }
+
+    private async Task ReadStreamAsync(Stream stream, int frameIntervalMs, CancellationToken cancellationToken)
+    {
+        // Format negotiation: a WAV header wins over the format given in the address
+        var probe = await ProbeWaveHeaderAsync(stream, cancellationToken);
+        var format = probe.Format ?? _address.Format;
+        var converter = AudioConverter.IsVoskCompatible(format) ? null : CreateConverter(format);
+
+        // Resampled output does not map to whole frames, so it is rechunked to the target frame size
+        var target = AudioConverter.GetVoskTargetFormat();
+        var convertedChunker = converter != null
+            ? new FrameRechunker(FrameRechunker.GetFrameBytes(target.SampleRate, target.Channels, target.BitsPerSample, frameIntervalMs), target.BlockAlign)
+            : null;
+
+        var frameBytes = Math.Max(format.BlockAlign, format.AverageBytesPerSecond * frameIntervalMs / 1000 / format.BlockAlign * format.BlockAlign);
+        var frame = new byte[frameBytes];
+        probe.Leading.CopyTo(frame);
+        var filled = probe.Leading.Length;
+
+        var pacing = Stopwatch.StartNew();
+        long bytesRead = 0;
+
+        while (true)
+        {
+            filled += await stream.ReadAtLeastAsync(frame.AsMemory(filled), frame.Length - filled, throwOnEndOfStream: false, cancellationToken);
+
+            // Emit whole sample frames only; a trailing partial sample at EOF is dropped
+            var length = filled - filled % format.BlockAlign;
+            if (length > 0)
+            {
+                if (converter != null && convertedChunker != null)
+                {
+                    convertedChunker.Write(converter.Convert(frame.AsSpan(0, length)), _emitFrame);
+                }
+                else
+                {
+                    _emitFrame(frame.AsMemory(0, length));
+                }
+                bytesRead += length;
+            }
+
+            if (filled < frame.Length)
+            {
+                // Writer closed the stream
+                convertedChunker?.Flush(_emitFrame);
+                return;
+            }
+
+            filled = 0;
+
+            if (_paceToRealTime)
+            {
+                var ahead = TimeSpan.FromSeconds((double)bytesRead / format.AverageBytesPerSecond) - pacing.Elapsed;
+                if (ahead > TimeSpan.Zero)
+                {
+                    await Task.Delay(ahead, cancellationToken);
+                }
+            }
+        }
+    }
+
+    private StreamingAudioConverter CreateConverter(WaveFormat format)
+    {
+        try
+        {
+            return new StreamingAudioConverter(format);
+        }
+        catch (ArgumentException ex)
+        {
+            // Fails the stream, which is reported, instead of feeding the recognizer audio it cannot use
+            throw new InvalidDataException($"Cannot convert {format} from {_address} to 16kHz mono", ex);
+        }
+    }
+
+    private async Task<Stream> OpenAsync(CancellationToken cancellationToken)
+    {
+        switch (_address.Kind)
+        {
+            case PcmSourceKind.StandardInput:
+                return Console.OpenStandardInput();
+
+            case PcmSourceKind.File:
+                return new FileStream(_address.Path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite, bufferSize: 1, FileOptions.SequentialScan);
+
+            case PcmSourceKind.NamedPipe when OperatingSystem.IsWindows():
+                var pipe = new NamedPipeServerStream(_address.Path, PipeDirection.In, 1, PipeTransmissionMode.Byte, PipeOptions.Asynchronous);
+                try
+                {
+                    await pipe.WaitForConnectionAsync(cancellationToken);
+                    return pipe;
+                }
+                catch
+                {
+                    await pipe.DisposeAsync();
+                    throw;
+                }
+
+            case PcmSourceKind.NamedPipe:
+                // Opening a FIFO blocks until a writer opens the other end
+                return await Task.Run(() => new FileStream(_address.Path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite, bufferSize: 1), cancellationToken)
+                    .WaitAsync(cancellationToken);
+
+            case PcmSourceKind.UnixSocket:
+                var listener = _socketListener ??= ListenOnUnixSocket(_address.Path);
+                var client = await listener.AcceptAsync(cancellationToken);
+                return new NetworkStream(client, ownsSocket: true);
+
+            default:
+                throw new NotSupportedException($"Unsupported audio source kind {_address.Kind}");
+        }
+    }
+
+    private static Socket ListenOnUnixSocket(string path)
+    {
+        // A socket file left by a previous run would make Bind fail
+        TryDeleteSocketFile(path);
+
+        var socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
+        try
+        {
+            socket.Bind(new UnixDomainSocketEndPoint(path));
+            socket.Listen(1);
+            return socket;
+        }
+        catch
+        {
+            socket.Dispose();
+            throw;
+        }
+    }
+
+    private static void TryDeleteSocketFile(string path)
+    {
+        try
+        {
+            if (File.Exists(path))
+            {
+                File.Delete(path);
+            }
+        }
+        catch (IOException)
+        {
+            // Best effort; Bind reports a clearer error if the file is still there
+        }
+    }
+
+    /// <summary>
+    /// Reads the start of <paramref name="stream"/> and, when it is a RIFF/WAVE file, consumes the
+    /// header up to the data chunk and returns its format. Otherwise the bytes read are returned as
+    /// the beginning of the audio.
+    /// </summary>
+    public static async Task<WaveProbeResult> ProbeWaveHeaderAsync(Stream stream, CancellationToken cancellationToken = default)
+    {
+        var head = new byte[12];
+        var read = await stream.ReadAtLeastAsync(head, head.Length, throwOnEndOfStream: false, cancellationToken);
+        if (read < head.Length || !head.AsSpan(0, 4).SequenceEqual("RIFF"u8) || !head.AsSpan(8, 4).SequenceEqual("WAVE"u8))
+            return new WaveProbeResult(null, head.AsMemory(0, read));
+
+        var chunkHeader = new byte[8];
+        WaveFormat? format = null;
+        while (true)
+        {
+            await stream.ReadExactlyAsync(chunkHeader, cancellationToken);
+            var chunkSize = BinaryPrimitives.ReadInt32LittleEndian(chunkHeader.AsSpan(4));
+
+            if (chunkHeader.AsSpan(0, 4).SequenceEqual("data"u8))
+            {
+                return format != null
+                    ? new WaveProbeResult(format, ReadOnlyMemory<byte>.Empty)
+                    : throw new InvalidDataException("WAV data chunk appears before the fmt chunk");
+            }
+
+            if (chunkSize < 0 || chunkSize > 1 << 20)
+                throw new InvalidDataException($"WAV header chunk is implausibly large ({chunkSize} bytes)");
+
+            // Chunks are word aligned
+            var body = new byte[chunkSize + (chunkSize & 1)];
+            await stream.ReadExactlyAsync(body, cancellationToken);
+
+            if (chunkHeader.AsSpan(0, 4).SequenceEqual("fmt "u8))
+            {
+                format = ParseFormatChunk(body);
+            }
+        }
+    }
+
+    private static WaveFormat ParseFormatChunk(ReadOnlySpan<byte> fmt)
+    {
+        if (fmt.Length < 16)
+            throw new InvalidDataException("WAV fmt chunk is truncated");
+
+        var formatTag = BinaryPrimitives.ReadUInt16LittleEndian(fmt);
+        var channels = BinaryPrimitives.ReadUInt16LittleEndian(fmt[2..]);
+        var sampleRate = BinaryPrimitives.ReadInt32LittleEndian(fmt[4..]);
+        var bitsPerSample = BinaryPrimitives.ReadUInt16LittleEndian(fmt[14..]);
+
+        // WAVE_FORMAT_EXTENSIBLE carries the real tag in the first two bytes of the sub-format GUID
+        if (formatTag == 0xFFFE && fmt.Length >= 26)
+        {
+            formatTag = BinaryPrimitives.ReadUInt16LittleEndian(fmt[24..]);
+        }
+
+        return formatTag switch
+        {
+            1 when bitsPerSample is 8 or 16 or 24 or 32 => new WaveFormat(sampleRate, bitsPerSample, channels),
+            3 when bitsPerSample == 32 => WaveFormat.CreateIeeeFloatWaveFormat(sampleRate, channels),
+            _ => throw new InvalidDataException($"Unsupported WAV encoding (tag {formatTag}, {bitsPerSample}-bit)")
+        };
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container
+public readonly record struct WaveProbeResult(WaveFormat? Format, ReadOnlyMemory<byte> Leading);
@@ -0,0 +1,101 @@
+﻿using NAudio.Wave;
+using NAudio.Wave.SampleProviders;
+
+namespace Sttify.Corelib.Audio;
+
+/// <summary>
+/// Converts one continuous PCM stream to 16kHz mono 16-bit, a buffer at a time. The conversion
+/// chain, and with it the resampler's filter history, lives as long as the stream, so buffer
+/// boundaries are seamless and converting a buffer allocates nothing once the output buffer has
+/// grown to size. Not thread-safe; use one instance per stream.
+/// </summary>
+public sealed class StreamingAudioConverter
+{
+    private const int ReadChunkBytes = 4096;
+
+    private readonly BufferedWaveProvider _input;
+    private readonly IWaveProvider _output;
+    private byte[] _inputBuffer = Array.Empty<byte>();
+    private byte[] _outputBuffer = Array.Empty<byte>();
+
+    /// <exception cref="ArgumentException">NAudio cannot read <paramref name="sourceFormat"/>.</exception>
+    public StreamingAudioConverter(WaveFormat sourceFormat)
+    {
+        SourceFormat = sourceFormat ?? throw new ArgumentNullException(nameof(sourceFormat));
+
+        // Each Convert call drains the input completely, so it only has to hold one chunk
+        _input = new BufferedWaveProvider(sourceFormat)
+        {
+            BufferDuration = TimeSpan.FromSeconds(1),
+            ReadFully = false
+        };
+
+        var samples = _input.ToSampleProvider();
+        if (sourceFormat.Channels == 2)
+        {
+            samples = samples.ToMono();
+        }
+        else if (sourceFormat.Channels > 2)
+        {
+            // Multichannel arrays carry the primary microphone on the first channel
+            samples = new MultiplexingSampleProvider(new[] { samples }, 1);
+        }
+
+        if (sourceFormat.SampleRate != AudioConverter.GetVoskTargetFormat().SampleRate)
+        {
+            samples = new WdlResamplingSampleProvider(samples, AudioConverter.GetVoskTargetFormat().SampleRate);
+        }
+
+        _output = new SampleToWaveProvider16(samples);
+    }
+
+    public WaveFormat SourceFormat { get; }
+
+    /// <summary>
+    /// Converts the next buffer of the stream. The result is only valid until the next call, and may
+    /// be a few samples short of the input's duration while the resampler holds back filter history.
+    /// </summary>
+    public ReadOnlySpan<byte> Convert(ReadOnlySpan<byte> audio)
+    {
+        // BufferedWaveProvider only accepts arrays
+        if (_inputBuffer.Length < audio.Length)
+        {
+            _inputBuffer = new byte[audio.Length];
+        }
+        audio.CopyTo(_inputBuffer);
+
+        var blockAlign = SourceFormat.BlockAlign;
+        var written = 0;
+        var offset = 0;
+        while (offset < audio.Length)
+        {
+            var count = Math.Min(audio.Length - offset, _input.BufferLength - _input.BufferedBytes);
+            count -= count % blockAlign;
+            if (count <= 0)
+                throw new InvalidDataException($"Audio buffer of {audio.Length} bytes is not a whole number of {blockAlign}-byte sample frames");
+
+            _input.AddSamples(_inputBuffer, offset, count);
+            offset += count;
+            written = Drain(written);
+        }
+
+        return _outputBuffer.AsSpan(0, written);
+    }
+
+    private int Drain(int written)
+    {
+        while (true)
+        {
+            if (_outputBuffer.Length - written < ReadChunkBytes)
+            {
+                Array.Resize(ref _outputBuffer, Math.Max(_outputBuffer.Length * 2, written + ReadChunkBytes));
+            }
+
+            var read = _output.Read(_outputBuffer, written, ReadChunkBytes);
+            if (read <= 0)
+                return written;
+
+            written += read;
+        }
+    }
+}
@@ -1,5 +1,4 @@
-﻿using System.Buffers;
-using System.Diagnostics.CodeAnalysis;
+﻿using System.Diagnostics.CodeAnalysis;
 using NAudio.CoreAudioApi;
 using NAudio.Wave;
 using Sttify.Corelib.Diagnostics;
@@ -7,10 +6,12 @@ using Sttify.Corelib.Diagnostics;
 namespace Sttify.Corelib.Audio;
 
 [ExcludeFromCodeCoverage] // WASAPI hardware dependent, system integration, difficult to mock effectively
-public class WasapiAudioCapture : IDisposable
+public class WasapiAudioCapture : IAudioSource
 {
-    private readonly ArrayPool<byte> _bufferPool = ArrayPool<byte>.Shared;
+    private readonly Action<ReadOnlyMemory<byte>> _emitFrame;
     private readonly object _lockObject = new();
+    private StreamingAudioConverter? _converter; // Null when the device already delivers 16kHz mono 16-bit
+    private FrameRechunker? _frameChunker;
     private bool _isCapturing;
     private AudioCaptureSettings _settings = new();
 
@@ -29,6 +30,11 @@ public class WasapiAudioCapture : IDisposable
 
     public WaveFormat? CurrentWaveFormat { get; private set; }
 
+    public WasapiAudioCapture()
+    {
+        _emitFrame = frame => OnFrame?.Invoke(this, new AudioFrameEventArgs(frame));
+    }
+
     public void Dispose()
     {
         Dispose(true);
@@ -88,10 +94,21 @@ public class WasapiAudioCapture : IDisposable
 
         try
         {
+            // Frames are raised in the converted (16kHz mono 16-bit) format
+            var target = AudioConverter.GetVoskTargetFormat();
+            _frameChunker = new FrameRechunker(
+                FrameRechunker.GetFrameBytes(target.SampleRate, target.Channels, target.BitsPerSample, _settings.FrameIntervalMs),
+                target.BlockAlign);
+
             await Task.Run(() => InitializeCapture(), cancellationToken);
 
             if (_wasapiCapture != null)
             {
+                // Built once per capture so the resampler's filter state runs across device buffers
+                _converter = CurrentWaveFormat == null || AudioConverter.IsVoskCompatible(CurrentWaveFormat)
+                    ? null
+                    : new StreamingAudioConverter(CurrentWaveFormat);
+
                 _wasapiCapture.DataAvailable += OnDataAvailable;
                 _wasapiCapture.RecordingStopped += OnRecordingStopped;
 
@@ -107,6 +124,7 @@ public class WasapiAudioCapture : IDisposable
                     CurrentWaveFormat?.SampleRate,
                     CurrentWaveFormat?.Channels,
                     CurrentWaveFormat?.BitsPerSample,
+                    _settings.FrameIntervalMs,
                     _settings.DeviceId
                 });
             }
@@ -187,7 +205,10 @@ public class WasapiAudioCapture : IDisposable
 
         CurrentWaveFormat = new WaveFormat(_settings.SampleRate, _settings.BitsPerSample, _settings.Channels);
 
-        _wasapiCapture = new WasapiCapture(captureDevice, true, 100);
+        // Two frames of device buffer keep callbacks close to the frame cadence without risking
+        // overruns; shared mode will not go below its ~10ms period anyway
+        var deviceBufferMs = Math.Clamp(_settings.FrameIntervalMs * 2, 20, 100);
+        _wasapiCapture = new WasapiCapture(captureDevice, true, deviceBufferMs);
 
         System.Diagnostics.Debug.WriteLine($"*** WASAPI Capture Format - Requested: {_settings.SampleRate}Hz, {_settings.Channels}ch, {_settings.BitsPerSample}bit ***");
         System.Diagnostics.Debug.WriteLine($"*** WASAPI Capture Format - Actual: {_wasapiCapture.WaveFormat.SampleRate}Hz, {_wasapiCapture.WaveFormat.Channels}ch, {_wasapiCapture.WaveFormat.BitsPerSample}bit ***");
@@ -212,37 +233,24 @@ public class WasapiAudioCapture : IDisposable
     {
         try
         {
-            if (e.BytesRecorded > 0 && IsCapturing && CurrentWaveFormat != null)
+            var chunker = _frameChunker;
+            if (e.BytesRecorded > 0 && IsCapturing && CurrentWaveFormat != null && chunker != null)
             {
-                // Use buffer pool to avoid allocations
-                var rentedBuffer = _bufferPool.Rent(e.BytesRecorded);
-                try
-                {
-                    Array.Copy(e.Buffer, 0, rentedBuffer, 0, e.BytesRecorded);
-                    var audioSpan = rentedBuffer.AsSpan(0, e.BytesRecorded);
+                var audioSpan = e.Buffer.AsSpan(0, e.BytesRecorded);
 
-                    // Convert to Vosk-compatible format if necessary
-                    byte[] processedData;
-                    if (!AudioConverter.IsVoskCompatible(CurrentWaveFormat))
-                    {
-                        processedData = AudioConverter.ConvertToVoskFormat(audioSpan, CurrentWaveFormat);
-                    }
-                    else
-                    {
-                        // Create a copy for the event since we need to return the rented buffer
-                        processedData = audioSpan.ToArray();
-                    }
+                // Convert to Vosk-compatible format if necessary; compatible audio is rechunked in place.
+                // A buffer that fails to convert is reported below and dropped, never passed on raw.
+                var converter = _converter;
+                ReadOnlySpan<byte> processedData = converter == null
+                    ? audioSpan
+                    : converter.Convert(audioSpan);
 
-                    var level = AudioConverter.CalculateAudioLevel(processedData, AudioConverter.GetVoskTargetFormat());
+                var level = AudioConverter.CalculateAudioLevel(processedData, AudioConverter.GetVoskTargetFormat());
 
-                    Telemetry.LogAudioCapture(e.BytesRecorded, level);
-                    // processedData will be handled by the event handler
-                    OnFrame?.Invoke(this, new AudioFrameEventArgs(processedData));
-                }
-                finally
-                {
-                    _bufferPool.Return(rentedBuffer);
-                }
+                Telemetry.LogAudioCapture(e.BytesRecorded, level);
+
+                // Device buffers vary in size; handlers always see exact FrameIntervalMs frames
+                chunker.Write(processedData, _emitFrame);
             }
         }
         catch (Exception ex)
@@ -0,0 +1,100 @@
+﻿using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Batch;
+
+/// <summary>
+/// Runs the same work at increasing worker counts to show how decoding scales with cores: a batch
+/// of files, or one long recording split at pauses. Transcripts are not written, so only decoding
+/// (and reading or scanning the audio) is timed.
+/// </summary>
+public static class BatchScalingBenchmark
+{
+    public static readonly int[] DefaultWorkerCounts = [1, 2, 4, 8, 16];
+
+    public static async Task<List<BatchScalingResult>> MeasureAsync(Func<IBatchDecoder> decoderFactory,
+        IReadOnlyList<string> inputPaths,
+        IReadOnlyList<int>? workerCounts = null,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(decoderFactory);
+        ArgumentNullException.ThrowIfNull(inputPaths);
+        if (inputPaths.Count == 0)
+            throw new ArgumentException("At least one input is required", nameof(inputPaths));
+
+        return await MeasureAsync(workerCounts, async workers =>
+        {
+            var transcriber = new BatchTranscriber(decoderFactory, new BatchTranscriptionSettings
+            {
+                MaxWorkers = workers,
+                WriteTranscripts = false
+            });
+            var report = await transcriber.TranscribeAsync(inputPaths, cancellationToken).ConfigureAwait(false);
+            return (report.Workers, report.WallTime, report.AudioDuration);
+        }).ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Scaling of <see cref="SegmentedTranscriber"/> on one recording. Past the point where every
+    /// segment has its own core the wall time is bounded by the longest segment, so
+    /// <see cref="SilenceSplitSettings.MaxSegmentSeconds"/> decides how far this can scale.
+    /// </summary>
+    public static async Task<List<BatchScalingResult>> MeasureSegmentedAsync(Func<IBatchDecoder> decoderFactory,
+        byte[] pcm,
+        IReadOnlyList<int>? workerCounts = null,
+        SilenceSplitSettings? splitSettings = null,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(decoderFactory);
+        ArgumentNullException.ThrowIfNull(pcm);
+        if (pcm.Length == 0)
+            throw new ArgumentException("Audio must not be empty", nameof(pcm));
+
+        return await MeasureAsync(workerCounts, async workers =>
+        {
+            var transcriber = new SegmentedTranscriber(decoderFactory, new SegmentedTranscriptionSettings
+            {
+                MaxWorkers = workers,
+                Split = splitSettings ?? new SilenceSplitSettings()
+            });
+            var report = await transcriber.TranscribeAsync(pcm, cancellationToken: cancellationToken).ConfigureAwait(false);
+            return (report.Workers, report.WallTime, report.AudioDuration);
+        }).ConfigureAwait(false);
+    }
+
+    private static async Task<List<BatchScalingResult>> MeasureAsync(IReadOnlyList<int>? workerCounts,
+        Func<int, Task<(int Workers, TimeSpan WallTime, TimeSpan AudioDuration)>> run)
+    {
+        // Warm up the JIT and the file cache so the single-worker baseline is not penalized
+        await run(1).ConfigureAwait(false);
+
+        var results = new List<BatchScalingResult>();
+        TimeSpan? baseline = null;
+        foreach (var workerCount in workerCounts ?? DefaultWorkerCounts)
+        {
+            var (workers, wallTime, audioDuration) = await run(workerCount).ConfigureAwait(false);
+            baseline ??= wallTime;
+            results.Add(new BatchScalingResult
+            {
+                Workers = workers,
+                WallTime = wallTime,
+                AudioDuration = audioDuration,
+                ScalingFactor = wallTime > TimeSpan.Zero ? baseline.Value.TotalSeconds / wallTime.TotalSeconds : 0.0
+            });
+        }
+
+        return results;
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class BatchScalingResult
+{
+    public int Workers { get; set; } // Fewer than requested when there are fewer files or segments
+    public TimeSpan WallTime { get; set; }
+    public TimeSpan AudioDuration { get; set; }
+
+    // Wall-clock speedup over the first (normally single-worker) run
+    public double ScalingFactor { get; set; }
+    public double ScalingEfficiency => Workers > 0 ? ScalingFactor / Workers : 0.0;
+    public double RealTimeFactor => AudioDuration > TimeSpan.Zero ? WallTime.TotalSeconds / AudioDuration.TotalSeconds : 0.0;
+}
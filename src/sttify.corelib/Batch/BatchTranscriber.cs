@@ -0,0 +1,233 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Audio;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Batch;
+
+/// <summary>
+/// Transcribes recordings offline on several workers. Each worker owns one decoder (for Vosk, its
+/// own recognizer over a model shared by all of them) and takes the next file as soon as it is free,
+/// longest files first so a long recording does not start last and hold up the whole batch. A file
+/// that fails is reported and the rest carry on.
+/// </summary>
+public sealed class BatchTranscriber
+{
+    private const int BytesPerSample = 2;
+    private const int SampleRate = 16000;
+    private const int FeedChunkBytes = SampleRate * BytesPerSample / 5; // 200 ms, as a capture device would deliver
+
+    private readonly Func<IBatchDecoder> _decoderFactory;
+    private readonly BatchTranscriptionSettings _settings;
+
+    public BatchTranscriber(Func<IBatchDecoder> decoderFactory, BatchTranscriptionSettings? settings = null)
+    {
+        _decoderFactory = decoderFactory ?? throw new ArgumentNullException(nameof(decoderFactory));
+        _settings = settings ?? new BatchTranscriptionSettings();
+    }
+
+    /// <summary>
+    /// Files are read with <see cref="AudioConverter.ReadFileAsVoskPcm"/>: WAV in any format, or
+    /// raw 16kHz mono 16-bit <c>.pcm</c>/<c>.raw</c>.
+    /// </summary>
+    public async Task<BatchTranscriptionReport> TranscribeAsync(IReadOnlyList<string> inputPaths, CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(inputPaths);
+
+        var workers = Math.Max(1, Math.Min(GetWorkerCount(_settings.MaxWorkers), inputPaths.Count));
+        var order = Enumerable.Range(0, inputPaths.Count)
+            .OrderByDescending(i => GetFileLength(inputPaths[i]))
+            .ToArray();
+        var results = new BatchFileResult[inputPaths.Count];
+        var next = -1;
+
+        var stopwatch = Stopwatch.StartNew();
+        var tasks = new Task[workers];
+        for (int i = 0; i < workers; i++)
+        {
+            // Decoding is synchronous CPU work for the whole batch, so keep it off the pool
+            tasks[i] = Task.Factory.StartNew(() =>
+            {
+                IBatchDecoder? decoder = null;
+                try
+                {
+                    int slot;
+                    while ((slot = Interlocked.Increment(ref next)) < order.Length)
+                    {
+                        cancellationToken.ThrowIfCancellationRequested();
+                        var index = order[slot];
+                        results[index] = TranscribeFile(ref decoder, inputPaths[index]);
+                    }
+                }
+                finally
+                {
+                    decoder?.Dispose();
+                }
+            }, cancellationToken, TaskCreationOptions.LongRunning, TaskScheduler.Default);
+        }
+
+        await Task.WhenAll(tasks).ConfigureAwait(false);
+        stopwatch.Stop();
+
+        var report = new BatchTranscriptionReport
+        {
+            Workers = workers,
+            WallTime = stopwatch.Elapsed,
+            Files = results.ToList()
+        };
+
+        Telemetry.LogEvent("BatchTranscriptionCompleted", new
+        {
+            Files = report.Files.Count,
+            report.FailedFiles,
+            report.Workers,
+            AudioSeconds = report.AudioDuration.TotalSeconds,
+            WallSeconds = report.WallTime.TotalSeconds,
+            report.RealTimeFactor,
+            report.Speedup
+        });
+
+        return report;
+    }
+
+    /// <summary>
+    /// Expands directories to the audio files directly inside them; files are passed through.
+    /// </summary>
+    [ExcludeFromCodeCoverage] // File system I/O
+    public static List<string> ExpandInputs(IEnumerable<string> paths)
+    {
+        var files = new List<string>();
+        foreach (var path in paths)
+        {
+            if (Directory.Exists(path))
+            {
+                files.AddRange(Directory.EnumerateFiles(path)
+                    .Where(f => Path.GetExtension(f).ToLowerInvariant() is ".wav" or ".pcm" or ".raw")
+                    .OrderBy(f => f, StringComparer.Ordinal));
+            }
+            else
+            {
+                files.Add(path);
+            }
+        }
+
+        return files;
+    }
+
+    public string GetOutputPath(string inputPath)
+    {
+        return string.IsNullOrEmpty(_settings.OutputDirectory)
+            ? Path.ChangeExtension(inputPath, ".json")
+            : Path.Combine(_settings.OutputDirectory, Path.GetFileNameWithoutExtension(inputPath) + ".json");
+    }
+
+    private BatchFileResult TranscribeFile(ref IBatchDecoder? decoder, string path)
+    {
+        var result = new BatchFileResult { InputPath = path };
+        try
+        {
+            decoder ??= _decoderFactory();
+            var pcm = AudioConverter.ReadFileAsVoskPcm(path)
+                ?? throw new NotSupportedException($"Unsupported audio file type '{Path.GetExtension(path)}'");
+
+            var transcript = new Transcript
+            {
+                SourcePath = path,
+                AudioDuration = TimeSpan.FromSeconds((double)(pcm.Length / BytesPerSample) / SampleRate)
+            };
+
+            var stopwatch = Stopwatch.StartNew();
+            Decode(decoder, pcm, transcript.Utterances);
+            stopwatch.Stop();
+
+            result.AudioDuration = transcript.AudioDuration;
+            result.DecodeTime = stopwatch.Elapsed;
+            result.Utterances = transcript.Utterances.Count;
+
+            if (_settings.WriteTranscripts)
+            {
+                result.OutputPath = GetOutputPath(path);
+                TranscriptWriter.WriteFile(result.OutputPath, transcript);
+            }
+        }
+        catch (Exception ex)
+        {
+            result.Error = ex.Message;
+            Telemetry.LogError("BatchFileFailed", ex, new { Path = path });
+
+            // The decoder may be left mid-utterance; the next file gets a fresh one
+            decoder?.Dispose();
+            decoder = null;
+        }
+
+        return result;
+    }
+
+    /// <summary>
+    /// Feeds a whole recording to <paramref name="decoder"/> and completes it.
+    /// </summary>
+    internal static void Decode(IBatchDecoder decoder, ReadOnlySpan<byte> pcm, List<TranscriptUtterance> utterances)
+    {
+        for (int offset = 0; offset < pcm.Length; offset += FeedChunkBytes)
+        {
+            decoder.Accept(pcm.Slice(offset, Math.Min(FeedChunkBytes, pcm.Length - offset)), utterances);
+        }
+
+        decoder.Complete(utterances);
+    }
+
+    internal static int GetWorkerCount(int maxWorkers) => maxWorkers > 0 ? maxWorkers : Environment.ProcessorCount;
+
+    private static long GetFileLength(string path)
+    {
+        try
+        {
+            return new FileInfo(path).Length;
+        }
+        catch (Exception)
+        {
+            return 0; // Missing files sort last and fail when read
+        }
+    }
+}
+
+[ExcludeFromCodeCoverage] // Configuration class with no business logic
+public class BatchTranscriptionSettings
+{
+    public int MaxWorkers { get; set; } // 0 uses one worker per core
+    public string OutputDirectory { get; set; } = ""; // Empty writes each transcript next to its recording
+    public bool WriteTranscripts { get; set; } = true;
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class BatchFileResult
+{
+    public string InputPath { get; set; } = "";
+    public string? OutputPath { get; set; }
+    public TimeSpan AudioDuration { get; set; }
+    public TimeSpan DecodeTime { get; set; }
+    public int Utterances { get; set; }
+    public string? Error { get; set; }
+
+    public bool Succeeded => Error == null;
+    public double RealTimeFactor => AudioDuration > TimeSpan.Zero ? DecodeTime.TotalSeconds / AudioDuration.TotalSeconds : 0.0;
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class BatchTranscriptionReport
+{
+    public int Workers { get; set; }
+    public TimeSpan WallTime { get; set; }
+    public List<BatchFileResult> Files { get; set; } = new();
+
+    public int FailedFiles => Files.Count(f => !f.Succeeded);
+    public TimeSpan AudioDuration => TimeSpan.FromTicks(Files.Sum(f => f.AudioDuration.Ticks));
+    public TimeSpan DecodeTime => TimeSpan.FromTicks(Files.Sum(f => f.DecodeTime.Ticks));
+
+    // Wall-clock seconds per second of audio for the whole batch; below 1 is faster than real time
+    public double RealTimeFactor => AudioDuration > TimeSpan.Zero ? WallTime.TotalSeconds / AudioDuration.TotalSeconds : 0.0;
+
+    // How many workers were decoding at once on average
+    public double Speedup => WallTime > TimeSpan.Zero ? DecodeTime.TotalSeconds / WallTime.TotalSeconds : 0.0;
+    public double ParallelEfficiency => Workers > 0 ? Speedup / Workers : 0.0;
+}
@@ -0,0 +1,19 @@
+﻿namespace Sttify.Corelib.Batch;
+
+/// <summary>
+/// Offline recognizer used by batch transcription. Each worker owns one decoder and feeds it one
+/// recording at a time, so implementations need not be thread-safe. Utterance and word times are
+/// relative to the start of the current recording.
+/// </summary>
+public interface IBatchDecoder : IDisposable
+{
+    /// <summary>
+    /// Feeds 16kHz mono 16-bit PCM, appending any utterances it completes.
+    /// </summary>
+    void Accept(ReadOnlySpan<byte> pcm, List<TranscriptUtterance> utterances);
+
+    /// <summary>
+    /// Ends the recording: appends the last utterance and resets so the next one starts at zero.
+    /// </summary>
+    void Complete(List<TranscriptUtterance> utterances);
+}
@@ -0,0 +1,150 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Audio;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Batch;
+
+/// <summary>
+/// Transcribes one long recording on several cores. A recognizer is sequential, so the recording is
+/// first cut at pauses with <see cref="SilenceSplitter"/>; the segments are then decoded
+/// concurrently, longest first, each worker with its own decoder, and the results are stitched
+/// back in order with times shifted to the start of the recording.
+/// </summary>
+public sealed class SegmentedTranscriber
+{
+    private readonly Func<IBatchDecoder> _decoderFactory;
+    private readonly SegmentedTranscriptionSettings _settings;
+
+    public SegmentedTranscriber(Func<IBatchDecoder> decoderFactory, SegmentedTranscriptionSettings? settings = null)
+    {
+        _decoderFactory = decoderFactory ?? throw new ArgumentNullException(nameof(decoderFactory));
+        _settings = settings ?? new SegmentedTranscriptionSettings();
+    }
+
+    [ExcludeFromCodeCoverage] // File system I/O
+    public Task<SegmentedTranscriptionReport> TranscribeFileAsync(string path, CancellationToken cancellationToken = default)
+    {
+        var pcm = AudioConverter.ReadFileAsVoskPcm(path)
+            ?? throw new NotSupportedException($"Unsupported audio file type '{Path.GetExtension(path)}'");
+        return TranscribeAsync(pcm, path, cancellationToken);
+    }
+
+    /// <summary>
+    /// Transcribes 16kHz mono 16-bit PCM. A segment that fails to decode fails the whole recording.
+    /// </summary>
+    public async Task<SegmentedTranscriptionReport> TranscribeAsync(byte[] pcm, string sourcePath = "", CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(pcm);
+
+        var maxWorkers = BatchTranscriber.GetWorkerCount(_settings.MaxWorkers);
+        var stopwatch = Stopwatch.StartNew();
+        var segments = await Task.Run(() => SilenceSplitter.Split(pcm, _settings.Split, maxWorkers), cancellationToken).ConfigureAwait(false);
+        var scanTime = stopwatch.Elapsed;
+
+        var workers = Math.Max(1, Math.Min(maxWorkers, segments.Count));
+        var order = Enumerable.Range(0, segments.Count)
+            .OrderByDescending(i => segments[i].Length)
+            .ToArray();
+        var results = new List<TranscriptUtterance>[segments.Count];
+        var decodeTicks = 0L;
+        var next = -1;
+
+        var tasks = new Task[workers];
+        for (int i = 0; i < workers; i++)
+        {
+            tasks[i] = Task.Factory.StartNew(() =>
+            {
+                using var decoder = _decoderFactory();
+                int slot;
+                while ((slot = Interlocked.Increment(ref next)) < order.Length)
+                {
+                    cancellationToken.ThrowIfCancellationRequested();
+                    var index = order[slot];
+                    var segment = segments[index];
+
+                    var started = Stopwatch.GetTimestamp();
+                    var utterances = new List<TranscriptUtterance>();
+                    BatchTranscriber.Decode(decoder, pcm.AsSpan(segment.Offset, segment.Length), utterances);
+                    Interlocked.Add(ref decodeTicks, Stopwatch.GetElapsedTime(started).Ticks);
+
+                    ShiftTimes(utterances, segment.Start);
+                    results[index] = utterances;
+                }
+            }, cancellationToken, TaskCreationOptions.LongRunning, TaskScheduler.Default);
+        }
+
+        await Task.WhenAll(tasks).ConfigureAwait(false);
+        stopwatch.Stop();
+
+        var transcript = new Transcript
+        {
+            SourcePath = sourcePath,
+            AudioDuration = TimeSpan.FromSeconds(pcm.Length / 32000.0),
+            Utterances = results.SelectMany(r => r).ToList()
+        };
+
+        var report = new SegmentedTranscriptionReport
+        {
+            Transcript = transcript,
+            Workers = workers,
+            Segments = segments.Count,
+            LongestSegment = segments.Count > 0 ? segments.Max(s => s.Duration) : TimeSpan.Zero,
+            ScanTime = scanTime,
+            WallTime = stopwatch.Elapsed,
+            DecodeTime = TimeSpan.FromTicks(decodeTicks)
+        };
+
+        Telemetry.LogEvent("SegmentedTranscriptionCompleted", new
+        {
+            report.Segments,
+            report.Workers,
+            AudioSeconds = transcript.AudioDuration.TotalSeconds,
+            LongestSegmentSeconds = report.LongestSegment.TotalSeconds,
+            ScanSeconds = report.ScanTime.TotalSeconds,
+            WallSeconds = report.WallTime.TotalSeconds,
+            report.RealTimeFactor,
+            report.Speedup
+        });
+
+        return report;
+    }
+
+    private static void ShiftTimes(List<TranscriptUtterance> utterances, TimeSpan offset)
+    {
+        foreach (var utterance in utterances)
+        {
+            utterance.Start += offset;
+            utterance.End += offset;
+            foreach (var word in utterance.Words)
+            {
+                word.Start += offset;
+                word.End += offset;
+            }
+        }
+    }
+}
+
+[ExcludeFromCodeCoverage] // Configuration class with no business logic
+public class SegmentedTranscriptionSettings
+{
+    public int MaxWorkers { get; set; } // 0 uses one worker per core
+    public SilenceSplitSettings Split { get; set; } = new();
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class SegmentedTranscriptionReport
+{
+    public Transcript Transcript { get; set; } = new();
+    public int Workers { get; set; }
+    public int Segments { get; set; }
+    public TimeSpan LongestSegment { get; set; } // No run can finish sooner than this one segment decodes
+    public TimeSpan ScanTime { get; set; }
+    public TimeSpan WallTime { get; set; } // Including the scan
+    public TimeSpan DecodeTime { get; set; } // Summed over workers
+
+    public TimeSpan AudioDuration => Transcript.AudioDuration;
+    public double RealTimeFactor => AudioDuration > TimeSpan.Zero ? WallTime.TotalSeconds / AudioDuration.TotalSeconds : 0.0;
+    public double Speedup => WallTime > TimeSpan.Zero ? DecodeTime.TotalSeconds / WallTime.TotalSeconds : 0.0;
+    public double ParallelEfficiency => Workers > 0 ? Speedup / Workers : 0.0;
+}
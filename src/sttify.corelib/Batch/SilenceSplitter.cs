@@ -0,0 +1,166 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Audio;
+
+namespace Sttify.Corelib.Batch;
+
+/// <summary>
+/// Cuts a long 16kHz mono recording into segments at pauses, so each can be decoded by its own
+/// recognizer. A recognizer keeps no useful context across a long pause, which is what makes the
+/// segments independent. Segments are contiguous and cover the whole recording.
+/// </summary>
+public static class SilenceSplitter
+{
+    private const int BytesPerSample = 2;
+    private const int SampleRate = 16000;
+
+    public static List<AudioSegment> Split(byte[] pcm, SilenceSplitSettings? settings = null, int maxDegreeOfParallelism = -1)
+    {
+        ArgumentNullException.ThrowIfNull(pcm);
+        settings ??= new SilenceSplitSettings();
+
+        var voiced = ClassifyFrames(pcm, settings, maxDegreeOfParallelism);
+        return FindSegments(voiced, pcm.Length, settings);
+    }
+
+    /// <summary>
+    /// Runs <see cref="VoiceActivityDetector"/> over every frame. The recording is scanned in
+    /// blocks of <see cref="SilenceSplitSettings.ScanBlockSeconds"/>, each with its own detector,
+    /// so the pre-scan does not become the serial part of a parallel decode.
+    /// </summary>
+    public static bool[] ClassifyFrames(byte[] pcm, SilenceSplitSettings settings, int maxDegreeOfParallelism = -1)
+    {
+        ArgumentNullException.ThrowIfNull(pcm);
+        ArgumentNullException.ThrowIfNull(settings);
+
+        var frameBytes = GetFrameBytes(settings);
+        var voiced = new bool[pcm.Length / frameBytes];
+        var framesPerBlock = Math.Max(1, settings.ScanBlockSeconds * 1000 / settings.FrameMs);
+        var blocks = (voiced.Length + framesPerBlock - 1) / framesPerBlock;
+
+        Parallel.For(0, blocks, new ParallelOptions { MaxDegreeOfParallelism = maxDegreeOfParallelism }, block =>
+        {
+            using var vad = new VoiceActivityDetector(settings.Vad);
+            var end = Math.Min(voiced.Length, (block + 1) * framesPerBlock);
+            for (int frame = block * framesPerBlock; frame < end; frame++)
+            {
+                voiced[frame] = vad.ProcessAudioFrame(pcm.AsSpan(frame * frameBytes, frameBytes), SampleRate, 1).IsVoice;
+            }
+        });
+
+        return voiced;
+    }
+
+    /// <summary>
+    /// Chooses cut points from per-frame voice decisions: at the middle of the first pause of at
+    /// least <see cref="SilenceSplitSettings.MinPauseMs"/> once a segment is
+    /// <see cref="SilenceSplitSettings.MinSegmentSeconds"/> long. A segment that reaches
+    /// <see cref="SilenceSplitSettings.MaxSegmentSeconds"/> without one is cut at the longest
+    /// shorter pause seen, or where it stands when there was none.
+    /// </summary>
+    public static List<AudioSegment> FindSegments(IReadOnlyList<bool> voiced, int totalBytes, SilenceSplitSettings settings)
+    {
+        ArgumentNullException.ThrowIfNull(voiced);
+        ArgumentNullException.ThrowIfNull(settings);
+
+        var frameBytes = GetFrameBytes(settings);
+        var minPause = Math.Max(1, (settings.MinPauseMs + settings.FrameMs - 1) / settings.FrameMs);
+        var minSegment = settings.MinSegmentSeconds * 1000 / settings.FrameMs;
+        var maxSegment = Math.Max(minSegment + 1, settings.MaxSegmentSeconds * 1000 / settings.FrameMs);
+
+        var segments = new List<AudioSegment>();
+        var segmentStart = 0;
+        var pauseStart = -1;
+        var bestCut = -1;
+        var bestPause = 0;
+
+        void Cut(int frame)
+        {
+            segments.Add(new AudioSegment(segmentStart * frameBytes, (frame - segmentStart) * frameBytes));
+            segmentStart = frame;
+            bestCut = -1;
+            bestPause = 0;
+        }
+
+        for (int i = 0; i <= voiced.Count; i++)
+        {
+            var isVoice = i < voiced.Count && voiced[i];
+            if (!isVoice && i < voiced.Count)
+            {
+                if (pauseStart < 0)
+                {
+                    pauseStart = i;
+                }
+            }
+            else if (pauseStart >= 0)
+            {
+                var pause = i - pauseStart;
+                var middle = pauseStart + pause / 2;
+                if (middle - segmentStart >= minSegment)
+                {
+                    if (pause >= minPause)
+                    {
+                        Cut(middle);
+                    }
+                    else if (pause > bestPause)
+                    {
+                        bestPause = pause;
+                        bestCut = middle;
+                    }
+                }
+                pauseStart = -1;
+            }
+
+            if (i < voiced.Count && i - segmentStart >= maxSegment)
+            {
+                if (!isVoice)
+                {
+                    // Already in a pause: cut here and let the rest of it count for the next segment
+                    Cut(i);
+                    pauseStart = i;
+                }
+                else
+                {
+                    Cut(bestCut >= 0 ? bestCut : i);
+                }
+            }
+        }
+
+        // The last segment also takes any trailing partial frame
+        var lastOffset = segmentStart * frameBytes;
+        if (totalBytes > lastOffset)
+        {
+            segments.Add(new AudioSegment(lastOffset, totalBytes - lastOffset));
+        }
+
+        return segments;
+    }
+
+    private static int GetFrameBytes(SilenceSplitSettings settings)
+    {
+        if (settings.FrameMs <= 0)
+            throw new ArgumentOutOfRangeException(nameof(settings), "Frame length must be positive");
+
+        return SampleRate * BytesPerSample * settings.FrameMs / 1000;
+    }
+}
+
+/// <summary>
+/// A slice of a 16kHz mono 16-bit recording, in bytes.
+/// </summary>
+[ExcludeFromCodeCoverage] // Simple data container
+public readonly record struct AudioSegment(int Offset, int Length)
+{
+    public TimeSpan Start => TimeSpan.FromSeconds(Offset / 32000.0);
+    public TimeSpan Duration => TimeSpan.FromSeconds(Length / 32000.0);
+}
+
+[ExcludeFromCodeCoverage] // Configuration class with no business logic
+public class SilenceSplitSettings
+{
+    public int FrameMs { get; set; } = 30;
+    public int MinPauseMs { get; set; } = 600; // Pauses at least this long end a segment
+    public int MinSegmentSeconds { get; set; } = 10; // Shorter segments cost accuracy at their edges for little gain
+    public int MaxSegmentSeconds { get; set; } = 60; // Bounds the longest task, and so the wall time on many cores
+    public int ScanBlockSeconds { get; set; } = 300;
+    public VadSettings Vad { get; set; } = new();
+}
@@ -0,0 +1,30 @@
+﻿using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Batch;
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class TranscriptWord
+{
+    public string Word { get; set; } = "";
+    public TimeSpan Start { get; set; }
+    public TimeSpan End { get; set; }
+    public double Confidence { get; set; }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class TranscriptUtterance
+{
+    public string Text { get; set; } = "";
+    public TimeSpan Start { get; set; } // From the start of the recording
+    public TimeSpan End { get; set; }
+    public double Confidence { get; set; }
+    public List<TranscriptWord> Words { get; set; } = new();
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class Transcript
+{
+    public string SourcePath { get; set; } = "";
+    public TimeSpan AudioDuration { get; set; }
+    public List<TranscriptUtterance> Utterances { get; set; } = new();
+}
@@ -0,0 +1,68 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using System.Text.Json;
+
+namespace Sttify.Corelib.Batch;
+
+/// <summary>
+/// Writes transcripts as JSON with times in seconds. Written by hand with
+/// <see cref="Utf8JsonWriter"/> so it needs no reflection under trimming.
+/// </summary>
+public static class TranscriptWriter
+{
+    [ExcludeFromCodeCoverage] // File system I/O
+    public static void WriteFile(string path, Transcript transcript)
+    {
+        var directory = Path.GetDirectoryName(path);
+        if (!string.IsNullOrEmpty(directory))
+        {
+            Directory.CreateDirectory(directory);
+        }
+
+        using var stream = File.Create(path);
+        Write(stream, transcript);
+    }
+
+    public static void Write(Stream stream, Transcript transcript)
+    {
+        ArgumentNullException.ThrowIfNull(stream);
+        ArgumentNullException.ThrowIfNull(transcript);
+
+        using var writer = new Utf8JsonWriter(stream, new JsonWriterOptions { Indented = true });
+        writer.WriteStartObject();
+        writer.WriteString("source", transcript.SourcePath);
+        WriteSeconds(writer, "duration", transcript.AudioDuration);
+        writer.WriteString("text", string.Join(" ", transcript.Utterances.Select(u => u.Text)));
+
+        writer.WriteStartArray("utterances");
+        foreach (var utterance in transcript.Utterances)
+        {
+            writer.WriteStartObject();
+            WriteSeconds(writer, "start", utterance.Start);
+            WriteSeconds(writer, "end", utterance.End);
+            writer.WriteString("text", utterance.Text);
+            writer.WriteNumber("confidence", Math.Round(utterance.Confidence, 3));
+
+            writer.WriteStartArray("words");
+            foreach (var word in utterance.Words)
+            {
+                writer.WriteStartObject();
+                writer.WriteString("word", word.Word);
+                WriteSeconds(writer, "start", word.Start);
+                WriteSeconds(writer, "end", word.End);
+                writer.WriteNumber("confidence", Math.Round(word.Confidence, 3));
+                writer.WriteEndObject();
+            }
+
+            writer.WriteEndArray();
+            writer.WriteEndObject();
+        }
+
+        writer.WriteEndArray();
+        writer.WriteEndObject();
+    }
+
+    private static void WriteSeconds(Utf8JsonWriter writer, string name, TimeSpan value)
+    {
+        writer.WriteNumber(name, Math.Round(value.TotalSeconds, 3));
+    }
+}
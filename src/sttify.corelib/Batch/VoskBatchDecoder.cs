@@ -0,0 +1,71 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Engine.Vosk;
+using Sttify.Corelib.Text;
+
+namespace Sttify.Corelib.Batch;
+
+/// <summary>
+/// Batch decoder over one <see cref="VoskNativeRecognizer"/>. Recognizers are cheap next to the
+/// model, so workers share a single <see cref="VoskNativeModel"/> and each builds its own
+/// recognizer once, resetting it between recordings.
+/// </summary>
+[ExcludeFromCodeCoverage] // Native libvosk wrapper, requires a model on disk
+public sealed class VoskBatchDecoder : IBatchDecoder
+{
+    private const int SampleRate = 16000;
+
+    private readonly TextNormalizer _normalizer;
+    private readonly VoskNativeRecognizer _recognizer;
+    private readonly List<TranscriptWord> _words = new();
+    private TimeSpan _recordingStart; // Vosk times keep counting across resets
+    private long _samplesFed;
+
+    public VoskBatchDecoder(VoskNativeModel model, string language = "ja")
+    {
+        _recognizer = new VoskNativeRecognizer(model, SampleRate);
+        _recognizer.SetMaxAlternatives(0);
+        _recognizer.SetWords(true);
+        _normalizer = TextNormalizer.ForLanguage(language);
+    }
+
+    public void Accept(ReadOnlySpan<byte> pcm, List<TranscriptUtterance> utterances)
+    {
+        _samplesFed += pcm.Length / 2;
+        if (_recognizer.AcceptWaveform(pcm))
+        {
+            ReadUtterance(_recognizer.Result(), utterances);
+        }
+    }
+
+    public void Complete(List<TranscriptUtterance> utterances)
+    {
+        ReadUtterance(_recognizer.FinalResult(), utterances);
+        _recognizer.Reset();
+        _recordingStart = TimeSpan.FromSeconds((double)_samplesFed / SampleRate);
+    }
+
+    public void Dispose() => _recognizer.Dispose();
+
+    private void ReadUtterance(ReadOnlySpan<byte> json, List<TranscriptUtterance> utterances)
+    {
+        _words.Clear();
+        if (json.IsEmpty || !VoskResultReader.TryReadFinal(json, out var text, out var confidence, _words))
+            return;
+
+        foreach (var word in _words)
+        {
+            word.Start -= _recordingStart;
+            word.End -= _recordingStart;
+        }
+
+        var previousEnd = utterances.Count > 0 ? utterances[^1].End : TimeSpan.Zero;
+        utterances.Add(new TranscriptUtterance
+        {
+            Text = _normalizer.Normalize(text, appendTerminalPunctuation: true),
+            Start = _words.Count > 0 ? _words[0].Start : previousEnd,
+            End = _words.Count > 0 ? _words[^1].End : previousEnd,
+            Confidence = confidence,
+            Words = new List<TranscriptWord>(_words)
+        });
+    }
+}
@@ -0,0 +1,129 @@
+﻿namespace Sttify.Corelib.Collections;
+
+/// <summary>
+/// Fixed-size history of the most recent PCM bytes. A single producer (the capture thread)
+/// writes without locking; readers copy a snapshot and discard any prefix the producer
+/// overwrote while they were copying, so a reader never observes torn data.
+/// </summary>
+public class AudioHistoryRing
+{
+    private readonly byte[] _buffer;
+    private readonly int _blockAlign;
+    private long _reserved;
+    private long _totalWritten;
+
+    /// <param name="capacityBytes">Number of bytes of history to retain</param>
+    /// <param name="blockAlign">Bytes per sample frame; reads are rounded down to this</param>
+    public AudioHistoryRing(int capacityBytes, int blockAlign = 2)
+    {
+        if (capacityBytes <= 0)
+            throw new ArgumentOutOfRangeException(nameof(capacityBytes), "Capacity must be positive");
+        if (blockAlign <= 0)
+            throw new ArgumentOutOfRangeException(nameof(blockAlign), "Block align must be positive");
+
+        _blockAlign = blockAlign;
+        _buffer = new byte[capacityBytes - capacityBytes % blockAlign];
+        if (_buffer.Length == 0)
+            throw new ArgumentOutOfRangeException(nameof(capacityBytes), "Capacity must hold at least one block");
+    }
+
+    public int Capacity => _buffer.Length;
+
+    /// <summary>
+    /// Total bytes written since creation or the last <see cref="Clear"/>.
+    /// </summary>
+    public long TotalWritten => Volatile.Read(ref _totalWritten);
+
+    /// <summary>
+    /// Number of bytes currently available to read.
+    /// </summary>
+    public int Available => (int)Math.Min(TotalWritten, _buffer.Length);
+
+    /// <summary>
+    /// Appends audio. Must only be called from one thread at a time.
+    /// </summary>
+    public void Write(ReadOnlySpan<byte> data)
+    {
+        if (data.IsEmpty)
+            return;
+
+        var written = _totalWritten;
+
+        // Only the tail can survive if the write is larger than the ring
+        if (data.Length > _buffer.Length)
+        {
+            written += data.Length - _buffer.Length;
+            data = data[^_buffer.Length..];
+        }
+
+        // Announce the region about to be overwritten before touching it (full fence)
+        Interlocked.Exchange(ref _reserved, written + data.Length);
+
+        var offset = (int)(written % _buffer.Length);
+        var firstPart = Math.Min(data.Length, _buffer.Length - offset);
+        data[..firstPart].CopyTo(_buffer.AsSpan(offset));
+        data[firstPart..].CopyTo(_buffer);
+
+        // Publish after the bytes are in place
+        Volatile.Write(ref _totalWritten, written + data.Length);
+    }
+
+    /// <summary>
+    /// Copies up to the last <paramref name="byteCount"/> bytes into <paramref name="destination"/>
+    /// in chronological order and returns the number of bytes copied.
+    /// </summary>
+    public int CopyLatest(Span<byte> destination, int byteCount) =>
+        CopyBefore(destination, byteCount, Volatile.Read(ref _totalWritten));
+
+    /// <summary>
+    /// As <see cref="CopyLatest"/>, but the copy ends at stream position <paramref name="end"/>
+    /// (a past <see cref="TotalWritten"/>) so a consumer running behind the producer can read the
+    /// history as it was when a frame was captured.
+    /// </summary>
+    public int CopyBefore(Span<byte> destination, int byteCount, long end)
+    {
+        var written = Volatile.Read(ref _totalWritten);
+        end = Math.Clamp(end, 0, written);
+        var retained = end - Math.Max(0, written - _buffer.Length);
+        var count = (int)Math.Max(0, Math.Min(Math.Min(byteCount, destination.Length), retained));
+        count -= count % _blockAlign;
+        if (count <= 0)
+            return 0;
+
+        var start = end - count;
+        var offset = (int)(start % _buffer.Length);
+        var firstPart = Math.Min(count, _buffer.Length - offset);
+        _buffer.AsSpan(offset, firstPart).CopyTo(destination);
+        _buffer.AsSpan(0, count - firstPart).CopyTo(destination[firstPart..]);
+
+        // Anything the producer wrapped over (or started to) while we were copying is stale
+        Interlocked.MemoryBarrier();
+        var overwritten = Volatile.Read(ref _reserved) - _buffer.Length - start;
+        if (overwritten <= 0)
+            return count;
+
+        var stale = (int)Math.Min(count, overwritten + (_blockAlign - overwritten % _blockAlign) % _blockAlign);
+        destination.Slice(stale, count - stale).CopyTo(destination);
+        return count - stale;
+    }
+
+    /// <summary>
+    /// Copies the bytes between stream positions <paramref name="start"/> and <paramref name="end"/>,
+    /// keeping the most recent ones when the range does not fit in <paramref name="destination"/>
+    /// or has partly been overwritten.
+    /// </summary>
+    public int CopyRange(Span<byte> destination, long start, long end)
+    {
+        var length = end - start;
+        return length <= 0 ? 0 : CopyBefore(destination, (int)Math.Min(length, destination.Length), end);
+    }
+
+    /// <summary>
+    /// Forgets all history. Must not race with <see cref="Write"/>.
+    /// </summary>
+    public void Clear()
+    {
+        Volatile.Write(ref _reserved, 0);
+        Volatile.Write(ref _totalWritten, 0);
+    }
+}
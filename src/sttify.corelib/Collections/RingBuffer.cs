@@ -0,0 +1,81 @@
+﻿namespace Sttify.Corelib.Collections;
+
+/// <summary>
+/// Fixed-capacity FIFO over a preallocated array. Adding to a full buffer overwrites the oldest
+/// item, so steady-state use never allocates. Not thread-safe.
+/// </summary>
+/// <typeparam name="T">Item type; value types avoid per-item allocations</typeparam>
+public class RingBuffer<T> where T : struct
+{
+    private readonly T[] _items;
+    private int _head; // index of the oldest item
+
+    public RingBuffer(int capacity)
+    {
+        if (capacity <= 0)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity must be positive");
+
+        _items = new T[capacity];
+    }
+
+    public int Capacity => _items.Length;
+    public int Count { get; private set; }
+    public bool IsFull => Count == _items.Length;
+
+    /// <summary>
+    /// Item by age: 0 is the oldest, <c>Count - 1</c> the newest.
+    /// </summary>
+    public ref readonly T this[int index]
+    {
+        get
+        {
+            if ((uint)index >= (uint)Count)
+                throw new ArgumentOutOfRangeException(nameof(index));
+
+            return ref _items[(_head + index) % _items.Length];
+        }
+    }
+
+    public ref readonly T Oldest => ref this[0];
+    public ref readonly T Newest => ref this[Count - 1];
+
+    /// <summary>
+    /// Appends an item, returning true and the evicted item when the buffer was full.
+    /// </summary>
+    public bool Add(in T item, out T evicted)
+    {
+        if (Count < _items.Length)
+        {
+            _items[(_head + Count) % _items.Length] = item;
+            Count++;
+            evicted = default;
+            return false;
+        }
+
+        evicted = _items[_head];
+        _items[_head] = item;
+        _head = (_head + 1) % _items.Length;
+        return true;
+    }
+
+    public void Add(in T item) => Add(item, out _);
+
+    public T RemoveOldest()
+    {
+        if (Count == 0)
+            throw new InvalidOperationException("Ring buffer is empty");
+
+        var item = _items[_head];
+        _items[_head] = default;
+        _head = (_head + 1) % _items.Length;
+        Count--;
+        return item;
+    }
+
+    public void Clear()
+    {
+        Array.Clear(_items);
+        _head = 0;
+        Count = 0;
+    }
+}
@@ -0,0 +1,48 @@
+﻿namespace Sttify.Corelib.Collections;
+
+/// <summary>
+/// Releases items tagged with consecutive sequence numbers in order, holding back any that
+/// complete early until the gap before them is filled. Not thread-safe.
+/// </summary>
+public class SequenceReorderBuffer<T>
+{
+    private readonly Dictionary<long, T> _pending = new();
+
+    public SequenceReorderBuffer(long firstSequence = 0)
+    {
+        NextSequence = firstSequence;
+    }
+
+    /// <summary>
+    /// Sequence number of the next item to be released.
+    /// </summary>
+    public long NextSequence { get; private set; }
+
+    public int PendingCount => _pending.Count;
+
+    public void Add(long sequence, T item)
+    {
+        if (sequence < NextSequence)
+            throw new ArgumentOutOfRangeException(nameof(sequence), $"Sequence {sequence} was already released");
+        if (!_pending.TryAdd(sequence, item))
+            throw new ArgumentException($"Sequence {sequence} was already added", nameof(sequence));
+    }
+
+    public bool TryTakeNext(out T item)
+    {
+        if (_pending.Remove(NextSequence, out item!))
+        {
+            NextSequence++;
+            return true;
+        }
+
+        item = default!;
+        return false;
+    }
+
+    public void Clear(long nextSequence)
+    {
+        _pending.Clear();
+        NextSequence = nextSequence;
+    }
+}
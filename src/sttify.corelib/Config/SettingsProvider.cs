@@ -1,6 +1,6 @@
 ﻿using System.Diagnostics.CodeAnalysis;
 using System.Text.Json;
-using System.Text.Json.Serialization;
+using Sttify.Corelib.Audio;
 using Sttify.Corelib.Diagnostics;
 using Sttify.Corelib.Engine.Vosk;
 using Sttify.Corelib.Output;
@@ -11,8 +11,8 @@ public class SettingsProvider : IDisposable
 {
     private const int DebounceMs = 250;
     private readonly string _configPath;
-    private readonly JsonSerializerOptions _jsonOptions;
     private readonly object _lockObject = new();
+    private readonly bool _watchForChanges;
     private SttifySettings? _cachedSettings;
     private volatile bool _configChanged;
     private Timer? _debounceTimer;
@@ -20,22 +20,34 @@ public class SettingsProvider : IDisposable
     private FileSystemWatcher? _fileWatcher;
 
     public SettingsProvider()
+        : this(GetDefaultConfigPath())
     {
-        var appDataPath = Environment.GetFolderPath(Environment.SpecialFolder.ApplicationData);
-        var sttifyDir = Path.Combine(appDataPath, "sttify");
-        Directory.CreateDirectory(sttifyDir);
+    }
 
-        _configPath = Path.Combine(sttifyDir, "config.json");
+    /// <summary>
+    /// Reads settings from <paramref name="configPath"/>; headless hosts pass their own file and
+    /// usually skip the watcher since nothing edits the config while they run.
+    /// </summary>
+    public SettingsProvider(string configPath, bool watchForChanges = true)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(configPath);
+
+        _configPath = Path.GetFullPath(configPath);
+        Directory.CreateDirectory(Path.GetDirectoryName(_configPath)!);
 
-        _jsonOptions = new JsonSerializerOptions
+        _watchForChanges = watchForChanges;
+        if (_watchForChanges)
         {
-            PropertyNamingPolicy = JsonNamingPolicy.CamelCase,
-            WriteIndented = true,
-            DefaultIgnoreCondition = JsonIgnoreCondition.WhenWritingNull,
-            NumberHandling = JsonNumberHandling.AllowNamedFloatingPointLiterals
-        };
+            SetupFileWatcher();
+        }
+    }
+
+    public string ConfigPath => _configPath;
 
-        SetupFileWatcher();
+    public static string GetDefaultConfigPath()
+    {
+        var appDataPath = Environment.GetFolderPath(Environment.SpecialFolder.ApplicationData);
+        return Path.Combine(appDataPath, "sttify", "config.json");
     }
 
     public void Dispose()
@@ -80,7 +92,7 @@ public class SettingsProvider : IDisposable
 
     public async Task SaveSettingsAsync(SttifySettings settings)
     {
-        var json = JsonSerializer.Serialize(settings, _jsonOptions);
+        var json = JsonSerializer.Serialize(settings, SttifySettingsJsonContext.Default.SttifySettings);
 
         var backupPath = Path.ChangeExtension(_configPath, ".backup.json");
         if (File.Exists(_configPath))
@@ -108,7 +120,10 @@ public class SettingsProvider : IDisposable
         }
         finally
         {
-            SetupFileWatcher();
+            if (_watchForChanges)
+            {
+                SetupFileWatcher();
+            }
         }
     }
 
@@ -161,7 +176,7 @@ public class SettingsProvider : IDisposable
         try
         {
             var json = await File.ReadAllTextAsync(_configPath);
-            var settings = JsonSerializer.Deserialize<SttifySettings>(json, _jsonOptions);
+            var settings = JsonSerializer.Deserialize(json, SttifySettingsJsonContext.Default.SttifySettings);
 
             if (settings == null)
             {
@@ -357,18 +372,18 @@ public class SettingsProvider : IDisposable
         try
         {
             var modelsDirectory = VoskModelManager.GetDefaultModelsDirectory();
-            var installedModels = VoskModelManager.GetInstalledModels(modelsDirectory);
+            var installedModels = VoskModelCatalog.Default.GetModels(modelsDirectory);
 
-            if (installedModels.Length > 0)
+            if (installedModels.Count > 0)
             {
                 // Prefer recommended models first, then any available model
                 var availableModels = VoskModelManager.AvailableModels;
                 var recommendedModel = installedModels.FirstOrDefault(installed =>
                     availableModels.Any(available =>
                         available.IsRecommended &&
-                        installed.EndsWith(available.Name, StringComparison.OrdinalIgnoreCase)));
+                        string.Equals(installed.Name, available.Name, StringComparison.OrdinalIgnoreCase)));
 
-                return recommendedModel ?? installedModels[0];
+                return (recommendedModel ?? installedModels[0]).Path;
             }
         }
         catch (Exception ex)
@@ -397,7 +412,7 @@ public class SettingsProvider : IDisposable
                 return CreateDefaultSettings();
             }
 
-            var settings = JsonSerializer.Deserialize<SttifySettings>(json, _jsonOptions);
+            var settings = JsonSerializer.Deserialize(json, SttifySettingsJsonContext.Default.SttifySettings);
             return settings ?? CreateDefaultSettings();
         }
         catch (Exception ex)
@@ -445,8 +460,11 @@ public class WindowPosition
 public class AudioSettings
 {
     public string DeviceId { get; set; } = "";
+    public string Source { get; set; } = ""; // Empty = capture device; stdin, file:<path>, pipe:<name>, unix:<path>[?rate=&channels=&format=]
     public int SampleRate { get; set; } = 16000;
     public int Channels { get; set; } = 1;
+    public int FrameMs { get; set; } = 0; // Capture frame length; 10, 20 or 30 for low latency, 0 = session default (100)
+    public NoiseSuppressionSettings NoiseSuppression { get; set; } = new(); // Spectral suppression before the engine (off by default)
 }
 
 [ExcludeFromCodeCoverage] // Simple configuration class with no business logic
@@ -456,6 +474,8 @@ public class EngineSettings
     public VoskEngineSettings Vosk { get; set; } = new();
     public CloudEngineSettings Cloud { get; set; } = new();
     public VibeEngineSettings Vibe { get; set; } = new();
+    public HedgedEngineSettings Hedged { get; set; } = new(); // Used by the "cloud-hedged" profile; Cloud is the primary
+    public HybridEngineSettings Hybrid { get; set; } = new(); // Used by the "hybrid" profile; Cloud refines the local finals
 }
 
 [ExcludeFromCodeCoverage] // Simple configuration class with no business logic
@@ -468,6 +488,8 @@ public class VoskEngineSettings
     public int TokensPerPartial { get; set; } = 5;
     public int SampleRate { get; set; } = 16000;
     public string Grammar { get; set; } = "";
+    public int DecodeChunkMs { get; set; } = 0; // Aggregate small capture frames into chunks this long per decode call (0 = decode every frame)
+    public RealTimeFactorGovernorSettings Governor { get; set; } = new(); // Falls back to a smaller model while decoding is slower than real time
 }
 
 [ExcludeFromCodeCoverage] // Simple configuration class with no business logic
@@ -482,14 +504,44 @@ public class CloudEngineSettings
     public int TimeoutSeconds { get; set; } = 30;
     public bool EnableProfanityFilter { get; set; } = false;
     public bool EnableAutomaticPunctuation { get; set; } = true;
+    public int MaxInFlightRequests { get; set; } = 4; // Upper bound for pipelined chunk requests (window adapts to RTT)
+    public string UploadEncoding { get; set; } = "pcm"; // "pcm" or "flac" (lossless); used by providers that accept FLAC
     public Dictionary<string, object> AdditionalSettings { get; set; } = new();
 }
 
+[ExcludeFromCodeCoverage] // Simple configuration class with no business logic
+public class HedgedEngineSettings
+{
+    public CloudEngineSettings Secondary { get; set; } = new() { Provider = "google" };
+    public double HedgePercentile { get; set; } = 0.9; // Primary latency percentile after which the secondary is also asked
+    public int InitialHedgeDelayMs { get; set; } = 1500; // Used until the primary has enough samples
+    public int MinHedgeDelayMs { get; set; } = 200;
+    public int MinSamples { get; set; } = 20;
+}
+
+[ExcludeFromCodeCoverage] // Simple configuration class with no business logic
+public class HybridEngineSettings
+{
+    public string LocalProfile { get; set; } = "vosk"; // Engine profile used for live results
+    public int MaxPendingRefinements { get; set; } = 4; // Oldest queued utterance is dropped beyond this
+    public int MaxUtteranceSeconds { get; set; } = 30; // Longer utterances are not refined
+    public int MinUtteranceMs { get; set; } = 300;
+    public int StopDrainSeconds { get; set; } = 3; // Time given to queued refinements when stopping
+}
+
 [ExcludeFromCodeCoverage] // Simple configuration class with no business logic
 public class SessionSettings
 {
     public string Mode { get; set; } = "ptt";
     public BoundarySettings Boundary { get; set; } = new();
+    public WakeWordSettings WakeWord { get; set; } = new();
+}
+
+[ExcludeFromCodeCoverage] // Simple configuration class with no business logic
+public class WakeWordSettings
+{
+    public bool UseAudioSpotter { get; set; } = true; // Gate the full engine behind a grammar-restricted spotter
+    public string SpotterModelPath { get; set; } = ""; // Small dynamic-graph model (vosk-model-small-*); empty = transcript matching
 }
 
 [ExcludeFromCodeCoverage] // Simple configuration class with no business logic
@@ -0,0 +1,25 @@
+﻿using System.Text.Json;
+using System.Text.Json.Serialization;
+
+namespace Sttify.Corelib.Config;
+
+/// <summary>
+/// Source-generated serializer for the settings file, so loading config needs no reflection and
+/// stays intact under trimming and NativeAOT. Options match what the file has always used.
+/// </summary>
+[JsonSourceGenerationOptions(
+    PropertyNamingPolicy = JsonKnownNamingPolicy.CamelCase,
+    WriteIndented = true,
+    DefaultIgnoreCondition = JsonIgnoreCondition.WhenWritingNull,
+    NumberHandling = JsonNumberHandling.AllowNamedFloatingPointLiterals)]
+[JsonSerializable(typeof(SttifySettings))]
+// CloudEngineSettings.AdditionalSettings values round-trip as JsonElement or these primitives
+[JsonSerializable(typeof(JsonElement))]
+[JsonSerializable(typeof(string))]
+[JsonSerializable(typeof(bool))]
+[JsonSerializable(typeof(int))]
+[JsonSerializable(typeof(long))]
+[JsonSerializable(typeof(double))]
+public partial class SttifySettingsJsonContext : JsonSerializerContext
+{
+}
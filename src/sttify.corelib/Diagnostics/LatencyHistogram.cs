@@ -0,0 +1,97 @@
+﻿namespace Sttify.Corelib.Diagnostics;
+
+/// <summary>
+/// Log-scaled latency histogram (1 ms to about 2 minutes, each bucket 20% wider than the last).
+/// Percentiles are reported as bucket upper bounds. Counts are halved once
+/// <see cref="MaxSamples"/> is reached, so old samples fade and percentiles follow the recent state
+/// of a service.
+/// </summary>
+public sealed class LatencyHistogram
+{
+    private const double GrowthFactor = 1.2;
+    private static readonly double[] BucketUpperBoundsMs = CreateBuckets();
+
+    private readonly long[] _counts = new long[BucketUpperBoundsMs.Length + 1]; // Last bucket = overflow
+    private readonly object _lockObject = new();
+    private long _total;
+
+    public LatencyHistogram(int maxSamples = 1000)
+    {
+        if (maxSamples < 2)
+            throw new ArgumentOutOfRangeException(nameof(maxSamples), "At least two samples must be kept");
+        MaxSamples = maxSamples;
+    }
+
+    public int MaxSamples { get; }
+
+    public long Count
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _total;
+            }
+        }
+    }
+
+    public void Record(TimeSpan latency)
+    {
+        var index = Array.BinarySearch(BucketUpperBoundsMs, Math.Max(0.0, latency.TotalMilliseconds));
+        if (index < 0)
+            index = ~index;
+
+        lock (_lockObject)
+        {
+            _counts[index]++;
+            _total++;
+
+            if (_total >= MaxSamples)
+            {
+                _total = 0;
+                for (int i = 0; i < _counts.Length; i++)
+                {
+                    _counts[i] /= 2;
+                    _total += _counts[i];
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Returns the latency below which <paramref name="percentile"/> (0..1) of the samples fall, or
+    /// null when nothing has been recorded.
+    /// </summary>
+    public TimeSpan? GetPercentile(double percentile)
+    {
+        if (percentile is < 0.0 or > 1.0)
+            throw new ArgumentOutOfRangeException(nameof(percentile), "Percentile must be between 0 and 1");
+
+        lock (_lockObject)
+        {
+            if (_total == 0)
+                return null;
+
+            var rank = Math.Max(1, (long)Math.Ceiling(percentile * _total));
+            long seen = 0;
+            for (int i = 0; i < BucketUpperBoundsMs.Length; i++)
+            {
+                seen += _counts[i];
+                if (seen >= rank)
+                    return TimeSpan.FromMilliseconds(BucketUpperBoundsMs[i]);
+            }
+
+            return TimeSpan.FromMilliseconds(BucketUpperBoundsMs[^1]);
+        }
+    }
+
+    private static double[] CreateBuckets()
+    {
+        var bounds = new List<double>();
+        for (var bound = 1.0; bound <= 120_000; bound *= GrowthFactor)
+        {
+            bounds.Add(bound);
+        }
+        return bounds.ToArray();
+    }
+}
@@ -0,0 +1,75 @@
+﻿namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// Sizes the number of concurrent recognition requests from the measured round-trip time: to keep
+/// up with real time, a new chunk is produced every <c>chunkInterval</c>, so roughly
+/// <c>RTT / chunkInterval</c> requests must be in flight, plus one for jitter. Thread-safe.
+/// </summary>
+public class AdaptiveRequestWindow
+{
+    private readonly TimeSpan _chunkInterval;
+    private readonly object _lockObject = new();
+    private readonly double _smoothing;
+    private double? _smoothedRoundTripMs;
+    private int _size;
+
+    public AdaptiveRequestWindow(TimeSpan chunkInterval, int minSize = 1, int maxSize = 4, double smoothing = 0.2)
+    {
+        if (chunkInterval <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(chunkInterval), "Chunk interval must be positive");
+        if (minSize < 1 || maxSize < minSize)
+            throw new ArgumentOutOfRangeException(nameof(maxSize), "Window bounds must satisfy 1 <= min <= max");
+        if (smoothing is <= 0 or > 1)
+            throw new ArgumentOutOfRangeException(nameof(smoothing), "Smoothing must be in (0, 1]");
+
+        _chunkInterval = chunkInterval;
+        _smoothing = smoothing;
+        MinSize = minSize;
+        MaxSize = maxSize;
+
+        // Allow one request of overlap until the link has been measured
+        _size = Math.Min(minSize + 1, maxSize);
+    }
+
+    public int MinSize { get; }
+    public int MaxSize { get; }
+
+    public int Size
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _size;
+            }
+        }
+    }
+
+    public TimeSpan? SmoothedRoundTrip
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _smoothedRoundTripMs.HasValue ? TimeSpan.FromMilliseconds(_smoothedRoundTripMs.Value) : null;
+            }
+        }
+    }
+
+    public void RecordRoundTrip(TimeSpan roundTrip)
+    {
+        if (roundTrip < TimeSpan.Zero)
+            return;
+
+        lock (_lockObject)
+        {
+            var sampleMs = roundTrip.TotalMilliseconds;
+            _smoothedRoundTripMs = _smoothedRoundTripMs.HasValue
+                ? _smoothedRoundTripMs.Value + _smoothing * (sampleMs - _smoothedRoundTripMs.Value)
+                : sampleMs;
+
+            var needed = (int)Math.Ceiling(_smoothedRoundTripMs.Value / _chunkInterval.TotalMilliseconds) + 1;
+            _size = Math.Clamp(needed, MinSize, MaxSize);
+        }
+    }
+}
@@ -0,0 +1,285 @@
+﻿using System.Buffers.Binary;
+using System.Text;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// Encoder/decoder for the AWS event-stream binary framing (application/vnd.amazon.eventstream):
+/// <c>[total length][headers length][prelude CRC][headers][payload][message CRC]</c>, big-endian,
+/// CRC32 (IEEE). Used by streaming Transcribe in both directions.
+/// </summary>
+public static class AwsEventStream
+{
+    public const int PreludeLength = 12;
+    public const int MinimumMessageLength = PreludeLength + 4;
+    public const int MaximumMessageLength = 16 * 1024 * 1024;
+
+    private const byte HeaderTypeByteArray = 6;
+    private const byte HeaderTypeString = 7;
+    private const byte HeaderTypeTimestamp = 8;
+
+    private static readonly uint[] CrcTable = BuildCrcTable();
+
+    public static byte[] Encode(IReadOnlyList<AwsEventStreamHeader> headers, ReadOnlySpan<byte> payload)
+    {
+        var headersLength = GetEncodedHeadersLength(headers);
+        var totalLength = PreludeLength + headersLength + payload.Length + 4;
+        var buffer = new byte[totalLength];
+        var span = buffer.AsSpan();
+
+        BinaryPrimitives.WriteInt32BigEndian(span, totalLength);
+        BinaryPrimitives.WriteInt32BigEndian(span[4..], headersLength);
+        BinaryPrimitives.WriteUInt32BigEndian(span[8..], Crc32(span[..8]));
+
+        WriteHeaders(headers, span.Slice(PreludeLength, headersLength));
+        payload.CopyTo(span[(PreludeLength + headersLength)..]);
+
+        BinaryPrimitives.WriteUInt32BigEndian(span[^4..], Crc32(span[..^4]));
+        return buffer;
+    }
+
+    /// <summary>
+    /// Encodes headers only, as hashed into an event chunk signature.
+    /// </summary>
+    public static byte[] EncodeHeaders(IReadOnlyList<AwsEventStreamHeader> headers)
+    {
+        var buffer = new byte[GetEncodedHeadersLength(headers)];
+        WriteHeaders(headers, buffer);
+        return buffer;
+    }
+
+    /// <summary>
+    /// Attempts to decode one message from the start of <paramref name="buffer"/>. Returns false when
+    /// more bytes are needed; throws <see cref="InvalidDataException"/> on corrupt framing.
+    /// </summary>
+    public static bool TryDecode(ReadOnlySpan<byte> buffer, out AwsEventStreamMessage? message, out int consumed)
+    {
+        message = null;
+        consumed = 0;
+
+        if (buffer.Length < PreludeLength)
+            return false;
+
+        var totalLength = BinaryPrimitives.ReadInt32BigEndian(buffer);
+        var headersLength = BinaryPrimitives.ReadInt32BigEndian(buffer[4..]);
+        var preludeCrc = BinaryPrimitives.ReadUInt32BigEndian(buffer[8..]);
+
+        if (Crc32(buffer[..8]) != preludeCrc)
+            throw new InvalidDataException("Event stream prelude checksum mismatch");
+        if (totalLength < MinimumMessageLength || totalLength > MaximumMessageLength ||
+            headersLength < 0 || headersLength > totalLength - MinimumMessageLength)
+            throw new InvalidDataException($"Invalid event stream message length: {totalLength}");
+
+        if (buffer.Length < totalLength)
+            return false;
+
+        var frame = buffer[..totalLength];
+        if (Crc32(frame[..^4]) != BinaryPrimitives.ReadUInt32BigEndian(frame[^4..]))
+            throw new InvalidDataException("Event stream message checksum mismatch");
+
+        var headers = ReadHeaders(frame.Slice(PreludeLength, headersLength));
+        var payload = frame[(PreludeLength + headersLength)..^4].ToArray();
+
+        message = new AwsEventStreamMessage(headers, payload);
+        consumed = totalLength;
+        return true;
+    }
+
+    public static uint Crc32(ReadOnlySpan<byte> data)
+    {
+        var crc = 0xFFFFFFFFu;
+        foreach (var b in data)
+        {
+            crc = CrcTable[(crc ^ b) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    private static int GetEncodedHeadersLength(IReadOnlyList<AwsEventStreamHeader> headers)
+    {
+        var length = 0;
+        foreach (var header in headers)
+        {
+            length += 1 + Encoding.UTF8.GetByteCount(header.Name) + 1;
+            length += header.Type switch
+            {
+                AwsEventStreamHeaderType.String => 2 + Encoding.UTF8.GetByteCount(header.StringValue!),
+                AwsEventStreamHeaderType.ByteArray => 2 + header.BytesValue!.Length,
+                AwsEventStreamHeaderType.Timestamp => 8,
+                _ => throw new NotSupportedException($"Unsupported header type: {header.Type}")
+            };
+        }
+        return length;
+    }
+
+    private static void WriteHeaders(IReadOnlyList<AwsEventStreamHeader> headers, Span<byte> destination)
+    {
+        var offset = 0;
+        foreach (var header in headers)
+        {
+            var nameLength = Encoding.UTF8.GetBytes(header.Name, destination[(offset + 1)..]);
+            destination[offset] = (byte)nameLength;
+            offset += 1 + nameLength;
+
+            switch (header.Type)
+            {
+                case AwsEventStreamHeaderType.String:
+                    destination[offset++] = HeaderTypeString;
+                    var valueLength = Encoding.UTF8.GetBytes(header.StringValue!, destination[(offset + 2)..]);
+                    BinaryPrimitives.WriteUInt16BigEndian(destination[offset..], (ushort)valueLength);
+                    offset += 2 + valueLength;
+                    break;
+
+                case AwsEventStreamHeaderType.ByteArray:
+                    destination[offset++] = HeaderTypeByteArray;
+                    BinaryPrimitives.WriteUInt16BigEndian(destination[offset..], (ushort)header.BytesValue!.Length);
+                    header.BytesValue.CopyTo(destination[(offset + 2)..]);
+                    offset += 2 + header.BytesValue.Length;
+                    break;
+
+                case AwsEventStreamHeaderType.Timestamp:
+                    destination[offset++] = HeaderTypeTimestamp;
+                    BinaryPrimitives.WriteInt64BigEndian(destination[offset..], header.TimestampValue.ToUnixTimeMilliseconds());
+                    offset += 8;
+                    break;
+            }
+        }
+    }
+
+    private static List<AwsEventStreamHeader> ReadHeaders(ReadOnlySpan<byte> data)
+    {
+        var headers = new List<AwsEventStreamHeader>();
+        var offset = 0;
+
+        while (offset < data.Length)
+        {
+            int nameLength = data[offset++];
+            var name = Encoding.UTF8.GetString(data.Slice(offset, nameLength));
+            offset += nameLength;
+
+            var type = data[offset++];
+            switch (type)
+            {
+                case HeaderTypeString:
+                    int stringLength = BinaryPrimitives.ReadUInt16BigEndian(data[offset..]);
+                    headers.Add(AwsEventStreamHeader.String(name, Encoding.UTF8.GetString(data.Slice(offset + 2, stringLength))));
+                    offset += 2 + stringLength;
+                    break;
+
+                case HeaderTypeByteArray:
+                    int bytesLength = BinaryPrimitives.ReadUInt16BigEndian(data[offset..]);
+                    headers.Add(AwsEventStreamHeader.Bytes(name, data.Slice(offset + 2, bytesLength).ToArray()));
+                    offset += 2 + bytesLength;
+                    break;
+
+                case HeaderTypeTimestamp:
+                    var millis = BinaryPrimitives.ReadInt64BigEndian(data[offset..]);
+                    headers.Add(AwsEventStreamHeader.Timestamp(name, DateTimeOffset.FromUnixTimeMilliseconds(millis)));
+                    offset += 8;
+                    break;
+
+                // Fixed-size types we never need to interpret: skip them
+                case 0: case 1:
+                    break;
+                case 2:
+                    offset += 1;
+                    break;
+                case 3:
+                    offset += 2;
+                    break;
+                case 4:
+                    offset += 4;
+                    break;
+                case 5:
+                    offset += 8;
+                    break;
+                case 9:
+                    offset += 16;
+                    break;
+
+                default:
+                    throw new InvalidDataException($"Unknown event stream header type: {type}");
+            }
+        }
+
+        return headers;
+    }
+
+    private static uint[] BuildCrcTable()
+    {
+        var table = new uint[256];
+        for (uint i = 0; i < table.Length; i++)
+        {
+            var c = i;
+            for (int k = 0; k < 8; k++)
+            {
+                c = (c & 1) != 0 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return table;
+    }
+}
+
+public enum AwsEventStreamHeaderType
+{
+    ByteArray,
+    String,
+    Timestamp
+}
+
+public sealed class AwsEventStreamHeader
+{
+    private AwsEventStreamHeader(string name, AwsEventStreamHeaderType type)
+    {
+        Name = name;
+        Type = type;
+    }
+
+    public string Name { get; }
+    public AwsEventStreamHeaderType Type { get; }
+    public string? StringValue { get; private init; }
+    public byte[]? BytesValue { get; private init; }
+    public DateTimeOffset TimestampValue { get; private init; }
+
+    public static AwsEventStreamHeader String(string name, string value) =>
+        new(name, AwsEventStreamHeaderType.String) { StringValue = value };
+
+    public static AwsEventStreamHeader Bytes(string name, byte[] value) =>
+        new(name, AwsEventStreamHeaderType.ByteArray) { BytesValue = value };
+
+    public static AwsEventStreamHeader Timestamp(string name, DateTimeOffset value) =>
+        new(name, AwsEventStreamHeaderType.Timestamp) { TimestampValue = value };
+}
+
+public sealed class AwsEventStreamMessage
+{
+    public AwsEventStreamMessage(IReadOnlyList<AwsEventStreamHeader> headers, byte[] payload)
+    {
+        Headers = headers;
+        Payload = payload;
+    }
+
+    public IReadOnlyList<AwsEventStreamHeader> Headers { get; }
+    public byte[] Payload { get; }
+
+    public string? GetString(string name)
+    {
+        foreach (var header in Headers)
+        {
+            if (header.Type == AwsEventStreamHeaderType.String && string.Equals(header.Name, name, StringComparison.Ordinal))
+                return header.StringValue;
+        }
+        return null;
+    }
+
+    public AwsEventStreamHeader? GetHeader(string name)
+    {
+        foreach (var header in Headers)
+        {
+            if (string.Equals(header.Name, name, StringComparison.Ordinal))
+                return header;
+        }
+        return null;
+    }
+}
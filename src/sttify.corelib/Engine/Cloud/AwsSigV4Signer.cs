@@ -0,0 +1,93 @@
+﻿using System.Globalization;
+using System.Security.Cryptography;
+using System.Text;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// AWS Signature Version 4: signs the initial HTTP request and, for event streams, each chunk
+/// chained to the signature of the one before it.
+/// </summary>
+public sealed class AwsSigV4Signer
+{
+    public const string Algorithm = "AWS4-HMAC-SHA256";
+    public const string StreamingEventsPayload = "STREAMING-AWS4-HMAC-SHA256-EVENTS";
+
+    private const string ChunkAlgorithm = "AWS4-HMAC-SHA256-PAYLOAD";
+
+    private readonly string _accessKeyId;
+    private readonly string _secretAccessKey;
+
+    public AwsSigV4Signer(string accessKeyId, string secretAccessKey, string region, string service)
+    {
+        _accessKeyId = accessKeyId;
+        _secretAccessKey = secretAccessKey;
+        Region = region;
+        Service = service;
+    }
+
+    public string Region { get; }
+    public string Service { get; }
+
+    public static string FormatDateTime(DateTimeOffset time) =>
+        time.UtcDateTime.ToString("yyyyMMdd'T'HHmmss'Z'", CultureInfo.InvariantCulture);
+
+    public string GetCredentialScope(DateTimeOffset time) =>
+        $"{time.UtcDateTime.ToString("yyyyMMdd", CultureInfo.InvariantCulture)}/{Region}/{Service}/aws4_request";
+
+    /// <summary>
+    /// Computes the request signature (lowercase hex). Header names are lowercased and sorted
+    /// here; values are trimmed.
+    /// </summary>
+    public string ComputeSignature(string method, string canonicalUri, string canonicalQuery,
+        IEnumerable<KeyValuePair<string, string>> headers, string payloadHash, DateTimeOffset time,
+        out string signedHeaders)
+    {
+        var sortedHeaders = headers
+            .Select(h => (Name: h.Key.ToLowerInvariant(), Value: h.Value.Trim()))
+            .OrderBy(h => h.Name, StringComparer.Ordinal)
+            .ToList();
+
+        signedHeaders = string.Join(';', sortedHeaders.Select(h => h.Name));
+
+        var canonicalRequest = new StringBuilder()
+            .Append(method).Append('\n')
+            .Append(canonicalUri).Append('\n')
+            .Append(canonicalQuery).Append('\n');
+        foreach (var (name, value) in sortedHeaders)
+        {
+            canonicalRequest.Append(name).Append(':').Append(value).Append('\n');
+        }
+        canonicalRequest.Append('\n')
+            .Append(signedHeaders).Append('\n')
+            .Append(payloadHash);
+
+        var stringToSign = $"{Algorithm}\n{FormatDateTime(time)}\n{GetCredentialScope(time)}\n{HashHex(Encoding.UTF8.GetBytes(canonicalRequest.ToString()))}";
+        return Convert.ToHexStringLower(HMACSHA256.HashData(DeriveSigningKey(time), Encoding.UTF8.GetBytes(stringToSign)));
+    }
+
+    public string BuildAuthorizationHeader(string signature, string signedHeaders, DateTimeOffset time) =>
+        $"{Algorithm} Credential={_accessKeyId}/{GetCredentialScope(time)}, SignedHeaders={signedHeaders}, Signature={signature}";
+
+    /// <summary>
+    /// Signs one event-stream chunk. <paramref name="encodedHeaders"/> is the encoded <c>:date</c>
+    /// header of the outer frame; <paramref name="priorSignature"/> is the request signature for the
+    /// first chunk and the previous chunk's signature afterwards.
+    /// </summary>
+    public byte[] SignChunk(ReadOnlySpan<byte> encodedHeaders, ReadOnlySpan<byte> payload, string priorSignature, DateTimeOffset time)
+    {
+        var stringToSign = $"{ChunkAlgorithm}\n{FormatDateTime(time)}\n{GetCredentialScope(time)}\n{priorSignature}\n{HashHex(encodedHeaders)}\n{HashHex(payload)}";
+        return HMACSHA256.HashData(DeriveSigningKey(time), Encoding.UTF8.GetBytes(stringToSign));
+    }
+
+    public static string HashHex(ReadOnlySpan<byte> data) => Convert.ToHexStringLower(SHA256.HashData(data));
+
+    private byte[] DeriveSigningKey(DateTimeOffset time)
+    {
+        var date = time.UtcDateTime.ToString("yyyyMMdd", CultureInfo.InvariantCulture);
+        var key = HMACSHA256.HashData(Encoding.UTF8.GetBytes("AWS4" + _secretAccessKey), Encoding.UTF8.GetBytes(date));
+        key = HMACSHA256.HashData(key, Encoding.UTF8.GetBytes(Region));
+        key = HMACSHA256.HashData(key, Encoding.UTF8.GetBytes(Service));
+        return HMACSHA256.HashData(key, "aws4_request"u8);
+    }
+}
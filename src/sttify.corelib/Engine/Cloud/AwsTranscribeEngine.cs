@@ -2,6 +2,7 @@
 using System.Text;
 using System.Text.Json;
 using System.Text.RegularExpressions;
+using Sttify.Corelib.Audio;
 using Sttify.Corelib.Config;
 
 namespace Sttify.Corelib.Engine.Cloud;
@@ -9,11 +10,6 @@ namespace Sttify.Corelib.Engine.Cloud;
 [ExcludeFromCodeCoverage] // External AWS API integration, network dependent, difficult to mock effectively
 public partial class AwsTranscribeEngine : CloudSttEngine
 {
-    private static readonly JsonSerializerOptions JsonOptions = new()
-    {
-        PropertyNamingPolicy = JsonNamingPolicy.CamelCase
-    };
-
     private readonly string _accessKeyId;
     private readonly string _region;
 
@@ -31,6 +27,8 @@ public partial class AwsTranscribeEngine : CloudSttEngine
         }
     }
 
+    private string MediaFormat => UseFlacUpload ? "flac" : "wav";
+
     protected override void ConfigureHttpClient()
     {
         // AWS Transcribe uses signature-based authentication
@@ -82,7 +80,7 @@ public partial class AwsTranscribeEngine : CloudSttEngine
         // In a real implementation, you would use AWS SDK to upload to S3
         // For now, we'll simulate with a direct API call
 
-        var endpoint = $"https://{bucketName}.s3.{_region}.amazonaws.com/{objectKey}.wav";
+        var endpoint = $"https://{bucketName}.s3.{_region}.amazonaws.com/{objectKey}.{MediaFormat}";
         var timestamp = DateTimeOffset.UtcNow;
         var headers = CreateAwsHeaders(endpoint, timestamp);
 
@@ -91,13 +89,13 @@ public partial class AwsTranscribeEngine : CloudSttEngine
         {
             request.Headers.TryAddWithoutValidation(header.Key, header.Value);
         }
-        request.Content = new ByteArrayContent(audioData);
-        request.Content.Headers.ContentType = new System.Net.Http.Headers.MediaTypeHeaderValue("audio/wav");
+        request.Content = new ByteArrayContent(UseFlacUpload ? FlacEncoder.Encode(audioData) : audioData);
+        request.Content.Headers.ContentType = new System.Net.Http.Headers.MediaTypeHeaderValue($"audio/{MediaFormat}");
 
         var response = await HttpClient.SendAsync(request, cancellationToken);
         response.EnsureSuccessStatusCode();
 
-        return $"s3://{bucketName}/{objectKey}.wav";
+        return $"s3://{bucketName}/{objectKey}.{MediaFormat}";
     }
 
     private async Task<CloudRecognitionResult> StartTranscriptionJobAsync(string jobName, string s3Uri, CancellationToken cancellationToken)
@@ -109,7 +107,7 @@ public partial class AwsTranscribeEngine : CloudSttEngine
         {
             TranscriptionJobName = jobName,
             LanguageCode = Settings.Language,
-            MediaFormat = "wav",
+            MediaFormat = MediaFormat,
             Media = new AwsTranscribeMedia { MediaFileUri = s3Uri },
             Settings = new AwsTranscribeSettings
             {
@@ -118,7 +116,7 @@ public partial class AwsTranscribeEngine : CloudSttEngine
             }
         };
 
-        var json = JsonSerializer.Serialize(requestBody, JsonOptions);
+        var json = JsonSerializer.Serialize(requestBody, CloudEngineCamelCaseJsonContext.Default.AwsTranscribeJobRequest);
 
         var headers = CreateAwsHeaders(endpoint, timestamp);
         headers["X-Amz-Target"] = "Transcribe.StartTranscriptionJob";
@@ -153,11 +151,8 @@ public partial class AwsTranscribeEngine : CloudSttEngine
         while (attempt < maxAttempts && !cancellationToken.IsCancellationRequested)
         {
             var timestamp = DateTimeOffset.UtcNow;
-            var requestBody = new { TranscriptionJobName = jobName };
-            var json = JsonSerializer.Serialize(requestBody, new JsonSerializerOptions
-            {
-                PropertyNamingPolicy = JsonNamingPolicy.CamelCase
-            });
+            var requestBody = new AwsGetTranscriptionJobRequest { TranscriptionJobName = jobName };
+            var json = JsonSerializer.Serialize(requestBody, CloudEngineCamelCaseJsonContext.Default.AwsGetTranscriptionJobRequest);
 
             var headers = CreateAwsHeaders(endpoint, timestamp);
             headers["X-Amz-Target"] = "Transcribe.GetTranscriptionJob";
@@ -173,10 +168,7 @@ public partial class AwsTranscribeEngine : CloudSttEngine
             if (response.IsSuccessStatusCode)
             {
                 var content = await response.Content.ReadAsStringAsync(cancellationToken);
-                var jobResponse = JsonSerializer.Deserialize<AwsTranscribeJobResponse>(content, new JsonSerializerOptions
-                {
-                    PropertyNamingPolicy = JsonNamingPolicy.CamelCase
-                });
+                var jobResponse = JsonSerializer.Deserialize(content, CloudEngineCamelCaseJsonContext.Default.AwsTranscribeJobResponse);
 
                 if (jobResponse?.TranscriptionJob?.TranscriptionJobStatus == "COMPLETED")
                 {
@@ -220,7 +212,7 @@ public partial class AwsTranscribeEngine : CloudSttEngine
         var content = await response.Content.ReadAsStringAsync(cancellationToken);
 
         // Parse AWS transcript JSON format
-        var transcript = JsonSerializer.Deserialize<AwsTranscriptResult>(content);
+        var transcript = JsonSerializer.Deserialize(content, CloudEngineJsonContext.Default.AwsTranscriptResult);
         return transcript?.Results?.Transcripts?.FirstOrDefault()?.Transcript ?? "";
     }
 
@@ -228,7 +220,7 @@ public partial class AwsTranscribeEngine : CloudSttEngine
     {
         try
         {
-            var endpoint = $"https://{bucketName}.s3.{_region}.amazonaws.com/{objectKey}.wav";
+            var endpoint = $"https://{bucketName}.s3.{_region}.amazonaws.com/{objectKey}.{MediaFormat}";
             var timestamp = DateTimeOffset.UtcNow;
             var headers = CreateAwsHeaders(endpoint, timestamp);
 
@@ -280,11 +272,8 @@ public partial class AwsTranscribeEngine : CloudSttEngine
             // Test connection by listing transcription jobs (should return 200 even if empty)
             var endpoint = $"https://transcribe.{_region}.amazonaws.com/";
             var timestamp = DateTimeOffset.UtcNow;
-            var requestBody = new { MaxResults = 1 };
-            var json = JsonSerializer.Serialize(requestBody, new JsonSerializerOptions
-            {
-                PropertyNamingPolicy = JsonNamingPolicy.CamelCase
-            });
+            var requestBody = new AwsListTranscriptionJobsRequest { MaxResults = 1 };
+            var json = JsonSerializer.Serialize(requestBody, CloudEngineCamelCaseJsonContext.Default.AwsListTranscriptionJobsRequest);
 
             var headers = CreateAwsHeaders(endpoint, timestamp);
             headers["X-Amz-Target"] = "Transcribe.ListTranscriptionJobs";
@@ -338,6 +327,18 @@ internal class AwsTranscribeSettings
     public int MaxSpeakerLabels { get; set; }
 }
 
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsGetTranscriptionJobRequest
+{
+    public string TranscriptionJobName { get; set; } = "";
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsListTranscriptionJobsRequest
+{
+    public int MaxResults { get; set; }
+}
+
 [ExcludeFromCodeCoverage] // Simple DTO with no business logic
 internal class AwsTranscribeJobResponse
 {
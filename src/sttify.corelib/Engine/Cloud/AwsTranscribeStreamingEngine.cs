@@ -0,0 +1,591 @@
+﻿using System.Buffers;
+using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using System.Net;
+using System.Net.Http.Headers;
+using System.Runtime.InteropServices;
+using System.Text.Json;
+using System.Text.RegularExpressions;
+using System.Threading.Channels;
+using Sttify.Corelib.Audio;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// AWS Transcribe streaming: audio goes up and transcripts come back over a single HTTP/2 request
+/// framed as an AWS event stream, with every audio chunk signed (SigV4) against the previous one.
+/// Partials and finals arrive as the service produces them instead of after a batch job. A stream
+/// that fails mid-session is reopened with exponential backoff; audio queued meanwhile is sent on
+/// the new stream, and what does not fit in the queue is dropped and reported.
+/// </summary>
+public partial class AwsTranscribeStreamingEngine : ISttEngine
+{
+    private const string ServiceName = "transcribe";
+    private const string EventStreamContentType = "application/vnd.amazon.eventstream";
+    private const int SampleRate = 16000;
+    private const int ChunkBytes = 3200; // 100ms of 16kHz mono 16-bit; AWS recommends 50-200ms chunks
+    private const int MaxQueuedChunks = 100;
+    private static readonly TimeSpan StopDrainTimeout = TimeSpan.FromSeconds(5);
+    private static readonly TimeSpan InitialReconnectDelay = TimeSpan.FromMilliseconds(250);
+    private static readonly TimeSpan MaxReconnectDelay = TimeSpan.FromSeconds(30);
+
+    private readonly HttpClient _httpClient;
+    private readonly object _lockObject = new();
+    private readonly CloudEngineSettings _settings;
+    private readonly AwsSigV4Signer _signer;
+    private readonly Uri _streamUri;
+    private readonly bool _useFlac;
+    private readonly bool _warmUpOnStart;
+
+    private StreamingAudioQueue? _audioQueue;
+    private bool _isRunning;
+    private CancellationTokenSource? _streamCancellation;
+    private Task? _streamTask;
+
+    public AwsTranscribeStreamingEngine(CloudEngineSettings settings, HttpMessageHandler? handler = null)
+    {
+        _settings = settings ?? throw new ArgumentNullException(nameof(settings));
+
+        if (string.IsNullOrEmpty(settings.ApiKey))
+            throw new ArgumentException("Access Key ID is required for AWS Transcribe");
+        if (string.IsNullOrEmpty(settings.SecretKey))
+            throw new ArgumentException("Secret Access Key is required for AWS Transcribe");
+
+        var region = !string.IsNullOrEmpty(settings.Region)
+            ? settings.Region
+            : ExtractRegionFromEndpoint(settings.Endpoint) ?? "us-east-1";
+
+        _streamUri = string.IsNullOrEmpty(settings.Endpoint)
+            ? new Uri($"https://transcribestreaming.{region}.amazonaws.com:8443/stream-transcription")
+            : new Uri(settings.Endpoint);
+
+        _signer = new AwsSigV4Signer(settings.ApiKey, settings.SecretKey, region, ServiceName);
+        _useFlac = CloudSttEngine.IsFlacEncoding(settings.UploadEncoding);
+
+        // The stream stays open for the whole session, so no overall request timeout
+        _warmUpOnStart = handler == null;
+        _httpClient = handler != null
+            ? new HttpClient(handler, disposeHandler: false)
+            : SharedHttpHandler.CreateClient(Timeout.InfiniteTimeSpan);
+        _httpClient.Timeout = Timeout.InfiniteTimeSpan;
+    }
+
+    public TimeSpan DroppedAudio => _audioQueue?.DroppedAudio ?? TimeSpan.Zero;
+
+    public event EventHandler<PartialRecognitionEventArgs>? OnPartial;
+    public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
+    public event EventHandler<SttErrorEventArgs>? OnError;
+
+    public Task StartAsync(CancellationToken cancellationToken = default)
+    {
+        lock (_lockObject)
+        {
+            if (_isRunning)
+                throw new InvalidOperationException("AWS Transcribe streaming engine is already running");
+
+            _isRunning = true;
+            _audioQueue = new StreamingAudioQueue(MaxQueuedChunks, SampleRate * sizeof(short), "AwsStreamingAudioDropped");
+            _streamCancellation = new CancellationTokenSource();
+        }
+
+        var audioQueue = _audioQueue;
+        var token = _streamCancellation.Token;
+        if (_warmUpOnStart)
+        {
+            // Connect while the user starts speaking rather than on the first audio chunk
+            AsyncHelper.FireAndForget(() => SharedHttpHandler.WarmUpAsync(_httpClient, _streamUri.ToString(), token), "AwsStreamingWarmUp");
+        }
+
+        _streamTask = Task.Run(() => RunAsync(audioQueue, token), cancellationToken);
+
+        Telemetry.LogEvent("AwsStreamingStarted", new { Endpoint = _streamUri.ToString(), _signer.Region, _settings.Language, MediaEncoding = _useFlac ? "flac" : "pcm" });
+        return Task.CompletedTask;
+    }
+
+    public async Task StopAsync(CancellationToken cancellationToken = default)
+    {
+        StreamingAudioQueue? audioQueue;
+        CancellationTokenSource? cancellation;
+        Task? streamTask;
+
+        lock (_lockObject)
+        {
+            if (!_isRunning)
+                return;
+
+            _isRunning = false;
+            audioQueue = _audioQueue;
+            cancellation = _streamCancellation;
+            streamTask = _streamTask;
+        }
+
+        // Completing the writer sends the end-of-stream frame; the service then flushes its finals
+        audioQueue?.Complete();
+
+        if (streamTask != null)
+        {
+            try
+            {
+                await streamTask.WaitAsync(StopDrainTimeout, cancellationToken);
+            }
+            catch (TimeoutException)
+            {
+                Telemetry.LogWarning("AwsStreamingDrainTimeout", "Transcript stream did not close in time", new { TimeoutSeconds = StopDrainTimeout.TotalSeconds });
+            }
+            catch (OperationCanceledException)
+            {
+                // Caller gave up waiting
+            }
+        }
+
+        if (cancellation != null)
+        {
+            await cancellation.CancelAsync();
+        }
+
+        if (streamTask != null)
+        {
+            try
+            {
+                await streamTask;
+            }
+            catch (OperationCanceledException)
+            {
+                // Expected when the stream is cancelled
+            }
+        }
+
+        cancellation?.Dispose();
+        _streamCancellation = null;
+        _streamTask = null;
+        audioQueue?.Clear();
+
+        Telemetry.LogEvent("AwsStreamingStopped", new
+        {
+            DroppedAudioMs = audioQueue?.DroppedAudio.TotalMilliseconds ?? 0,
+            DroppedChunks = audioQueue?.DroppedChunks ?? 0
+        });
+    }
+
+    public void PushAudio(ReadOnlySpan<byte> audioData)
+    {
+        if (!_isRunning || audioData.IsEmpty)
+            return;
+
+        _audioQueue?.TryWrite(audioData);
+    }
+
+    public void Dispose()
+    {
+        Dispose(true);
+        GC.SuppressFinalize(this);
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (disposing)
+        {
+            StopAsync().GetAwaiter().GetResult();
+            _httpClient.Dispose();
+        }
+    }
+
+    private async Task RunAsync(StreamingAudioQueue audioQueue, CancellationToken cancellationToken)
+    {
+        var failures = 0;
+        try
+        {
+            // A stream is opened when there is audio to send, so one that failed (or that the service
+            // closed while we were idle) is replaced on the next chunk
+            while (await audioQueue.Reader.WaitToReadAsync(cancellationToken))
+            {
+                var started = Stopwatch.GetTimestamp();
+                try
+                {
+                    await RunStreamAsync(audioQueue.Reader, cancellationToken);
+                    failures = 0;
+                }
+                catch (Exception ex) when (!cancellationToken.IsCancellationRequested)
+                {
+                    Telemetry.LogError("AwsStreamingFailed", ex, new { Failures = failures + 1 });
+                    OnError?.Invoke(this, new SttErrorEventArgs(ex, $"AWS Transcribe streaming failed: {ex.Message}"));
+
+                    if (!IsTransient(ex))
+                        return;
+
+                    // A stream that ran for a while before failing starts the backoff over
+                    if (Stopwatch.GetElapsedTime(started) >= MaxReconnectDelay)
+                    {
+                        failures = 0;
+                    }
+
+                    var delay = GetReconnectDelay(failures++);
+                    Telemetry.LogEvent("AwsStreamingReconnecting", new { Attempt = failures, DelayMs = delay.TotalMilliseconds });
+                    await Task.Delay(delay, cancellationToken);
+                }
+            }
+        }
+        catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+        {
+            // Stopped
+        }
+    }
+
+    private static TimeSpan GetReconnectDelay(int failures)
+    {
+        var delay = InitialReconnectDelay * Math.Pow(2, Math.Min(failures, 10));
+        return delay < MaxReconnectDelay ? delay : MaxReconnectDelay;
+    }
+
+    private static bool IsTransient(Exception ex) => ex switch
+    {
+        AwsStreamingException streamingException => streamingException.IsRetryable,
+        HttpRequestException { StatusCode: { } status } => status == HttpStatusCode.TooManyRequests || (int)status >= 500,
+        _ => true // Connection resets, truncated streams and timeouts
+    };
+
+    private async Task RunStreamAsync(ChannelReader<AudioChunk> audioReader, CancellationToken cancellationToken)
+    {
+        var now = DateTimeOffset.UtcNow;
+        var amzDate = AwsSigV4Signer.FormatDateTime(now);
+        var host = _streamUri.IsDefaultPort ? _streamUri.Host : _streamUri.Authority;
+
+        var signedHeaders = new Dictionary<string, string>
+        {
+            ["host"] = host,
+            ["content-type"] = EventStreamContentType,
+            ["x-amz-date"] = amzDate,
+            ["x-amz-content-sha256"] = AwsSigV4Signer.StreamingEventsPayload,
+            ["x-amz-target"] = "com.amazonaws.transcribe.Transcribe.StartStreamTranscription",
+            ["x-amz-transcribe-language-code"] = _settings.Language,
+            ["x-amz-transcribe-media-encoding"] = _useFlac ? "flac" : "pcm",
+            ["x-amz-transcribe-sample-rate"] = SampleRate.ToString(System.Globalization.CultureInfo.InvariantCulture)
+        };
+
+        var seedSignature = _signer.ComputeSignature("POST", _streamUri.AbsolutePath, "", signedHeaders,
+            AwsSigV4Signer.StreamingEventsPayload, now, out var signedHeaderNames);
+
+        using var request = new HttpRequestMessage(HttpMethod.Post, _streamUri)
+        {
+            Version = HttpVersion.Version20,
+            VersionPolicy = HttpVersionPolicy.RequestVersionExact,
+            Content = new AudioEventStreamContent(audioReader, _signer, seedSignature,
+                _useFlac ? new FlacEncoder(SampleRate, ChunkBytes / sizeof(short)) : null)
+        };
+
+        request.Headers.Host = host;
+        foreach (var (name, value) in signedHeaders)
+        {
+            if (name is "host" or "content-type")
+                continue;
+            request.Headers.TryAddWithoutValidation(name, value);
+        }
+        request.Headers.TryAddWithoutValidation("Authorization", _signer.BuildAuthorizationHeader(seedSignature, signedHeaderNames, now));
+        request.Content.Headers.ContentType = new MediaTypeHeaderValue(EventStreamContentType);
+
+        using var response = await _httpClient.SendAsync(request, HttpCompletionOption.ResponseHeadersRead, cancellationToken);
+        if (!response.IsSuccessStatusCode)
+        {
+            var errorContent = await response.Content.ReadAsStringAsync(cancellationToken);
+            throw new HttpRequestException($"AWS Transcribe streaming error: {response.StatusCode} - {errorContent}", null, response.StatusCode);
+        }
+
+        await using var responseStream = await response.Content.ReadAsStreamAsync(cancellationToken);
+        await ReadEventsAsync(responseStream, cancellationToken);
+    }
+
+    private async Task ReadEventsAsync(Stream stream, CancellationToken cancellationToken)
+    {
+        var buffer = new byte[64 * 1024];
+        var count = 0;
+
+        while (true)
+        {
+            if (count == buffer.Length)
+            {
+                Array.Resize(ref buffer, buffer.Length * 2);
+            }
+
+            var read = await stream.ReadAsync(buffer.AsMemory(count), cancellationToken);
+            if (read == 0)
+                break;
+
+            count += read;
+
+            var offset = 0;
+            while (AwsEventStream.TryDecode(buffer.AsSpan(offset, count - offset), out var message, out var consumed))
+            {
+                offset += consumed;
+                HandleMessage(message!);
+            }
+
+            if (offset > 0)
+            {
+                Buffer.BlockCopy(buffer, offset, buffer, 0, count - offset);
+                count -= offset;
+            }
+        }
+
+        if (count > 0)
+            throw new InvalidDataException($"Transcript stream ended inside a message ({count} bytes left)");
+    }
+
+    private void HandleMessage(AwsEventStreamMessage message)
+    {
+        var messageType = message.GetString(":message-type");
+
+        if (messageType == "event")
+        {
+            if (message.GetString(":event-type") == "TranscriptEvent")
+            {
+                var transcriptEvent = JsonSerializer.Deserialize(message.Payload, CloudEngineJsonContext.Default.AwsStreamingTranscriptEvent);
+                DispatchResults(transcriptEvent?.Transcript?.Results);
+            }
+            return;
+        }
+
+        // "exception" carries a modelled error type and JSON body; "error" only headers
+        var errorType = message.GetString(":exception-type") ?? message.GetString(":error-code") ?? "Unknown";
+        var errorMessage = message.GetString(":error-message");
+        if (errorMessage == null && message.Payload.Length > 0)
+        {
+            try
+            {
+                errorMessage = JsonSerializer.Deserialize(message.Payload, CloudEngineJsonContext.Default.AwsStreamingError)?.Message;
+            }
+            catch (JsonException)
+            {
+                // Not JSON: report the type alone
+            }
+        }
+
+        throw new AwsStreamingException(errorType, errorMessage ?? "no details");
+    }
+
+    private void DispatchResults(AwsStreamingResult[]? results)
+    {
+        if (results == null)
+            return;
+
+        foreach (var result in results)
+        {
+            var alternative = result.Alternatives?.Length > 0 ? result.Alternatives[0] : null;
+            if (string.IsNullOrWhiteSpace(alternative?.Transcript))
+                continue;
+
+            var confidence = GetConfidence(alternative);
+            if (result.IsPartial)
+            {
+                OnPartial?.Invoke(this, new PartialRecognitionEventArgs(alternative.Transcript, confidence));
+            }
+            else
+            {
+                var duration = TimeSpan.FromSeconds(Math.Max(0, result.EndTime - result.StartTime));
+                OnFinal?.Invoke(this, new FinalRecognitionEventArgs(alternative.Transcript, confidence, duration));
+            }
+        }
+    }
+
+    private static double GetConfidence(AwsStreamingAlternative alternative)
+    {
+        // Word confidences are only populated on final results
+        if (alternative.Items == null)
+            return 0.0;
+
+        var sum = 0.0;
+        var count = 0;
+        foreach (var item in alternative.Items)
+        {
+            if (item.Confidence.HasValue)
+            {
+                sum += item.Confidence.Value;
+                count++;
+            }
+        }
+        return count > 0 ? sum / count : 0.0;
+    }
+
+    [GeneratedRegex(@"transcribe(?:streaming)?\.([^.]+)\.amazonaws\.com", RegexOptions.None)]
+    private static partial Regex AwsRegionRegex();
+
+    private static string? ExtractRegionFromEndpoint(string endpoint)
+    {
+        if (string.IsNullOrEmpty(endpoint))
+            return null;
+
+        var match = AwsRegionRegex().Match(endpoint);
+        return match.Success ? match.Groups[1].Value : null;
+    }
+
+    /// <summary>
+    /// Request body that never ends on its own: audio from the channel is re-chunked, wrapped in an
+    /// AudioEvent and a signed envelope, and flushed immediately. An empty signed envelope ends it.
+    /// With FLAC each AudioEvent carries one frame, and the first also carries the stream header.
+    /// </summary>
+    private sealed class AudioEventStreamContent : HttpContent
+    {
+        private static readonly AwsEventStreamHeader[] AudioEventHeaders =
+        [
+            AwsEventStreamHeader.String(":message-type", "event"),
+            AwsEventStreamHeader.String(":event-type", "AudioEvent"),
+            AwsEventStreamHeader.String(":content-type", "application/octet-stream")
+        ];
+
+        private readonly ChannelReader<AudioChunk> _audioReader;
+        private readonly FlacEncoder? _flacEncoder;
+        private readonly ArrayBufferWriter<byte> _flacBuffer = new();
+        private readonly AwsSigV4Signer _signer;
+        private string _priorSignature;
+
+        public AudioEventStreamContent(ChannelReader<AudioChunk> audioReader, AwsSigV4Signer signer, string seedSignature, FlacEncoder? flacEncoder = null)
+        {
+            _audioReader = audioReader;
+            _signer = signer;
+            _priorSignature = seedSignature;
+            _flacEncoder = flacEncoder;
+        }
+
+        protected override Task SerializeToStreamAsync(Stream stream, TransportContext? context) =>
+            SerializeToStreamAsync(stream, context, CancellationToken.None);
+
+        protected override async Task SerializeToStreamAsync(Stream stream, TransportContext? context, CancellationToken cancellationToken)
+        {
+            var pending = new byte[ChunkBytes];
+            var pendingCount = 0;
+
+            while (await _audioReader.WaitToReadAsync(cancellationToken))
+            {
+                while (_audioReader.TryRead(out var audio))
+                {
+                    try
+                    {
+                        var offset = 0;
+                        while (offset < audio.Length)
+                        {
+                            var toCopy = Math.Min(ChunkBytes - pendingCount, audio.Length - offset);
+                            Buffer.BlockCopy(audio.Buffer, offset, pending, pendingCount, toCopy);
+                            pendingCount += toCopy;
+                            offset += toCopy;
+
+                            if (pendingCount == ChunkBytes)
+                            {
+                                await WriteAudioEventAsync(stream, pending.AsMemory(0, pendingCount), cancellationToken);
+                                pendingCount = 0;
+                            }
+                        }
+                    }
+                    finally
+                    {
+                        audio.Return();
+                    }
+                }
+            }
+
+            if (pendingCount > 0)
+            {
+                await WriteAudioEventAsync(stream, pending.AsMemory(0, pendingCount), cancellationToken);
+            }
+
+            await WriteSignedFrameAsync(stream, ReadOnlyMemory<byte>.Empty, cancellationToken);
+        }
+
+        protected override bool TryComputeLength(out long length)
+        {
+            length = 0;
+            return false;
+        }
+
+        private Task WriteAudioEventAsync(Stream stream, ReadOnlyMemory<byte> audio, CancellationToken cancellationToken)
+        {
+            if (_flacEncoder != null)
+            {
+                var samples = MemoryMarshal.Cast<byte, short>(audio.Span);
+                if (samples.IsEmpty)
+                    return Task.CompletedTask;
+
+                _flacBuffer.ResetWrittenCount();
+                if (_flacEncoder.FramesEncoded == 0)
+                {
+                    _flacEncoder.WriteStreamHeader(_flacBuffer);
+                }
+                _flacEncoder.EncodeFrame(samples, _flacBuffer);
+                audio = _flacBuffer.WrittenMemory;
+            }
+
+            var audioEvent = AwsEventStream.Encode(AudioEventHeaders, audio.Span);
+            return WriteSignedFrameAsync(stream, audioEvent, cancellationToken);
+        }
+
+        private async Task WriteSignedFrameAsync(Stream stream, ReadOnlyMemory<byte> payload, CancellationToken cancellationToken)
+        {
+            var now = DateTimeOffset.UtcNow;
+            var dateHeader = AwsEventStreamHeader.Timestamp(":date", now);
+            var signature = _signer.SignChunk(AwsEventStream.EncodeHeaders([dateHeader]), payload.Span, _priorSignature, now);
+            _priorSignature = Convert.ToHexStringLower(signature);
+
+            var frame = AwsEventStream.Encode([dateHeader, AwsEventStreamHeader.Bytes(":chunk-signature", signature)], payload.Span);
+            await stream.WriteAsync(frame, cancellationToken);
+            await stream.FlushAsync(cancellationToken);
+        }
+    }
+}
+
+/// <summary>
+/// Error message received on the transcript stream, e.g. <c>BadRequestException</c> or <c>LimitExceededException</c>.
+/// </summary>
+public class AwsStreamingException : Exception
+{
+    public AwsStreamingException(string errorType, string message) : base($"{errorType}: {message}")
+    {
+        ErrorType = errorType;
+    }
+
+    public string ErrorType { get; }
+
+    // Throttling and service faults clear up on their own; bad requests and credentials do not
+    public bool IsRetryable => ErrorType is "LimitExceededException" or "InternalFailureException" or "ServiceUnavailableException";
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsStreamingTranscriptEvent
+{
+    public AwsStreamingTranscript? Transcript { get; set; }
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsStreamingTranscript
+{
+    public AwsStreamingResult[]? Results { get; set; }
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsStreamingResult
+{
+    public string? ResultId { get; set; }
+    public double StartTime { get; set; }
+    public double EndTime { get; set; }
+    public bool IsPartial { get; set; }
+    public AwsStreamingAlternative[]? Alternatives { get; set; }
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsStreamingAlternative
+{
+    public string Transcript { get; set; } = "";
+    public AwsStreamingItem[]? Items { get; set; }
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsStreamingItem
+{
+    public string? Content { get; set; }
+    public double? Confidence { get; set; }
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class AwsStreamingError
+{
+    public string? Message { get; set; }
+}
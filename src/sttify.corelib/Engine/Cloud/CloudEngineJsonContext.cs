@@ -0,0 +1,31 @@
+﻿using System.Text.Json.Serialization;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// Source-generated serializers for the cloud engines' wire formats, so requests and responses
+/// survive trimming and NativeAOT. This context keeps the default (PascalCase) options the
+/// Azure and AWS result payloads have always been read with.
+/// </summary>
+[JsonSerializable(typeof(AzureSpeechEngine.AzureRecognitionResponse))]
+[JsonSerializable(typeof(AwsTranscriptResult))]
+[JsonSerializable(typeof(AwsStreamingTranscriptEvent))]
+[JsonSerializable(typeof(AwsStreamingError))]
+internal partial class CloudEngineJsonContext : JsonSerializerContext
+{
+}
+
+/// <summary>
+/// Camel-cased counterpart of <see cref="CloudEngineJsonContext"/> for the Google and AWS
+/// Transcribe job APIs.
+/// </summary>
+[JsonSourceGenerationOptions(PropertyNamingPolicy = JsonKnownNamingPolicy.CamelCase)]
+[JsonSerializable(typeof(GoogleSpeechRequest))]
+[JsonSerializable(typeof(GoogleSpeechResponse))]
+[JsonSerializable(typeof(AwsTranscribeJobRequest))]
+[JsonSerializable(typeof(AwsTranscribeJobResponse))]
+[JsonSerializable(typeof(AwsGetTranscriptionJobRequest))]
+[JsonSerializable(typeof(AwsListTranscriptionJobsRequest))]
+internal partial class CloudEngineCamelCaseJsonContext : JsonSerializerContext
+{
+}
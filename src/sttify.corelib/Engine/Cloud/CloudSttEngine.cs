@@ -1,4 +1,6 @@
-﻿using System.Diagnostics.CodeAnalysis;
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using System.Runtime.InteropServices;
 using System.Text.Json;
 using Sttify.Corelib.Caching;
 using Sttify.Corelib.Collections;
@@ -9,6 +11,11 @@ namespace Sttify.Corelib.Engine.Cloud;
 
 public abstract class CloudSttEngine : ISttEngine
 {
+    private const int BytesPerSecond = 32000; // 16kHz mono 16-bit
+    private const int MaxChunkBytes = BytesPerSecond; // Cut a request once a second of audio is buffered
+    private const int MaxBacklogBytes = 10 * BytesPerSecond; // Audio held while every request slot is busy
+    private static readonly TimeSpan MaxChunkSpan = TimeSpan.FromSeconds(3); // Audio held this long goes out even if under MaxChunkBytes
+
     protected readonly BoundedQueue<byte[]> AudioQueue;
     protected readonly HttpClient HttpClient;
     protected readonly object LockObject = new();
@@ -21,37 +28,57 @@ public abstract class CloudSttEngine : ISttEngine
     protected Task? ProcessingTask;
     protected DateTime RecognitionStartTime;
 
+    private readonly AdaptiveRequestWindow _requestWindow;
+    private readonly SequenceReorderBuffer<CloudRecognitionResult> _resultOrder = new();
+    private readonly object _resultOrderLock = new();
+    private readonly Queue<CloudRecognitionResult> _readyResults = new();
+    private bool _deliveringResults;
+    private long _chunksCompleted;
+    private long _chunksSubmitted;
+    private long _droppedAudioBytes;
+    private long _droppedAudioEvents;
+
     protected CloudSttEngine(CloudEngineSettings settings)
     {
         Settings = settings ?? throw new ArgumentNullException(nameof(settings));
-        HttpClient = new HttpClient();
-        HttpClient.Timeout = TimeSpan.FromSeconds(30);
+        HttpClient = SharedHttpHandler.CreateClient(TimeSpan.FromSeconds(30));
 
         // Use bounded queue to prevent memory bloat
         AudioQueue = new BoundedQueue<byte[]>(50); // Smaller queue for cloud processing
 
         // Cache responses to reduce API calls and improve latency
         ResponseCache = new ResponseCache<CloudRecognitionResult>(maxEntries: 500, ttl: TimeSpan.FromMinutes(15));
+
+        // Overlap requests when the round trip exceeds the chunk length so long dictation stays real-time
+        var chunkDuration = TimeSpan.FromSeconds((double)MaxChunkBytes / BytesPerSecond);
+        _requestWindow = new AdaptiveRequestWindow(chunkDuration, 1, Math.Max(1, settings.MaxInFlightRequests));
     }
 
     public event EventHandler<PartialRecognitionEventArgs>? OnPartial;
     public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
     public event EventHandler<SttErrorEventArgs>? OnError;
 
+    public CloudPipelineStatistics PipelineStatistics => new()
+    {
+        ChunksSubmitted = Interlocked.Read(ref _chunksSubmitted),
+        ChunksCompleted = Interlocked.Read(ref _chunksCompleted),
+        WindowSize = _requestWindow.Size,
+        SmoothedRoundTrip = _requestWindow.SmoothedRoundTrip,
+        DroppedAudioBytes = Interlocked.Read(ref _droppedAudioBytes),
+        DroppedAudioEvents = Interlocked.Read(ref _droppedAudioEvents)
+    };
+
     public virtual async Task StartAsync(CancellationToken cancellationToken = default)
     {
         if (IsRunning)
             throw new InvalidOperationException("Engine is already running");
 
-        // Configure HTTP client on first start (not in constructor to avoid calling virtual method)
-        if (!HttpClientConfigured)
-        {
-            ConfigureHttpClient();
-            HttpClientConfigured = true;
-        }
+        EnsureHttpClientConfigured();
 
         try
         {
+            // Validation doubles as the connection warm-up: it reaches the same host, and the pooled
+            // connection it opens survives engine restarts, so only the first start pays the handshakes
             await ValidateConnectionAsync(cancellationToken);
 
             lock (LockObject)
@@ -112,7 +139,17 @@ public abstract class CloudSttEngine : ISttEngine
         ProcessingCancellation = null;
         ProcessingTask = null;
 
-        Telemetry.LogEvent("CloudEngineStopped", new { Provider = GetProviderName() });
+        var statistics = PipelineStatistics;
+        Telemetry.LogEvent("CloudEngineStopped", new
+        {
+            Provider = GetProviderName(),
+            statistics.ChunksSubmitted,
+            statistics.ChunksCompleted,
+            statistics.WindowSize,
+            SmoothedRoundTripMs = statistics.SmoothedRoundTrip?.TotalMilliseconds,
+            statistics.DroppedAudioBytes,
+            statistics.DroppedAudioEvents
+        });
     }
 
     public void PushAudio(ReadOnlySpan<byte> audioData)
@@ -123,8 +160,9 @@ public abstract class CloudSttEngine : ISttEngine
         var buffer = audioData.ToArray();
         if (!AudioQueue.TryEnqueue(buffer))
         {
-            // Queue full - drop oldest data
-            Telemetry.LogWarning("CloudAudioQueueFull", "Audio queue full, dropping oldest data", new { QueueSize = AudioQueue.Count });
+            // Queue full - the oldest frame was dropped; frames are uniform so count this one's size
+            RecordDroppedAudio(buffer.Length);
+            Telemetry.LogWarning("CloudAudioQueueFull", "Audio queue full, dropping oldest data", new { QueueSize = AudioQueue.Count, DroppedAudioBytes = Interlocked.Read(ref _droppedAudioBytes) });
         }
     }
 
@@ -145,65 +183,87 @@ public abstract class CloudSttEngine : ISttEngine
         }
     }
 
+    /// <summary>
+    /// Validates credentials, which also warms the connection pool, without starting the audio
+    /// loop, for composite engines that drive this provider segment by segment.
+    /// </summary>
+    internal async Task PrepareAsync(CancellationToken cancellationToken)
+    {
+        EnsureHttpClientConfigured();
+        await ValidateConnectionAsync(cancellationToken);
+    }
+
+    /// <summary>
+    /// Recognizes one segment directly, bypassing the audio loop and response cache.
+    /// </summary>
+    internal Task<CloudRecognitionResult> RecognizeSegmentAsync(byte[] audioData, CancellationToken cancellationToken)
+    {
+        EnsureHttpClientConfigured();
+        return ProcessAudioChunkAsync(audioData, cancellationToken);
+    }
+
+    internal string ProviderName => GetProviderName();
+
+    private void EnsureHttpClientConfigured()
+    {
+        // Configure HTTP client on first use (not in constructor to avoid calling virtual method)
+        lock (LockObject)
+        {
+            if (!HttpClientConfigured)
+            {
+                ConfigureHttpClient();
+                HttpClientConfigured = true;
+            }
+        }
+    }
+
     protected abstract void ConfigureHttpClient();
     protected abstract Task<CloudRecognitionResult> ProcessAudioChunkAsync(byte[] audioData, CancellationToken cancellationToken);
 
     protected virtual async Task ProcessAudioLoop(CancellationToken cancellationToken)
     {
         var audioBuffer = new List<byte>();
-        var lastProcessTime = DateTime.UtcNow;
+        var inFlight = new List<Task>();
+        var lastSubmitTime = DateTime.UtcNow;
+        long nextSequence = 0;
+
+        lock (_resultOrderLock)
+        {
+            _resultOrder.Clear(0);
+            _readyResults.Clear();
+        }
 
         try
         {
             while (!cancellationToken.IsCancellationRequested && IsRunning)
             {
-                if (!AudioQueue.TryDequeue(out var audioChunk))
+                // Drain everything captured since the last pass
+                while (AudioQueue.TryDequeue(out var audioChunk))
                 {
-                    audioChunk = null;
+                    audioBuffer.AddRange(audioChunk);
                 }
 
-                if (audioChunk != null)
+                if (audioBuffer.Count > MaxBacklogBytes)
                 {
-                    audioBuffer.AddRange(audioChunk);
+                    // Every request slot is busy and the link cannot keep up; keep the newest audio
+                    var excess = audioBuffer.Count - MaxBacklogBytes;
+                    audioBuffer.RemoveRange(0, excess);
+                    RecordDroppedAudio(excess);
+                    Telemetry.LogWarning("CloudAudioBacklogFull", "Request window saturated, dropping oldest audio", new { DroppedBytes = excess, WindowSize = _requestWindow.Size });
                 }
 
-                // Process accumulated audio every few seconds or when buffer is large enough
-                var timeSinceLastProcess = DateTime.UtcNow - lastProcessTime;
-                if (audioBuffer.Count > 0 && (timeSinceLastProcess.TotalSeconds >= 3.0 || audioBuffer.Count > 32000))
+                inFlight.RemoveAll(task => task.IsCompleted);
+
+                // Submit without waiting for earlier chunks; results are re-ordered on delivery
+                while (audioBuffer.Count > 0 && inFlight.Count < _requestWindow.Size &&
+                       (audioBuffer.Count >= MaxChunkBytes || DateTime.UtcNow - lastSubmitTime >= MaxChunkSpan))
                 {
-                    try
-                    {
-                        var audioArray = audioBuffer.ToArray();
-                        var cacheKey = ResponseCache<CloudRecognitionResult>.GenerateKey(audioArray, GetProviderName());
-
-                        CloudRecognitionResult result;
-                        if (ResponseCache.TryGet(cacheKey, out var cachedResult))
-                        {
-                            result = cachedResult;
-                            Telemetry.LogEvent("CloudCacheHit", new { Provider = GetProviderName(), AudioSize = audioArray.Length });
-                        }
-                        else
-                        {
-                            result = await ProcessAudioChunkAsync(audioArray, cancellationToken);
-                            if (result.Success)
-                            {
-                                ResponseCache.Set(cacheKey, result);
-                            }
-                        }
-
-                        ProcessCloudResult(result);
-
-                        audioBuffer.Clear();
-                        lastProcessTime = DateTime.UtcNow;
-                    }
-                    catch (Exception ex)
-                    {
-                        Telemetry.LogError("CloudAudioProcessingError", ex);
-                        OnError?.Invoke(this, new SttErrorEventArgs(ex, "Error processing audio with cloud service"));
-
-                        // Clear buffer on error to prevent infinite retry
-                        audioBuffer.Clear();
-                    }
+                    var length = Math.Min(audioBuffer.Count, MaxChunkBytes);
+                    var chunk = CollectionsMarshal.AsSpan(audioBuffer)[..length].ToArray();
+                    audioBuffer.RemoveRange(0, length);
+
+                    inFlight.Add(SubmitChunkAsync(nextSequence++, chunk, cancellationToken));
+                    lastSubmitTime = DateTime.UtcNow;
                 }
 
                 await Task.Delay(100, cancellationToken);
@@ -218,6 +278,99 @@ public abstract class CloudSttEngine : ISttEngine
             Telemetry.LogError("CloudProcessingLoopError", ex);
             OnError?.Invoke(this, new SttErrorEventArgs(ex, $"Error in cloud processing loop: {ex.Message}"));
         }
+
+        // Requests observe the same cancellation; wait so none deliver after the engine has stopped
+        await Task.WhenAll(inFlight);
+    }
+
+    private async Task SubmitChunkAsync(long sequence, byte[] audioData, CancellationToken cancellationToken)
+    {
+        Interlocked.Increment(ref _chunksSubmitted);
+
+        CloudRecognitionResult result;
+        try
+        {
+            var cacheKey = ResponseCache<CloudRecognitionResult>.GenerateKey(audioData, GetProviderName());
+            if (ResponseCache.TryGet(cacheKey, out var cachedResult))
+            {
+                result = cachedResult;
+                Telemetry.LogEvent("CloudCacheHit", new { Provider = GetProviderName(), AudioSize = audioData.Length });
+            }
+            else
+            {
+                var stopwatch = Stopwatch.StartNew();
+                result = await ProcessAudioChunkAsync(audioData, cancellationToken);
+                _requestWindow.RecordRoundTrip(stopwatch.Elapsed);
+
+                if (result.Success)
+                {
+                    ResponseCache.Set(cacheKey, result);
+                }
+            }
+        }
+        catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+        {
+            // Stopping: nothing after this point will be delivered
+            return;
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogError("CloudAudioProcessingError", ex, new { Sequence = sequence });
+            OnError?.Invoke(this, new SttErrorEventArgs(ex, "Error processing audio with cloud service"));
+
+            // A failed chunk still fills its slot so later results are not held back
+            result = new CloudRecognitionResult { Success = false, ErrorMessage = ex.Message };
+        }
+
+        Interlocked.Increment(ref _chunksCompleted);
+        DeliverInOrder(sequence, result);
+    }
+
+    private void DeliverInOrder(long sequence, CloudRecognitionResult result)
+    {
+        lock (_resultOrderLock)
+        {
+            _resultOrder.Add(sequence, result);
+            while (_resultOrder.TryTakeNext(out var next))
+            {
+                _readyResults.Enqueue(next);
+            }
+
+            // Only one request raises callbacks at a time; it also picks up what others made ready
+            if (_deliveringResults)
+                return;
+            _deliveringResults = true;
+        }
+
+        // Callbacks run outside the lock, and a throwing subscriber must not fault the request
+        // (and with it the processing loop's final wait)
+        while (true)
+        {
+            CloudRecognitionResult next;
+            lock (_resultOrderLock)
+            {
+                if (!_readyResults.TryDequeue(out next!))
+                {
+                    _deliveringResults = false;
+                    return;
+                }
+            }
+
+            try
+            {
+                ProcessCloudResult(next);
+            }
+            catch (Exception ex)
+            {
+                Telemetry.LogError("CloudResultCallbackFailed", ex, new { Provider = GetProviderName() });
+            }
+        }
+    }
+
+    private void RecordDroppedAudio(int byteCount)
+    {
+        Interlocked.Add(ref _droppedAudioBytes, byteCount);
+        Interlocked.Increment(ref _droppedAudioEvents);
     }
 
     protected virtual void ProcessCloudResult(CloudRecognitionResult result)
@@ -240,6 +393,17 @@ public abstract class CloudSttEngine : ISttEngine
     protected abstract Task ValidateConnectionAsync(CancellationToken cancellationToken);
     protected abstract string GetProviderName();
 
+    /// <summary>
+    /// True when the settings ask for FLAC uploads. Lossless FLAC roughly halves the bytes sent for
+    /// speech at a small CPU cost; providers without FLAC support keep sending PCM.
+    /// </summary>
+    protected bool UseFlacUpload => IsFlacEncoding(Settings.UploadEncoding);
+
+    internal static bool IsFlacEncoding(string? encoding)
+    {
+        return string.Equals(encoding, "flac", StringComparison.OrdinalIgnoreCase);
+    }
+
     protected virtual string GetAudioFormat()
     {
         return "audio/wav"; // Default format, override as needed
@@ -301,6 +465,17 @@ public abstract class CloudSttEngine : ISttEngine
     }
 }
 
+[ExcludeFromCodeCoverage] // Simple data container class
+public class CloudPipelineStatistics
+{
+    public long ChunksSubmitted { get; init; }
+    public long ChunksCompleted { get; init; }
+    public int WindowSize { get; init; }
+    public TimeSpan? SmoothedRoundTrip { get; init; }
+    public long DroppedAudioBytes { get; init; }
+    public long DroppedAudioEvents { get; init; }
+}
+
 [ExcludeFromCodeCoverage] // Simple data container class
 public class CloudRecognitionResult
 {
@@ -344,7 +519,7 @@ public class AzureSpeechEngine : CloudSttEngine
             response.EnsureSuccessStatusCode();
 
             var jsonResponse = await response.Content.ReadAsStringAsync(cancellationToken);
-            var azureResult = JsonSerializer.Deserialize<AzureRecognitionResponse>(jsonResponse);
+            var azureResult = JsonSerializer.Deserialize(jsonResponse, CloudEngineJsonContext.Default.AzureRecognitionResponse);
 
             if (azureResult?.NBest is { Length: > 0 })
             {
@@ -398,13 +573,13 @@ public class AzureSpeechEngine : CloudSttEngine
 
     protected override string GetProviderName() => "Azure Speech Services";
 
-    private sealed class AzureRecognitionResponse
+    internal sealed class AzureRecognitionResponse
     {
         public string RecognitionStatus { get; set; } = string.Empty;
         public AzureNBestResult[] NBest { get; set; } = [];
     }
 
-    private sealed class AzureNBestResult
+    internal sealed class AzureNBestResult
     {
         public double Confidence { get; set; }
         public string Display { get; set; } = string.Empty;
@@ -2,17 +2,13 @@
 using System.Text;
 using System.Text.Json;
 using System.Text.Json.Serialization;
+using Sttify.Corelib.Audio;
 using Sttify.Corelib.Config;
 
 namespace Sttify.Corelib.Engine.Cloud;
 
 public class GoogleCloudSpeechEngine : CloudSttEngine
 {
-    private static readonly JsonSerializerOptions JsonOptions = new()
-    {
-        PropertyNamingPolicy = JsonNamingPolicy.CamelCase
-    };
-
     public GoogleCloudSpeechEngine(CloudEngineSettings settings) : base(settings)
     {
     }
@@ -32,11 +28,15 @@ public class GoogleCloudSpeechEngine : CloudSttEngine
         {
             var endpoint = $"{Settings.Endpoint}/v1/speech:recognize";
 
+            // Base64 inflates the payload by a third, so compressing first pays off twice
+            var useFlac = UseFlacUpload;
+            var audioContent = useFlac ? FlacEncoder.Encode(audioData) : audioData;
+
             var request = new GoogleSpeechRequest
             {
                 Config = new GoogleSpeechConfig
                 {
-                    Encoding = "LINEAR16",
+                    Encoding = useFlac ? "FLAC" : "LINEAR16",
                     SampleRateHertz = 16000,
                     LanguageCode = Settings.Language,
                     EnableWordTimeOffsets = true,
@@ -45,11 +45,11 @@ public class GoogleCloudSpeechEngine : CloudSttEngine
                 },
                 Audio = new GoogleSpeechAudio
                 {
-                    Content = Convert.ToBase64String(audioData)
+                    Content = Convert.ToBase64String(audioContent)
                 }
             };
 
-            var json = JsonSerializer.Serialize(request, JsonOptions);
+            var json = JsonSerializer.Serialize(request, CloudEngineCamelCaseJsonContext.Default.GoogleSpeechRequest);
 
             var content = new StringContent(json, Encoding.UTF8, "application/json");
             var response = await HttpClient.PostAsync(endpoint, content, cancellationToken);
@@ -65,7 +65,7 @@ public class GoogleCloudSpeechEngine : CloudSttEngine
             }
 
             var responseContent = await response.Content.ReadAsStringAsync(cancellationToken);
-            var googleResponse = JsonSerializer.Deserialize<GoogleSpeechResponse>(responseContent, JsonOptions);
+            var googleResponse = JsonSerializer.Deserialize(responseContent, CloudEngineCamelCaseJsonContext.Default.GoogleSpeechResponse);
 
             if (googleResponse?.Results?.Length > 0)
             {
@@ -0,0 +1,618 @@
+﻿using System.Buffers.Binary;
+using System.Diagnostics;
+using System.Net;
+using System.Net.Http.Headers;
+using System.Threading.Channels;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// Google Cloud Speech <c>StreamingRecognize</c> spoken as gRPC over HTTP/2. Each utterance gets its
+/// own bidirectional stream (single-utterance mode); interim results are raised as partials while
+/// audio is still being sent. Streams share one <see cref="HttpClient"/>, so consecutive utterances
+/// reuse the same HTTP/2 connection instead of renegotiating.
+/// </summary>
+public class GoogleStreamingSpeechEngine : ISttEngine
+{
+    private const string DefaultEndpoint = "https://speech.googleapis.com";
+    private const string StreamingRecognizePath = "/google.cloud.speech.v1.Speech/StreamingRecognize";
+    private const int SampleRate = 16000;
+    private const int MaxQueuedChunks = 100;
+    private const int EndOfSingleUtterance = 1; // StreamingRecognizeResponse.SpeechEventType
+    private static readonly TimeSpan StopDrainTimeout = TimeSpan.FromSeconds(5);
+    private static readonly TimeSpan RetryDelay = TimeSpan.FromSeconds(1);
+
+    private readonly HttpClient _httpClient;
+    private readonly object _lockObject = new();
+    private readonly CloudEngineSettings _settings;
+    private readonly byte[] _streamingConfigMessage;
+    private readonly Uri _streamUri;
+    private readonly bool _warmUpOnStart;
+
+    private StreamingAudioQueue? _audioQueue;
+    private bool _isRunning;
+    private CancellationTokenSource? _streamCancellation;
+    private Task? _streamTask;
+
+    public GoogleStreamingSpeechEngine(CloudEngineSettings settings, HttpMessageHandler? handler = null)
+    {
+        _settings = settings ?? throw new ArgumentNullException(nameof(settings));
+
+        var endpoint = string.IsNullOrEmpty(settings.Endpoint) ? DefaultEndpoint : settings.Endpoint.TrimEnd('/');
+        _streamUri = new Uri(endpoint + StreamingRecognizePath);
+        _streamingConfigMessage = FrameGrpcMessage(EncodeStreamingConfig(settings));
+
+        // The shared pool keeps the connection alive between utterances, so the next stream skips the handshakes
+        _warmUpOnStart = handler == null;
+        _httpClient = handler != null
+            ? new HttpClient(handler, disposeHandler: false)
+            : SharedHttpHandler.CreateClient(Timeout.InfiniteTimeSpan);
+        _httpClient.Timeout = Timeout.InfiniteTimeSpan;
+    }
+
+    public TimeSpan DroppedAudio => _audioQueue?.DroppedAudio ?? TimeSpan.Zero;
+
+    public event EventHandler<PartialRecognitionEventArgs>? OnPartial;
+    public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
+    public event EventHandler<SttErrorEventArgs>? OnError;
+
+    public Task StartAsync(CancellationToken cancellationToken = default)
+    {
+        lock (_lockObject)
+        {
+            if (_isRunning)
+                throw new InvalidOperationException("Google streaming engine is already running");
+
+            _isRunning = true;
+            // Not single-reader: a stream that ended can leave its wait for audio pending
+            _audioQueue = new StreamingAudioQueue(MaxQueuedChunks, SampleRate * sizeof(short), "GoogleStreamingAudioDropped", singleReader: false);
+            _streamCancellation = new CancellationTokenSource();
+        }
+
+        var audioQueue = _audioQueue;
+        var token = _streamCancellation.Token;
+        if (_warmUpOnStart)
+        {
+            // Connect while the user starts speaking rather than on the first audio chunk
+            AsyncHelper.FireAndForget(() => SharedHttpHandler.WarmUpAsync(_httpClient, _streamUri.ToString(), token), "GoogleStreamingWarmUp");
+        }
+
+        _streamTask = Task.Run(() => RunAsync(audioQueue.Reader, token), cancellationToken);
+
+        Telemetry.LogEvent("GoogleStreamingStarted", new { Endpoint = _streamUri.ToString(), _settings.Language });
+        return Task.CompletedTask;
+    }
+
+    public async Task StopAsync(CancellationToken cancellationToken = default)
+    {
+        StreamingAudioQueue? audioQueue;
+        CancellationTokenSource? cancellation;
+        Task? streamTask;
+
+        lock (_lockObject)
+        {
+            if (!_isRunning)
+                return;
+
+            _isRunning = false;
+            audioQueue = _audioQueue;
+            cancellation = _streamCancellation;
+            streamTask = _streamTask;
+        }
+
+        // Completing the writer half-closes the current stream; Google then returns its final result
+        audioQueue?.Complete();
+
+        if (streamTask != null)
+        {
+            try
+            {
+                await streamTask.WaitAsync(StopDrainTimeout, cancellationToken);
+            }
+            catch (TimeoutException)
+            {
+                Telemetry.LogWarning("GoogleStreamingDrainTimeout", "Recognition stream did not close in time", new { TimeoutSeconds = StopDrainTimeout.TotalSeconds });
+            }
+            catch (OperationCanceledException)
+            {
+                // Caller gave up waiting
+            }
+        }
+
+        if (cancellation != null)
+        {
+            await cancellation.CancelAsync();
+        }
+
+        if (streamTask != null)
+        {
+            try
+            {
+                await streamTask;
+            }
+            catch (OperationCanceledException)
+            {
+                // Expected when the stream is cancelled
+            }
+        }
+
+        cancellation?.Dispose();
+        _streamCancellation = null;
+        _streamTask = null;
+        audioQueue?.Clear();
+
+        Telemetry.LogEvent("GoogleStreamingStopped", new
+        {
+            DroppedAudioMs = audioQueue?.DroppedAudio.TotalMilliseconds ?? 0,
+            DroppedChunks = audioQueue?.DroppedChunks ?? 0
+        });
+    }
+
+    public void PushAudio(ReadOnlySpan<byte> audioData)
+    {
+        if (!_isRunning || audioData.IsEmpty)
+            return;
+
+        _audioQueue?.TryWrite(audioData);
+    }
+
+    public void Dispose()
+    {
+        Dispose(true);
+        GC.SuppressFinalize(this);
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (disposing)
+        {
+            StopAsync().GetAwaiter().GetResult();
+            _httpClient.Dispose();
+        }
+    }
+
+    private async Task RunAsync(ChannelReader<AudioChunk> audioReader, CancellationToken cancellationToken)
+    {
+        try
+        {
+            // A stream is opened lazily when audio for the next utterance arrives
+            while (await audioReader.WaitToReadAsync(cancellationToken))
+            {
+                try
+                {
+                    await RunUtteranceStreamAsync(audioReader, cancellationToken);
+                }
+                catch (Exception ex) when (ex is not OperationCanceledException)
+                {
+                    Telemetry.LogError("GoogleStreamingFailed", ex);
+                    OnError?.Invoke(this, new SttErrorEventArgs(ex, $"Google streaming recognition failed: {ex.Message}"));
+
+                    // Avoid hammering the service when it keeps rejecting us
+                    await Task.Delay(RetryDelay, cancellationToken);
+                }
+            }
+        }
+        catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+        {
+            // Stopped
+        }
+    }
+
+    private async Task RunUtteranceStreamAsync(ChannelReader<AudioChunk> audioReader, CancellationToken cancellationToken)
+    {
+        var endOfUtterance = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var timings = new UtteranceTimings(Stopwatch.StartNew());
+
+        try
+        {
+            using var request = new HttpRequestMessage(HttpMethod.Post, _streamUri)
+            {
+                Version = HttpVersion.Version20,
+                VersionPolicy = HttpVersionPolicy.RequestVersionExact,
+                Content = new StreamingRecognizeContent(audioReader, _streamingConfigMessage, endOfUtterance.Task)
+            };
+
+            request.Headers.TE.Add(new TransferCodingWithQualityHeaderValue("trailers"));
+            if (!string.IsNullOrEmpty(_settings.ApiKey))
+            {
+                request.Headers.Authorization = new AuthenticationHeaderValue("Bearer", _settings.ApiKey);
+            }
+            request.Content.Headers.ContentType = new MediaTypeHeaderValue("application/grpc");
+
+            using var response = await _httpClient.SendAsync(request, HttpCompletionOption.ResponseHeadersRead, cancellationToken);
+            timings.StreamOpenMs = timings.Stopwatch.Elapsed.TotalMilliseconds;
+
+            if (!response.IsSuccessStatusCode)
+            {
+                var errorContent = await response.Content.ReadAsStringAsync(cancellationToken);
+                throw new HttpRequestException($"Google streaming error: {response.StatusCode} - {errorContent}", null, response.StatusCode);
+            }
+
+            // Trailers-only responses carry the status in the headers
+            ThrowIfGrpcError(response.Headers);
+
+            await using (var responseStream = await response.Content.ReadAsStreamAsync(cancellationToken))
+            {
+                await ReadResponsesAsync(responseStream, endOfUtterance, timings, cancellationToken);
+            }
+
+            ThrowIfGrpcError(response.TrailingHeaders);
+        }
+        finally
+        {
+            endOfUtterance.TrySetResult();
+        }
+
+        Telemetry.LogEvent("GoogleStreamingUtterance", new
+        {
+            timings.StreamOpenMs,
+            timings.FirstResultMs,
+            timings.FinalAfterEndpointMs,
+            timings.Partials,
+            timings.Finals
+        });
+    }
+
+    private async Task ReadResponsesAsync(Stream stream, TaskCompletionSource endOfUtterance, UtteranceTimings timings, CancellationToken cancellationToken)
+    {
+        var buffer = new byte[16 * 1024];
+        var count = 0;
+
+        while (true)
+        {
+            if (count == buffer.Length)
+            {
+                Array.Resize(ref buffer, buffer.Length * 2);
+            }
+
+            var read = await stream.ReadAsync(buffer.AsMemory(count), cancellationToken);
+            if (read == 0)
+                break;
+
+            count += read;
+
+            var offset = 0;
+            while (TryReadGrpcMessage(buffer.AsSpan(offset, count - offset), out var message, out var consumed))
+            {
+                offset += consumed;
+                HandleResponse(DecodeResponse(message!), endOfUtterance, timings);
+            }
+
+            if (offset > 0)
+            {
+                Buffer.BlockCopy(buffer, offset, buffer, 0, count - offset);
+                count -= offset;
+            }
+        }
+
+        if (count > 0)
+            throw new InvalidDataException($"Recognition stream ended inside a message ({count} bytes left)");
+    }
+
+    private void HandleResponse(GoogleStreamingResponse response, TaskCompletionSource endOfUtterance, UtteranceTimings timings)
+    {
+        if (response.ErrorCode != 0)
+            throw new InvalidOperationException($"Google streaming error {response.ErrorCode}: {response.ErrorMessage}");
+
+        if (response.SpeechEventType == EndOfSingleUtterance)
+        {
+            // Google stops listening here; stop sending so the rest of the audio opens the next stream
+            timings.EndpointMs ??= timings.Stopwatch.Elapsed.TotalMilliseconds;
+            endOfUtterance.TrySetResult();
+        }
+
+        foreach (var result in response.Results)
+        {
+            if (string.IsNullOrWhiteSpace(result.Transcript))
+                continue;
+
+            timings.FirstResultMs ??= timings.Stopwatch.Elapsed.TotalMilliseconds;
+
+            if (result.IsFinal)
+            {
+                timings.Finals++;
+                if (timings.EndpointMs.HasValue)
+                {
+                    timings.FinalAfterEndpointMs = timings.Stopwatch.Elapsed.TotalMilliseconds - timings.EndpointMs.Value;
+                }
+
+                OnFinal?.Invoke(this, new FinalRecognitionEventArgs(result.Transcript, result.Confidence, result.EndTime));
+                endOfUtterance.TrySetResult();
+            }
+            else
+            {
+                timings.Partials++;
+                // Interim results carry stability (likelihood of not changing) rather than confidence
+                OnPartial?.Invoke(this, new PartialRecognitionEventArgs(result.Transcript, result.Stability));
+            }
+        }
+    }
+
+    private static void ThrowIfGrpcError(HttpHeaders headers)
+    {
+        if (!headers.TryGetValues("grpc-status", out var statusValues))
+            return;
+
+        var status = statusValues.FirstOrDefault();
+        if (status is null or "0")
+            return;
+
+        var message = headers.TryGetValues("grpc-message", out var messageValues)
+            ? Uri.UnescapeDataString(messageValues.FirstOrDefault() ?? "")
+            : "";
+        throw new InvalidOperationException($"Google streaming gRPC status {status}: {message}");
+    }
+
+    private static byte[] EncodeStreamingConfig(CloudEngineSettings settings)
+    {
+        // RecognitionConfig: encoding=LINEAR16, sample_rate_hertz, language_code, profanity_filter, enable_automatic_punctuation
+        var recognitionConfig = new ProtobufWriter()
+            .WriteInt32(1, 1)
+            .WriteInt32(2, SampleRate)
+            .WriteString(3, settings.Language)
+            .WriteBool(5, settings.EnableProfanityFilter)
+            .WriteBool(11, settings.EnableAutomaticPunctuation);
+
+        // StreamingRecognitionConfig: config, single_utterance, interim_results
+        var streamingConfig = new ProtobufWriter()
+            .WriteMessage(1, recognitionConfig)
+            .WriteBool(2, true)
+            .WriteBool(3, true);
+
+        // StreamingRecognizeRequest.streaming_config
+        return new ProtobufWriter().WriteMessage(1, streamingConfig).ToArray();
+    }
+
+    private static byte[] EncodeAudioRequest(ReadOnlySpan<byte> audio)
+    {
+        // StreamingRecognizeRequest.audio_content
+        return new ProtobufWriter().WriteBytes(2, audio).ToArray();
+    }
+
+    /// <summary>
+    /// gRPC length-prefixed message: compressed flag (0) and big-endian length, then the message.
+    /// </summary>
+    private static byte[] FrameGrpcMessage(ReadOnlySpan<byte> message)
+    {
+        var frame = new byte[5 + message.Length];
+        BinaryPrimitives.WriteInt32BigEndian(frame.AsSpan(1), message.Length);
+        message.CopyTo(frame.AsSpan(5));
+        return frame;
+    }
+
+    private static bool TryReadGrpcMessage(ReadOnlySpan<byte> buffer, out byte[]? message, out int consumed)
+    {
+        message = null;
+        consumed = 0;
+
+        if (buffer.Length < 5)
+            return false;
+
+        if (buffer[0] != 0)
+            throw new InvalidDataException("Compressed gRPC messages are not supported");
+
+        var length = BinaryPrimitives.ReadInt32BigEndian(buffer[1..]);
+        if (length < 0)
+            throw new InvalidDataException($"Invalid gRPC message length: {length}");
+        if (buffer.Length < 5 + length)
+            return false;
+
+        message = buffer.Slice(5, length).ToArray();
+        consumed = 5 + length;
+        return true;
+    }
+
+    private static GoogleStreamingResponse DecodeResponse(ReadOnlySpan<byte> data)
+    {
+        var response = new GoogleStreamingResponse();
+        var reader = new ProtobufReader(data);
+
+        while (reader.TryReadTag(out var field, out var wireType))
+        {
+            switch (field)
+            {
+                case 1 when wireType == ProtobufWireType.LengthDelimited:
+                    DecodeStatus(reader.ReadLengthDelimited(), response);
+                    break;
+                case 2 when wireType == ProtobufWireType.LengthDelimited:
+                    response.Results.Add(DecodeResult(reader.ReadLengthDelimited()));
+                    break;
+                case 4 when wireType == ProtobufWireType.Varint:
+                    response.SpeechEventType = (int)reader.ReadVarint();
+                    break;
+                default:
+                    reader.Skip(wireType);
+                    break;
+            }
+        }
+
+        return response;
+    }
+
+    private static void DecodeStatus(ReadOnlySpan<byte> data, GoogleStreamingResponse response)
+    {
+        var reader = new ProtobufReader(data);
+        while (reader.TryReadTag(out var field, out var wireType))
+        {
+            switch (field)
+            {
+                case 1 when wireType == ProtobufWireType.Varint:
+                    response.ErrorCode = (int)reader.ReadVarint();
+                    break;
+                case 2 when wireType == ProtobufWireType.LengthDelimited:
+                    response.ErrorMessage = reader.ReadString();
+                    break;
+                default:
+                    reader.Skip(wireType);
+                    break;
+            }
+        }
+    }
+
+    private static GoogleStreamingResult DecodeResult(ReadOnlySpan<byte> data)
+    {
+        var result = new GoogleStreamingResult();
+        var hasAlternative = false;
+        var reader = new ProtobufReader(data);
+
+        while (reader.TryReadTag(out var field, out var wireType))
+        {
+            switch (field)
+            {
+                // Only the top alternative is used
+                case 1 when wireType == ProtobufWireType.LengthDelimited && !hasAlternative:
+                    DecodeAlternative(reader.ReadLengthDelimited(), result);
+                    hasAlternative = true;
+                    break;
+                case 2 when wireType == ProtobufWireType.Varint:
+                    result.IsFinal = reader.ReadBool();
+                    break;
+                case 3 when wireType == ProtobufWireType.Fixed32:
+                    result.Stability = reader.ReadFloat();
+                    break;
+                case 4 when wireType == ProtobufWireType.LengthDelimited:
+                    result.EndTime = DecodeDuration(reader.ReadLengthDelimited());
+                    break;
+                default:
+                    reader.Skip(wireType);
+                    break;
+            }
+        }
+
+        return result;
+    }
+
+    private static void DecodeAlternative(ReadOnlySpan<byte> data, GoogleStreamingResult result)
+    {
+        var reader = new ProtobufReader(data);
+        while (reader.TryReadTag(out var field, out var wireType))
+        {
+            switch (field)
+            {
+                case 1 when wireType == ProtobufWireType.LengthDelimited:
+                    result.Transcript = reader.ReadString();
+                    break;
+                case 2 when wireType == ProtobufWireType.Fixed32:
+                    result.Confidence = reader.ReadFloat();
+                    break;
+                default:
+                    reader.Skip(wireType);
+                    break;
+            }
+        }
+    }
+
+    private static TimeSpan DecodeDuration(ReadOnlySpan<byte> data)
+    {
+        long seconds = 0;
+        long nanos = 0;
+        var reader = new ProtobufReader(data);
+        while (reader.TryReadTag(out var field, out var wireType))
+        {
+            switch (field)
+            {
+                case 1 when wireType == ProtobufWireType.Varint:
+                    seconds = (long)reader.ReadVarint();
+                    break;
+                case 2 when wireType == ProtobufWireType.Varint:
+                    nanos = (long)reader.ReadVarint();
+                    break;
+                default:
+                    reader.Skip(wireType);
+                    break;
+            }
+        }
+
+        return TimeSpan.FromSeconds(seconds) + TimeSpan.FromTicks(nanos / 100);
+    }
+
+    /// <summary>
+    /// Request body for one utterance: the config message, then audio as it arrives, until the
+    /// service signals the end of the utterance or the engine stops. Audio left in the channel is
+    /// picked up by the next stream.
+    /// </summary>
+    private sealed class StreamingRecognizeContent : HttpContent
+    {
+        private readonly ChannelReader<AudioChunk> _audioReader;
+        private readonly byte[] _configFrame;
+        private readonly Task _endOfUtterance;
+
+        public StreamingRecognizeContent(ChannelReader<AudioChunk> audioReader, byte[] configFrame, Task endOfUtterance)
+        {
+            _audioReader = audioReader;
+            _configFrame = configFrame;
+            _endOfUtterance = endOfUtterance;
+        }
+
+        protected override Task SerializeToStreamAsync(Stream stream, TransportContext? context) =>
+            SerializeToStreamAsync(stream, context, CancellationToken.None);
+
+        protected override async Task SerializeToStreamAsync(Stream stream, TransportContext? context, CancellationToken cancellationToken)
+        {
+            await stream.WriteAsync(_configFrame, cancellationToken);
+            await stream.FlushAsync(cancellationToken);
+
+            while (!_endOfUtterance.IsCompleted)
+            {
+                var waitForAudio = _audioReader.WaitToReadAsync(cancellationToken).AsTask();
+                if (await Task.WhenAny(waitForAudio, _endOfUtterance) == _endOfUtterance || !await waitForAudio)
+                    break;
+
+                // Write everything queued, then flush once
+                while (!_endOfUtterance.IsCompleted && _audioReader.TryRead(out var audio))
+                {
+                    try
+                    {
+                        await stream.WriteAsync(FrameGrpcMessage(EncodeAudioRequest(audio.Span)), cancellationToken);
+                    }
+                    finally
+                    {
+                        audio.Return();
+                    }
+                }
+                await stream.FlushAsync(cancellationToken);
+            }
+        }
+
+        protected override bool TryComputeLength(out long length)
+        {
+            length = 0;
+            return false;
+        }
+    }
+
+    private sealed class UtteranceTimings
+    {
+        public UtteranceTimings(Stopwatch stopwatch)
+        {
+            Stopwatch = stopwatch;
+        }
+
+        public Stopwatch Stopwatch { get; }
+        public double StreamOpenMs { get; set; }
+        public double? FirstResultMs { get; set; }
+        public double? EndpointMs { get; set; }
+        public double? FinalAfterEndpointMs { get; set; }
+        public int Partials { get; set; }
+        public int Finals { get; set; }
+    }
+}
+
+internal class GoogleStreamingResponse
+{
+    public int ErrorCode { get; set; }
+    public string? ErrorMessage { get; set; }
+    public List<GoogleStreamingResult> Results { get; } = new();
+    public int SpeechEventType { get; set; }
+}
+
+internal class GoogleStreamingResult
+{
+    public string Transcript { get; set; } = "";
+    public float Confidence { get; set; }
+    public float Stability { get; set; }
+    public bool IsFinal { get; set; }
+    public TimeSpan EndTime { get; set; }
+}
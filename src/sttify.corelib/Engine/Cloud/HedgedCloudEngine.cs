@@ -0,0 +1,225 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// Sends each segment to a primary provider and, when no result has arrived by the primary's
+/// p90 latency, to a secondary as well; the first successful answer is delivered and the other
+/// request cancelled. Latency histograms and cost counters are kept per provider.
+/// </summary>
+public class HedgedCloudEngine : CloudSttEngine
+{
+    private const int BytesPerSecond = 32000; // 16kHz mono 16-bit
+
+    private readonly HedgedEngineSettings _hedgeSettings;
+    private readonly HedgedProvider _primary;
+    private readonly HedgedProvider _secondary;
+
+    public HedgedCloudEngine(CloudEngineSettings primarySettings, HedgedEngineSettings hedgeSettings, CloudSttEngine primary, CloudSttEngine secondary)
+        : base(primarySettings)
+    {
+        _hedgeSettings = hedgeSettings ?? throw new ArgumentNullException(nameof(hedgeSettings));
+        _primary = new HedgedProvider(primary ?? throw new ArgumentNullException(nameof(primary)));
+        _secondary = new HedgedProvider(secondary ?? throw new ArgumentNullException(nameof(secondary)));
+    }
+
+    /// <summary>
+    /// Delay before the secondary is asked: the primary's configured latency percentile once enough
+    /// samples exist, the initial delay before that.
+    /// </summary>
+    public TimeSpan HedgeDelay
+    {
+        get
+        {
+            var minimum = TimeSpan.FromMilliseconds(Math.Max(0, _hedgeSettings.MinHedgeDelayMs));
+            if (_primary.Latency.Count < _hedgeSettings.MinSamples)
+                return TimeSpan.FromMilliseconds(Math.Max(_hedgeSettings.InitialHedgeDelayMs, minimum.TotalMilliseconds));
+
+            var percentile = _primary.Latency.GetPercentile(Math.Clamp(_hedgeSettings.HedgePercentile, 0.0, 1.0)) ?? minimum;
+            return percentile > minimum ? percentile : minimum;
+        }
+    }
+
+    public IReadOnlyList<HedgedProviderStatistics> ProviderStatistics => [_primary.GetStatistics(), _secondary.GetStatistics()];
+
+    public override async Task StopAsync(CancellationToken cancellationToken = default)
+    {
+        await base.StopAsync(cancellationToken);
+
+        foreach (var statistics in ProviderStatistics)
+        {
+            Telemetry.LogEvent("HedgedProviderStatistics", new
+            {
+                statistics.Provider,
+                statistics.Requests,
+                statistics.Wins,
+                statistics.Failures,
+                statistics.Cancelled,
+                statistics.BilledAudioSeconds,
+                P50Ms = statistics.P50?.TotalMilliseconds,
+                P90Ms = statistics.P90?.TotalMilliseconds
+            });
+        }
+    }
+
+    protected override void Dispose(bool disposing)
+    {
+        base.Dispose(disposing);
+        if (disposing)
+        {
+            _primary.Engine.Dispose();
+            _secondary.Engine.Dispose();
+        }
+    }
+
+    protected override void ConfigureHttpClient()
+    {
+        // Requests go through the providers' own clients
+    }
+
+    protected override async Task ValidateConnectionAsync(CancellationToken cancellationToken)
+    {
+        await _primary.Engine.PrepareAsync(cancellationToken);
+
+        try
+        {
+            await _secondary.Engine.PrepareAsync(cancellationToken);
+        }
+        catch (Exception ex) when (ex is not OperationCanceledException)
+        {
+            // Still usable without hedging; a failing secondary simply never wins
+            Telemetry.LogWarning("HedgedSecondaryUnavailable", ex.Message, new { Provider = _secondary.Name });
+        }
+    }
+
+    protected override string GetProviderName() => $"Hedged ({_primary.Name} + {_secondary.Name})";
+
+    protected override async Task<CloudRecognitionResult> ProcessAudioChunkAsync(byte[] audioData, CancellationToken cancellationToken)
+    {
+        var audioSeconds = (double)audioData.Length / BytesPerSecond;
+        var hedgeDelay = HedgeDelay;
+
+        var outcome = await HedgedRequest.RunAsync(
+            token => _primary.RecognizeAsync(audioData, audioSeconds, hedgeDelay, token),
+            token => _secondary.RecognizeAsync(audioData, audioSeconds, TimeSpan.Zero, token),
+            hedgeDelay,
+            result => result.Success,
+            cancellationToken);
+
+        if (outcome.Winner == HedgedWinner.Primary)
+            _primary.RecordWin();
+        else if (outcome.Winner == HedgedWinner.Secondary)
+            _secondary.RecordWin();
+
+        if (outcome.Hedged)
+        {
+            Telemetry.LogEvent("HedgedRequestCompleted", new
+            {
+                Winner = outcome.Winner.ToString(),
+                HedgeDelayMs = hedgeDelay.TotalMilliseconds,
+                AudioSeconds = audioSeconds
+            });
+        }
+
+        outcome.Result.Metadata["provider"] = outcome.Winner == HedgedWinner.Secondary ? _secondary.Name : _primary.Name;
+        return outcome.Result;
+    }
+
+    private sealed class HedgedProvider
+    {
+        private readonly object _lockObject = new();
+        private double _billedAudioSeconds;
+        private long _cancelled;
+        private long _failures;
+        private long _requests;
+        private long _wins;
+
+        public HedgedProvider(CloudSttEngine engine)
+        {
+            Engine = engine;
+            Name = engine.ProviderName;
+        }
+
+        public CloudSttEngine Engine { get; }
+        public string Name { get; }
+        public LatencyHistogram Latency { get; } = new();
+
+        public async Task<CloudRecognitionResult> RecognizeAsync(byte[] audioData, double audioSeconds, TimeSpan censoredFloor, CancellationToken cancellationToken)
+        {
+            lock (_lockObject)
+            {
+                // Providers bill for audio sent, whether or not the answer is used
+                _requests++;
+                _billedAudioSeconds += audioSeconds;
+            }
+
+            var stopwatch = Stopwatch.StartNew();
+            try
+            {
+                var result = await Engine.RecognizeSegmentAsync(audioData, cancellationToken);
+                if (result.Success)
+                {
+                    Latency.Record(stopwatch.Elapsed);
+                }
+                else
+                {
+                    Interlocked.Increment(ref _failures);
+                }
+                return result;
+            }
+            catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+            {
+                // The losers are the slow tail: leaving them out would pull the percentiles, and with
+                // them the hedge delay, down exactly when the provider is slow. Record the time they
+                // are known to have taken at least (the hedge delay for the primary) as a censored sample.
+                var elapsed = stopwatch.Elapsed;
+                Latency.Record(elapsed > censoredFloor ? elapsed : censoredFloor);
+                Interlocked.Increment(ref _cancelled);
+                throw;
+            }
+            catch
+            {
+                Interlocked.Increment(ref _failures);
+                throw;
+            }
+        }
+
+        public void RecordWin() => Interlocked.Increment(ref _wins);
+
+        public HedgedProviderStatistics GetStatistics()
+        {
+            lock (_lockObject)
+            {
+                return new HedgedProviderStatistics
+                {
+                    Provider = Name,
+                    Requests = _requests,
+                    Wins = Interlocked.Read(ref _wins),
+                    Failures = Interlocked.Read(ref _failures),
+                    Cancelled = Interlocked.Read(ref _cancelled),
+                    BilledAudioSeconds = _billedAudioSeconds,
+                    P50 = Latency.GetPercentile(0.5),
+                    P90 = Latency.GetPercentile(0.9),
+                    P99 = Latency.GetPercentile(0.99)
+                };
+            }
+        }
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class HedgedProviderStatistics
+{
+    public string Provider { get; init; } = "";
+    public long Requests { get; init; }
+    public long Wins { get; init; }
+    public long Failures { get; init; }
+    public long Cancelled { get; init; } // Lost the race and were cancelled in flight
+    public double BilledAudioSeconds { get; init; } // Audio sent, including requests that lost the race
+    public TimeSpan? P50 { get; init; }
+    public TimeSpan? P90 { get; init; }
+    public TimeSpan? P99 { get; init; }
+}
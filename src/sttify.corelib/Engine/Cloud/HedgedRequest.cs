@@ -0,0 +1,114 @@
+﻿using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// Runs a request against a primary backend and, if it has not succeeded within the hedge delay
+/// (or fails before then), against a secondary as well. The first successful result wins and the
+/// other request is cancelled.
+/// </summary>
+public static class HedgedRequest
+{
+    public static async Task<HedgedOutcome<T>> RunAsync<T>(
+        Func<CancellationToken, Task<T>> primary,
+        Func<CancellationToken, Task<T>> secondary,
+        TimeSpan hedgeDelay,
+        Func<T, bool> isSuccess,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(primary);
+        ArgumentNullException.ThrowIfNull(secondary);
+        ArgumentNullException.ThrowIfNull(isSuccess);
+
+        using var primaryCancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        using var secondaryCancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+
+        var primaryTask = InvokeAsync(primary, primaryCancellation.Token);
+        Task first;
+        using (var delayCancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken))
+        {
+            first = await Task.WhenAny(primaryTask, Task.Delay(hedgeDelay, delayCancellation.Token)).ConfigureAwait(false);
+            await delayCancellation.CancelAsync().ConfigureAwait(false);
+        }
+
+        if (first == primaryTask && Succeeded(primaryTask, isSuccess))
+            return new HedgedOutcome<T>(primaryTask.Result, HedgedWinner.Primary, hedged: false);
+
+        cancellationToken.ThrowIfCancellationRequested();
+
+        var secondaryTask = InvokeAsync(secondary, secondaryCancellation.Token);
+        var pending = new List<Task<T>>(2) { secondaryTask };
+        if (!primaryTask.IsCompleted)
+        {
+            pending.Add(primaryTask);
+        }
+
+        while (pending.Count > 0)
+        {
+            var done = await Task.WhenAny(pending).ConfigureAwait(false);
+            pending.Remove(done);
+            if (!Succeeded(done, isSuccess))
+                continue;
+
+            // The loser sees cancellation; its outcome is no longer awaited
+            ObserveFaults(done == primaryTask ? secondaryTask : primaryTask);
+            if (done == primaryTask)
+            {
+                await secondaryCancellation.CancelAsync().ConfigureAwait(false);
+                return new HedgedOutcome<T>(done.Result, HedgedWinner.Primary, hedged: true);
+            }
+
+            await primaryCancellation.CancelAsync().ConfigureAwait(false);
+            return new HedgedOutcome<T>(done.Result, HedgedWinner.Secondary, hedged: true);
+        }
+
+        // Both failed: report the primary's unsuccessful result if it produced one, else the secondary's
+        cancellationToken.ThrowIfCancellationRequested();
+        if (primaryTask.IsCompletedSuccessfully)
+            return new HedgedOutcome<T>(primaryTask.Result, HedgedWinner.None, hedged: true);
+        if (secondaryTask.IsCompletedSuccessfully)
+            return new HedgedOutcome<T>(secondaryTask.Result, HedgedWinner.None, hedged: true);
+
+        ObserveFaults(secondaryTask); // The primary's exception is the one reported
+        return new HedgedOutcome<T>(await primaryTask.ConfigureAwait(false), HedgedWinner.None, hedged: true);
+    }
+
+    private static bool Succeeded<T>(Task<T> task, Func<T, bool> isSuccess)
+    {
+        return task.IsCompletedSuccessfully && isSuccess(task.Result);
+    }
+
+    private static async Task<T> InvokeAsync<T>(Func<CancellationToken, Task<T>> request, CancellationToken cancellationToken)
+    {
+        // Synchronous throws become faulted tasks like any other failure
+        return await request(cancellationToken).ConfigureAwait(false);
+    }
+
+    private static void ObserveFaults(Task task)
+    {
+        task.ContinueWith(static t => _ = t.Exception, CancellationToken.None,
+            TaskContinuationOptions.OnlyOnFaulted | TaskContinuationOptions.ExecuteSynchronously, TaskScheduler.Default);
+    }
+}
+
+public enum HedgedWinner
+{
+    None,
+    Primary,
+    Secondary
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public readonly struct HedgedOutcome<T>
+{
+    public HedgedOutcome(T result, HedgedWinner winner, bool hedged)
+    {
+        Result = result;
+        Winner = winner;
+        Hedged = hedged;
+    }
+
+    public T Result { get; }
+    public HedgedWinner Winner { get; }
+    public bool Hedged { get; } // The secondary was started
+}
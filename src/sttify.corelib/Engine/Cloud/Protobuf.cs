@@ -0,0 +1,173 @@
+﻿using System.Buffers;
+using System.Buffers.Binary;
+using System.Text;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+public enum ProtobufWireType
+{
+    Varint = 0,
+    Fixed64 = 1,
+    LengthDelimited = 2,
+    Fixed32 = 5
+}
+
+/// <summary>
+/// Minimal protocol buffers encoder covering the scalar and nested-message fields used by the
+/// streaming speech APIs, so they can be spoken without generated code.
+/// </summary>
+public sealed class ProtobufWriter
+{
+    private readonly ArrayBufferWriter<byte> _buffer = new();
+
+    public ReadOnlySpan<byte> WrittenSpan => _buffer.WrittenSpan;
+
+    public ProtobufWriter WriteVarint(int field, ulong value)
+    {
+        WriteTag(field, ProtobufWireType.Varint);
+        WriteRawVarint(value);
+        return this;
+    }
+
+    public ProtobufWriter WriteInt32(int field, int value) => WriteVarint(field, (ulong)(long)value);
+
+    public ProtobufWriter WriteBool(int field, bool value) => WriteVarint(field, value ? 1UL : 0UL);
+
+    public ProtobufWriter WriteFloat(int field, float value)
+    {
+        WriteTag(field, ProtobufWireType.Fixed32);
+        BinaryPrimitives.WriteSingleLittleEndian(_buffer.GetSpan(4), value);
+        _buffer.Advance(4);
+        return this;
+    }
+
+    public ProtobufWriter WriteString(int field, string value)
+    {
+        WriteTag(field, ProtobufWireType.LengthDelimited);
+        var length = Encoding.UTF8.GetByteCount(value);
+        WriteRawVarint((ulong)length);
+        Encoding.UTF8.GetBytes(value, _buffer.GetSpan(length));
+        _buffer.Advance(length);
+        return this;
+    }
+
+    public ProtobufWriter WriteBytes(int field, ReadOnlySpan<byte> value)
+    {
+        WriteTag(field, ProtobufWireType.LengthDelimited);
+        WriteRawVarint((ulong)value.Length);
+        _buffer.Write(value);
+        return this;
+    }
+
+    public ProtobufWriter WriteMessage(int field, ProtobufWriter message) => WriteBytes(field, message.WrittenSpan);
+
+    public byte[] ToArray() => _buffer.WrittenSpan.ToArray();
+
+    private void WriteTag(int field, ProtobufWireType wireType) => WriteRawVarint(((ulong)field << 3) | (ulong)wireType);
+
+    private void WriteRawVarint(ulong value)
+    {
+        var span = _buffer.GetSpan(10);
+        var count = 0;
+        while (value >= 0x80)
+        {
+            span[count++] = (byte)(value | 0x80);
+            value >>= 7;
+        }
+        span[count++] = (byte)value;
+        _buffer.Advance(count);
+    }
+}
+
+/// <summary>
+/// Forward-only protocol buffers decoder over a span. Unknown fields are skipped with <see cref="Skip"/>.
+/// </summary>
+public ref struct ProtobufReader
+{
+    private readonly ReadOnlySpan<byte> _data;
+    private int _position;
+
+    public ProtobufReader(ReadOnlySpan<byte> data)
+    {
+        _data = data;
+        _position = 0;
+    }
+
+    public bool TryReadTag(out int field, out ProtobufWireType wireType)
+    {
+        if (_position >= _data.Length)
+        {
+            field = 0;
+            wireType = default;
+            return false;
+        }
+
+        var tag = ReadVarint();
+        field = (int)(tag >> 3);
+        wireType = (ProtobufWireType)(tag & 0x7);
+        return true;
+    }
+
+    public ulong ReadVarint()
+    {
+        ulong value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (_position >= _data.Length)
+                throw new InvalidDataException("Truncated protobuf varint");
+
+            var b = _data[_position++];
+            value |= (ulong)(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+                return value;
+        }
+
+        throw new InvalidDataException("Malformed protobuf varint");
+    }
+
+    public bool ReadBool() => ReadVarint() != 0;
+
+    public float ReadFloat() => BinaryPrimitives.ReadSingleLittleEndian(Take(4));
+
+    public ReadOnlySpan<byte> ReadLengthDelimited()
+    {
+        var length = ReadVarint();
+        if (length > (ulong)(_data.Length - _position))
+            throw new InvalidDataException("Truncated protobuf field");
+
+        return Take((int)length);
+    }
+
+    public string ReadString() => Encoding.UTF8.GetString(ReadLengthDelimited());
+
+    public void Skip(ProtobufWireType wireType)
+    {
+        switch (wireType)
+        {
+            case ProtobufWireType.Varint:
+                ReadVarint();
+                break;
+            case ProtobufWireType.Fixed64:
+                Take(8);
+                break;
+            case ProtobufWireType.LengthDelimited:
+                ReadLengthDelimited();
+                break;
+            case ProtobufWireType.Fixed32:
+                Take(4);
+                break;
+            default:
+                throw new InvalidDataException($"Unsupported protobuf wire type: {wireType}");
+        }
+    }
+
+    private ReadOnlySpan<byte> Take(int count)
+    {
+        if (count > _data.Length - _position)
+            throw new InvalidDataException("Truncated protobuf field");
+
+        var slice = _data.Slice(_position, count);
+        _position += count;
+        return slice;
+    }
+}
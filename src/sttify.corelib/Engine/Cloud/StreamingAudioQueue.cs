@@ -0,0 +1,103 @@
+﻿using System.Buffers;
+using System.Threading.Channels;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Engine.Cloud;
+
+/// <summary>
+/// Bounded queue of pooled audio chunks between <c>PushAudio</c> and a streaming request body.
+/// When the stream falls behind, or is reconnecting, the oldest audio is dropped. Dropped audio is
+/// counted and logged once per backlog episode so a degraded stream shows up in telemetry.
+/// </summary>
+public sealed class StreamingAudioQueue
+{
+    private readonly int _bytesPerSecond;
+    private readonly int _capacity;
+    private readonly Channel<AudioChunk> _channel;
+    private readonly string _dropEventName;
+    private long _droppedBytes;
+    private long _droppedChunks;
+    private int _dropWarningLogged;
+
+    public StreamingAudioQueue(int capacity, int bytesPerSecond, string dropEventName, bool singleReader = true)
+    {
+        if (capacity < 1)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity must be at least one chunk");
+        if (bytesPerSecond < 1)
+            throw new ArgumentOutOfRangeException(nameof(bytesPerSecond), "Byte rate must be positive");
+
+        _capacity = capacity;
+        _bytesPerSecond = bytesPerSecond;
+        _dropEventName = dropEventName;
+        _channel = Channel.CreateBounded<AudioChunk>(new BoundedChannelOptions(capacity)
+        {
+            FullMode = BoundedChannelFullMode.DropOldest,
+            SingleReader = singleReader,
+            SingleWriter = true
+        }, OnChunkDropped);
+    }
+
+    public ChannelReader<AudioChunk> Reader => _channel.Reader;
+    public long DroppedChunks => Interlocked.Read(ref _droppedChunks);
+    public TimeSpan DroppedAudio => TimeSpan.FromSeconds((double)Interlocked.Read(ref _droppedBytes) / _bytesPerSecond);
+
+    public bool TryWrite(ReadOnlySpan<byte> audio)
+    {
+        if (audio.IsEmpty)
+            return false;
+
+        // The stream has caught up since the last drop, so the next drop starts a new episode
+        if (_channel.Reader.Count == 0)
+        {
+            Volatile.Write(ref _dropWarningLogged, 0);
+        }
+
+        var buffer = ArrayPool<byte>.Shared.Rent(audio.Length);
+        audio.CopyTo(buffer);
+        if (_channel.Writer.TryWrite(new AudioChunk(buffer, audio.Length)))
+            return true;
+
+        // Completed: the engine is stopping
+        ArrayPool<byte>.Shared.Return(buffer);
+        return false;
+    }
+
+    public void Complete() => _channel.Writer.TryComplete();
+
+    /// <summary>
+    /// Returns chunks no stream will send anymore. Only call once the reader has stopped.
+    /// </summary>
+    public void Clear()
+    {
+        while (_channel.Reader.TryRead(out var chunk))
+        {
+            chunk.Return();
+        }
+    }
+
+    private void OnChunkDropped(AudioChunk chunk)
+    {
+        Interlocked.Increment(ref _droppedChunks);
+        var dropped = Interlocked.Add(ref _droppedBytes, chunk.Length);
+        chunk.Return();
+
+        if (Interlocked.Exchange(ref _dropWarningLogged, 1) == 0)
+        {
+            Telemetry.LogWarning(_dropEventName, "Stream fell behind capture; dropping the oldest queued audio", new
+            {
+                MaxQueuedChunks = _capacity,
+                TotalDroppedMs = TimeSpan.FromSeconds((double)dropped / _bytesPerSecond).TotalMilliseconds
+            });
+        }
+    }
+}
+
+/// <summary>
+/// Audio rented from <see cref="ArrayPool{T}.Shared"/>; whoever takes it off the queue returns it.
+/// </summary>
+public readonly record struct AudioChunk(byte[] Buffer, int Length)
+{
+    public ReadOnlySpan<byte> Span => Buffer.AsSpan(0, Length);
+
+    public void Return() => ArrayPool<byte>.Shared.Return(Buffer);
+}
@@ -0,0 +1,195 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Engine;
+
+/// <summary>
+/// Plays a recording into an engine at real-time pace and records when results arrive, so that
+/// engines (e.g. batch vs. streaming cloud recognizers) can be compared on the same audio.
+/// </summary>
+public static class EngineLatencyBenchmark
+{
+    private const int BytesPerSample = 2;
+
+    public static async Task<EngineLatencyResult> MeasureAsync(ISttEngine engine,
+        byte[] pcm,
+        EngineLatencyOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(engine);
+        ArgumentNullException.ThrowIfNull(pcm);
+        options ??= new EngineLatencyOptions();
+        if (options.FrameSizeBytes <= 0)
+            throw new ArgumentOutOfRangeException(nameof(options), "Frame size must be positive");
+
+        var result = new EngineLatencyResult
+        {
+            AudioDuration = GetDuration(pcm.Length, options.SampleRate)
+        };
+        var finals = new List<string>();
+        var stopwatch = new Stopwatch();
+        var lockObject = new object();
+
+        EventHandler<PartialRecognitionEventArgs> partialHandler = (_, _) =>
+        {
+            lock (lockObject)
+            {
+                result.PartialCount++;
+                result.FirstResult ??= stopwatch.Elapsed;
+            }
+        };
+        EventHandler<FinalRecognitionEventArgs> finalHandler = (_, e) =>
+        {
+            lock (lockObject)
+            {
+                result.FinalCount++;
+                result.FirstResult ??= stopwatch.Elapsed;
+                result.LastFinal = stopwatch.Elapsed;
+                finals.Add(e.Text);
+            }
+        };
+        EventHandler<SttErrorEventArgs> errorHandler = (_, _) =>
+        {
+            lock (lockObject)
+            {
+                result.ErrorCount++;
+            }
+        };
+
+        engine.OnPartial += partialHandler;
+        engine.OnFinal += finalHandler;
+        engine.OnError += errorHandler;
+
+        try
+        {
+            await engine.StartAsync(cancellationToken).ConfigureAwait(false);
+            stopwatch.Start();
+
+            try
+            {
+                await PlayAsync(engine, pcm, options, stopwatch, TimeSpan.Zero, cancellationToken).ConfigureAwait(false);
+
+                // Trailing silence lets endpointing engines close the utterance
+                var silence = new byte[(int)(options.TrailingSilence.TotalSeconds * options.SampleRate) * BytesPerSample];
+                await PlayAsync(engine, silence, options, stopwatch, result.AudioDuration, cancellationToken).ConfigureAwait(false);
+
+                await Task.Delay(options.SettleTime, cancellationToken).ConfigureAwait(false);
+            }
+            finally
+            {
+                await engine.StopAsync(cancellationToken).ConfigureAwait(false);
+            }
+        }
+        finally
+        {
+            engine.OnPartial -= partialHandler;
+            engine.OnFinal -= finalHandler;
+            engine.OnError -= errorHandler;
+        }
+
+        lock (lockObject)
+        {
+            result.Transcript = string.Join(" ", finals);
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// Measures both engines on each recording. Engines are created per recording so every run
+    /// starts from the same state.
+    /// </summary>
+    [ExcludeFromCodeCoverage] // Requires running engines
+    public static async Task<List<EngineLatencyComparison>> CompareAsync(Func<ISttEngine> baselineFactory,
+        Func<ISttEngine> candidateFactory,
+        IEnumerable<(string Name, byte[] Pcm)> recordings,
+        EngineLatencyOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        var comparisons = new List<EngineLatencyComparison>();
+        foreach (var (name, pcm) in recordings)
+        {
+            EngineLatencyResult baseline;
+            using (var engine = baselineFactory())
+            {
+                baseline = await MeasureAsync(engine, pcm, options, cancellationToken).ConfigureAwait(false);
+            }
+
+            EngineLatencyResult candidate;
+            using (var engine = candidateFactory())
+            {
+                candidate = await MeasureAsync(engine, pcm, options, cancellationToken).ConfigureAwait(false);
+            }
+
+            comparisons.Add(new EngineLatencyComparison(name, baseline, candidate));
+        }
+        return comparisons;
+    }
+
+    private static async Task PlayAsync(ISttEngine engine, byte[] pcm, EngineLatencyOptions options,
+        Stopwatch stopwatch, TimeSpan startOffset, CancellationToken cancellationToken)
+    {
+        for (int offset = 0; offset < pcm.Length; offset += options.FrameSizeBytes)
+        {
+            var length = Math.Min(options.FrameSizeBytes, pcm.Length - offset);
+            engine.PushAudio(pcm.AsSpan(offset, length));
+
+            if (options.RealTime)
+            {
+                // Pace against the clock rather than per-frame delays so timer slack does not accumulate
+                var due = startOffset + GetDuration(offset + length, options.SampleRate);
+                var wait = due - stopwatch.Elapsed;
+                if (wait > TimeSpan.Zero)
+                {
+                    await Task.Delay(wait, cancellationToken).ConfigureAwait(false);
+                }
+            }
+        }
+    }
+
+    private static TimeSpan GetDuration(int byteCount, int sampleRate)
+    {
+        return TimeSpan.FromSeconds((double)byteCount / (BytesPerSample * sampleRate));
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple configuration class with no business logic
+public class EngineLatencyOptions
+{
+    public int FrameSizeBytes { get; set; } = 3200; // 100ms at 16kHz mono 16-bit
+    public int SampleRate { get; set; } = 16000;
+    public bool RealTime { get; set; } = true;
+    public TimeSpan TrailingSilence { get; set; } = TimeSpan.FromSeconds(1);
+    public TimeSpan SettleTime { get; set; } = TimeSpan.FromSeconds(5); // Time allowed for late results before stopping
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class EngineLatencyResult
+{
+    public TimeSpan AudioDuration { get; set; }
+    public TimeSpan? FirstResult { get; set; } // From the start of playback
+    public TimeSpan? LastFinal { get; set; }
+    public int PartialCount { get; set; }
+    public int FinalCount { get; set; }
+    public int ErrorCount { get; set; }
+    public string Transcript { get; set; } = "";
+
+    /// <summary>
+    /// Time from the end of the recorded speech to its last final result.
+    /// </summary>
+    public TimeSpan? FinalLatency => LastFinal.HasValue ? LastFinal.Value - AudioDuration : null;
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class EngineLatencyComparison
+{
+    public EngineLatencyComparison(string name, EngineLatencyResult baseline, EngineLatencyResult candidate)
+    {
+        Name = name;
+        Baseline = baseline;
+        Candidate = candidate;
+    }
+
+    public string Name { get; }
+    public EngineLatencyResult Baseline { get; }
+    public EngineLatencyResult Candidate { get; }
+}
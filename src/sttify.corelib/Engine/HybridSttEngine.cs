@@ -0,0 +1,355 @@
+﻿using System.Buffers;
+using System.Threading.Channels;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Diagnostics;
+using Sttify.Corelib.Engine.Cloud;
+
+namespace Sttify.Corelib.Engine;
+
+/// <summary>
+/// Local-first recognition with cloud refinement. Partials and finals from the local engine are
+/// forwarded as they arrive; each final's utterance audio is then queued for the cloud engine, and
+/// <see cref="OnRefined"/> is raised when the cloud result differs. The refinement queue is bounded
+/// and drops the oldest utterance, so a slow link never holds back live capture. Engines that decode
+/// on their own thread report how far into the pushed audio each final reaches, and the utterance is
+/// cut there; audio pushed after that point carries over to the next utterance.
+/// </summary>
+public class HybridSttEngine : ISttEngine, IRefiningSttEngine, ISilenceTimeoutTunable
+{
+    private const int BytesPerSecond = 32000; // 16kHz mono 16-bit
+
+    private readonly CloudSttEngine _cloud;
+    private readonly ISttEngine _local;
+    private readonly object _lockObject = new();
+    private readonly HybridEngineSettings _settings;
+    private readonly ArrayBufferWriter<byte> _utteranceAudio = new();
+
+    private bool _cloudAvailable;
+    private long _droppedRefinements;
+    private bool _isRunning;
+    private long _nextUtteranceId;
+    private Channel<RefinementJob>? _refinementChannel;
+    private CancellationTokenSource? _refinementCancellation;
+    private Task? _refinementTask;
+    private long _bufferStart; // Offset in the pushed audio of the first buffered byte
+    private long _pushedBytes;
+    private long _refinedCount;
+    private long _utteranceStart; // Where the previous final ended
+    private bool _utteranceTruncated;
+
+    public HybridSttEngine(ISttEngine local, CloudSttEngine cloud, HybridEngineSettings settings)
+    {
+        _local = local ?? throw new ArgumentNullException(nameof(local));
+        _cloud = cloud ?? throw new ArgumentNullException(nameof(cloud));
+        _settings = settings ?? throw new ArgumentNullException(nameof(settings));
+
+        _local.OnPartial += OnLocalPartial;
+        _local.OnFinal += OnLocalFinal;
+        _local.OnError += OnLocalError;
+    }
+
+    public event EventHandler<PartialRecognitionEventArgs>? OnPartial;
+    public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
+    public event EventHandler<SttErrorEventArgs>? OnError;
+    public event EventHandler<RefinedRecognitionEventArgs>? OnRefined;
+
+    public long RefinedCount => Interlocked.Read(ref _refinedCount);
+    public long DroppedRefinements => Interlocked.Read(ref _droppedRefinements);
+
+    public int SilenceTimeoutMs
+    {
+        get => _local is ISilenceTimeoutTunable tunable ? tunable.SilenceTimeoutMs : 0;
+        set
+        {
+            if (_local is ISilenceTimeoutTunable tunable)
+            {
+                tunable.SilenceTimeoutMs = value;
+            }
+        }
+    }
+
+    public async Task StartAsync(CancellationToken cancellationToken = default)
+    {
+        lock (_lockObject)
+        {
+            if (_isRunning)
+                throw new InvalidOperationException("Hybrid engine is already running");
+        }
+
+        await _local.StartAsync(cancellationToken);
+
+        try
+        {
+            await _cloud.PrepareAsync(cancellationToken);
+            _cloudAvailable = true;
+        }
+        catch (Exception ex) when (ex is not OperationCanceledException)
+        {
+            // Local recognition carries on; finals are simply not refined
+            _cloudAvailable = false;
+            Telemetry.LogWarning("HybridCloudUnavailable", ex.Message, new { Provider = _cloud.ProviderName });
+        }
+
+        var channel = Channel.CreateBounded<RefinementJob>(
+            new BoundedChannelOptions(Math.Max(1, _settings.MaxPendingRefinements))
+            {
+                FullMode = BoundedChannelFullMode.DropOldest,
+                SingleReader = true
+            },
+            dropped =>
+            {
+                Interlocked.Increment(ref _droppedRefinements);
+                Telemetry.LogWarning("HybridRefinementDropped", "Refinement queue full, dropping oldest utterance", new { dropped.UtteranceId });
+            });
+
+        lock (_lockObject)
+        {
+            _isRunning = true;
+            _utteranceAudio.ResetWrittenCount();
+            _utteranceTruncated = false;
+            _pushedBytes = 0;
+            _bufferStart = 0;
+            _utteranceStart = 0;
+            _refinementChannel = channel;
+            _refinementCancellation = new CancellationTokenSource();
+            var token = _refinementCancellation.Token;
+            _refinementTask = Task.Run(() => RunRefinementLoopAsync(channel.Reader, token), CancellationToken.None);
+        }
+
+        Telemetry.LogEvent("HybridEngineStarted", new { Cloud = _cloud.ProviderName, CloudAvailable = _cloudAvailable });
+    }
+
+    public async Task StopAsync(CancellationToken cancellationToken = default)
+    {
+        Channel<RefinementJob>? channel;
+        CancellationTokenSource? cancellation;
+        Task? refinementTask;
+
+        lock (_lockObject)
+        {
+            if (!_isRunning)
+                return;
+
+            _isRunning = false;
+            channel = _refinementChannel;
+            cancellation = _refinementCancellation;
+            refinementTask = _refinementTask;
+            _refinementCancellation = null;
+            _refinementTask = null;
+        }
+
+        // The local engine flushes its last final on stop, which still queues a refinement
+        await _local.StopAsync(cancellationToken);
+        lock (_lockObject)
+        {
+            _refinementChannel = null;
+        }
+        channel?.Writer.TryComplete();
+
+        if (refinementTask != null)
+        {
+            // Give queued refinements a moment, then abandon whatever is still in flight
+            var finished = await Task.WhenAny(refinementTask, Task.Delay(TimeSpan.FromSeconds(Math.Max(0, _settings.StopDrainSeconds)), cancellationToken));
+            if (finished != refinementTask && cancellation != null)
+            {
+                await cancellation.CancelAsync();
+            }
+
+            try
+            {
+                await refinementTask;
+            }
+            catch (OperationCanceledException)
+            {
+                // Expected when refinements are abandoned
+            }
+        }
+
+        cancellation?.Dispose();
+
+        Telemetry.LogEvent("HybridEngineStopped", new { RefinedCount, DroppedRefinements });
+    }
+
+    public void PushAudio(ReadOnlySpan<byte> audioData)
+    {
+        lock (_lockObject)
+        {
+            if (!_isRunning)
+                return;
+
+            // Appended before the local engine sees the frame, since it may emit the final synchronously
+            _pushedBytes += audioData.Length;
+            if (!_utteranceTruncated && _utteranceAudio.WrittenCount + audioData.Length <= _settings.MaxUtteranceSeconds * BytesPerSecond)
+            {
+                audioData.CopyTo(_utteranceAudio.GetSpan(audioData.Length));
+                _utteranceAudio.Advance(audioData.Length);
+            }
+            else
+            {
+                _utteranceTruncated = true;
+            }
+        }
+
+        _local.PushAudio(audioData);
+    }
+
+    public void Dispose()
+    {
+        Dispose(true);
+        GC.SuppressFinalize(this);
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposing)
+            return;
+
+        try
+        {
+            StopAsync().Wait(TimeSpan.FromSeconds(5));
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogError("HybridEngineDisposeFailed", ex);
+        }
+
+        _local.OnPartial -= OnLocalPartial;
+        _local.OnFinal -= OnLocalFinal;
+        _local.OnError -= OnLocalError;
+        _local.Dispose();
+        _cloud.Dispose();
+    }
+
+    private void OnLocalPartial(object? sender, PartialRecognitionEventArgs e)
+    {
+        OnPartial?.Invoke(this, e);
+    }
+
+    private void OnLocalFinal(object? sender, FinalRecognitionEventArgs e)
+    {
+        RefinementJob? job = null;
+        ChannelWriter<RefinementJob>? writer;
+
+        lock (_lockObject)
+        {
+            writer = _refinementChannel?.Writer;
+
+            // Without an offset the final was raised inside PushAudio and covers everything pushed so far
+            var endOffset = Math.Clamp(e.AudioEndOffset ?? _pushedBytes, _utteranceStart, _pushedBytes);
+            var bufferedEnd = _bufferStart + _utteranceAudio.WrittenCount;
+            var audioMs = (endOffset - _utteranceStart) * 1000L / BytesPerSecond;
+
+            // An utterance missing audio at either end would come back from the cloud shorter than what was typed
+            var complete = _bufferStart == _utteranceStart && endOffset <= bufferedEnd;
+            if (_cloudAvailable && complete && audioMs >= _settings.MinUtteranceMs && !string.IsNullOrWhiteSpace(e.Text))
+            {
+                job = new RefinementJob(++_nextUtteranceId, e.Text, _utteranceAudio.WrittenSpan[..(int)(endOffset - _bufferStart)].ToArray());
+            }
+
+            _utteranceStart = endOffset;
+            DiscardBufferedAudioBefore(endOffset);
+        }
+
+        OnFinal?.Invoke(this, e);
+
+        if (job != null)
+        {
+            writer?.TryWrite(job);
+        }
+    }
+
+    private void DiscardBufferedAudioBefore(long offset)
+    {
+        var buffered = _utteranceAudio.WrittenCount;
+        var discard = (int)Math.Clamp(offset - _bufferStart, 0, buffered);
+        var remaining = buffered - discard;
+        if (remaining == 0)
+        {
+            // Audio skipped while the buffer was full is gone; buffering resumes with the next frame
+            _utteranceAudio.ResetWrittenCount();
+            _bufferStart = _pushedBytes;
+            _utteranceTruncated = false;
+            return;
+        }
+
+        // The decoder has not reached this audio yet, so it starts the next utterance
+        var tail = ArrayPool<byte>.Shared.Rent(remaining);
+        _utteranceAudio.WrittenSpan[discard..].CopyTo(tail);
+        _utteranceAudio.ResetWrittenCount();
+        tail.AsSpan(0, remaining).CopyTo(_utteranceAudio.GetSpan(remaining));
+        _utteranceAudio.Advance(remaining);
+        ArrayPool<byte>.Shared.Return(tail);
+        _bufferStart += discard;
+    }
+
+    private void OnLocalError(object? sender, SttErrorEventArgs e)
+    {
+        OnError?.Invoke(this, e);
+    }
+
+    private async Task RunRefinementLoopAsync(ChannelReader<RefinementJob> reader, CancellationToken cancellationToken)
+    {
+        await foreach (var job in reader.ReadAllAsync(cancellationToken))
+        {
+            try
+            {
+                var result = await _cloud.RecognizeSegmentAsync(job.Audio, cancellationToken);
+                if (!result.Success || string.IsNullOrWhiteSpace(result.Text))
+                    continue;
+
+                var refinedText = result.Text.Trim();
+                if (IsEquivalent(job.Text, refinedText))
+                    continue;
+
+                Interlocked.Increment(ref _refinedCount);
+                Telemetry.LogEvent("HybridFinalRefined", new
+                {
+                    job.UtteranceId,
+                    OriginalLength = job.Text.Length,
+                    RefinedLength = refinedText.Length,
+                    AudioSeconds = (double)job.Audio.Length / BytesPerSecond
+                });
+                OnRefined?.Invoke(this, new RefinedRecognitionEventArgs(job.Text, refinedText, result.Confidence));
+            }
+            catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+            {
+                throw;
+            }
+            catch (Exception ex)
+            {
+                // The local final already went out; a failed refinement just leaves it in place
+                Telemetry.LogWarning("HybridRefinementFailed", ex.Message, new { job.UtteranceId });
+            }
+        }
+    }
+
+    /// <summary>
+    /// Compares two transcripts ignoring case, whitespace and punctuation, so that a cloud result
+    /// which only adds a full stop or spacing does not trigger a visible replacement.
+    /// </summary>
+    public static bool IsEquivalent(string? local, string? refined)
+    {
+        var a = (local ?? string.Empty).AsSpan();
+        var b = (refined ?? string.Empty).AsSpan();
+        int i = 0, j = 0;
+
+        while (true)
+        {
+            while (i < a.Length && IsIgnorable(a[i])) i++;
+            while (j < b.Length && IsIgnorable(b[j])) j++;
+
+            if (i == a.Length || j == b.Length)
+                return i == a.Length && j == b.Length;
+
+            if (char.ToLowerInvariant(a[i]) != char.ToLowerInvariant(b[j]))
+                return false;
+
+            i++;
+            j++;
+        }
+    }
+
+    private static bool IsIgnorable(char c) => char.IsWhiteSpace(c) || char.IsPunctuation(c);
+
+    private sealed record RefinementJob(long UtteranceId, string Text, byte[] Audio);
+}
@@ -13,6 +13,35 @@ public interface ISttEngine : IDisposable
     void PushAudio(ReadOnlySpan<byte> audioData);
 }
 
+/// <summary>
+/// Engines with their own end-of-utterance silence detection that can be retuned between utterances.
+/// </summary>
+public interface ISilenceTimeoutTunable
+{
+    int SilenceTimeoutMs { get; set; }
+}
+
+/// <summary>
+/// Engines that may later replace a final they already delivered with a more accurate transcript.
+/// </summary>
+public interface IRefiningSttEngine
+{
+    event EventHandler<RefinedRecognitionEventArgs>? OnRefined;
+}
+
+/// <summary>
+/// Engines that decode off the capture thread, measure whether they keep up with live audio, and may
+/// move to a lighter model while they do not.
+/// </summary>
+public interface IRealTimeGovernedEngine
+{
+    event EventHandler<ModelSwitchedEventArgs>? OnModelSwitched;
+
+    double RealTimeFactor { get; } // Decode time per second of audio, over the last measurement window
+    TimeSpan QueuedAudio { get; } // Audio pushed but not yet decoded
+    bool IsUsingFallbackModel { get; }
+}
+
 [ExcludeFromCodeCoverage] // Simple DTO with no business logic
 public class PartialRecognitionEventArgs : EventArgs
 {
@@ -29,16 +58,18 @@ public class PartialRecognitionEventArgs : EventArgs
 [ExcludeFromCodeCoverage] // Simple DTO with no business logic
 public class FinalRecognitionEventArgs : EventArgs
 {
-    public FinalRecognitionEventArgs(string text, double confidence, TimeSpan duration)
+    public FinalRecognitionEventArgs(string text, double confidence, TimeSpan duration, long? audioEndOffset = null)
     {
         Text = text;
         Confidence = confidence;
         Duration = duration;
+        AudioEndOffset = audioEndOffset;
     }
 
     public string Text { get; }
     public double Confidence { get; }
     public TimeSpan Duration { get; }
+    public long? AudioEndOffset { get; } // Bytes pushed since StartAsync that the final covers; null when raised during PushAudio
 }
 
 [ExcludeFromCodeCoverage] // Simple DTO with no business logic
@@ -53,3 +84,35 @@ public class SttErrorEventArgs : EventArgs
     public Exception Exception { get; }
     public string Message { get; }
 }
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+public class RefinedRecognitionEventArgs : EventArgs
+{
+    public RefinedRecognitionEventArgs(string originalText, string refinedText, double confidence)
+    {
+        OriginalText = originalText;
+        RefinedText = refinedText;
+        Confidence = confidence;
+    }
+
+    public string OriginalText { get; } // The final text as delivered earlier
+    public string RefinedText { get; }
+    public double Confidence { get; }
+}
+
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+public class ModelSwitchedEventArgs : EventArgs
+{
+    public ModelSwitchedEventArgs(string modelPath, bool isFallback, double realTimeFactor, TimeSpan queuedAudio)
+    {
+        ModelPath = modelPath;
+        IsFallback = isFallback;
+        RealTimeFactor = realTimeFactor;
+        QueuedAudio = queuedAudio;
+    }
+
+    public string ModelPath { get; } // The model now in use
+    public bool IsFallback { get; }
+    public double RealTimeFactor { get; } // Of the model switched away from
+    public TimeSpan QueuedAudio { get; }
+}
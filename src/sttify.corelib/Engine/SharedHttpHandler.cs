@@ -0,0 +1,138 @@
+﻿using System.Diagnostics;
+using System.Net;
+using System.Net.Security;
+using System.Net.Sockets;
+using System.Runtime.CompilerServices;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Engine;
+
+/// <summary>
+/// Process-wide connection pool for HTTP-based engines. Engines create their own
+/// <see cref="HttpClient"/> (for their default headers and timeout) on top of this handler, so
+/// restarting an engine reuses pooled TCP/TLS (and HTTP/2) connections instead of handshaking again.
+/// </summary>
+public static class SharedHttpHandler
+{
+    private static readonly Lazy<SocketsHttpHandler> LazyHandler = new(CreateHandler);
+    private static readonly ConditionalWeakTable<HttpRequestMessage, ConnectTiming> ConnectTimings = new();
+
+    public static SocketsHttpHandler Handler => LazyHandler.Value;
+
+    /// <summary>
+    /// Creates a client over the shared handler that prefers HTTP/2 and falls back to HTTP/1.1.
+    /// Disposing the client leaves the pool intact.
+    /// </summary>
+    public static HttpClient CreateClient(TimeSpan timeout)
+    {
+        return new HttpClient(Handler, disposeHandler: false)
+        {
+            Timeout = timeout,
+            DefaultRequestVersion = HttpVersion.Version20,
+            DefaultVersionPolicy = HttpVersionPolicy.RequestVersionOrLower
+        };
+    }
+
+    /// <summary>
+    /// Opens (or revalidates) a pooled connection to <paramref name="endpoint"/> with a HEAD request.
+    /// Any HTTP response counts as warm; failures are logged and otherwise ignored, since the real
+    /// request will surface them.
+    /// </summary>
+    public static async Task WarmUpAsync(HttpClient client, string? endpoint, CancellationToken cancellationToken = default)
+    {
+        if (string.IsNullOrEmpty(endpoint) || !Uri.TryCreate(endpoint, UriKind.Absolute, out var uri))
+            return;
+
+        var stopwatch = Stopwatch.StartNew();
+        try
+        {
+            using var request = new HttpRequestMessage(HttpMethod.Head, new Uri(uri.GetLeftPart(UriPartial.Authority)));
+            using var response = await client.SendAsync(request, HttpCompletionOption.ResponseHeadersRead, cancellationToken).ConfigureAwait(false);
+
+            Telemetry.LogEvent("HttpWarmUpCompleted", new
+            {
+                uri.Host,
+                ElapsedMs = stopwatch.Elapsed.TotalMilliseconds,
+                HttpVersion = response.Version.ToString(),
+                StatusCode = (int)response.StatusCode
+            });
+        }
+        catch (Exception ex) when (ex is HttpRequestException or TaskCanceledException)
+        {
+            Telemetry.LogWarning("HttpWarmUpFailed", ex.Message, new { uri.Host, ElapsedMs = stopwatch.Elapsed.TotalMilliseconds });
+        }
+    }
+
+    private static SocketsHttpHandler CreateHandler()
+    {
+        return new SocketsHttpHandler
+        {
+            // Recycle connections periodically so DNS changes are picked up
+            PooledConnectionLifetime = TimeSpan.FromMinutes(10),
+            PooledConnectionIdleTimeout = TimeSpan.FromMinutes(2),
+            ConnectTimeout = TimeSpan.FromSeconds(10),
+            EnableMultipleHttp2Connections = true,
+            AutomaticDecompression = DecompressionMethods.All,
+
+            // Keep idle HTTP/2 connections alive between utterances
+            KeepAlivePingDelay = TimeSpan.FromSeconds(30),
+            KeepAlivePingTimeout = TimeSpan.FromSeconds(10),
+            KeepAlivePingPolicy = HttpKeepAlivePingPolicy.Always,
+
+            ConnectCallback = ConnectAsync,
+            PlaintextStreamFilter = OnConnectionEstablished
+        };
+    }
+
+    private static async ValueTask<Stream> ConnectAsync(SocketsHttpConnectionContext context, CancellationToken cancellationToken)
+    {
+        var stopwatch = Stopwatch.StartNew();
+        var socket = new Socket(SocketType.Stream, ProtocolType.Tcp) { NoDelay = true };
+        try
+        {
+            await socket.ConnectAsync(context.DnsEndPoint, cancellationToken).ConfigureAwait(false);
+        }
+        catch
+        {
+            socket.Dispose();
+            throw;
+        }
+
+        ConnectTimings.AddOrUpdate(context.InitialRequestMessage, new ConnectTiming(stopwatch));
+        return new NetworkStream(socket, ownsSocket: true);
+    }
+
+    /// <summary>
+    /// Runs once per new connection after TLS (if any) completes, which is where handshake cost is known.
+    /// </summary>
+    private static ValueTask<Stream> OnConnectionEstablished(SocketsHttpPlaintextStreamFilterContext context, CancellationToken cancellationToken)
+    {
+        if (ConnectTimings.TryGetValue(context.InitialRequestMessage, out var timing))
+        {
+            ConnectTimings.Remove(context.InitialRequestMessage);
+
+            var totalMs = timing.Stopwatch.Elapsed.TotalMilliseconds;
+            Telemetry.LogEvent("HttpConnectionEstablished", new
+            {
+                Host = context.InitialRequestMessage.RequestUri?.Host,
+                ConnectMs = timing.ConnectMs,
+                TlsMs = context.PlaintextStream is SslStream ? totalMs - timing.ConnectMs : 0.0,
+                HttpVersion = context.NegotiatedHttpVersion.ToString()
+            });
+        }
+
+        return ValueTask.FromResult(context.PlaintextStream);
+    }
+
+    private sealed class ConnectTiming
+    {
+        public ConnectTiming(Stopwatch stopwatch)
+        {
+            Stopwatch = stopwatch;
+            ConnectMs = stopwatch.Elapsed.TotalMilliseconds;
+        }
+
+        public Stopwatch Stopwatch { get; }
+        public double ConnectMs { get; } // DNS resolution + TCP connect
+    }
+}
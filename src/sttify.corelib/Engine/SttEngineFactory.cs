@@ -10,8 +10,12 @@ public static class SttEngineFactory
 {
     private const string AzureProvider = "azure";
     private const string GoogleProvider = "google";
+    private const string GoogleStreamingProvider = "google-streaming";
     private const string AwsProvider = "aws";
+    private const string AwsStreamingProvider = "aws-streaming";
     private const string VoskProvider = "vosk";
+    private const string HedgedProfile = "cloud-hedged";
+    private const string HybridProfile = "hybrid";
 
     public static ISttEngine CreateEngine(EngineSettings engineSettings)
     {
@@ -26,7 +30,9 @@ public static class SttEngineFactory
             "vibe" => new VibeSttEngine(engineSettings.Vibe),
             AzureProvider => new AzureSpeechEngine(engineSettings.Cloud),
             "cloud" => CreateCloudEngine(engineSettings.Cloud),
-            GoogleProvider or AwsProvider => CreateCloudEngine(engineSettings.Cloud),
+            HedgedProfile => CreateHedgedEngine(engineSettings),
+            HybridProfile => CreateHybridEngine(engineSettings),
+            GoogleProvider or GoogleStreamingProvider or AwsProvider or AwsStreamingProvider => CreateCloudEngine(engineSettings.Cloud),
             _ => FallbackToDefault(engineSettings, profile)
         };
         System.Diagnostics.Debug.WriteLine($"*** SttEngineFactory.CreateEngine - Created: {engine.GetType().Name} ***");
@@ -40,11 +46,57 @@ public static class SttEngineFactory
         {
             AzureProvider => new AzureSpeechEngine(settings),
             GoogleProvider => new GoogleCloudSpeechEngine(settings),
+            GoogleStreamingProvider => new GoogleStreamingSpeechEngine(settings),
             AwsProvider => new AwsTranscribeEngine(settings),
+            AwsStreamingProvider => new AwsTranscribeStreamingEngine(settings),
             _ => throw new ArgumentException($"Unsupported cloud provider: {settings.Provider}")
         };
     }
 
+    private static ISttEngine CreateHedgedEngine(EngineSettings engineSettings)
+    {
+        // Hedging resends whole segments, so only the request/response providers can take part
+        var primary = CreateCloudEngine(engineSettings.Cloud);
+        var secondary = CreateCloudEngine(engineSettings.Hedged.Secondary);
+        if (primary is not CloudSttEngine primaryCloud || secondary is not CloudSttEngine secondaryCloud)
+        {
+            primary.Dispose();
+            secondary.Dispose();
+            throw new ArgumentException("Hedging requires request/response providers (azure, google or aws)");
+        }
+
+        return new HedgedCloudEngine(engineSettings.Cloud, engineSettings.Hedged, primaryCloud, secondaryCloud);
+    }
+
+    private static ISttEngine CreateHybridEngine(EngineSettings engineSettings)
+    {
+        var localProfile = engineSettings.Hybrid.LocalProfile;
+        if (string.IsNullOrEmpty(localProfile) || localProfile.Equals(HybridProfile, StringComparison.OrdinalIgnoreCase))
+        {
+            localProfile = VoskProvider;
+        }
+
+        var cloud = CreateCloudEngine(engineSettings.Cloud);
+        if (cloud is not CloudSttEngine refiner)
+        {
+            cloud.Dispose();
+            throw new ArgumentException("Hybrid refinement requires a request/response provider (azure, google or aws)");
+        }
+
+        // Same settings with only the profile swapped, so the caller's object is not mutated
+        var local = CreateEngine(new EngineSettings
+        {
+            Profile = localProfile,
+            Vosk = engineSettings.Vosk,
+            Cloud = engineSettings.Cloud,
+            Vibe = engineSettings.Vibe,
+            Hedged = engineSettings.Hedged,
+            Hybrid = engineSettings.Hybrid
+        });
+
+        return new HybridSttEngine(local, refiner, engineSettings.Hybrid);
+    }
+
     private static ISttEngine CreateVoskEngine(VoskEngineSettings voskSettings)
     {
         System.Diagnostics.Debug.WriteLine($"*** CreateVoskEngine - ModelPath: '{voskSettings.ModelPath}' ***");
@@ -67,28 +119,8 @@ public static class SttEngineFactory
 
     private static bool IsValidVoskModel(string modelPath)
     {
-        if (string.IsNullOrEmpty(modelPath) || !Directory.Exists(modelPath))
-            return false;
-
-        // Check for essential Vosk model files
-        var requiredFiles = new[]
-        {
-            "am/final.mdl",          // Acoustic model
-            "graph/HCLG.fst",        // Grammar/language model
-            "graph/words.txt",       // Word list
-            "ivector/final.ie"       // ivector extractor (optional but common)
-        };
-
-        // Check if at least the core files exist
-        int foundRequiredFiles = 0;
-        foreach (var file in requiredFiles)
-        {
-            if (File.Exists(Path.Combine(modelPath, file)))
-                foundRequiredFiles++;
-        }
-
-        // We need at least the acoustic model and some language model files
-        return foundRequiredFiles >= 2;
+        // Answered from the model catalog; the model directory is only inspected the first time
+        return VoskModelCatalog.Default.GetModel(modelPath)?.IsValid == true;
     }
 
     public static string[] GetAvailableEngines()
@@ -101,6 +133,8 @@ public static class SttEngineFactory
             "vosk-mock",
             AzureProvider,
             "cloud",
+            HedgedProfile,
+            HybridProfile,
             "vibe"
         ];
     }
@@ -114,9 +148,13 @@ public static class SttEngineFactory
             "vosk-real" => "Vosk (Real implementation)",
             "vosk-mock" => "Vosk (Mock implementation for testing)",
             GoogleProvider => "Google Cloud Speech (via Cloud settings)",
+            GoogleStreamingProvider => "Google Cloud Speech Streaming (gRPC, interim results)",
             AwsProvider => "AWS Transcribe (via Cloud settings)",
+            AwsStreamingProvider => "AWS Transcribe Streaming (HTTP/2, real-time partials)",
             AzureProvider => "Azure Cognitive Services (Cloud)",
             "cloud" => "Cloud (Azure/Google/AWS via settings)",
+            HedgedProfile => "Cloud with a hedged secondary provider (first result wins)",
+            HybridProfile => "Local results immediately, refined by the cloud engine in the background",
             "vibe" => "Vibe (HTTP API-based speech recognition)",
             _ => "Unknown engine"
         };
@@ -0,0 +1,16 @@
+﻿using System.Text.Json.Serialization;
+
+namespace Sttify.Corelib.Engine.Vibe;
+
+/// <summary>
+/// Source-generated serializer for the Vibe HTTP API, so the engine works under trimming and
+/// NativeAOT. Unset request fields are left out rather than sent as null.
+/// </summary>
+[JsonSourceGenerationOptions(
+    PropertyNamingPolicy = JsonKnownNamingPolicy.CamelCase,
+    DefaultIgnoreCondition = JsonIgnoreCondition.WhenWritingNull)]
+[JsonSerializable(typeof(VibeTranscribeRequest))]
+[JsonSerializable(typeof(VibeApiResponse))]
+internal partial class VibeJsonContext : JsonSerializerContext
+{
+}
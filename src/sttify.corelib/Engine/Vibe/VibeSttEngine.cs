@@ -1,6 +1,7 @@
 ﻿using System.Diagnostics.CodeAnalysis;
 using System.Text;
 using System.Text.Json;
+using System.Text.Json.Serialization;
 using Sttify.Corelib.Config;
 using Sttify.Corelib.Diagnostics;
 
@@ -23,8 +24,7 @@ public class VibeSttEngine : ISttEngine
     public VibeSttEngine(VibeEngineSettings settings)
     {
         _settings = settings ?? throw new ArgumentNullException(nameof(settings));
-        _httpClient = new HttpClient();
-        _httpClient.Timeout = TimeSpan.FromSeconds(_settings.TimeoutSeconds);
+        _httpClient = SharedHttpHandler.CreateClient(TimeSpan.FromSeconds(_settings.TimeoutSeconds));
 
         if (!string.IsNullOrEmpty(_settings.ApiKey))
         {
@@ -46,6 +46,9 @@ public class VibeSttEngine : ISttEngine
             // Note: Skip health check for now since /health endpoint may not exist in all Vibe deployments
             System.Diagnostics.Debug.WriteLine("*** VibeSttEngine.StartAsync - Skipping health check, proceeding with startup ***");
 
+            // Open the connection in the background so the first transcription skips the handshake
+            AsyncHelper.FireAndForget(() => SharedHttpHandler.WarmUpAsync(_httpClient, _settings.Endpoint, cancellationToken), "VibeWarmUp");
+
             lock (_lockObject)
             {
                 _isRunning = true;
@@ -237,16 +240,16 @@ public class VibeSttEngine : ISttEngine
                 await File.WriteAllBytesAsync(tempAudioFile, CreateWavFile(audioData), cancellationToken);
 
                 // Create JSON request matching Vibe API
-                var requestBody = new
+                var requestBody = new VibeTranscribeRequest
                 {
-                    path = tempAudioFile,
-                    language = !string.IsNullOrEmpty(_settings.Language) ? _settings.Language : (object?)null,
-                    model = !string.IsNullOrEmpty(_settings.Model) ? _settings.Model : (object?)null,
-                    diarization = _settings.EnableDiarization,
-                    output_format = _settings.OutputFormat
+                    Path = tempAudioFile,
+                    Language = !string.IsNullOrEmpty(_settings.Language) ? _settings.Language : null,
+                    Model = !string.IsNullOrEmpty(_settings.Model) ? _settings.Model : null,
+                    Diarization = _settings.EnableDiarization,
+                    OutputFormat = _settings.OutputFormat
                 };
 
-                var jsonContent = JsonSerializer.Serialize(requestBody, new JsonSerializerOptions { DefaultIgnoreCondition = System.Text.Json.Serialization.JsonIgnoreCondition.WhenWritingNull });
+                var jsonContent = JsonSerializer.Serialize(requestBody, VibeJsonContext.Default.VibeTranscribeRequest);
                 var content = new StringContent(jsonContent, Encoding.UTF8, "application/json");
 
                 var endpoint = $"{_settings.Endpoint.TrimEnd('/')}/transcribe";
@@ -257,10 +260,7 @@ public class VibeSttEngine : ISttEngine
                 var jsonResponse = await response.Content.ReadAsStringAsync(cancellationToken);
                 System.Diagnostics.Debug.WriteLine($"*** Vibe response: {jsonResponse} ***");
 
-                var result = JsonSerializer.Deserialize<VibeApiResponse>(jsonResponse, new JsonSerializerOptions
-                {
-                    PropertyNamingPolicy = JsonNamingPolicy.CamelCase
-                });
+                var result = JsonSerializer.Deserialize(jsonResponse, VibeJsonContext.Default.VibeApiResponse);
 
                 return new VibeTranscriptionResult
                 {
@@ -409,6 +409,18 @@ public class VibeTranscriptionResult
     public VibeSegment[] Segments { get; set; } = Array.Empty<VibeSegment>();
 }
 
+[ExcludeFromCodeCoverage] // Simple DTO with no business logic
+internal class VibeTranscribeRequest
+{
+    public string Path { get; set; } = "";
+    public string? Language { get; set; }
+    public string? Model { get; set; }
+    public bool Diarization { get; set; }
+
+    [JsonPropertyName("output_format")]
+    public string? OutputFormat { get; set; }
+}
+
 public class VibeApiResponse
 {
     public string? Text { get; set; }
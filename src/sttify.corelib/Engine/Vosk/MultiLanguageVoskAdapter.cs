@@ -1,6 +1,7 @@
 ﻿using System.Text.Json;
 using Sttify.Corelib.Config;
 using Sttify.Corelib.Diagnostics;
+using Sttify.Corelib.Text;
 using Vosk;
 
 namespace Sttify.Corelib.Engine.Vosk;
@@ -201,7 +202,7 @@ public class MultiLanguageVoskAdapter : ISttEngine
                     {
                         Language = modelInfo.Key,
                         ModelPath = modelInfo.Value,
-                        ModelSize = GetDirectorySize(modelInfo.Value)
+                        ModelSize = VoskModelCatalog.Default.GetModel(modelInfo.Value)?.SizeBytes ?? 0
                     });
                 }
                 catch (Exception ex)
@@ -235,70 +236,29 @@ public class MultiLanguageVoskAdapter : ISttEngine
         if (string.IsNullOrEmpty(_settings.ModelPath))
             return modelPaths;
 
+        var catalog = VoskModelCatalog.Default;
+
         // Check if ModelPath is a direct model directory
-        if (IsValidModelDirectory(_settings.ModelPath))
+        var model = catalog.GetModel(_settings.ModelPath);
+        if (model is { IsValid: true })
         {
-            var language = DetectModelLanguage(_settings.ModelPath);
-            modelPaths[language] = _settings.ModelPath;
+            modelPaths[GetModelLanguage(model)] = _settings.ModelPath;
             return modelPaths;
         }
 
         // Check if ModelPath is a parent directory containing multiple models
-        if (Directory.Exists(_settings.ModelPath))
+        foreach (var installed in catalog.GetModels(_settings.ModelPath))
         {
-            var subdirectories = Directory.GetDirectories(_settings.ModelPath);
-            foreach (var subdir in subdirectories)
-            {
-                if (IsValidModelDirectory(subdir))
-                {
-                    var language = DetectModelLanguage(subdir);
-                    modelPaths[language] = subdir;
-                }
-            }
+            modelPaths[GetModelLanguage(installed)] = installed.Path;
         }
 
         return modelPaths;
     }
 
-    private bool IsValidModelDirectory(string path)
-    {
-        if (!Directory.Exists(path))
-            return false;
-
-        var requiredFiles = new[]
-        {
-            "am/final.mdl",
-            "graph/HCLG.fst",
-            "graph/words.txt"
-        };
-
-        return requiredFiles.All(file => File.Exists(Path.Combine(path, file)));
-    }
-
-    private string DetectModelLanguage(string modelPath)
+    private string GetModelLanguage(VoskModelEntry model)
     {
-        var modelName = Path.GetFileName(modelPath).ToLowerInvariant();
-
-        // Try to detect language from model directory name
-        if (modelName.Contains("-ja-") || modelName.Contains("japanese"))
-            return "ja";
-        if (modelName.Contains("-en-") || modelName.Contains("english"))
-            return "en";
-        if (modelName.Contains("-zh-") || modelName.Contains("chinese"))
-            return "zh";
-        if (modelName.Contains("-ko-") || modelName.Contains("korean"))
-            return "ko";
-        if (modelName.Contains("-es-") || modelName.Contains("spanish"))
-            return "es";
-        if (modelName.Contains("-fr-") || modelName.Contains("french"))
-            return "fr";
-        if (modelName.Contains("-de-") || modelName.Contains("german"))
-            return "de";
-        if (modelName.Contains("-ru-") || modelName.Contains("russian"))
-            return "ru";
-
-        // Default to the configured language or 'unknown'
-        return _settings.Language;
+        // Default to the configured language when the model name does not reveal it
+        return !string.IsNullOrEmpty(model.Language) ? model.Language : _settings.Language;
     }
 
     private async Task ProcessAudioLoop(CancellationToken cancellationToken)
@@ -361,7 +321,7 @@ public class MultiLanguageVoskAdapter : ISttEngine
             if (string.IsNullOrEmpty(jsonResult))
                 return;
 
-            var result = JsonSerializer.Deserialize<VoskResult>(jsonResult);
+            var result = JsonSerializer.Deserialize(jsonResult, VoskJsonContext.Default.VoskResult);
             if (result == null)
                 return;
 
@@ -369,8 +329,8 @@ public class MultiLanguageVoskAdapter : ISttEngine
             if (string.IsNullOrEmpty(text))
                 return;
 
-            // Apply language-specific post-processing
-            text = ApplyLanguageSpecificProcessing(text, _currentLanguage);
+            // Apply language-specific post-processing; sentences are only closed on finals
+            text = TextNormalizer.ForLanguage(_currentLanguage).Normalize(text, isFinal && _settings.Punctuation);
 
             var confidence = result.Confidence ?? 0.0;
 
@@ -400,70 +360,7 @@ public class MultiLanguageVoskAdapter : ISttEngine
         }
     }
 
-    private string ApplyLanguageSpecificProcessing(string text, string language)
-    {
-        if (string.IsNullOrEmpty(text) || !_settings.Punctuation)
-            return text;
-
-        return language switch
-        {
-            "ja" => ApplyJapanesePunctuation(text),
-            "zh" => ApplyChinesePunctuation(text),
-            "en" => ApplyEnglishPunctuation(text),
-            _ => ApplyDefaultPunctuation(text)
-        };
-    }
-
-    private string ApplyJapanesePunctuation(string text)
-    {
-        if (!text.EndsWith("。") && !text.EndsWith("？") && !text.EndsWith("！"))
-        {
-            text += "。";
-        }
-        return text;
-    }
-
-    private string ApplyChinesePunctuation(string text)
-    {
-        if (!text.EndsWith("。") && !text.EndsWith("？") && !text.EndsWith("！"))
-        {
-            text += "。";
-        }
-        return text;
-    }
-
-    private string ApplyEnglishPunctuation(string text)
-    {
-        if (!text.EndsWith(".") && !text.EndsWith("?") && !text.EndsWith("!"))
-        {
-            text += ".";
-        }
-        return text;
-    }
-
-    private string ApplyDefaultPunctuation(string text)
-    {
-        if (!text.EndsWith(".") && !text.EndsWith("。"))
-        {
-            text += ".";
-        }
-        return text;
-    }
-
-    private long GetDirectorySize(string directoryPath)
-    {
-        try
-        {
-            var directoryInfo = new DirectoryInfo(directoryPath);
-            return directoryInfo.GetFiles("*", SearchOption.AllDirectories).Sum(file => file.Length);
-        }
-        catch
-        {
-            return 0;
-        }
-    }
-
-    private class VoskResult
+    internal class VoskResult
     {
         public string? Text { get; set; }
         public double? Confidence { get; set; }
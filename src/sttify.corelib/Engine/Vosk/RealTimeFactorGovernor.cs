@@ -0,0 +1,184 @@
+﻿using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Engine.Vosk;
+
+public enum ModelTier
+{
+    Primary,
+    Fallback
+}
+
+/// <summary>
+/// Decides when a recognizer that cannot keep up with live audio should move to a smaller model,
+/// and when it may move back. Decode time is measured against audio time in fixed windows of audio:
+/// a sustained real-time factor above <see cref="RealTimeFactorGovernorSettings.DowngradeRtf"/>, or
+/// a backlog beyond <see cref="RealTimeFactorGovernorSettings.MaxQueuedAudioMs"/>, asks for the
+/// fallback. On the fallback, the primary model's cost is estimated from the ratio of the two
+/// models' RTF measured around the switch; once that estimate stays under
+/// <see cref="RealTimeFactorGovernorSettings.UpgradeRtf"/> long enough it asks to go back. Switching
+/// back and falling behind again soon after doubles the wait next time. The caller performs
+/// switches at utterance boundaries and reports them with <see cref="OnSwitched"/>. Not thread-safe.
+/// </summary>
+public sealed class RealTimeFactorGovernor
+{
+    private readonly RealTimeFactorGovernorSettings _settings;
+
+    private double _fallbackCostRatio; // Primary RTF over fallback RTF; 0 until measured
+    private int _fastWindows;
+    private double _primaryRtfAtDowngrade;
+    private int _slowWindows;
+    private int _upgradeWindows;
+    private TimeSpan _windowAudio;
+    private TimeSpan _windowDecode;
+    private int _windowsSinceUpgrade = int.MaxValue;
+
+    public RealTimeFactorGovernor(RealTimeFactorGovernorSettings settings)
+    {
+        _settings = settings ?? throw new ArgumentNullException(nameof(settings));
+        _upgradeWindows = Math.Max(1, _settings.UpgradeWindows);
+    }
+
+    public ModelTier ActiveTier { get; private set; } = ModelTier.Primary;
+    public ModelTier TargetTier { get; private set; } = ModelTier.Primary;
+    public bool SwitchPending => TargetTier != ActiveTier;
+
+    public double RealTimeFactor { get; private set; } // Of the active model, over the last full window
+    public double MaxRealTimeFactor { get; private set; }
+    public double EstimatedPrimaryRealTimeFactor => ActiveTier == ModelTier.Primary ? RealTimeFactor : RealTimeFactor * _fallbackCostRatio;
+    public TimeSpan QueuedAudio { get; private set; }
+    public TimeSpan MaxQueuedAudio { get; private set; }
+    public int Downgrades { get; private set; }
+    public int Upgrades { get; private set; }
+    public int CurrentUpgradeWindows => _upgradeWindows;
+    public bool FallbackAvailable { get; private set; } = true;
+
+    /// <summary>
+    /// Records one decode call: how much audio it took, how long it ran, and how much audio is
+    /// still waiting behind it.
+    /// </summary>
+    public void RecordDecode(TimeSpan audio, TimeSpan decodeTime, TimeSpan queuedAudio)
+    {
+        QueuedAudio = queuedAudio;
+        if (queuedAudio > MaxQueuedAudio)
+        {
+            MaxQueuedAudio = queuedAudio;
+        }
+
+        _windowAudio += audio;
+        _windowDecode += decodeTime;
+
+        // A backlog this large means latency is already growing; do not wait for more windows
+        if (ActiveTier == ModelTier.Primary && FallbackAvailable && queuedAudio.TotalMilliseconds >= _settings.MaxQueuedAudioMs)
+        {
+            TargetTier = ModelTier.Fallback;
+        }
+
+        if (_windowAudio.TotalMilliseconds < _settings.WindowMs)
+            return;
+
+        var rtf = _windowDecode.TotalSeconds / _windowAudio.TotalSeconds;
+        _windowAudio = TimeSpan.Zero;
+        _windowDecode = TimeSpan.Zero;
+        RealTimeFactor = rtf;
+        MaxRealTimeFactor = Math.Max(MaxRealTimeFactor, rtf);
+
+        if (ActiveTier == ModelTier.Primary)
+        {
+            if (_windowsSinceUpgrade < int.MaxValue)
+            {
+                _windowsSinceUpgrade++;
+            }
+
+            _slowWindows = rtf > _settings.DowngradeRtf ? _slowWindows + 1 : 0;
+            if (_slowWindows >= Math.Max(1, _settings.SustainWindows) && FallbackAvailable)
+            {
+                TargetTier = ModelTier.Fallback;
+            }
+            return;
+        }
+
+        // The first window on the fallback runs under the same load that slowed the primary down
+        if (_fallbackCostRatio == 0)
+        {
+            _fallbackCostRatio = Math.Max(1.0, _primaryRtfAtDowngrade / Math.Max(rtf, 1e-3));
+        }
+
+        var caughtUp = QueuedAudio.TotalMilliseconds < _settings.WindowMs;
+        _fastWindows = caughtUp && EstimatedPrimaryRealTimeFactor < _settings.UpgradeRtf ? _fastWindows + 1 : 0;
+        if (_fastWindows >= _upgradeWindows)
+        {
+            TargetTier = ModelTier.Primary;
+        }
+    }
+
+    /// <summary>
+    /// Tells the governor the caller has switched to <paramref name="tier"/>.
+    /// </summary>
+    public void OnSwitched(ModelTier tier)
+    {
+        if (tier == ActiveTier)
+            return;
+
+        if (tier == ModelTier.Fallback)
+        {
+            var partialRtf = _windowAudio > TimeSpan.Zero ? _windowDecode.TotalSeconds / _windowAudio.TotalSeconds : 0.0;
+            _primaryRtfAtDowngrade = Math.Max(Math.Max(RealTimeFactor, partialRtf), _settings.DowngradeRtf);
+            _fallbackCostRatio = 0;
+            if (_windowsSinceUpgrade < _settings.FlapWindows)
+            {
+                _upgradeWindows = Math.Min(_upgradeWindows * 2, Math.Max(_settings.UpgradeWindows, _settings.MaxUpgradeWindows));
+            }
+            Downgrades++;
+        }
+        else
+        {
+            _windowsSinceUpgrade = 0;
+            Upgrades++;
+        }
+
+        ActiveTier = tier;
+        TargetTier = tier;
+        _slowWindows = 0;
+        _fastWindows = 0;
+        _windowAudio = TimeSpan.Zero;
+        _windowDecode = TimeSpan.Zero;
+    }
+
+    /// <summary>
+    /// Tells the governor whether there is a fallback to switch to. Without one (none configured,
+    /// or it failed to load) a pending downgrade is dropped and no new one is requested.
+    /// </summary>
+    public void SetFallbackAvailable(bool available)
+    {
+        FallbackAvailable = available;
+        if (!available && TargetTier == ModelTier.Fallback && ActiveTier == ModelTier.Primary)
+        {
+            CancelSwitch();
+        }
+    }
+
+    /// <summary>
+    /// Drops a pending switch the caller cannot make, e.g. because the fallback model failed to load.
+    /// </summary>
+    public void CancelSwitch()
+    {
+        TargetTier = ActiveTier;
+        _slowWindows = 0;
+        _fastWindows = 0;
+    }
+}
+
+[ExcludeFromCodeCoverage] // Configuration class with no business logic
+public class RealTimeFactorGovernorSettings
+{
+    public bool Enabled { get; set; } = false;
+    public string FallbackModelPath { get; set; } = ""; // Smaller model, preloaded in the background, used while the configured one cannot keep up
+    public int WindowMs { get; set; } = 2000; // Audio per real-time factor measurement
+    public double DowngradeRtf { get; set; } = 1.0;
+    public int SustainWindows { get; set; } = 2; // Consecutive slow windows before downgrading
+    public int MaxQueuedAudioMs { get; set; } = 3000; // Backlog that downgrades immediately
+    public double UpgradeRtf { get; set; } = 0.7; // Estimated primary-model RTF needed to switch back
+    public int UpgradeWindows { get; set; } = 10; // Consecutive fast windows before switching back
+    public int MaxUpgradeWindows { get; set; } = 160;
+    public int FlapWindows { get; set; } = 30; // Falling behind again within this many windows of switching back doubles UpgradeWindows
+}
@@ -1,44 +1,99 @@
-﻿using System.Text;
+﻿using System.Buffers;
+using System.Diagnostics;
+using System.Text;
 using System.Text.Json;
+using System.Threading.Channels;
+using Sttify.Corelib.Audio;
 using Sttify.Corelib.Config;
 using Sttify.Corelib.Diagnostics;
-using Vosk;
+using Sttify.Corelib.Text;
 
 namespace Sttify.Corelib.Engine.Vosk;
 
-public class RealVoskEngineAdapter : ISttEngine
+/// <summary>
+/// Streaming Vosk engine. Audio is copied into a queue and decoded on a dedicated thread, so a model
+/// that runs slower than real time delays results instead of stalling capture. The queue holds at
+/// most twice <see cref="RealTimeFactorGovernorSettings.MaxQueuedAudioMs"/> of audio; beyond that the
+/// oldest audio is dropped. A <see cref="RealTimeFactorGovernor"/> watches decode speed and backlog
+/// and, when enabled with a fallback model, swaps to it (and back) at utterance boundaries.
+/// </summary>
+public class RealVoskEngineAdapter : ISttEngine, ISilenceTimeoutTunable, IRealTimeGovernedEngine
 {
     private const int SilenceThresholdMs = 800; // 800ms of silence to trigger processing
     private const double VoiceThreshold = 0.005; // Minimum voice level threshold (raised to allow silence detection)
+    private readonly Action<ReadOnlyMemory<byte>> _decodeChunk;
+    private readonly FrameRechunker? _decodeChunker;
+    private readonly RealTimeFactorGovernor _governor;
     private readonly object _lockObject = new();
 
+    private readonly TextNormalizer _normalizer;
     private readonly VoskEngineSettings _settings;
     private readonly System.Timers.Timer _silenceTimer;
 
     // Track last partial text to avoid duplicate events
     private string _currentPartialText = string.Empty;
+    private CancellationTokenSource? _decodeCts;
+    private Task? _decodeLoop;
+    private Channel<DecodeItem>? _decodeQueue;
+    private long _decodedOffset; // Decode thread only: end of the audio handed to the recognizer
+    private long _droppedBytes;
+    private int _droppedFinalize; // 1 when a finalize marker was dropped; the decode thread finalizes before its next audio
+    private int _dropWarningLogged;
+    private volatile bool _fallbackLoadFailed;
+    private VoskNativeModel? _fallbackModel;
+    private RecognizerPool<VoskNativeRecognizer>? _fallbackPool;
+    private VoskNativeRecognizer? _fallbackRecognizer;
     private int _frameCount;
     private bool _isRunning;
 
     // Voice Activity Detection (VAD) - for forced finalization on silence
     private bool _isSpeaking;
-    private Model? _model;
+    private byte[] _lastPartialJson = [];
+    private int _lastPartialJsonLength;
+    private VoskNativeModel? _model;
+    private VoskNativeRecognizer? _primaryRecognizer;
+    private long _pushedBytes;
+    private long _queuedBytes;
     private DateTime _recognitionStartTime;
-    private VoskRecognizer? _recognizer;
+    private VoskNativeRecognizer? _recognizer; // The active one, primary or fallback; only the decode thread uses it once started
+    private RecognizerPool<VoskNativeRecognizer>? _recognizerPool;
 
     public RealVoskEngineAdapter(VoskEngineSettings settings)
     {
         _settings = settings ?? throw new ArgumentNullException(nameof(settings));
+        _normalizer = TextNormalizer.ForLanguage(_settings.Language);
+
+        // With 10-30ms capture frames, per-call decoder overhead dominates; batching frames trades
+        // a little partial latency for fewer AcceptWaveform calls
+        _decodeChunk = chunk => Decode(chunk.Span);
+        if (_settings.DecodeChunkMs > 0)
+        {
+            _decodeChunker = new FrameRechunker(FrameRechunker.GetFrameBytes(_settings.SampleRate, 1, 16, _settings.DecodeChunkMs));
+        }
+
+        _governor = new RealTimeFactorGovernor(_settings.Governor);
 
         // Initialize silence timer for VAD
-        _silenceTimer = new System.Timers.Timer(SilenceThresholdMs);
+        _silenceTimer = new System.Timers.Timer(_settings.EndpointSilenceMs > 0 ? _settings.EndpointSilenceMs : SilenceThresholdMs);
         _silenceTimer.Elapsed += OnSilenceDetected;
         _silenceTimer.AutoReset = false; // Only trigger once per silence period
     }
 
+    public int SilenceTimeoutMs
+    {
+        get => (int)_silenceTimer.Interval;
+        set => _silenceTimer.Interval = Math.Max(1, value);
+    }
+
+    public double RealTimeFactor => _governor.RealTimeFactor;
+    public TimeSpan QueuedAudio => BytesToDuration(Interlocked.Read(ref _queuedBytes));
+    public TimeSpan DroppedAudio => BytesToDuration(Interlocked.Read(ref _droppedBytes));
+    public bool IsUsingFallbackModel => _governor.ActiveTier == ModelTier.Fallback;
+
     public event EventHandler<PartialRecognitionEventArgs>? OnPartial;
     public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
     public event EventHandler<SttErrorEventArgs>? OnError;
+    public event EventHandler<ModelSwitchedEventArgs>? OnModelSwitched;
 
     public async Task StartAsync(CancellationToken cancellationToken = default)
     {
@@ -53,10 +108,18 @@ public class RealVoskEngineAdapter : ISttEngine
             {
                 _isRunning = true;
                 _recognitionStartTime = DateTime.UtcNow;
+                _pushedBytes = 0;
+                _decodedOffset = 0;
+                // The decode queue is sized from the first frame, so it starts with PushAudio
+                _decodeQueue = null;
+                _decodeLoop = null;
+                _decodeCts?.Dispose();
+                _decodeCts = new CancellationTokenSource();
             }
 
-            // Create a streaming recognizer
-            CreateStreamingRecognizer();
+            // Create a streaming recognizer; a spare is built in the background
+            CreateRecognizerPool();
+            PreloadFallbackModel();
 
             System.Diagnostics.Debug.WriteLine("*** Voice Activity Detection (VAD) Vosk Engine Started ***");
 
@@ -65,6 +128,9 @@ public class RealVoskEngineAdapter : ISttEngine
                 _settings.ModelPath,
                 _settings.Language,
                 _settings.Punctuation,
+                _settings.DecodeChunkMs,
+                GovernorEnabled = _settings.Governor.Enabled,
+                _settings.Governor.FallbackModelPath,
                 VadEnabled = true
             });
         }
@@ -76,12 +142,12 @@ public class RealVoskEngineAdapter : ISttEngine
         }
     }
 
-    public Task StopAsync(CancellationToken cancellationToken = default)
+    public async Task StopAsync(CancellationToken cancellationToken = default)
     {
         lock (_lockObject)
         {
             if (!_isRunning)
-                return Task.CompletedTask;
+                return;
 
             _isRunning = false;
         }
@@ -89,12 +155,29 @@ public class RealVoskEngineAdapter : ISttEngine
         // Stop VAD timer
         _silenceTimer.Stop();
 
-        // Flush any pending result
+        // Flush any pending result once the queued audio has been decoded; cancelling skips the
+        // (bounded) backlog instead
         ForceFinalizeRecognition();
+        _decodeQueue?.Writer.TryComplete();
+        if (_decodeLoop != null)
+        {
+            var decodeCts = _decodeCts;
+            using var registration = cancellationToken.Register(() => decodeCts?.Cancel());
+            await _decodeLoop.ConfigureAwait(false);
+        }
 
-        Telemetry.LogEvent("VoskEngineStopped");
-
-        return Task.CompletedTask;
+        Telemetry.LogEvent("VoskEngineStopped", new
+        {
+            RecognizerResets = _recognizerPool?.ResetCount ?? 0,
+            RecognizerConstructions = _recognizerPool?.ConstructionCount ?? 0,
+            AverageConstructionMs = _recognizerPool?.AverageConstructionMs ?? 0.0,
+            _governor.RealTimeFactor,
+            _governor.MaxRealTimeFactor,
+            MaxQueuedAudioMs = _governor.MaxQueuedAudio.TotalMilliseconds,
+            DroppedAudioMs = DroppedAudio.TotalMilliseconds,
+            _governor.Downgrades,
+            _governor.Upgrades
+        });
     }
 
     public void PushAudio(ReadOnlySpan<byte> audioData)
@@ -102,10 +185,17 @@ public class RealVoskEngineAdapter : ISttEngine
         if (!_isRunning || audioData.IsEmpty)
             return;
 
+        // Capture frames are only valid during the call; the copy is returned to the pool once decoded
+        var buffer = ArrayPool<byte>.Shared.Rent(audioData.Length);
+        audioData.CopyTo(buffer);
+
         lock (_lockObject)
         {
             if (!_isRunning)
+            {
+                ArrayPool<byte>.Shared.Return(buffer);
                 return;
+            }
 
             // Calculate audio level for Voice Activity Detection
             double audioLevel = CalculateAudioLevel(audioData);
@@ -134,46 +224,178 @@ public class RealVoskEngineAdapter : ISttEngine
                 _silenceTimer.Start();
             }
 
-            // Stream audio to Vosk recognizer for partial/final results
-            if (_recognizer != null)
+            // Enqueued under the lock so a finalization requested by the silence timer lands in order
+            var queue = _decodeQueue ??= StartDecodeLoop(audioData.Length);
+            _pushedBytes += audioData.Length;
+            Interlocked.Add(ref _queuedBytes, audioData.Length);
+            if (!queue.Writer.TryWrite(new DecodeItem(buffer, audioData.Length, _pushedBytes)))
+            {
+                Interlocked.Add(ref _queuedBytes, -audioData.Length);
+                ArrayPool<byte>.Shared.Return(buffer);
+            }
+        }
+    }
+
+    private Channel<DecodeItem> StartDecodeLoop(int frameBytes)
+    {
+        // Twice the governor's immediate-downgrade backlog, so the governor reacts before audio is lost
+        var maxQueuedBytes = 2L * Math.Max(1, _settings.Governor.MaxQueuedAudioMs) * (_settings.SampleRate > 0 ? _settings.SampleRate : 16000) * 2 / 1000;
+        var capacity = (int)Math.Clamp(maxQueuedBytes / Math.Max(1, frameBytes), 2, 10_000) + 1; // Room for a finalize marker
+        var queue = Channel.CreateBounded<DecodeItem>(new BoundedChannelOptions(capacity)
+        {
+            FullMode = BoundedChannelFullMode.DropOldest,
+            SingleReader = true,
+            SingleWriter = true // PushAudio and ForceFinalizeRecognition write under _lockObject
+        }, OnDecodeItemDropped);
+        var cancellationToken = _decodeCts?.Token ?? CancellationToken.None;
+        _decodeLoop = Task.Factory.StartNew(() => RunDecodeLoop(queue.Reader, cancellationToken), CancellationToken.None,
+            TaskCreationOptions.LongRunning, TaskScheduler.Default);
+        return queue;
+    }
+
+    private void OnDecodeItemDropped(DecodeItem item)
+    {
+        if (item.Buffer == null)
+        {
+            Interlocked.Exchange(ref _droppedFinalize, 1);
+            return;
+        }
+
+        Interlocked.Add(ref _queuedBytes, -item.Length);
+        var dropped = Interlocked.Add(ref _droppedBytes, item.Length);
+        ArrayPool<byte>.Shared.Return(item.Buffer);
+
+        // Once per overload episode; reset when the decode thread catches up
+        if (Interlocked.Exchange(ref _dropWarningLogged, 1) == 0)
+        {
+            Telemetry.LogWarning("VoskDecodeBacklogDropped", "Decoding fell behind capture; dropping the oldest queued audio", new
             {
-                try
+                MaxQueuedAudioMs = _settings.Governor.MaxQueuedAudioMs * 2,
+                TotalDroppedMs = BytesToDuration(dropped).TotalMilliseconds,
+                GovernorEnabled = _settings.Governor.Enabled
+            });
+        }
+    }
+
+    private void RunDecodeLoop(ChannelReader<DecodeItem> reader, CancellationToken cancellationToken)
+    {
+        try
+        {
+            // Synchronous waits keep decoding on this one dedicated thread
+            while (reader.WaitToReadAsync(cancellationToken).AsTask().GetAwaiter().GetResult())
+            {
+                while (!cancellationToken.IsCancellationRequested && reader.TryRead(out var item))
                 {
-                    bool hasResult = _recognizer.AcceptWaveform(audioData.ToArray(), audioData.Length);
-                    if (hasResult)
+                    // The marker was dropped with the oldest audio; the utterance still ends before this item
+                    if (Interlocked.Exchange(ref _droppedFinalize, 0) == 1)
                     {
-                        var resultJson = _recognizer.Result();
-                        ProcessVoskResult(resultJson);
-                        _recognitionStartTime = DateTime.UtcNow;
-                        _currentPartialText = string.Empty;
+                        FinalizeUtterance();
                     }
-                    else
+
+                    if (item.Buffer == null)
                     {
-                        var partialJson = _recognizer.PartialResult();
-                        var partialText = ExtractPartialText(partialJson);
-                        var normalizedPartial = NormalizeJapaneseSpacing(partialText);
-                        if (!string.IsNullOrWhiteSpace(normalizedPartial) && !string.Equals(normalizedPartial, _currentPartialText, StringComparison.Ordinal))
+                        FinalizeUtterance();
+                        continue;
+                    }
+
+                    try
+                    {
+                        var started = Stopwatch.GetTimestamp();
+                        var audio = item.Buffer.AsSpan(0, item.Length);
+
+                        // Where this item starts in the pushed stream, less what the chunker still holds;
+                        // dropped items leave a gap the offset skips over
+                        _decodedOffset = item.EndOffset - item.Length - (_decodeChunker?.PendingBytes ?? 0);
+                        if (_decodeChunker != null)
                         {
-                            _currentPartialText = normalizedPartial;
-                            OnPartial?.Invoke(this, new PartialRecognitionEventArgs(normalizedPartial, 0.5));
+                            _decodeChunker.Write(audio, _decodeChunk);
                         }
+                        else
+                        {
+                            Decode(audio);
+                        }
+
+                        var queuedBytes = Interlocked.Add(ref _queuedBytes, -item.Length);
+                        if (queuedBytes == 0)
+                        {
+                            Volatile.Write(ref _dropWarningLogged, 0);
+                        }
+                        _governor.RecordDecode(BytesToDuration(item.Length), Stopwatch.GetElapsedTime(started), BytesToDuration(queuedBytes));
+                    }
+                    finally
+                    {
+                        ArrayPool<byte>.Shared.Return(item.Buffer);
                     }
                 }
-                catch (Exception ex)
+
+                cancellationToken.ThrowIfCancellationRequested();
+            }
+        }
+        catch (OperationCanceledException)
+        {
+            // Stopped or disposed with audio still queued
+        }
+        finally
+        {
+            // Anything left goes back to the pool undecoded; the writer is completed before cancelling
+            while (reader.TryRead(out var item))
+            {
+                if (item.Buffer != null)
+                {
+                    Interlocked.Add(ref _queuedBytes, -item.Length);
+                    ArrayPool<byte>.Shared.Return(item.Buffer);
+                }
+            }
+        }
+    }
+
+    private void Decode(ReadOnlySpan<byte> audio)
+    {
+        if (_recognizer == null)
+            return;
+
+        try
+        {
+            // The span is pinned for the native call, and results are read in place as UTF-8
+            _decodedOffset += audio.Length;
+            bool hasResult = _recognizer.AcceptWaveform(audio);
+            if (hasResult)
+            {
+                ProcessVoskResult(_recognizer.Result());
+                _recognitionStartTime = DateTime.UtcNow;
+                _currentPartialText = string.Empty;
+                _lastPartialJsonLength = 0;
+                ApplyPendingModelSwitch();
+            }
+            else
+            {
+                var partialJson = _recognizer.PartialResult();
+                if (!RememberPartialJson(partialJson))
+                    return;
+
+                var partialText = ExtractPartialText(partialJson);
+                var normalizedPartial = _normalizer.Normalize(partialText);
+                if (!string.IsNullOrWhiteSpace(normalizedPartial) && !string.Equals(normalizedPartial, _currentPartialText, StringComparison.Ordinal))
                 {
-                    System.Diagnostics.Debug.WriteLine($"*** VoskEngineAdapter - Error processing streaming audio: {ex.Message} ***");
-                    OnError?.Invoke(this, new SttErrorEventArgs(ex, $"Error processing audio: {ex.Message}"));
+                    _currentPartialText = normalizedPartial;
+                    OnPartial?.Invoke(this, new PartialRecognitionEventArgs(normalizedPartial, 0.5));
                 }
             }
         }
+        catch (Exception ex)
+        {
+            System.Diagnostics.Debug.WriteLine($"*** VoskEngineAdapter - Error processing streaming audio: {ex.Message} ***");
+            OnError?.Invoke(this, new SttErrorEventArgs(ex, $"Error processing audio: {ex.Message}"));
+        }
     }
 
     public void Dispose()
     {
         try
         {
-            // Avoid potential deadlock by running stop without capturing context and with a short timeout
-            Task.Run(async () => await StopAsync().ConfigureAwait(false)).Wait(TimeSpan.FromSeconds(3));
+            // Avoid potential deadlock by running stop without capturing context and with a short timeout.
+            // The cancelled token returns queued audio to the pool instead of decoding it.
+            Task.Run(async () => await StopAsync(new CancellationToken(canceled: true)).ConfigureAwait(false)).Wait(TimeSpan.FromSeconds(3));
         }
         catch (Exception ex)
         {
@@ -183,8 +405,33 @@ public class RealVoskEngineAdapter : ISttEngine
 
         _silenceTimer.Stop();
         _silenceTimer.Dispose();
-        _recognizer?.Dispose();
-        _model?.Dispose();
+
+        // Native objects are freed only once the decode thread has left them; a decode call that is
+        // still running defers that to the loop's completion instead of racing it
+        var decodeLoop = _decodeLoop;
+        if (decodeLoop != null && !decodeLoop.Wait(TimeSpan.FromSeconds(2)))
+        {
+            Telemetry.LogWarning("VoskDecodeLoopStillRunning", "Deferring native disposal until the decode thread exits");
+            decodeLoop.ContinueWith(_ => DisposeNativeObjects(), TaskScheduler.Default);
+            return;
+        }
+
+        DisposeNativeObjects();
+    }
+
+    private void DisposeNativeObjects()
+    {
+        lock (_lockObject)
+        {
+            _decodeCts?.Dispose();
+            _decodeCts = null;
+            _primaryRecognizer?.Dispose();
+            _fallbackRecognizer?.Dispose();
+            _recognizerPool?.Dispose();
+            _fallbackPool?.Dispose();
+            _model?.Dispose();
+            _fallbackModel?.Dispose();
+        }
     }
 
     private void InitializeVoskModel()
@@ -197,16 +444,16 @@ public class RealVoskEngineAdapter : ISttEngine
         try
         {
             // Set Vosk log level (0 = no logs, 1 = info, 2 = debug)
-            global::Vosk.Vosk.SetLogLevel(0);
+            VoskNativeModel.SetLogLevel(0);
 
             // Load Vosk model only - recognizer will be created for streaming
-            _model = new Model(_settings.ModelPath);
+            _model = new VoskNativeModel(_settings.ModelPath);
             System.Diagnostics.Debug.WriteLine($"*** Vosk Model loaded from: {_settings.ModelPath} ***");
 
             Telemetry.LogEvent("VoskModelLoaded", new
             {
                 _settings.ModelPath,
-                ModelSize = GetDirectorySize(_settings.ModelPath)
+                ModelSize = VoskModelCatalog.Default.GetModel(_settings.ModelPath)?.SizeBytes ?? 0
             });
         }
         catch (Exception ex)
@@ -239,7 +486,7 @@ public class RealVoskEngineAdapter : ISttEngine
         if (!_isRunning)
             return;
 
-        System.Diagnostics.Debug.WriteLine($"*** SILENCE DETECTED - Forcing finalization (Timer triggered after {SilenceThresholdMs}ms) ***");
+        System.Diagnostics.Debug.WriteLine($"*** SILENCE DETECTED - Forcing finalization (Timer triggered after {_silenceTimer.Interval}ms) ***");
 
         // Force finalize current utterance
         ForceFinalizeRecognition();
@@ -252,20 +499,42 @@ public class RealVoskEngineAdapter : ISttEngine
     }
 
     private void ForceFinalizeRecognition()
+    {
+        // Called from the silence timer and on stop; the decode thread finalizes after the audio queued before it
+        lock (_lockObject)
+        {
+            _decodeQueue?.Writer.TryWrite(default);
+        }
+    }
+
+    private void FinalizeUtterance()
     {
         try
         {
             if (_recognizer == null)
                 return;
 
+            // Decode the partially filled chunk so the utterance's tail is not lost
+            _decodeChunker?.Flush(_decodeChunk);
+
             var jsonResult = _recognizer.FinalResult();
-            System.Diagnostics.Debug.WriteLine($"*** Vosk FinalResult (forced): {jsonResult} ***");
+            System.Diagnostics.Debug.WriteLine($"*** Vosk FinalResult (forced): {Encoding.UTF8.GetString(jsonResult)} ***");
             ProcessVoskResult(jsonResult);
 
-            // Recreate recognizer for next utterance to be safe after FinalResult
-            CreateStreamingRecognizer();
+            // Reset in place for the next utterance; rebuilding here would delay its first frames
+            var pool = IsUsingFallbackModel ? _fallbackPool : _recognizerPool;
+            if (pool != null)
+            {
+                _recognizer = pool.Recycle(_recognizer);
+                if (IsUsingFallbackModel)
+                    _fallbackRecognizer = _recognizer;
+                else
+                    _primaryRecognizer = _recognizer;
+            }
             _recognitionStartTime = DateTime.UtcNow;
             _currentPartialText = string.Empty;
+            _lastPartialJsonLength = 0;
+            ApplyPendingModelSwitch();
         }
         catch (Exception ex)
         {
@@ -275,67 +544,27 @@ public class RealVoskEngineAdapter : ISttEngine
         }
     }
 
-    private void ProcessVoskResult(string jsonResult)
+    private void ProcessVoskResult(ReadOnlySpan<byte> jsonResult)
     {
         try
         {
-            if (string.IsNullOrEmpty(jsonResult))
+            if (jsonResult.IsEmpty || !VoskResultReader.TryReadFinal(jsonResult, out var text, out var confidence))
                 return;
 
-            // Parse JSON result to extract text (like reference code)
-            var jsonDoc = JsonDocument.Parse(jsonResult);
-            if (jsonDoc.RootElement.TryGetProperty("text", out var textElement))
-            {
-                var text = textElement.GetString()?.Trim();
-                if (!string.IsNullOrEmpty(text))
-                {
-                    // Apply punctuation if enabled
-                    if (_settings.Punctuation)
-                    {
-                        text = ApplyPunctuation(text);
-                    }
+            // Normalize spacing and width, and end the sentence if punctuation is enabled
+            text = _normalizer.Normalize(text, _settings.Punctuation);
+            var duration = DateTime.UtcNow - _recognitionStartTime;
 
-                    // Normalize spacing for Japanese output
-                    text = NormalizeJapaneseSpacing(text);
+            System.Diagnostics.Debug.WriteLine($"*** FINAL RECOGNITION: '{text}' ***");
 
-                    // Compute confidence from word results if available; fallback to top-level/confidence or default
-                    double confidence = 0.95;
-                    if (jsonDoc.RootElement.TryGetProperty("result", out var resultArray) &&
-                        resultArray.ValueKind == JsonValueKind.Array)
-                    {
-                        double sum = 0.0;
-                        int count = 0;
-                        foreach (var w in resultArray.EnumerateArray())
-                        {
-                            if (w.TryGetProperty("conf", out var confEl) && confEl.ValueKind == JsonValueKind.Number)
-                            {
-                                sum += confEl.GetDouble();
-                                count++;
-                            }
-                        }
-                        if (count > 0)
-                        {
-                            confidence = Math.Clamp(sum / count, 0.0, 1.0);
-                        }
-                        else if (jsonDoc.RootElement.TryGetProperty("confidence", out var confTop) && confTop.ValueKind == JsonValueKind.Number)
-                        {
-                            confidence = Math.Clamp(confTop.GetDouble(), 0.0, 1.0);
-                        }
-                    }
-                    var duration = DateTime.UtcNow - _recognitionStartTime;
-
-                    System.Diagnostics.Debug.WriteLine($"*** FINAL RECOGNITION: '{text}' ***");
-
-                    // Fire final recognition event
-                    OnFinal?.Invoke(this, new FinalRecognitionEventArgs(text, confidence, duration));
+            // Raised from the decode thread, usually well after PushAudio returned, so say which audio it covers
+            OnFinal?.Invoke(this, new FinalRecognitionEventArgs(text, confidence, duration, _decodedOffset));
 
-                    _recognitionStartTime = DateTime.UtcNow;
-                }
-            }
+            _recognitionStartTime = DateTime.UtcNow;
         }
         catch (JsonException ex)
         {
-            Telemetry.LogError("VoskResultParsingError", ex, new { JsonResult = jsonResult });
+            Telemetry.LogError("VoskResultParsingError", ex, new { JsonResult = Encoding.UTF8.GetString(jsonResult) });
         }
         catch (Exception ex)
         {
@@ -343,126 +572,187 @@ public class RealVoskEngineAdapter : ISttEngine
         }
     }
 
-
-    private string ApplyPunctuation(string text)
+    /// <summary>
+    /// Keeps a copy of the latest partial JSON and reports whether it changed. Most frames leave the
+    /// hypothesis as it was, and those are skipped without parsing or allocating.
+    /// </summary>
+    private bool RememberPartialJson(ReadOnlySpan<byte> partialJson)
     {
-        if (string.IsNullOrEmpty(text))
-            return text;
-
-        // Simple punctuation rules for Japanese
-        var punctuatedText = text;
+        if (partialJson.SequenceEqual(_lastPartialJson.AsSpan(0, _lastPartialJsonLength)))
+            return false;
 
-        // Add period at the end if not present
-        if (!punctuatedText.EndsWith("。") && !punctuatedText.EndsWith("？") && !punctuatedText.EndsWith("！"))
+        if (_lastPartialJson.Length < partialJson.Length)
         {
-            punctuatedText += "。";
+            _lastPartialJson = new byte[Math.Max(partialJson.Length, _lastPartialJson.Length * 2)];
         }
 
-        return punctuatedText;
+        partialJson.CopyTo(_lastPartialJson);
+        _lastPartialJsonLength = partialJson.Length;
+        return true;
     }
 
-    private long GetDirectorySize(string directoryPath)
+    private void CreateRecognizerPool()
     {
-        try
+        if (_model == null)
+            return;
+
+        var model = _model;
+        lock (_lockObject)
         {
-            var directoryInfo = new DirectoryInfo(directoryPath);
-            return directoryInfo.GetFiles("*", SearchOption.AllDirectories).Sum(file => file.Length);
+            _primaryRecognizer?.Dispose();
+            _recognizerPool?.Dispose();
+
+            _recognizerPool = new RecognizerPool<VoskNativeRecognizer>(() => CreateRecognizer(model), recognizer => recognizer.Reset(),
+                GetModelName(_settings.ModelPath));
+            _primaryRecognizer = _recognizerPool.Acquire();
+
+            // A restart keeps the model the governor last chose
+            _recognizer = IsUsingFallbackModel && _fallbackRecognizer != null ? _fallbackRecognizer : _primaryRecognizer;
         }
-        catch
+    }
+
+    /// <summary>
+    /// Loads the governor's fallback model and builds its recognizer in the background, so a switch
+    /// at an utterance boundary is only a pointer swap. Both models stay in memory while running.
+    /// </summary>
+    private void PreloadFallbackModel()
+    {
+        // The decode thread is not running yet, so the governor can be touched here
+        var fallbackPath = _settings.Governor.FallbackModelPath;
+        _fallbackLoadFailed = false;
+        _governor.SetFallbackAvailable(!string.IsNullOrEmpty(fallbackPath));
+        if (!_settings.Governor.Enabled || string.IsNullOrEmpty(fallbackPath) || _fallbackRecognizer != null)
+            return;
+
+        AsyncHelper.FireAndForget(() => Task.Run(() =>
         {
-            return 0;
+            try
+            {
+                LoadFallbackModel(fallbackPath);
+            }
+            catch
+            {
+                // Seen by the decode thread at the next utterance boundary
+                _fallbackLoadFailed = true;
+                throw;
+            }
+        }), "VoskFallbackModelPreload", new { ModelPath = fallbackPath });
+    }
+
+    private void LoadFallbackModel(string fallbackPath)
+    {
+        if (!Directory.Exists(fallbackPath))
+            throw new DirectoryNotFoundException($"Fallback Vosk model not found at: {fallbackPath}");
+
+        var model = new VoskNativeModel(fallbackPath);
+        var pool = new RecognizerPool<VoskNativeRecognizer>(() => CreateRecognizer(model), recognizer => recognizer.Reset(),
+            GetModelName(fallbackPath));
+        var recognizer = pool.Acquire();
+
+        lock (_lockObject)
+        {
+            if (_isRunning && _fallbackRecognizer == null)
+            {
+                _fallbackModel = model;
+                _fallbackPool = pool;
+                _fallbackRecognizer = recognizer;
+                Telemetry.LogEvent("VoskFallbackModelPreloaded", new { ModelPath = fallbackPath });
+                return;
+            }
         }
+
+        // Stopped while loading
+        recognizer.Dispose();
+        pool.Dispose();
+        model.Dispose();
     }
 
-    private void CreateStreamingRecognizer()
+    /// <summary>
+    /// Runs on the decode thread between utterances, when the recognizer holds no audio.
+    /// </summary>
+    private void ApplyPendingModelSwitch()
     {
-        if (_model == null)
+        if (!_governor.SwitchPending || !_settings.Governor.Enabled)
             return;
 
-        try
+        var target = _governor.TargetTier;
+        VoskNativeRecognizer? next;
+        lock (_lockObject)
         {
-            _recognizer?.Dispose();
-            var sampleRate = _settings.SampleRate > 0 ? _settings.SampleRate : 16000;
-            _recognizer = new VoskRecognizer(_model, sampleRate);
-            _recognizer.SetMaxAlternatives(0);
-            _recognizer.SetWords(true);
-            // Note: Vosk C# bindings may not expose SetGrammar; relying on SetWords and configuration-only
-            if (_settings.Punctuation)
+            next = target == ModelTier.Fallback ? _fallbackRecognizer : _primaryRecognizer;
+        }
+
+        if (next == null)
+        {
+            // Fallback still loading, or failed to load; keep going on the primary
+            if (_fallbackLoadFailed)
             {
-                // Vosk doesn't add punctuation automatically for all models; this flag is kept for symmetry
+                _governor.SetFallbackAvailable(false);
             }
+            return;
         }
-        catch (Exception ex)
+
+        var rtf = _governor.RealTimeFactor;
+        var queued = QueuedAudio;
+        _recognizer = next;
+        _governor.OnSwitched(target);
+
+        var modelPath = target == ModelTier.Fallback ? _settings.Governor.FallbackModelPath : _settings.ModelPath;
+        Telemetry.LogEvent(target == ModelTier.Fallback ? "VoskModelDowngraded" : "VoskModelRestored", new
         {
-            Telemetry.LogError("VoskRecognizerCreateFailed", ex);
-            throw;
-        }
+            ModelPath = modelPath,
+            RealTimeFactor = rtf,
+            QueuedAudioMs = queued.TotalMilliseconds,
+            NextUpgradeWindows = _governor.CurrentUpgradeWindows
+        });
+
+        OnModelSwitched?.Invoke(this, new ModelSwitchedEventArgs(modelPath, target == ModelTier.Fallback, rtf, queued));
     }
 
-    private static bool IsJapaneseChar(int codePoint)
+    private TimeSpan BytesToDuration(long bytes)
     {
-        // Hiragana: 3040–309F, Katakana: 30A0–30FF (includes prolonged sound mark 30FC)
-        // Katakana Phonetic Extensions: 31F0–31FF
-        // CJK Unified Ideographs: 4E00–9FFF
-        // Halfwidth Katakana: FF61–FF9F (includes prolonged sound mark FF70)
-        return (codePoint >= 0x3040 && codePoint <= 0x30FF) ||
-               (codePoint >= 0x31F0 && codePoint <= 0x31FF) ||
-               (codePoint >= 0x4E00 && codePoint <= 0x9FFF) ||
-               (codePoint >= 0xFF61 && codePoint <= 0xFF9F);
+        var sampleRate = _settings.SampleRate > 0 ? _settings.SampleRate : 16000;
+        return TimeSpan.FromSeconds(bytes / (2.0 * sampleRate));
     }
 
-    private static string NormalizeJapaneseSpacing(string input)
-    {
-        if (string.IsNullOrEmpty(input))
-            return input;
+    private static string GetModelName(string modelPath) =>
+        Path.GetFileName(modelPath.TrimEnd(Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar));
 
-        // Remove ASCII spaces between two Japanese chars only. Keep spaces elsewhere.
-        var sb = new StringBuilder(input.Length);
-        for (int i = 0; i < input.Length; i++)
+    private VoskNativeRecognizer CreateRecognizer(VoskNativeModel model)
+    {
+        try
         {
-            char c = input[i];
-            if (c == ' ')
+            var sampleRate = _settings.SampleRate > 0 ? _settings.SampleRate : 16000;
+            var recognizer = new VoskNativeRecognizer(model, sampleRate);
+            recognizer.SetMaxAlternatives(0);
+            recognizer.SetWords(true);
+            // Note: Vosk C# bindings may not expose SetGrammar; relying on SetWords and configuration-only
+            if (_settings.Punctuation)
             {
-                // Look at previous and next visible characters
-                int prev = i - 1;
-                while (prev >= 0 && char.IsWhiteSpace(input[prev]))
-                    prev--;
-                int next = i + 1;
-                while (next < input.Length && char.IsWhiteSpace(input[next]))
-                    next++;
-
-                if (prev >= 0 && next < input.Length)
-                {
-                    int prevCp = char.ConvertToUtf32(input, prev);
-                    int nextCp = char.ConvertToUtf32(input, next);
-                    if (IsJapaneseChar(prevCp) && IsJapaneseChar(nextCp))
-                    {
-                        // skip this space
-                        continue;
-                    }
-                }
+                // Vosk doesn't add punctuation automatically for all models; this flag is kept for symmetry
             }
-            sb.Append(c);
+            return recognizer;
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogError("VoskRecognizerCreateFailed", ex);
+            throw;
         }
-        return sb.ToString();
     }
 
-    private string ExtractPartialText(string partialJson)
+    private static string ExtractPartialText(ReadOnlySpan<byte> partialJson)
     {
         try
         {
-            if (string.IsNullOrEmpty(partialJson))
-                return string.Empty;
-            using var doc = JsonDocument.Parse(partialJson);
-            if (doc.RootElement.TryGetProperty("partial", out var p))
-            {
-                return p.GetString() ?? string.Empty;
-            }
+            return partialJson.IsEmpty ? string.Empty : VoskResultReader.ReadPartial(partialJson);
         }
         catch (JsonException)
         {
             // Invalid JSON, return empty string
+            return string.Empty;
         }
-        return string.Empty;
     }
+
+    // A null buffer asks the decode thread to finalize the current utterance
+    private readonly record struct DecodeItem(byte[]? Buffer, int Length, long EndOffset);
 }
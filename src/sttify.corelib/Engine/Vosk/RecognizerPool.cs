@@ -0,0 +1,182 @@
+﻿using System.Diagnostics;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Engine.Vosk;
+
+/// <summary>
+/// Keeps recognizer construction off the audio path. Between utterances the active recognizer is
+/// reset in place, which clears decoder state without rebuilding graphs; if a reset fails, a spare
+/// built in the background takes over and another is started. Construction time is logged per model.
+/// </summary>
+public sealed class RecognizerPool<T> : IDisposable where T : class, IDisposable
+{
+    private readonly Func<T> _factory;
+    private readonly object _lockObject = new();
+    private readonly string _modelName;
+    private readonly Action<T> _reset;
+    private readonly int _spareTarget;
+    private readonly Queue<T> _spares = new();
+
+    private long _constructionCount;
+    private bool _disposed;
+    private int _pendingConstructions;
+    private long _resetCount;
+    private double _totalConstructionMs;
+
+    public RecognizerPool(Func<T> factory, Action<T> reset, string modelName, int spareTarget = 1)
+    {
+        _factory = factory ?? throw new ArgumentNullException(nameof(factory));
+        _reset = reset ?? throw new ArgumentNullException(nameof(reset));
+        _modelName = modelName;
+        _spareTarget = Math.Max(0, spareTarget);
+    }
+
+    public int SpareCount
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _spares.Count;
+            }
+        }
+    }
+
+    public long ConstructionCount => Interlocked.Read(ref _constructionCount);
+    public long ResetCount => Interlocked.Read(ref _resetCount);
+
+    public double AverageConstructionMs
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _constructionCount > 0 ? _totalConstructionMs / _constructionCount : 0.0;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Returns a ready recognizer, preferring a warm spare; builds one inline only when none is ready.
+    /// </summary>
+    public T Acquire()
+    {
+        T? spare = null;
+        lock (_lockObject)
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            if (_spares.Count > 0)
+            {
+                spare = _spares.Dequeue();
+            }
+        }
+
+        Replenish();
+        return spare ?? Construct(background: false);
+    }
+
+    /// <summary>
+    /// Prepares <paramref name="recognizer"/> for the next utterance. Returns the same instance after a
+    /// successful reset, or a replacement (the faulted one is disposed) when the reset throws.
+    /// </summary>
+    public T Recycle(T recognizer)
+    {
+        ArgumentNullException.ThrowIfNull(recognizer);
+
+        try
+        {
+            _reset(recognizer);
+            Interlocked.Increment(ref _resetCount);
+            return recognizer;
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogWarning("RecognizerResetFailed", ex.Message, new { Model = _modelName });
+            recognizer.Dispose();
+            return Acquire();
+        }
+    }
+
+    /// <summary>
+    /// Starts background construction until the spare target is met.
+    /// </summary>
+    public void Replenish()
+    {
+        int toStart;
+        lock (_lockObject)
+        {
+            if (_disposed)
+                return;
+
+            toStart = _spareTarget - _spares.Count - _pendingConstructions;
+            if (toStart <= 0)
+                return;
+
+            _pendingConstructions += toStart;
+        }
+
+        for (int i = 0; i < toStart; i++)
+        {
+            AsyncHelper.FireAndForget(() => Task.Run(ConstructSpare), "RecognizerPoolReplenish", new { Model = _modelName });
+        }
+    }
+
+    public void Dispose()
+    {
+        T[] spares;
+        lock (_lockObject)
+        {
+            if (_disposed)
+                return;
+
+            _disposed = true;
+            spares = _spares.ToArray();
+            _spares.Clear();
+        }
+
+        foreach (var spare in spares)
+        {
+            spare.Dispose();
+        }
+    }
+
+    private void ConstructSpare()
+    {
+        T? recognizer = null;
+        try
+        {
+            recognizer = Construct(background: true);
+        }
+        finally
+        {
+            lock (_lockObject)
+            {
+                _pendingConstructions--;
+                if (recognizer != null && !_disposed)
+                {
+                    _spares.Enqueue(recognizer);
+                    recognizer = null;
+                }
+            }
+
+            // Pool was disposed while this one was being built
+            recognizer?.Dispose();
+        }
+    }
+
+    private T Construct(bool background)
+    {
+        var stopwatch = Stopwatch.StartNew();
+        var recognizer = _factory();
+        var elapsedMs = stopwatch.Elapsed.TotalMilliseconds;
+
+        lock (_lockObject)
+        {
+            _constructionCount++;
+            _totalConstructionMs += elapsedMs;
+        }
+
+        Telemetry.LogEvent("RecognizerConstructed", new { Model = _modelName, ElapsedMs = elapsedMs, Background = background });
+        return recognizer;
+    }
+}
@@ -0,0 +1,25 @@
+﻿using System.Text.Json.Serialization;
+
+namespace Sttify.Corelib.Engine.Vosk;
+
+/// <summary>
+/// Source-generated serializer for the model catalog file, so it loads without reflection under
+/// trimming and NativeAOT.
+/// </summary>
+[JsonSourceGenerationOptions(
+    PropertyNamingPolicy = JsonKnownNamingPolicy.CamelCase,
+    WriteIndented = true)]
+[JsonSerializable(typeof(VoskModelCatalogData))]
+internal partial class VoskModelCatalogJsonContext : JsonSerializerContext
+{
+}
+
+/// <summary>
+/// Source-generated serializer for what goes to and comes back from the recognizer itself:
+/// grammar phrase lists and result payloads.
+/// </summary>
+[JsonSerializable(typeof(string[]))]
+[JsonSerializable(typeof(MultiLanguageVoskAdapter.VoskResult))]
+internal partial class VoskJsonContext : JsonSerializerContext
+{
+}
@@ -0,0 +1,527 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using System.Security.Cryptography;
+using System.Text;
+using System.Text.Json;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Engine.Vosk;
+
+/// <summary>
+/// Persisted index of installed Vosk models (path, language, size, fingerprint, validity).
+/// A model directory is walked once when first seen; afterwards lookups are dictionary hits. Entries
+/// loaded from disk are re-validated by a handful of key-file stats instead of a recursive walk, and
+/// watched model roots are kept current incrementally by a <see cref="FileSystemWatcher"/>.
+/// </summary>
+public class VoskModelCatalog : IDisposable
+{
+    private const int DebounceMs = 1000;
+
+    // Files whose size/timestamp identify a model build without walking the whole tree
+    private static readonly string[] KeyFiles =
+    [
+        "am/final.mdl",
+        "graph/words.txt",
+        "graph/HCLG.fst",
+        "graph/HCLR.fst",
+        "conf/model.conf"
+    ];
+
+    private static readonly (string Token, string Language)[] LanguageTokens =
+    [
+        ("-ja-", "ja"), ("japanese", "ja"),
+        ("-en-", "en"), ("english", "en"),
+        ("-zh-", "zh"), ("chinese", "zh"),
+        ("-ko-", "ko"), ("korean", "ko"),
+        ("-es-", "es"), ("spanish", "es"),
+        ("-fr-", "fr"), ("french", "fr"),
+        ("-de-", "de"), ("german", "de"),
+        ("-ru-", "ru"), ("russian", "ru")
+    ];
+
+    private static readonly Lazy<VoskModelCatalog> LazyDefault = new(() => Load(GetDefaultCatalogPath()));
+
+    private readonly string? _catalogPath;
+    private readonly HashSet<string> _dirtyModels = new(StringComparer.OrdinalIgnoreCase);
+    private readonly Dictionary<string, VoskModelEntry> _entries = new(StringComparer.OrdinalIgnoreCase);
+    private readonly bool _enableWatchers;
+    private readonly object _lockObject = new();
+    private readonly Dictionary<string, VoskModelEntry> _persisted = new(StringComparer.OrdinalIgnoreCase);
+    private readonly Dictionary<string, HashSet<string>> _roots = new(StringComparer.OrdinalIgnoreCase);
+    private readonly object _saveLock = new();
+    private readonly Dictionary<string, FileSystemWatcher> _watchers = new(StringComparer.OrdinalIgnoreCase);
+
+    private Timer? _debounceTimer;
+    private bool _disposed;
+
+    public VoskModelCatalog(string? catalogPath = null, bool enableWatchers = true)
+    {
+        _catalogPath = catalogPath;
+        _enableWatchers = enableWatchers;
+    }
+
+    public static VoskModelCatalog Default => LazyDefault.Value;
+
+    public static string GetDefaultCatalogPath()
+    {
+        var appDataPath = Environment.GetFolderPath(Environment.SpecialFolder.ApplicationData);
+        return Path.Combine(appDataPath, "sttify", "model-catalog.json");
+    }
+
+    /// <summary>
+    /// Returns the entry for a model directory, indexing it on first use. Missing or incomplete
+    /// directories yield an entry with <see cref="VoskModelEntry.IsValid"/> false (or null when empty).
+    /// </summary>
+    public VoskModelEntry? GetModel(string? modelPath)
+    {
+        if (string.IsNullOrEmpty(modelPath))
+            return null;
+
+        var fullPath = NormalizePath(modelPath);
+        VoskModelEntry? known;
+        lock (_lockObject)
+        {
+            if (_entries.TryGetValue(fullPath, out var cached) && !_dirtyModels.Contains(fullPath))
+                return cached;
+
+            known = cached ?? _persisted.GetValueOrDefault(fullPath);
+        }
+
+        var entry = Resolve(fullPath, known);
+        lock (_lockObject)
+        {
+            if (entry != null)
+                _entries[fullPath] = entry;
+            else
+                _entries.Remove(fullPath);
+            _dirtyModels.Remove(fullPath);
+        }
+
+        // Changes inside this model are picked up by a watcher on the model directory itself
+        if (entry != null)
+        {
+            EnsureWatcher(fullPath, isModel: true);
+        }
+
+        return entry;
+    }
+
+    /// <summary>
+    /// Valid models directly under <paramref name="modelsDirectory"/>. The directory is listed once,
+    /// then kept current by the watcher.
+    /// </summary>
+    public IReadOnlyList<VoskModelEntry> GetModels(string? modelsDirectory)
+    {
+        if (string.IsNullOrEmpty(modelsDirectory))
+            return [];
+
+        var root = NormalizePath(modelsDirectory);
+        string[] children;
+        lock (_lockObject)
+        {
+            children = _roots.TryGetValue(root, out var known) ? known.ToArray() : [];
+        }
+
+        if (children.Length == 0 && !IsRootScanned(root))
+        {
+            if (!Directory.Exists(root))
+                return [];
+
+            children = Directory.GetDirectories(root).Select(NormalizePath).ToArray();
+            lock (_lockObject)
+            {
+                _roots[root] = new HashSet<string>(children, StringComparer.OrdinalIgnoreCase);
+            }
+            EnsureWatcher(root, isModel: false);
+        }
+
+        return children
+            .Select(GetModel)
+            .Where(entry => entry is { IsValid: true })
+            .Cast<VoskModelEntry>()
+            .OrderBy(entry => entry.Name, StringComparer.OrdinalIgnoreCase)
+            .ToArray();
+    }
+
+    /// <summary>
+    /// Forgets what is known about a model so the next lookup re-validates it.
+    /// </summary>
+    public void Invalidate(string modelPath)
+    {
+        lock (_lockObject)
+        {
+            _dirtyModels.Add(NormalizePath(modelPath));
+        }
+    }
+
+    public static string DetectLanguage(string modelName)
+    {
+        var known = VoskModelManager.AvailableModels.FirstOrDefault(m => string.Equals(m.Name, modelName, StringComparison.OrdinalIgnoreCase));
+        if (known != null)
+            return known.Language;
+
+        var lowerName = modelName.ToLowerInvariant();
+        foreach (var (token, language) in LanguageTokens)
+        {
+            if (lowerName.Contains(token))
+                return language;
+        }
+
+        return "";
+    }
+
+    [ExcludeFromCodeCoverage] // File system I/O
+    public static VoskModelCatalog Load(string catalogPath, bool enableWatchers = true)
+    {
+        var catalog = new VoskModelCatalog(catalogPath, enableWatchers);
+        if (!File.Exists(catalogPath))
+            return catalog;
+
+        try
+        {
+            var data = JsonSerializer.Deserialize(File.ReadAllText(catalogPath), VoskModelCatalogJsonContext.Default.VoskModelCatalogData);
+            foreach (var entry in data?.Models ?? new List<VoskModelEntry>())
+            {
+                if (!string.IsNullOrEmpty(entry.Path))
+                {
+                    catalog._persisted[NormalizePath(entry.Path)] = entry;
+                }
+            }
+        }
+        catch (Exception ex) when (ex is IOException or JsonException or UnauthorizedAccessException)
+        {
+            // The catalog is only a cache; rebuilding it costs one walk per model
+            Telemetry.LogError("ModelCatalogLoadFailed", ex, new { Path = catalogPath });
+        }
+
+        return catalog;
+    }
+
+    [ExcludeFromCodeCoverage] // File system I/O
+    public void Save()
+    {
+        if (_catalogPath == null)
+            return;
+
+        VoskModelCatalogData data;
+        lock (_lockObject)
+        {
+            // Keep persisted entries for models not looked up in this session
+            var merged = new Dictionary<string, VoskModelEntry>(_persisted, StringComparer.OrdinalIgnoreCase);
+            foreach (var (path, entry) in _entries)
+            {
+                merged[path] = entry;
+            }
+            data = new VoskModelCatalogData { Models = merged.Values.ToList() };
+        }
+
+        try
+        {
+            // Saves are scheduled from indexing and watcher callbacks and may overlap
+            lock (_saveLock)
+            {
+                Directory.CreateDirectory(Path.GetDirectoryName(_catalogPath)!);
+
+                // Write-then-move so a crash never leaves a truncated catalog
+                var tempPath = _catalogPath + ".tmp";
+                File.WriteAllText(tempPath, JsonSerializer.Serialize(data, VoskModelCatalogJsonContext.Default.VoskModelCatalogData));
+                File.Move(tempPath, _catalogPath, true);
+            }
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            Telemetry.LogError("ModelCatalogSaveFailed", ex, new { Path = _catalogPath });
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(true);
+        GC.SuppressFinalize(this);
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposing)
+            return;
+
+        FileSystemWatcher[] watchers;
+        lock (_lockObject)
+        {
+            if (_disposed)
+                return;
+
+            _disposed = true;
+            watchers = _watchers.Values.ToArray();
+            _watchers.Clear();
+        }
+
+        foreach (var watcher in watchers)
+        {
+            watcher.Dispose();
+        }
+        _debounceTimer?.Dispose();
+    }
+
+    public static VoskModelEntry IndexModel(string fullPath)
+    {
+        var name = Path.GetFileName(fullPath);
+        var entry = new VoskModelEntry
+        {
+            Path = fullPath,
+            Name = name,
+            Language = DetectLanguage(name),
+            IsValid = VoskModelManager.IsModelInstalled(fullPath),
+            Stamp = ComputeStamp(fullPath),
+            IndexedAtUtc = DateTime.UtcNow
+        };
+
+        // One walk for both the size and a fingerprint of every file's length and timestamp
+        try
+        {
+            var files = new DirectoryInfo(fullPath)
+                .EnumerateFiles("*", SearchOption.AllDirectories)
+                .Select(file => (RelativePath: Path.GetRelativePath(fullPath, file.FullName).Replace('\\', '/'), file.Length, file.LastWriteTimeUtc.Ticks))
+                .OrderBy(file => file.RelativePath, StringComparer.Ordinal)
+                .ToList();
+
+            using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+            foreach (var file in files)
+            {
+                hash.AppendData(Encoding.UTF8.GetBytes($"{file.RelativePath}|{file.Length}|{file.Ticks}\n"));
+                entry.SizeBytes += file.Length;
+            }
+            entry.ContentHash = Convert.ToHexStringLower(hash.GetHashAndReset());
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            Telemetry.LogWarning("ModelCatalogIndexFailed", ex.Message, new { Path = fullPath });
+        }
+
+        return entry;
+    }
+
+    public static string ComputeStamp(string fullPath)
+    {
+        var parts = new string[KeyFiles.Length];
+        for (int i = 0; i < KeyFiles.Length; i++)
+        {
+            var file = new FileInfo(Path.Combine(fullPath, KeyFiles[i]));
+            parts[i] = file.Exists ? $"{file.Length}:{file.LastWriteTimeUtc.Ticks}" : "-";
+        }
+        return string.Join("|", parts);
+    }
+
+    private VoskModelEntry? Resolve(string fullPath, VoskModelEntry? known)
+    {
+        if (!Directory.Exists(fullPath))
+            return null;
+
+        if (known != null && known.Stamp == ComputeStamp(fullPath))
+            return known;
+
+        var entry = IndexModel(fullPath);
+        Telemetry.LogEvent("ModelCatalogIndexed", new { entry.Name, entry.SizeBytes, entry.IsValid, Reason = known == null ? "new" : "changed" });
+        ScheduleSave();
+        return entry;
+    }
+
+    private bool IsRootScanned(string root)
+    {
+        lock (_lockObject)
+        {
+            return _roots.ContainsKey(root);
+        }
+    }
+
+    /// <summary>
+    /// A model directory is watched in full; a models directory only for child directories coming
+    /// and going. Siblings of a model that are not models themselves are never walked.
+    /// </summary>
+    [ExcludeFromCodeCoverage] // File system watcher
+    private void EnsureWatcher(string path, bool isModel)
+    {
+        if (!_enableWatchers)
+            return;
+
+        lock (_lockObject)
+        {
+            if (_disposed || _watchers.ContainsKey(path) || !Directory.Exists(path))
+                return;
+
+            try
+            {
+                var watcher = new FileSystemWatcher(path)
+                {
+                    IncludeSubdirectories = isModel,
+                    NotifyFilter = isModel
+                        ? NotifyFilters.DirectoryName | NotifyFilters.FileName | NotifyFilters.LastWrite | NotifyFilters.Size
+                        : NotifyFilters.DirectoryName
+                };
+                if (isModel)
+                {
+                    watcher.Changed += (_, _) => MarkDirty(path);
+                    watcher.Created += (_, _) => MarkDirty(path);
+                    watcher.Deleted += (_, _) => MarkDirty(path);
+                    watcher.Renamed += (_, _) => MarkDirty(path);
+                    watcher.Error += (_, e) => OnWatcherError(path, e.GetException());
+                }
+                else
+                {
+                    watcher.Created += (_, e) => OnModelListChanged(path, e.FullPath);
+                    watcher.Deleted += (_, e) => OnModelListChanged(path, e.FullPath);
+                    watcher.Renamed += (_, e) =>
+                    {
+                        OnModelListChanged(path, e.OldFullPath);
+                        OnModelListChanged(path, e.FullPath);
+                    };
+                    watcher.Error += (_, e) => OnRootWatcherError(path, e.GetException());
+                }
+                watcher.EnableRaisingEvents = true;
+                _watchers[path] = watcher;
+            }
+            catch (Exception ex) when (ex is IOException or ArgumentException or UnauthorizedAccessException)
+            {
+                // Without a watcher entries still re-validate by stamp on the next start
+                Telemetry.LogWarning("ModelCatalogWatcherFailed", ex.Message, new { Root = path });
+            }
+        }
+    }
+
+    /// <summary>
+    /// A directory appeared in or left a scanned models directory: track it as a model candidate.
+    /// </summary>
+    [ExcludeFromCodeCoverage] // File system watcher callback
+    private void OnModelListChanged(string root, string changedPath)
+    {
+        var modelPath = NormalizePath(changedPath);
+        if (!string.Equals(Path.GetDirectoryName(modelPath), root, StringComparison.OrdinalIgnoreCase))
+            return;
+
+        lock (_lockObject)
+        {
+            if (!_roots.TryGetValue(root, out var children))
+                return;
+
+            children.Add(modelPath);
+        }
+
+        MarkDirty(modelPath);
+    }
+
+    [ExcludeFromCodeCoverage] // File system watcher callback
+    private void MarkDirty(string modelPath)
+    {
+        lock (_lockObject)
+        {
+            if (_disposed)
+                return;
+
+            _dirtyModels.Add(modelPath);
+
+            // Extracting a model fires thousands of events; re-index once it settles
+            _debounceTimer ??= new Timer(_ => RefreshDirtyModels(), null, Timeout.Infinite, Timeout.Infinite);
+            _debounceTimer.Change(DebounceMs, Timeout.Infinite);
+        }
+    }
+
+    [ExcludeFromCodeCoverage] // File system watcher callback
+    private void OnWatcherError(string modelPath, Exception ex)
+    {
+        // Events were lost or the directory itself went away; re-check the model once things settle
+        Telemetry.LogWarning("ModelCatalogWatcherError", ex.Message, new { Root = modelPath });
+        MarkDirty(modelPath);
+    }
+
+    [ExcludeFromCodeCoverage] // File system watcher callback
+    private void OnRootWatcherError(string root, Exception ex)
+    {
+        // Events were lost (e.g. buffer overflow); list the root again on the next query
+        Telemetry.LogWarning("ModelCatalogWatcherError", ex.Message, new { Root = root });
+        lock (_lockObject)
+        {
+            _roots.Remove(root);
+        }
+    }
+
+    [ExcludeFromCodeCoverage] // File system watcher callback
+    private void RefreshDirtyModels()
+    {
+        string[] dirty;
+        var staleWatchers = new List<FileSystemWatcher>();
+        lock (_lockObject)
+        {
+            dirty = _dirtyModels.ToArray();
+        }
+
+        foreach (var modelPath in dirty)
+        {
+            var exists = Directory.Exists(modelPath);
+            lock (_lockObject)
+            {
+                if (!exists)
+                {
+                    _entries.Remove(modelPath);
+                    _persisted.Remove(modelPath);
+                    _dirtyModels.Remove(modelPath);
+                    foreach (var children in _roots.Values)
+                    {
+                        children.Remove(modelPath);
+                    }
+                    if (_watchers.Remove(modelPath, out var watcher))
+                    {
+                        staleWatchers.Add(watcher);
+                    }
+                }
+                else
+                {
+                    // Force a fresh walk: a changed file deep in the tree does not move the stamp
+                    _entries.Remove(modelPath);
+                    _persisted.Remove(modelPath);
+                }
+            }
+
+            if (exists)
+            {
+                GetModel(modelPath);
+            }
+        }
+
+        foreach (var watcher in staleWatchers)
+        {
+            watcher.Dispose();
+        }
+        Save();
+    }
+
+    private void ScheduleSave()
+    {
+        if (_catalogPath == null)
+            return;
+
+        AsyncHelper.FireAndForget(() => Task.Run(Save), "ModelCatalogSave");
+    }
+
+    private static string NormalizePath(string path)
+    {
+        return Path.TrimEndingDirectorySeparator(Path.GetFullPath(path));
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class VoskModelEntry
+{
+    public string Path { get; set; } = "";
+    public string Name { get; set; } = "";
+    public string Language { get; set; } = ""; // Empty when the name does not reveal it
+    public long SizeBytes { get; set; }
+    public string ContentHash { get; set; } = ""; // SHA-256 over every file's path, length and timestamp
+    public bool IsValid { get; set; }
+    public string Stamp { get; set; } = ""; // Key-file lengths and timestamps, checked instead of re-walking
+    public DateTime IndexedAtUtc { get; set; }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class VoskModelCatalogData
+{
+    public List<VoskModelEntry> Models { get; set; } = new();
+}
@@ -119,6 +119,7 @@ public class VoskModelManager
                 Directory.Move(extractedDirs[0], extractPath);
             }
 
+            VoskModelCatalog.Default.Invalidate(extractPath);
             Telemetry.LogEvent("VoskModelDownloadCompleted", new { Model = modelInfo.Name, Path = extractPath });
 
             onProgress?.Invoke(new DownloadProgressEventArgs(100, downloadedBytes, totalBytes, "Model ready"));
@@ -164,6 +165,20 @@ public class VoskModelManager
                (File.Exists(largeGraph) || File.Exists(smallGraph));
     }
 
+    public static bool SupportsGrammar(string modelPath)
+    {
+        if (string.IsNullOrEmpty(modelPath))
+            return false;
+
+        // Only dynamic-graph models (HCLr.fst + Gr.fst) can be restricted to a grammar at runtime;
+        // static HCLG.fst models silently ignore it and decode the full vocabulary
+        var lexiconGraph = Path.Combine(modelPath, "graph/HCLr.fst");
+        var grammarGraph = Path.Combine(modelPath, "graph/Gr.fst");
+
+        return (File.Exists(lexiconGraph) || File.Exists(Path.Combine(modelPath, "graph/HCLR.fst"))) &&
+               File.Exists(grammarGraph);
+    }
+
     public static VoskModelInfo? GetModelInfo(string modelPath)
     {
         if (!IsModelInstalled(modelPath))
@@ -175,11 +190,8 @@ public class VoskModelManager
 
     public static string[] GetInstalledModels(string modelsDirectory)
     {
-        if (!Directory.Exists(modelsDirectory))
-            return Array.Empty<string>();
-
-        return Directory.GetDirectories(modelsDirectory)
-            .Where(IsModelInstalled)
+        return VoskModelCatalog.Default.GetModels(modelsDirectory)
+            .Select(model => model.Path)
             .ToArray();
     }
 
@@ -191,19 +203,7 @@ public class VoskModelManager
 
     public static long GetModelSize(string modelPath)
     {
-        if (!Directory.Exists(modelPath))
-            return 0;
-
-        try
-        {
-            return new DirectoryInfo(modelPath)
-                .GetFiles("*", SearchOption.AllDirectories)
-                .Sum(file => file.Length);
-        }
-        catch
-        {
-            return 0;
-        }
+        return VoskModelCatalog.Default.GetModel(modelPath)?.SizeBytes ?? 0;
     }
 }
 
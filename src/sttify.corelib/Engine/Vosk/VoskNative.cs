@@ -0,0 +1,80 @@
+﻿using System.Runtime.InteropServices;
+using Microsoft.Win32.SafeHandles;
+
+namespace Sttify.Corelib.Engine.Vosk;
+
+/// <summary>
+/// Direct libvosk entry points for the streaming hot path. The Vosk NuGet wrapper only accepts
+/// <c>byte[]</c> audio and returns results as managed strings; these take pinned spans and hand
+/// back the recognizer's own UTF-8 buffer. The native library itself still ships with that package.
+/// </summary>
+internal static unsafe partial class VoskNative
+{
+    private const string LibraryName = "libvosk";
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_set_log_level")]
+    internal static partial void SetLogLevel(int level);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_model_new", StringMarshalling = StringMarshalling.Utf8)]
+    internal static partial VoskModelHandle ModelNew(string modelPath);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_model_free")]
+    internal static partial void ModelFree(IntPtr model);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_new")]
+    internal static partial VoskRecognizerHandle RecognizerNew(VoskModelHandle model, float sampleRate);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_free")]
+    internal static partial void RecognizerFree(IntPtr recognizer);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_set_words")]
+    internal static partial void RecognizerSetWords(VoskRecognizerHandle recognizer, int words);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_set_max_alternatives")]
+    internal static partial void RecognizerSetMaxAlternatives(VoskRecognizerHandle recognizer, int maxAlternatives);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_reset")]
+    internal static partial void RecognizerReset(VoskRecognizerHandle recognizer);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_accept_waveform")]
+    internal static partial int RecognizerAcceptWaveform(VoskRecognizerHandle recognizer, byte* data, int length);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_accept_waveform_s")]
+    internal static partial int RecognizerAcceptWaveformShort(VoskRecognizerHandle recognizer, short* data, int length);
+
+    // The returned strings are owned by the recognizer and valid until its next call
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_result")]
+    internal static partial byte* RecognizerResult(VoskRecognizerHandle recognizer);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_partial_result")]
+    internal static partial byte* RecognizerPartialResult(VoskRecognizerHandle recognizer);
+
+    [LibraryImport(LibraryName, EntryPoint = "vosk_recognizer_final_result")]
+    internal static partial byte* RecognizerFinalResult(VoskRecognizerHandle recognizer);
+}
+
+internal sealed class VoskModelHandle : SafeHandleZeroOrMinusOneIsInvalid
+{
+    public VoskModelHandle() : base(ownsHandle: true)
+    {
+    }
+
+    protected override bool ReleaseHandle()
+    {
+        VoskNative.ModelFree(handle);
+        return true;
+    }
+}
+
+internal sealed class VoskRecognizerHandle : SafeHandleZeroOrMinusOneIsInvalid
+{
+    public VoskRecognizerHandle() : base(ownsHandle: true)
+    {
+    }
+
+    protected override bool ReleaseHandle()
+    {
+        VoskNative.RecognizerFree(handle);
+        return true;
+    }
+}
@@ -0,0 +1,87 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using System.Runtime.InteropServices;
+
+namespace Sttify.Corelib.Engine.Vosk;
+
+/// <summary>
+/// A loaded Vosk model for <see cref="VoskNativeRecognizer"/>. libvosk reference-counts models, so
+/// disposing this while recognizers are alive is safe.
+/// </summary>
+[ExcludeFromCodeCoverage] // Native libvosk wrapper, requires a model on disk
+public sealed class VoskNativeModel : IDisposable
+{
+    public VoskNativeModel(string modelPath)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(modelPath);
+
+        Handle = VoskNative.ModelNew(modelPath);
+        if (Handle.IsInvalid)
+            throw new InvalidOperationException($"libvosk failed to load the model at {modelPath}");
+    }
+
+    internal VoskModelHandle Handle { get; }
+
+    /// <summary>
+    /// 0 silences libvosk, 1 logs info, 2 logs debug.
+    /// </summary>
+    public static void SetLogLevel(int level) => VoskNative.SetLogLevel(level);
+
+    public void Dispose() => Handle.Dispose();
+}
+
+/// <summary>
+/// Streaming recognizer that takes audio as spans and returns results as the recognizer's own
+/// UTF-8 JSON. Nothing is copied on the way in, and results can go straight to a
+/// <see cref="System.Text.Json.Utf8JsonReader"/> without a managed string. Result spans are only
+/// valid until the next call on the recognizer. Not thread-safe.
+/// </summary>
+[ExcludeFromCodeCoverage] // Native libvosk wrapper, requires a model on disk
+public sealed unsafe class VoskNativeRecognizer : IDisposable
+{
+    private readonly VoskRecognizerHandle _handle;
+
+    public VoskNativeRecognizer(VoskNativeModel model, float sampleRate)
+    {
+        ArgumentNullException.ThrowIfNull(model);
+
+        _handle = VoskNative.RecognizerNew(model.Handle, sampleRate);
+        if (_handle.IsInvalid)
+            throw new InvalidOperationException("libvosk failed to create a recognizer");
+    }
+
+    public void SetWords(bool words) => VoskNative.RecognizerSetWords(_handle, words ? 1 : 0);
+
+    public void SetMaxAlternatives(int maxAlternatives) => VoskNative.RecognizerSetMaxAlternatives(_handle, maxAlternatives);
+
+    public void Reset() => VoskNative.RecognizerReset(_handle);
+
+    /// <summary>
+    /// Feeds 16-bit little-endian PCM. Returns true when an utterance ended and <see cref="Result"/> is ready.
+    /// </summary>
+    public bool AcceptWaveform(ReadOnlySpan<byte> audio)
+    {
+        fixed (byte* data = audio)
+        {
+            return VoskNative.RecognizerAcceptWaveform(_handle, data, audio.Length) != 0;
+        }
+    }
+
+    public bool AcceptWaveform(ReadOnlySpan<short> samples)
+    {
+        fixed (short* data = samples)
+        {
+            return VoskNative.RecognizerAcceptWaveformShort(_handle, data, samples.Length) != 0;
+        }
+    }
+
+    public ReadOnlySpan<byte> Result() => AsSpan(VoskNative.RecognizerResult(_handle));
+
+    public ReadOnlySpan<byte> PartialResult() => AsSpan(VoskNative.RecognizerPartialResult(_handle));
+
+    public ReadOnlySpan<byte> FinalResult() => AsSpan(VoskNative.RecognizerFinalResult(_handle));
+
+    public void Dispose() => _handle.Dispose();
+
+    private static ReadOnlySpan<byte> AsSpan(byte* json) =>
+        json == null ? ReadOnlySpan<byte>.Empty : MemoryMarshal.CreateReadOnlySpanFromNullTerminated(json);
+}
@@ -0,0 +1,158 @@
+﻿using System.Text.Json;
+using Sttify.Corelib.Batch;
+
+namespace Sttify.Corelib.Engine.Vosk;
+
+/// <summary>
+/// Reads Vosk result JSON straight from UTF-8 with <see cref="Utf8JsonReader"/>, so results taken
+/// from <see cref="VoskNativeRecognizer"/> are never transcoded to a UTF-16 string first. Only the
+/// text itself is materialized. Malformed input throws <see cref="JsonException"/>.
+/// </summary>
+public static class VoskResultReader
+{
+    public const double DefaultConfidence = 0.95; // Used when the model reports no word confidences
+
+    /// <summary>
+    /// Reads <c>{"partial": "..."}</c>; empty when the member is missing.
+    /// </summary>
+    public static string ReadPartial(ReadOnlySpan<byte> json)
+    {
+        var reader = new Utf8JsonReader(json);
+        if (!reader.Read() || reader.TokenType != JsonTokenType.StartObject)
+            return string.Empty;
+
+        while (reader.Read() && reader.TokenType == JsonTokenType.PropertyName)
+        {
+            var isPartial = reader.ValueTextEquals("partial"u8);
+            reader.Read();
+            if (isPartial && reader.TokenType == JsonTokenType.String)
+                return reader.GetString() ?? string.Empty;
+
+            reader.Skip();
+        }
+
+        return string.Empty;
+    }
+
+    /// <summary>
+    /// Reads a result or final result: the trimmed <c>text</c> and the mean of the per-word
+    /// <c>conf</c> values, falling back to a top-level <c>confidence</c>. False when there is no text.
+    /// </summary>
+    public static bool TryReadFinal(ReadOnlySpan<byte> json, out string text, out double confidence) =>
+        TryReadFinal(json, out text, out confidence, words: null);
+
+    /// <summary>
+    /// As <see cref="TryReadFinal(ReadOnlySpan{byte}, out string, out double)"/>, also appending
+    /// the per-word timings (recognizer-relative seconds) reported when words are enabled.
+    /// </summary>
+    public static bool TryReadFinal(ReadOnlySpan<byte> json, out string text, out double confidence, List<TranscriptWord>? words)
+    {
+        text = string.Empty;
+        confidence = DefaultConfidence;
+        double? topLevelConfidence = null;
+        double sum = 0.0;
+        var count = 0;
+
+        var reader = new Utf8JsonReader(json);
+        if (!reader.Read() || reader.TokenType != JsonTokenType.StartObject)
+            return false;
+
+        while (reader.Read() && reader.TokenType == JsonTokenType.PropertyName)
+        {
+            if (reader.ValueTextEquals("text"u8))
+            {
+                reader.Read();
+                text = reader.TokenType == JsonTokenType.String ? reader.GetString()?.Trim() ?? string.Empty : string.Empty;
+            }
+            else if (reader.ValueTextEquals("result"u8))
+            {
+                reader.Read();
+                ReadWords(ref reader, words, ref sum, ref count);
+            }
+            else if (reader.ValueTextEquals("confidence"u8))
+            {
+                reader.Read();
+                if (reader.TokenType == JsonTokenType.Number)
+                {
+                    topLevelConfidence = reader.GetDouble();
+                }
+            }
+            else
+            {
+                reader.Read();
+                reader.Skip();
+            }
+        }
+
+        if (count > 0)
+        {
+            confidence = Math.Clamp(sum / count, 0.0, 1.0);
+        }
+        else if (topLevelConfidence.HasValue)
+        {
+            confidence = Math.Clamp(topLevelConfidence.Value, 0.0, 1.0);
+        }
+
+        return text.Length > 0;
+    }
+
+    private static void ReadWords(ref Utf8JsonReader reader, List<TranscriptWord>? words, ref double sum, ref int count)
+    {
+        if (reader.TokenType != JsonTokenType.StartArray)
+        {
+            reader.Skip();
+            return;
+        }
+
+        while (reader.Read() && reader.TokenType != JsonTokenType.EndArray)
+        {
+            if (reader.TokenType != JsonTokenType.StartObject)
+            {
+                reader.Skip();
+                continue;
+            }
+
+            var word = words != null ? new TranscriptWord() : null;
+            while (reader.Read() && reader.TokenType == JsonTokenType.PropertyName)
+            {
+                var isConfidence = reader.ValueTextEquals("conf"u8);
+                var isStart = !isConfidence && reader.ValueTextEquals("start"u8);
+                var isEnd = !isConfidence && !isStart && reader.ValueTextEquals("end"u8);
+                var isWord = word != null && reader.ValueTextEquals("word"u8);
+                reader.Read();
+
+                if (reader.TokenType == JsonTokenType.Number && (isConfidence || isStart || isEnd))
+                {
+                    var value = reader.GetDouble();
+                    if (isConfidence)
+                    {
+                        sum += value;
+                        count++;
+                        if (word != null)
+                            word.Confidence = value;
+                    }
+                    else if (word != null)
+                    {
+                        if (isStart)
+                            word.Start = TimeSpan.FromSeconds(value);
+                        else
+                            word.End = TimeSpan.FromSeconds(value);
+                    }
+                }
+                else if (isWord && reader.TokenType == JsonTokenType.String)
+                {
+                    word!.Word = reader.GetString() ?? "";
+                }
+                else
+                {
+                    reader.Skip();
+                }
+            }
+
+            if (word != null)
+            {
+                words!.Add(word);
+            }
+        }
+    }
+}
@@ -12,6 +12,20 @@ public interface ITextOutputSink
     Task SendAsync(string text, CancellationToken cancellationToken = default);
 }
 
+/// <summary>
+/// Sinks that can rewrite the text they delivered most recently, e.g. when a more accurate
+/// transcript of the same utterance arrives later.
+/// </summary>
+public interface ITextReplacingSink
+{
+    /// <summary>
+    /// Replaces <paramref name="previousText"/> with <paramref name="replacementText"/>. Returns false,
+    /// leaving the output untouched, when <paramref name="previousText"/> is no longer the last text sent.
+    /// Throws <see cref="TextOutputFailedException"/> when the old text was removed but the new text could not be written.
+    /// </summary>
+    Task<bool> ReplaceLastAsync(string previousText, string replacementText, CancellationToken cancellationToken = default);
+}
+
 public enum TextInsertionMode
 {
     FinalOnly,
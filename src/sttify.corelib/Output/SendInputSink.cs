@@ -11,6 +11,7 @@ using CsINPUT = Windows.Win32.UI.Input.KeyboardAndMouse.INPUT;
 using CsINPUT_TYPE = Windows.Win32.UI.Input.KeyboardAndMouse.INPUT_TYPE;
 using CsKEYBD_EVENT_FLAGS = Windows.Win32.UI.Input.KeyboardAndMouse.KEYBD_EVENT_FLAGS;
 using CsKEYBDINPUT = Windows.Win32.UI.Input.KeyboardAndMouse.KEYBDINPUT;
+using CsLASTINPUTINFO = Windows.Win32.UI.Input.KeyboardAndMouse.LASTINPUTINFO;
 using CsVIRTUAL_KEY = Windows.Win32.UI.Input.KeyboardAndMouse.VIRTUAL_KEY;
 // Reserved for future CsWin32 migrations
 using Win32PInvoke = Windows.Win32.PInvoke;
@@ -18,13 +19,20 @@ using Win32PInvoke = Windows.Win32.PInvoke;
 namespace Sttify.Corelib.Output;
 
 [ExcludeFromCodeCoverage] // Win32 SendInput API integration, difficult to mock effectively
-public class SendInputSink : ITextOutputSink
+public class SendInputSink : ITextOutputSink, ITextReplacingSink
 {
     private const uint CfUnicodetext = 13;
+    private const int VkBack = 0x08;
+    private const int InputSettleMs = 50; // Our own injected input may be stamped slightly after SendInput returns
     private readonly ImeController _imeController;
 
     private readonly SendInputSettings _settings;
 
+    // Last text typed, where and when, so a later correction can backspace over exactly that text
+    private string? _lastSentText;
+    private int _lastSentTick;
+    private IntPtr _lastTargetWindow;
+
     public SendInputSink(SendInputSettings? settings = null)
     {
         _settings = settings ?? new SendInputSettings();
@@ -162,9 +170,102 @@ public class SendInputSink : ITextOutputSink
             }
         }
 
+        _lastSentText = text;
+        _lastSentTick = Environment.TickCount;
+        _lastTargetWindow = targetWindow;
         System.Diagnostics.Debug.WriteLine($"*** SendInputSink.SendAsync - Completed sending '{text}' ***");
     }
 
+    [SupportedOSPlatform("windows")]
+    public async Task<bool> ReplaceLastAsync(string previousText, string replacementText, CancellationToken cancellationToken = default)
+    {
+        // A commit key may have moved the caret past our text, so corrections are not attempted
+        if (!IsAvailable || _settings.CommitKey != null || string.IsNullOrEmpty(previousText))
+            return false;
+
+        // Only safe while the caret is still right after our text in the same window: any key, click
+        // or mouse move since we typed it may have moved the caret or added text we would delete
+        var targetWindow = (IntPtr)GetForegroundWindow();
+        if (!string.Equals(_lastSentText, previousText, StringComparison.Ordinal) || targetWindow != _lastTargetWindow)
+            return false;
+
+        if (HasUserInputSince(_lastSentTick))
+        {
+            Telemetry.LogEvent("SendInputReplaceSkipped", new { Reason = "UserInput" });
+            return false;
+        }
+
+        if (!await CanSendAsync(cancellationToken))
+            return false;
+
+        // Keep the shared prefix on screen and retype only what changed
+        var common = 0;
+        var limit = Math.Min(previousText.Length, replacementText.Length);
+        while (common < limit && previousText[common] == replacementText[common])
+            common++;
+        if (common > 0 && char.IsHighSurrogate(previousText[common - 1]))
+            common--;
+
+        var deleteCount = new System.Globalization.StringInfo(previousText[common..]).LengthInTextElements;
+        if (deleteCount > 0 && !SendBackspaces(deleteCount))
+            return false;
+
+        // From here the old text is gone, so a failure to type the new text must not pass silently
+        _lastSentText = null;
+        if (common < replacementText.Length)
+        {
+            var imeRestorer = _settings.Ime.EnableImeControl ? _imeController.SuppressImeTemporarily() : null;
+            bool inserted;
+            try
+            {
+                inserted = await SendTextViaInputAsync(replacementText[common..], cancellationToken);
+            }
+            finally
+            {
+                imeRestorer?.Dispose();
+            }
+
+            if (!inserted)
+            {
+                Telemetry.LogError("SendInputReplaceFailed", new InvalidOperationException("SendInput rejected the replacement text"), new { Deleted = deleteCount });
+                throw new TextOutputFailedException($"Deleted {deleteCount} characters but could not type the replacement text");
+            }
+        }
+
+        _lastSentText = replacementText;
+        _lastSentTick = Environment.TickCount;
+        _lastTargetWindow = targetWindow;
+        Telemetry.LogEvent("SendInputTextReplaced", new { Deleted = deleteCount, Inserted = replacementText.Length - common });
+        return true;
+    }
+
+    [SupportedOSPlatform("windows")]
+    private static bool HasUserInputSince(int tick)
+    {
+        // Same clock as Environment.TickCount; unchecked subtraction handles the 49.7-day wrap
+        var info = new CsLASTINPUTINFO { cbSize = (uint)Marshal.SizeOf<CsLASTINPUTINFO>() };
+        if (!Win32PInvoke.GetLastInputInfo(ref info))
+            return true;
+
+        return unchecked((int)info.dwTime - tick) > InputSettleMs;
+    }
+
+    [SupportedOSPlatform("windows")]
+    private static unsafe bool SendBackspaces(int count)
+    {
+        var inputs = new CsINPUT[count * 2];
+        for (int i = 0; i < count; i++)
+        {
+            inputs[i * 2] = CreateKeyInput(VkBack, false);
+            inputs[i * 2 + 1] = CreateKeyInput(VkBack, true);
+        }
+
+        fixed (CsINPUT* pInputs = inputs)
+        {
+            return SafeSendInput((uint)inputs.Length, pInputs, Marshal.SizeOf<CsINPUT>()) == (uint)inputs.Length;
+        }
+    }
+
     /// <summary>
     /// Check if the current Windows version supports SendInput API (Windows 5.0+)
     /// </summary>
@@ -0,0 +1,37 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using static Vanara.PInvoke.User32;
+
+namespace Sttify.Corelib.Session;
+
+/// <summary>
+/// Identifies the application the user is dictating into, used to key per-application behaviour.
+/// </summary>
+[ExcludeFromCodeCoverage] // Win32 foreground window query
+public static class ForegroundAppContext
+{
+    public static string GetCurrentContextKey(string fallback)
+    {
+        try
+        {
+            if (!OperatingSystem.IsWindows())
+                return fallback;
+
+            var window = GetForegroundWindow();
+            if (window.IsNull)
+                return fallback;
+
+            GetWindowThreadProcessId(window, out uint processId);
+            if (processId == 0)
+                return fallback;
+
+            using var process = Process.GetProcessById((int)processId);
+            return process.ProcessName.ToLowerInvariant();
+        }
+        catch (Exception ex) when (ex is ArgumentException or InvalidOperationException or System.ComponentModel.Win32Exception)
+        {
+            // Process exited or is inaccessible
+            return fallback;
+        }
+    }
+}
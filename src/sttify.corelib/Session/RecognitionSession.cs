@@ -1,22 +1,55 @@
-﻿using System.Diagnostics.CodeAnalysis;
+﻿using System.Buffers;
+using System.Diagnostics.CodeAnalysis;
+using System.Threading.Channels;
 using Sttify.Corelib.Audio;
 using Sttify.Corelib.Diagnostics;
 using Sttify.Corelib.Engine;
+using Sttify.Corelib.Engine.Vosk;
 using Sttify.Corelib.Output;
 using Sttify.Corelib.Plugins;
+using Sttify.Corelib.Text;
+using Sttify.Corelib.Wake;
 
 namespace Sttify.Corelib.Session;
 
+/// <summary>
+/// Drives capture, engine, endpointing and output for one recognition session. Capture frames,
+/// engine results, endpoint events and commands (start/stop/PTT/mode) are posted to a single
+/// event loop and handled in the order they arrived, so session state is owned by that loop and
+/// needs no locks. Finals leave the loop through an ordered output stage and reach the sinks in
+/// utterance order without a slow sink holding up the audio.
+/// </summary>
 public class RecognitionSession : IDisposable
 {
     private readonly AudioCapture _audioCapture;
     private readonly EndpointDetector _endpointDetector;
-    private readonly object _lockObject = new();
+    private readonly Func<Config.EngineSettings, ISttEngine> _engineFactory;
     private readonly IOutputSinkProvider _outputSinkProvider;
     private readonly PluginManager? _pluginManager;
     private readonly RecognitionSessionSettings _settings;
     private readonly Config.SettingsProvider _settingsProvider;
     private readonly List<string> _wakeWords = ["スティファイ", "sttify"];
+    private readonly WakePhraseMatcher _wakeWordMatcher;
+    private readonly WakePhraseScanner _wakeWordScanner;
+
+    private const int MaxQueuedAudioMs = 2000; // Audio the loop may fall behind by (e.g. during engine start) before frames are dropped
+
+    // Event loop: the only reader of _events and the only writer of _outputs. Control events are
+    // never dropped; audio is bounded separately by _queuedAudioBytes.
+    private readonly Channel<SessionEvent> _events = Channel.CreateUnbounded<SessionEvent>(new UnboundedChannelOptions { SingleReader = true });
+    private readonly Channel<EventArgs> _outputs = Channel.CreateUnbounded<EventArgs>(new UnboundedChannelOptions { SingleReader = true, SingleWriter = true });
+    private readonly Task _eventLoop;
+    private readonly Task _outputLoop;
+
+    // Events raised by a component while the loop is calling into it (e.g. the endpoint detector
+    // inside ProcessAudioFrame); handled right after the current event instead of behind the queue
+    private readonly List<SessionEvent> _reentrantEvents = [];
+    private volatile int _dispatchThreadId;
+
+    // Audio posted to the loop but not handled yet, and frames dropped because of it
+    private long _queuedAudioBytes;
+    private long _droppedAudioFrames;
+    private int _audioBacklogWarned;
 
     // Continuous mode state
     private CancellationTokenSource? _continuousModeCts;
@@ -24,8 +57,37 @@ public class RecognitionSession : IDisposable
     // Voice activity detection events
     // OnVoiceActivity event removed - not used
 
+    // The loop applies mode changes in order with frames; the public getter reports the last request
     private RecognitionMode _currentMode = RecognitionMode.Ptt;
-    private SessionState _currentState = SessionState.Idle;
+    private volatile RecognitionMode _requestedMode = RecognitionMode.Ptt;
+    private volatile SessionState _currentState = SessionState.Idle;
+
+    // Audio-level wake word spotter (null = transcript matching fallback); the wait flag is set by
+    // the loop but read from capture and host threads
+    private IKeywordSpotter? _keywordSpotter;
+    private volatile bool _isWaitingForWakeWord;
+
+    // Learned endpointing: per-application pause profile and the context of the current utterance
+    private AdaptiveEndpointProfile? _endpointProfile;
+    private string _endpointContext = AdaptiveEndpointProfile.DefaultContext;
+
+    // User corrections applied to partials and finals (null = disabled or not loaded yet)
+    private volatile UserDictionary? _userDictionary;
+
+    // Last final delivered to a sink, so a refined transcript can replace it (output stage only)
+    private LastDelivery? _lastDelivery;
+
+    // Pre-roll requested by StartUtteranceFromPast, replayed before the next frame (0 = none)
+    private int _pendingPreRollMs;
+    // History position where the last spotted keyword ended; replay starts there (-1 = none)
+    private long _keywordEndPosition = -1;
+    // End of the last frame handed to the spotter, stamped on the hits it reports
+    private long _spotterPosition;
+    private int _frameMs;
+
+    // Optional noise suppression between capture and the engine
+    private NoiseSuppressor? _noiseSuppressor;
+    private byte[] _suppressedFrame = [];
 
     // PTT state
     private ISttEngine? _sttEngine;
@@ -41,7 +103,8 @@ public class RecognitionSession : IDisposable
         Config.SettingsProvider settingsProvider,
         IOutputSinkProvider outputSinkProvider,
         RecognitionSessionSettings settings,
-        PluginManager? pluginManager = null)
+        PluginManager? pluginManager = null,
+        Func<Config.EngineSettings, ISttEngine>? engineFactory = null)
     {
         System.Diagnostics.Debug.WriteLine($"*** RecognitionSession Constructor - Instance ID: {System.Runtime.CompilerServices.RuntimeHelpers.GetHashCode(this)} ***");
         _audioCapture = audioCapture ?? throw new ArgumentNullException(nameof(audioCapture));
@@ -49,23 +112,20 @@ public class RecognitionSession : IDisposable
         _outputSinkProvider = outputSinkProvider ?? throw new ArgumentNullException(nameof(outputSinkProvider));
         _settings = settings ?? throw new ArgumentNullException(nameof(settings));
         _pluginManager = pluginManager;
+        _engineFactory = engineFactory ?? SttEngineFactory.CreateEngine;
 
         _audioCapture.OnFrame += OnAudioFrame;
 
-        // Initialize endpoint detector using session settings
+        // Initialize endpoint detector using session settings; its timer fires on another thread,
+        // so every callback is posted to the loop
         _endpointDetector = new EndpointDetector(new EndpointSettings
         {
             SilenceTimeoutMs = _settings.EndpointSilenceMs
         });
-        _endpointDetector.OnEndpointTriggered += OnEndpointTriggered;
-        _endpointDetector.OnUtteranceStarted += (_, _) =>
-        {
-            Telemetry.LogEvent("SessionUtteranceStarted");
-        };
-        _endpointDetector.OnUtteranceEnded += (_, e) =>
-        {
-            Telemetry.LogEvent("SessionUtteranceEnded", new { e.Duration, e.EndpointType, e.Confidence });
-        };
+        _endpointDetector.OnEndpointTriggered += (_, e) => Post(new SessionEvent(SessionEventKind.EndpointTriggered, e));
+        _endpointDetector.OnUtteranceStarted += (_, e) => Post(new SessionEvent(SessionEventKind.UtteranceStarted, e));
+        _endpointDetector.OnUtteranceEnded += (_, e) => Post(new SessionEvent(SessionEventKind.UtteranceEnded, e));
+        _endpointDetector.OnPauseObserved += (_, e) => Post(new SessionEvent(SessionEventKind.PauseObserved, e));
 
         // No session-level silence/finalize timers
 
@@ -75,68 +135,42 @@ public class RecognitionSession : IDisposable
             _wakeWords.AddRange(_settings.WakeWords);
         }
 
+        _wakeWordMatcher = new WakePhraseMatcher(_wakeWords);
+        _wakeWordScanner = _wakeWordMatcher.CreateScanner();
+
+        _eventLoop = Task.Run(RunEventLoopAsync);
+        _outputLoop = Task.Run(RunOutputLoopAsync);
+
         Telemetry.LogEvent("RecognitionSessionCreated", new
         {
             Mode = _currentMode.ToString(),
             _settings.EndpointSilenceMs,
-            WakeWordsCount = _wakeWords.Count
+            WakeWordsCount = _wakeWordMatcher.Phrases.Count
         });
     }
 
     public RecognitionMode CurrentMode
     {
-        get { lock (_lockObject) { return _currentMode; } }
+        get => _requestedMode;
         set
         {
-            lock (_lockObject)
-            {
-                if (_currentMode != value)
-                {
-                    var oldMode = _currentMode;
-                    _currentMode = value;
-
-                    // Reset state when mode changes
-                    if (value == RecognitionMode.Ptt)
-                    {
-                        IsPttPressed = false;
-                    }
-                    else if (value == RecognitionMode.WakeWord)
-                    {
-                        IsWaitingForWakeWord = true;
-                    }
-
-                    OnModeChanged(oldMode, value);
-                }
-            }
+            _requestedMode = value;
+            Post(new SessionEvent(SessionEventKind.SetMode, Value: (int)value));
         }
     }
 
     public SessionState CurrentState
     {
-        get { lock (_lockObject) { return _currentState; } }
+        get => _currentState;
         private set
         {
-            SessionState oldState;
-            bool changed = false;
-            lock (_lockObject)
-            {
-                if (_currentState != value)
-                {
-                    oldState = _currentState;
-                    _currentState = value;
-                    changed = true;
-                }
-                else
-                {
-                    oldState = _currentState;
-                }
-            }
+            // Only the event loop changes state
+            var oldState = _currentState;
+            if (oldState == value)
+                return;
 
-            if (changed)
-            {
-                System.Diagnostics.Debug.WriteLine($"*** STATE CHANGE: {oldState} → {value} ***");
-                OnStateChanged?.Invoke(this, new SessionStateChangedEventArgs(oldState, value));
-            }
+            _currentState = value;
+            OnStateChanged?.Invoke(this, new SessionStateChangedEventArgs(oldState, value));
         }
     }
 
@@ -148,27 +182,37 @@ public class RecognitionSession : IDisposable
     /// <summary>
     /// Check if currently waiting for wake word
     /// </summary>
-    public bool IsWaitingForWakeWord { get; private set; }
+    public bool IsWaitingForWakeWord
+    {
+        get => _isWaitingForWakeWord;
+        private set => _isWaitingForWakeWord = value;
+    }
 
     public void Dispose()
     {
         try
         {
-            _continuousModeCts?.Cancel();
-            _continuousModeCts?.Dispose();
+            // Unsubscribe events to prevent memory leaks
+            _audioCapture.OnFrame -= OnAudioFrame;
+
+            StopAsync().Wait(5000); // Wait max 5 seconds
+
+            // Let the loop drain what is already queued so pending finals still reach the sinks
+            _events.Writer.TryComplete();
+            Task.WhenAll(_eventLoop, _outputLoop).Wait(5000);
 
             // Dispose endpoint detector
             _endpointDetector.Dispose();
 
-            // Unsubscribe events to prevent memory leaks
-            _audioCapture.OnFrame -= OnAudioFrame;
             if (_sttEngine != null)
             {
                 _sttEngine.OnPartial -= OnPartialRecognition;
                 _sttEngine.OnFinal -= OnFinalRecognition;
+                if (_sttEngine is IRefiningSttEngine refining)
+                {
+                    refining.OnRefined -= OnFinalRefined;
+                }
             }
-
-            StopAsync().Wait(5000); // Wait max 5 seconds
         }
         catch (Exception ex)
         {
@@ -176,15 +220,28 @@ public class RecognitionSession : IDisposable
         }
         finally
         {
+            _continuousModeCts?.Cancel();
+            _continuousModeCts?.Dispose();
             _audioCapture.Dispose();
             _sttEngine?.Dispose();
+            _userDictionary?.Dispose();
+            DisposeKeywordSpotter();
         }
     }
 
     public event EventHandler<SessionStateChangedEventArgs>? OnStateChanged;
     public event EventHandler<TextRecognizedEventArgs>? OnTextRecognized;
 
-    public async Task StartAsync(CancellationToken cancellationToken = default)
+    /// <summary>
+    /// Starts the session on the event loop; completes once it is listening or has failed.
+    /// </summary>
+    public Task StartAsync(CancellationToken cancellationToken = default)
+    {
+        return PostCommandAsync(SessionEventKind.Start, cancellationToken)
+            ?? Task.FromException(new ObjectDisposedException(nameof(RecognitionSession)));
+    }
+
+    private async Task StartCoreAsync(CancellationToken cancellationToken)
     {
         System.Diagnostics.Debug.WriteLine($"*** RecognitionSession.StartAsync ENTRY - Current State: {CurrentState} ***");
         Telemetry.LogEvent("RecognitionSession_StartRequested", new { CurrentState = CurrentState.ToString() });
@@ -211,6 +268,10 @@ public class RecognitionSession : IDisposable
                 {
                     _sttEngine.OnPartial -= OnPartialRecognition;
                     _sttEngine.OnFinal -= OnFinalRecognition;
+                    if (_sttEngine is IRefiningSttEngine refining)
+                    {
+                        refining.OnRefined -= OnFinalRefined;
+                    }
                     _sttEngine.Dispose();
                 }
                 catch (Exception disposeEx)
@@ -224,33 +285,63 @@ public class RecognitionSession : IDisposable
             }
 
             var appSettings = await _settingsProvider.GetSettingsAsync().ConfigureAwait(false);
-            var engine = SttEngineFactory.CreateEngine(appSettings.Engine);
+            var engine = _engineFactory(appSettings.Engine);
             engine.OnPartial += OnPartialRecognition;
             engine.OnFinal += OnFinalRecognition;
+            if (engine is IRefiningSttEngine refiningEngine)
+            {
+                refiningEngine.OnRefined += OnFinalRefined;
+            }
             _sttEngine = engine;
 
+            if (_settings.EnableLearnedEndpointing && _endpointProfile == null)
+            {
+                _endpointProfile = await Task.Run(() => AdaptiveEndpointProfile.Load(GetEndpointProfilePath()), cancellationToken).ConfigureAwait(false);
+            }
+            ApplyLearnedSilenceTimeout(force: true);
+
+            if (_settings.EnableUserDictionary && _userDictionary == null)
+            {
+                _userDictionary = await Task.Run(() => new UserDictionary(GetUserDictionaryPath()), cancellationToken).ConfigureAwait(false);
+            }
+
             System.Diagnostics.Debug.WriteLine($"*** About to call _sttEngine.StartAsync() on {_sttEngine.GetType().Name} ***");
             Telemetry.LogEvent("RecognitionSession_StartingEngine");
             // Guard against engine start hanging indefinitely
-            await _sttEngine.StartAsync(cancellationToken).WaitAsync(TimeSpan.FromSeconds(10));
+            await _sttEngine.StartAsync(cancellationToken).WaitAsync(TimeSpan.FromSeconds(10)).ConfigureAwait(false);
             System.Diagnostics.Debug.WriteLine($"*** _sttEngine.StartAsync() completed successfully ***");
             Telemetry.LogEvent("RecognitionSession_EngineStarted");
 
+            _pendingPreRollMs = 0;
+            _keywordEndPosition = -1;
+            _frameMs = Math.Clamp(appSettings.Audio.FrameMs > 0 ? appSettings.Audio.FrameMs : _settings.BufferSizeMs,
+                FrameRechunker.MinFrameMs, FrameRechunker.MaxFrameMs);
+            _noiseSuppressor = appSettings.Audio.NoiseSuppression.Enabled
+                ? new NoiseSuppressor(appSettings.Audio.NoiseSuppression)
+                : null;
             var audioCaptureSettings = new AudioCaptureSettings
             {
                 SampleRate = _settings.SampleRate,
                 Channels = _settings.Channels,
-                BufferSize = (_settings.SampleRate * _settings.Channels * 2 * _settings.BufferSizeMs) / 1000 // Convert ms to buffer size
+                BufferSize = FrameRechunker.GetFrameBytes(_settings.SampleRate, _settings.Channels, 16, _frameMs),
+                FrameIntervalMs = _frameMs,
+                HistoryMs = Math.Max(1000, _settings.PreRollMs),
+                Source = appSettings.Audio.Source
             };
 
-            Telemetry.LogEvent("RecognitionSession_StartingAudioCapture", new { audioCaptureSettings.SampleRate, audioCaptureSettings.Channels, audioCaptureSettings.BufferSize });
+            Telemetry.LogEvent("RecognitionSession_StartingAudioCapture", new { audioCaptureSettings.SampleRate, audioCaptureSettings.Channels, audioCaptureSettings.BufferSize, audioCaptureSettings.FrameIntervalMs, NoiseSuppression = _noiseSuppressor != null });
             // Guard against audio capture start hanging indefinitely
-            await _audioCapture.StartAsync(audioCaptureSettings, cancellationToken).WaitAsync(TimeSpan.FromSeconds(10));
+            await _audioCapture.StartAsync(audioCaptureSettings, cancellationToken).WaitAsync(TimeSpan.FromSeconds(10)).ConfigureAwait(false);
             Telemetry.LogEvent("RecognitionSession_AudioCaptureStarted");
 
+            if (_currentMode == RecognitionMode.WakeWord)
+            {
+                await StartKeywordSpotterAsync(appSettings, cancellationToken).ConfigureAwait(false);
+            }
+
             // Initialize mode-specific behavior
-            Telemetry.LogEvent("RecognitionSession_InitializingMode", new { Mode = CurrentMode.ToString() });
-            await InitializeModeAsync(cancellationToken);
+            Telemetry.LogEvent("RecognitionSession_InitializingMode", new { Mode = _currentMode.ToString() });
+            await InitializeModeAsync(cancellationToken).ConfigureAwait(false);
             Telemetry.LogEvent("RecognitionSession_ModeInitialized");
 
             CurrentState = SessionState.Listening;
@@ -258,7 +349,7 @@ public class RecognitionSession : IDisposable
 
             Telemetry.LogEvent("RecognitionSessionStarted", new
             {
-                Mode = CurrentMode.ToString(),
+                Mode = _currentMode.ToString(),
                 AudioSettings = new { audioCaptureSettings.SampleRate, audioCaptureSettings.Channels }
             });
             System.Diagnostics.Debug.WriteLine("*** RecognitionSession startup completed successfully ***");
@@ -268,14 +359,14 @@ public class RecognitionSession : IDisposable
             System.Diagnostics.Debug.WriteLine($"*** EXCEPTION in RecognitionSession.StartAsync: {ex.GetType().Name} - {ex.Message} ***");
             System.Diagnostics.Debug.WriteLine($"*** Exception Stack Trace: {ex.StackTrace} ***");
             CurrentState = SessionState.Error;
-            Telemetry.LogError("RecognitionSessionStartFailed", ex, new { Mode = CurrentMode.ToString() });
+            Telemetry.LogError("RecognitionSessionStartFailed", ex, new { Mode = _currentMode.ToString() });
             throw;
         }
     }
 
     private Task InitializeModeAsync(CancellationToken _)
     {
-        switch (CurrentMode)
+        switch (_currentMode)
         {
             case RecognitionMode.Continuous:
                 _continuousModeCts = new CancellationTokenSource();
@@ -284,7 +375,11 @@ public class RecognitionSession : IDisposable
 
             case RecognitionMode.WakeWord:
                 IsWaitingForWakeWord = true;
-                Telemetry.LogEvent("WakeWordModeStarted", new { WakeWords = _wakeWords });
+                Telemetry.LogEvent("WakeWordModeStarted", new
+                {
+                    WakeWords = _wakeWords,
+                    AudioSpotter = _keywordSpotter != null
+                });
                 break;
 
             case RecognitionMode.Ptt:
@@ -299,15 +394,24 @@ public class RecognitionSession : IDisposable
         return Task.CompletedTask;
     }
 
-    public async Task StopAsync()
+    /// <summary>
+    /// Stops the session on the event loop. Results the engine flushes while stopping are still
+    /// delivered, after everything queued before them.
+    /// </summary>
+    public Task StopAsync()
+    {
+        return PostCommandAsync(SessionEventKind.Stop, CancellationToken.None) ?? Task.CompletedTask;
+    }
+
+    private async Task StopCoreAsync()
     {
         try
         {
             CurrentState = SessionState.Stopping;
-            await _audioCapture.StopAsync().WaitAsync(TimeSpan.FromSeconds(5));
+            await _audioCapture.StopAsync().WaitAsync(TimeSpan.FromSeconds(5)).ConfigureAwait(false);
             if (_sttEngine != null)
             {
-                await _sttEngine.StopAsync().WaitAsync(TimeSpan.FromSeconds(5));
+                await _sttEngine.StopAsync().WaitAsync(TimeSpan.FromSeconds(5)).ConfigureAwait(false);
             }
         }
         catch (Exception ex)
@@ -316,30 +420,480 @@ public class RecognitionSession : IDisposable
         }
         finally
         {
+            DisposeKeywordSpotter();
+            _endpointProfile?.Save(GetEndpointProfilePath());
             CurrentState = SessionState.Idle;
         }
     }
 
+    private Task? PostCommandAsync(SessionEventKind kind, CancellationToken cancellationToken)
+    {
+        var command = new SessionCommand(new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously), cancellationToken);
+        return _events.Writer.TryWrite(new SessionEvent(kind, command)) ? command.Completion.Task : null;
+    }
+
+    private void Post(SessionEvent e)
+    {
+        if (Environment.CurrentManagedThreadId == _dispatchThreadId)
+        {
+            _reentrantEvents.Add(e);
+            return;
+        }
+
+        if (!_events.Writer.TryWrite(e) && e.Audio != null)
+        {
+            // Disposed; nobody will handle the frame
+            Interlocked.Add(ref _queuedAudioBytes, -e.Value);
+            ArrayPool<byte>.Shared.Return(e.Audio);
+        }
+    }
+
+    private async Task RunEventLoopAsync()
+    {
+        try
+        {
+            await foreach (var e in _events.Reader.ReadAllAsync().ConfigureAwait(false))
+            {
+                await HandleEventAsync(e).ConfigureAwait(false);
+
+                for (int i = 0; i < _reentrantEvents.Count; i++)
+                {
+                    await HandleEventAsync(_reentrantEvents[i]).ConfigureAwait(false);
+                }
+                _reentrantEvents.Clear();
+            }
+        }
+        finally
+        {
+            _outputs.Writer.TryComplete();
+        }
+    }
+
+    private async Task HandleEventAsync(SessionEvent e)
+    {
+        if (e.Kind is SessionEventKind.Start or SessionEventKind.Stop)
+        {
+            // Lifecycle commands await I/O; events posted meanwhile wait their turn
+            var command = (SessionCommand)e.Args!;
+            try
+            {
+                if (e.Kind == SessionEventKind.Start)
+                {
+                    await StartCoreAsync(command.CancellationToken).ConfigureAwait(false);
+                }
+                else
+                {
+                    await StopCoreAsync().ConfigureAwait(false);
+                }
+
+                command.Completion.TrySetResult();
+            }
+            catch (Exception ex)
+            {
+                command.Completion.TrySetException(ex);
+            }
+
+            return;
+        }
+
+        if (e.Audio != null && Interlocked.Add(ref _queuedAudioBytes, -e.Value) == 0)
+        {
+            // Caught up; warn again the next time the loop falls behind
+            Volatile.Write(ref _audioBacklogWarned, 0);
+        }
+
+        _dispatchThreadId = Environment.CurrentManagedThreadId;
+        try
+        {
+            HandleEvent(e);
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogError("RecognitionSessionEventFailed", ex, new { Kind = e.Kind.ToString() });
+        }
+        finally
+        {
+            _dispatchThreadId = 0;
+            if (e.Audio != null)
+            {
+                ArrayPool<byte>.Shared.Return(e.Audio);
+            }
+        }
+    }
+
+    private void HandleEvent(SessionEvent e)
+    {
+        switch (e.Kind)
+        {
+            case SessionEventKind.AudioFrame:
+                ProcessAudioFrame(e.Audio.AsSpan(0, e.Value), e.HistoryPosition);
+                break;
+            case SessionEventKind.Partial:
+                ProcessPartial((PartialRecognitionEventArgs)e.Args!);
+                break;
+            case SessionEventKind.Final:
+                ProcessFinal((FinalRecognitionEventArgs)e.Args!);
+                break;
+            case SessionEventKind.Refined:
+                _outputs.Writer.TryWrite((RefinedRecognitionEventArgs)e.Args!);
+                break;
+            case SessionEventKind.UtteranceStarted:
+                Telemetry.LogEvent("SessionUtteranceStarted");
+                if (_endpointProfile != null)
+                {
+                    _endpointContext = ForegroundAppContext.GetCurrentContextKey(AdaptiveEndpointProfile.DefaultContext);
+                }
+                break;
+            case SessionEventKind.UtteranceEnded:
+                var ended = (UtteranceEndedEventArgs)e.Args!;
+                Telemetry.LogEvent("SessionUtteranceEnded", new { ended.Duration, ended.EndpointType, ended.Confidence });
+                ApplyLearnedSilenceTimeout();
+                break;
+            case SessionEventKind.PauseObserved:
+                ProcessPause((PauseObservedEventArgs)e.Args!);
+                break;
+            case SessionEventKind.EndpointTriggered:
+                ProcessEndpoint((EndpointTriggeredEventArgs)e.Args!);
+                break;
+            case SessionEventKind.KeywordDetected:
+                ProcessKeyword((WakeWordDetectedEventArgs)e.Args!, e.HistoryPosition);
+                break;
+            case SessionEventKind.SetMode:
+                SetMode((RecognitionMode)e.Value);
+                break;
+            case SessionEventKind.StartPtt:
+            case SessionEventKind.StopPtt:
+                if (_currentMode == RecognitionMode.Ptt)
+                {
+                    IsPttPressed = e.Kind == SessionEventKind.StartPtt;
+                    // Additional PTT logic can be added here
+                }
+                break;
+            case SessionEventKind.StartFromPast:
+                _pendingPreRollMs = e.Value;
+                break;
+            case SessionEventKind.WakeWordMatched:
+                if (IsWaitingForWakeWord)
+                {
+                    AcceptWakeWord((string)e.Args!, "External");
+                }
+                break;
+        }
+    }
+
+    private void SetMode(RecognitionMode mode)
+    {
+        if (_currentMode == mode)
+            return;
+
+        var oldMode = _currentMode;
+        _currentMode = mode;
+
+        // Reset state when mode changes
+        if (mode == RecognitionMode.Ptt)
+        {
+            IsPttPressed = false;
+        }
+        else if (mode == RecognitionMode.WakeWord)
+        {
+            IsWaitingForWakeWord = true;
+        }
+
+        OnModeChanged(oldMode, mode);
+    }
+
+    private string GetEndpointProfilePath()
+    {
+        return string.IsNullOrEmpty(_settings.EndpointProfilePath)
+            ? AdaptiveEndpointProfile.GetDefaultProfilePath()
+            : _settings.EndpointProfilePath;
+    }
+
+    private string GetUserDictionaryPath()
+    {
+        return string.IsNullOrEmpty(_settings.UserDictionaryPath)
+            ? UserDictionary.GetDefaultDictionaryPath()
+            : _settings.UserDictionaryPath;
+    }
+
+    private void ProcessPause(PauseObservedEventArgs e)
+    {
+        var profile = _endpointProfile;
+        if (profile == null)
+            return;
+
+        // A gap after an endpoint is usually the pause between sentences; only one the speaker filled
+        // straight after the endpoint fired is treated as a cut-off pause at full weight
+        profile.RecordPause(_endpointContext, e.Duration, confirmed: !e.AfterEndpoint || e.IsLikelyCutOff);
+
+        if (e.IsLikelyCutOff)
+        {
+            Telemetry.LogEvent("PrematureEndpointObserved", new
+            {
+                Context = _endpointContext,
+                GapMs = e.Duration.TotalMilliseconds,
+                _endpointDetector.SilenceTimeoutMs
+            });
+        }
+    }
+
+    /// <summary>
+    /// Retunes the session and engine silence timeouts for the current application from the learned
+    /// pause profile. Only called between utterances so an utterance never sees its timeout change.
+    /// </summary>
+    private void ApplyLearnedSilenceTimeout(bool force = false)
+    {
+        var profile = _endpointProfile;
+        if (profile == null)
+            return;
+
+        var context = _endpointContext;
+        var timeoutMs = profile.GetSilenceTimeoutMs(context, _settings.EndpointSilenceMs);
+        if (!force && timeoutMs == _endpointDetector.SilenceTimeoutMs)
+            return;
+
+        _endpointDetector.SilenceTimeoutMs = timeoutMs;
+        if (_sttEngine is ISilenceTimeoutTunable tunableEngine)
+        {
+            tunableEngine.SilenceTimeoutMs = timeoutMs;
+        }
+
+        Telemetry.LogEvent("LearnedSilenceTimeoutApplied", new
+        {
+            Context = context,
+            TimeoutMs = timeoutMs,
+            Observations = profile.GetObservationCount(context)
+        });
+    }
+
+    private async Task StartKeywordSpotterAsync(Config.SttifySettings appSettings, CancellationToken cancellationToken)
+    {
+        DisposeKeywordSpotter();
+
+        // The engine's own model is never reused: the default large models have a static graph, so
+        // the spotter would be a second full recognizer rather than a cheap gate
+        var wakeSettings = appSettings.Session.WakeWord;
+        var modelPath = wakeSettings.SpotterModelPath;
+        if (!wakeSettings.UseAudioSpotter || string.IsNullOrEmpty(modelPath))
+            return;
+
+        if (!VoskModelManager.IsModelInstalled(modelPath))
+        {
+            Telemetry.LogWarning("KeywordSpotterUnavailable", "No spotter model installed, using transcript matching", new { ModelPath = modelPath });
+            return;
+        }
+
+        if (!VoskModelManager.SupportsGrammar(modelPath))
+        {
+            Telemetry.LogWarning("KeywordSpotterGrammarUnsupported", "Spotter model has a static graph and ignores the grammar, using transcript matching", new { ModelPath = modelPath });
+            return;
+        }
+
+        var spotter = new VoskKeywordSpotter(modelPath, _wakeWords, _settings.SampleRate);
+        try
+        {
+            await spotter.StartAsync(cancellationToken).WaitAsync(TimeSpan.FromSeconds(10), cancellationToken).ConfigureAwait(false);
+            spotter.OnKeywordDetected += OnKeywordDetected;
+            _keywordSpotter = spotter;
+        }
+        catch (Exception ex)
+        {
+            // Fall back to matching wake words in the full recognizer's transcript
+            spotter.Dispose();
+            Telemetry.LogError("KeywordSpotterStartFailed", ex, new { ModelPath = modelPath });
+        }
+    }
+
+    private void DisposeKeywordSpotter()
+    {
+        var spotter = _keywordSpotter;
+        if (spotter == null)
+            return;
+
+        _keywordSpotter = null;
+        spotter.OnKeywordDetected -= OnKeywordDetected;
+        spotter.Dispose();
+    }
+
+    private void OnKeywordDetected(object? sender, WakeWordDetectedEventArgs e)
+    {
+        // The hit ended no later than the frame the spotter was given last
+        Post(new SessionEvent(SessionEventKind.KeywordDetected, e, HistoryPosition: Volatile.Read(ref _spotterPosition)));
+    }
+
+    private void ProcessKeyword(WakeWordDetectedEventArgs e, long keywordEnd)
+    {
+        if (!IsWaitingForWakeWord)
+            return;
+
+        IsWaitingForWakeWord = false;
+        Telemetry.LogEvent("WakeWordSpotted", new { e.WakeWord, Source = "AudioSpotter" });
+
+        // The engine has not heard anything yet; give it what followed the keyword (frames queued
+        // behind the hit went to the spotter) but not the tail of the wake phrase itself
+        _keywordEndPosition = keywordEnd;
+    }
+
+    /// <summary>
+    /// Starts the next utterance <paramref name="milliseconds"/> in the past: buffered capture history
+    /// is pushed to the engine as fast as it will accept it before the next live frame.
+    /// Only meaningful while the engine is not already receiving live audio (e.g. wake-word gating).
+    /// </summary>
+    public void StartUtteranceFromPast(int milliseconds)
+    {
+        if (milliseconds <= 0)
+            return;
+
+        Post(new SessionEvent(SessionEventKind.StartFromPast, Value: milliseconds));
+    }
+
+    private void ReplayPreRoll(ISttEngine engine, long start, long historyPosition)
+    {
+        var history = _audioCapture.History;
+        var requestedBytes = (int)Math.Clamp(historyPosition - start, 0, history?.Capacity ?? 0);
+        if (history == null || requestedBytes == 0)
+            return;
+
+        var bytesPerMs = BytesPerMs;
+        var milliseconds = bytesPerMs > 0 ? requestedBytes / bytesPerMs : 0;
+        var buffer = ArrayPool<byte>.Shared.Rent(requestedBytes);
+        try
+        {
+            // Capture may be several frames ahead of the loop; replay only what preceded this frame
+            var copied = history.CopyRange(buffer, historyPosition - requestedBytes, historyPosition);
+            // Replay in capture-sized frames so the engine sees the same cadence as live audio
+            var frameBytes = Math.Max(bytesPerMs * _frameMs, bytesPerMs);
+            for (int offset = 0; offset < copied; offset += frameBytes)
+            {
+                engine.PushAudio(buffer.AsSpan(offset, Math.Min(frameBytes, copied - offset)));
+            }
+
+            Telemetry.LogEvent("PreRollReplayed", new
+            {
+                RequestedMs = milliseconds,
+                ReplayedMs = bytesPerMs > 0 ? copied / bytesPerMs : 0
+            });
+        }
+        catch (Exception ex)
+        {
+            Telemetry.LogError("PreRollReplayFailed", ex, new { RequestedMs = milliseconds });
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+    }
+
+    private int BytesPerMs => _settings.SampleRate * _settings.Channels * 2 / 1000;
+
+    private bool IsGatedByWakeWord => _currentMode == RecognitionMode.WakeWord && IsWaitingForWakeWord;
+
     private void OnAudioFrame(object? sender, AudioFrameEventArgs e)
     {
-        // Avoid taking state lock inside engine lock: read once without re-entrancy risk
-        var stateSnapshot = CurrentState;
+        // The frame is only valid during the callback, so the loop gets a pooled copy. History is
+        // written after this returns, so its current position is where this frame starts.
+        var frame = e.AudioData.Span;
+        if (Interlocked.Add(ref _queuedAudioBytes, frame.Length) > (long)MaxQueuedAudioMs * BytesPerMs)
+        {
+            // The loop is stuck (e.g. awaiting an engine start); keep memory bounded rather than
+            // queueing audio nobody will hear in time. Capture history still holds it for pre-roll.
+            Interlocked.Add(ref _queuedAudioBytes, -frame.Length);
+            var dropped = Interlocked.Increment(ref _droppedAudioFrames);
+            if (Interlocked.Exchange(ref _audioBacklogWarned, 1) == 0)
+            {
+                Telemetry.LogWarning("SessionAudioBacklogDropped", "Event loop fell behind, dropping audio frames",
+                    new { MaxQueuedAudioMs, DroppedFrames = dropped });
+            }
+            return;
+        }
+
+        var buffer = ArrayPool<byte>.Shared.Rent(frame.Length);
+        frame.CopyTo(buffer);
+        var historyPosition = _audioCapture.History?.TotalWritten ?? 0;
+
+        Post(new SessionEvent(SessionEventKind.AudioFrame, Audio: buffer, Value: frame.Length, HistoryPosition: historyPosition));
+    }
+
+    private void ProcessAudioFrame(ReadOnlySpan<byte> frame, long historyPosition)
+    {
         // Feed endpoint detector for boundary detection
-        _endpointDetector.ProcessAudioFrame(e.AudioData.Span, _settings.SampleRate, _settings.Channels);
-        if (stateSnapshot == SessionState.Listening && _sttEngine != null)
+        _endpointDetector.ProcessAudioFrame(frame, _settings.SampleRate, _settings.Channels);
+
+        // Suppress every frame, not only while listening, so the noise estimate stays current
+        var audio = SuppressNoise(frame);
+        if (_currentState != SessionState.Listening)
+            return;
+
+        // While waiting for the wake word only the lightweight spotter sees audio
+        var spotter = _keywordSpotter;
+        if (spotter != null && IsGatedByWakeWord)
+        {
+            Volatile.Write(ref _spotterPosition, historyPosition + frame.Length);
+            spotter.ProcessAudio(frame);
+            return;
+        }
+
+        var engine = _sttEngine;
+        if (engine == null)
+            return;
+
+        if (_keywordEndPosition >= 0)
+        {
+            var earliest = historyPosition - (long)_settings.PreRollMs * BytesPerMs;
+            ReplayPreRoll(engine, Math.Max(_keywordEndPosition, earliest), historyPosition);
+            _keywordEndPosition = -1;
+        }
+        else if (_pendingPreRollMs > 0)
+        {
+            ReplayPreRoll(engine, historyPosition - (long)_pendingPreRollMs * BytesPerMs, historyPosition);
+        }
+        _pendingPreRollMs = 0;
+
+        engine.PushAudio(audio);
+    }
+
+    private ReadOnlySpan<byte> SuppressNoise(ReadOnlySpan<byte> frame)
+    {
+        var suppressor = _noiseSuppressor;
+        if (suppressor == null)
+            return frame;
+
+        if (_suppressedFrame.Length < frame.Length)
         {
-            _sttEngine.PushAudio(e.AudioData.Span);
+            _suppressedFrame = new byte[frame.Length];
         }
+
+        var output = _suppressedFrame.AsSpan(0, frame.Length);
+        // The VAD already tracks the broadband noise floor; the suppressor reuses it to pick noise-only blocks
+        suppressor.Process(frame, output, _endpointDetector.NoiseFloorDb);
+        return output;
     }
 
     private void OnPartialRecognition(object? sender, PartialRecognitionEventArgs e)
     {
-        // Avoid heavy work or nested locks while holding engine callbacks
-        System.Diagnostics.Debug.WriteLine($"*** PARTIAL RECOGNITION: '{e.Text}' (Confidence: {e.Confidence}) ***");
-        OnTextRecognized?.Invoke(this, new TextRecognizedEventArgs(e.Text, false, e.Confidence));
+        Post(new SessionEvent(SessionEventKind.Partial, e));
     }
 
     private void OnFinalRecognition(object? sender, FinalRecognitionEventArgs e)
+    {
+        Post(new SessionEvent(SessionEventKind.Final, e));
+    }
+
+    private void OnFinalRefined(object? sender, RefinedRecognitionEventArgs e)
+    {
+        Post(new SessionEvent(SessionEventKind.Refined, e));
+    }
+
+    private void ProcessPartial(PartialRecognitionEventArgs e)
+    {
+        if (IsGatedByWakeWord && !IsWakeWordInPartial(e.Text))
+            return;
+
+        var text = _userDictionary?.Apply(e.Text) ?? e.Text;
+        OnTextRecognized?.Invoke(this, new TextRecognizedEventArgs(text, false, e.Confidence));
+    }
+
+    private void ProcessFinal(FinalRecognitionEventArgs e)
     {
         System.Diagnostics.Debug.WriteLine($"*** FINAL RECOGNITION: '{e.Text}' (Confidence: {e.Confidence}) ***");
 
@@ -349,19 +903,105 @@ public class RecognitionSession : IDisposable
             return;
         }
 
-        AsyncHelper.FireAndForget(async () =>
+        if (IsGatedByWakeWord && !IsWakeWordInFinal(e.Text))
+            return;
+
+        if (_currentMode == RecognitionMode.WakeWord)
         {
-            // Process text through plugins if available
-            var processedText = e.Text;
-            if (_pluginManager != null)
+            // One utterance per wake word; re-arm the spotter for the next command
+            IsWaitingForWakeWord = true;
+            _keywordSpotter?.Reset();
+            _wakeWordScanner.Reset();
+        }
+
+        _outputs.Writer.TryWrite(e);
+    }
+
+    /// <summary>
+    /// Output stage: finals and refinements are processed one at a time in the order the loop
+    /// accepted them, so the sinks see utterances in the order they were spoken.
+    /// </summary>
+    private async Task RunOutputLoopAsync()
+    {
+        await foreach (var result in _outputs.Reader.ReadAllAsync().ConfigureAwait(false))
+        {
+            try
             {
-                processedText = await ProcessTextThroughPluginsAsync(e.Text).ConfigureAwait(false);
+                if (result is FinalRecognitionEventArgs final)
+                {
+                    await DeliverFinalAsync(final).ConfigureAwait(false);
+                }
+                else if (result is RefinedRecognitionEventArgs refined)
+                {
+                    await ApplyRefinementAsync(refined).ConfigureAwait(false);
+                }
             }
+            catch (Exception ex)
+            {
+                Telemetry.LogError("RecognitionOutputFailed", ex, new { Kind = result.GetType().Name });
+            }
+        }
+    }
+
+    private async Task DeliverFinalAsync(FinalRecognitionEventArgs e)
+    {
+        // Apply user dictionary corrections, then text processing plugins if available
+        var processedText = _userDictionary?.Apply(e.Text) ?? e.Text;
+        if (_pluginManager != null)
+        {
+            processedText = await ProcessTextThroughPluginsAsync(processedText).ConfigureAwait(false);
+        }
+
+        OnTextRecognized?.Invoke(this, new TextRecognizedEventArgs(processedText, true, e.Confidence));
+
+        var sink = await SendTextToOutputSinksAsync(processedText).ConfigureAwait(false);
+        _lastDelivery = sink != null ? new LastDelivery(e.Text, processedText, sink) : null;
+    }
+
+    private async Task ApplyRefinementAsync(RefinedRecognitionEventArgs e)
+    {
+        var processedText = _userDictionary?.Apply(e.RefinedText) ?? e.RefinedText;
+        if (_pluginManager != null)
+        {
+            processedText = await ProcessTextThroughPluginsAsync(processedText).ConfigureAwait(false);
+        }
+
+        // Only the most recent final can be corrected; anything typed after it would be lost
+        var delivery = _lastDelivery;
+        if (delivery == null || !string.Equals(delivery.RawText, e.OriginalText, StringComparison.Ordinal))
+        {
+            Telemetry.LogEvent("RefinementSkipped", new { Reason = "Superseded" });
+            return;
+        }
+
+        if (string.Equals(delivery.OutputText, processedText, StringComparison.Ordinal))
+            return;
+
+        if (delivery.Sink is not ITextReplacingSink replacingSink)
+        {
+            Telemetry.LogEvent("RefinementSkipped", new { Reason = "SinkCannotReplace", Sink = delivery.Sink.Name });
+            return;
+        }
 
-            OnTextRecognized?.Invoke(this, new TextRecognizedEventArgs(processedText, true, e.Confidence));
+        try
+        {
+            if (!await replacingSink.ReplaceLastAsync(delivery.OutputText, processedText).ConfigureAwait(false))
+            {
+                Telemetry.LogEvent("RefinementSkipped", new { Reason = "OutputChanged", Sink = delivery.Sink.Name });
+                return;
+            }
+        }
+        catch (TextOutputFailedException ex)
+        {
+            // The original text is gone from the target; nothing left to correct later
+            _lastDelivery = null;
+            Telemetry.LogError("RefinementOutputFailed", ex, new { Sink = delivery.Sink.Name, Length = processedText.Length });
+            return;
+        }
 
-            await SendTextToOutputSinksAsync(processedText).ConfigureAwait(false);
-        }, nameof(OnFinalRecognition), new { e.Text, e.Confidence });
+        _lastDelivery = delivery with { OutputText = processedText };
+        OnTextRecognized?.Invoke(this, new TextRecognizedEventArgs(processedText, true, e.Confidence));
+        Telemetry.LogEvent("RefinementApplied", new { Sink = delivery.Sink.Name, OriginalLength = delivery.OutputText.Length, RefinedLength = processedText.Length });
     }
 
     private async Task<string> ProcessTextThroughPluginsAsync(string text)
@@ -408,11 +1048,7 @@ public class RecognitionSession : IDisposable
     /// </summary>
     public void StartPtt()
     {
-        if (_currentMode == RecognitionMode.Ptt)
-        {
-            IsPttPressed = true;
-            // Additional PTT logic can be added here
-        }
+        Post(new SessionEvent(SessionEventKind.StartPtt));
     }
 
     /// <summary>
@@ -420,38 +1056,71 @@ public class RecognitionSession : IDisposable
     /// </summary>
     public void StopPtt()
     {
-        if (_currentMode == RecognitionMode.Ptt)
-        {
-            IsPttPressed = false;
-            // Additional PTT logic can be added here
-        }
+        Post(new SessionEvent(SessionEventKind.StopPtt));
     }
 
     /// <summary>
-    /// Check if wake word is detected in the given text
+    /// Check if wake word is detected in the given text. A hit is handed to the session loop, which
+    /// stops waiting for the wake word in order with the audio it is processing.
     /// </summary>
     public bool IsWakeWordDetected(string text)
     {
         if (!IsWaitingForWakeWord || string.IsNullOrEmpty(text))
             return false;
 
-        foreach (var wakeWord in _wakeWords)
-        {
-            if (text.Contains(wakeWord, StringComparison.OrdinalIgnoreCase))
-            {
-                IsWaitingForWakeWord = false;
-                return true;
-            }
-        }
-        return false;
+        var wakeWord = _wakeWordMatcher.FindFirst(text);
+        if (wakeWord == null)
+            return false;
+
+        Post(new SessionEvent(SessionEventKind.WakeWordMatched, wakeWord));
+        return true;
     }
 
-    private async Task SendTextToOutputSinksAsync(string text)
+    private bool IsWakeWordInFinal(string text)
+    {
+        if (!IsWaitingForWakeWord || string.IsNullOrEmpty(text))
+            return false;
+
+        var wakeWord = _wakeWordMatcher.FindFirst(text);
+        if (wakeWord == null)
+            return false;
+
+        AcceptWakeWord(wakeWord, "Transcript");
+        return true;
+    }
+
+    /// <summary>
+    /// Incremental variant for streaming partials: only characters appended since the previous
+    /// partial are scanned.
+    /// </summary>
+    private bool IsWakeWordInPartial(string text)
+    {
+        if (!IsWaitingForWakeWord || string.IsNullOrEmpty(text))
+            return false;
+
+        var wakeWord = _wakeWordScanner.Feed(text);
+        if (wakeWord == null)
+            return false;
+
+        AcceptWakeWord(wakeWord, "Partial");
+        return true;
+    }
+
+    private void AcceptWakeWord(string wakeWord, string source)
+    {
+        IsWaitingForWakeWord = false;
+        Telemetry.LogEvent("WakeWordDetected", new { WakeWord = wakeWord, Source = source });
+    }
+
+    /// <summary>
+    /// Sends <paramref name="text"/> to the first sink that accepts it and returns that sink, or null when all failed.
+    /// </summary>
+    private async Task<ITextOutputSink?> SendTextToOutputSinksAsync(string text)
     {
         var sinks = _outputSinkProvider.GetSinks().ToList();
         System.Diagnostics.Debug.WriteLine($"*** SendTextToOutputSinksAsync - Text: '{text}', Sinks Count: {sinks.Count} ***");
 
-        bool textSentSuccessfully = false;
+        ITextOutputSink? deliveredTo = null;
         var failedSinks = new List<string>();
 
         foreach (var sink in sinks)
@@ -466,7 +1135,7 @@ public class RecognitionSession : IDisposable
                 {
                     System.Diagnostics.Debug.WriteLine($"*** Sending text '{text}' to {sink.Name} ***");
                     await sink.SendAsync(text);
-                    textSentSuccessfully = true;
+                    deliveredTo = sink;
                     System.Diagnostics.Debug.WriteLine($"*** Successfully sent to {sink.Name} ***");
 
                     Telemetry.LogEvent("TextOutputSuccessful", new
@@ -496,7 +1165,7 @@ public class RecognitionSession : IDisposable
             }
         }
 
-        if (!textSentSuccessfully)
+        if (deliveredTo == null)
         {
             Telemetry.LogError("AllOutputSinksFailed",
                 new InvalidOperationException("No output sinks available"),
@@ -507,9 +1176,11 @@ public class RecognitionSession : IDisposable
                     FailedSinkCount = failedSinks.Count
                 });
         }
+
+        return deliveredTo;
     }
 
-    private void OnEndpointTriggered(object? sender, EndpointTriggeredEventArgs e)
+    private void ProcessEndpoint(EndpointTriggeredEventArgs e)
     {
         Telemetry.LogEvent("RecognitionSession_EndpointTriggered", new
         {
@@ -519,12 +1190,44 @@ public class RecognitionSession : IDisposable
             e.Result.UtteranceDuration
         });
 
-        if (CurrentMode == RecognitionMode.SingleUtterance)
+        if (_currentMode == RecognitionMode.SingleUtterance)
         {
-            // End session on first endpoint in single-utterance mode
-            AsyncHelper.FireAndForget(() => StopAsync(), nameof(OnEndpointTriggered));
+            // End session on first endpoint in single-utterance mode, after anything already queued
+            _ = PostCommandAsync(SessionEventKind.Stop, CancellationToken.None);
         }
     }
+
+    private sealed record LastDelivery(string RawText, string OutputText, ITextOutputSink Sink);
+
+    private enum SessionEventKind
+    {
+        AudioFrame,
+        Partial,
+        Final,
+        Refined,
+        UtteranceStarted,
+        UtteranceEnded,
+        PauseObserved,
+        EndpointTriggered,
+        KeywordDetected,
+        Start,
+        Stop,
+        SetMode,
+        StartPtt,
+        StopPtt,
+        StartFromPast,
+        WakeWordMatched
+    }
+
+    // Audio is a pooled copy of a frame (Value bytes long) returned by the loop once handled
+    private readonly record struct SessionEvent(
+        SessionEventKind Kind,
+        object? Args = null,
+        byte[]? Audio = null,
+        int Value = 0,
+        long HistoryPosition = 0);
+
+    private sealed record SessionCommand(TaskCompletionSource Completion, CancellationToken CancellationToken);
 }
 
 public enum RecognitionMode
@@ -553,10 +1256,15 @@ public class RecognitionSessionSettings
     public int EndpointSilenceMs { get; set; } = 800;
     public int SampleRate { get; set; } = 16000;
     public int Channels { get; set; } = 1;
-    public int BufferSizeMs { get; set; } = 100;
+    public int BufferSizeMs { get; set; } = 100; // Capture frame length when AudioSettings.FrameMs is 0
     public string[] WakeWords { get; set; } = [];
     public double VoiceActivityThreshold { get; set; } = 0.01; // Audio level threshold for voice detection
     public int MinUtteranceLengthMs { get; set; } = 500; // Minimum utterance length
+    public int PreRollMs { get; set; } = 300; // Most audio after a wake-word hit, before the engine took over, replayed to it
+    public bool EnableLearnedEndpointing { get; set; } = true; // Tune silence timeout from the user's pause profile
+    public string EndpointProfilePath { get; set; } = ""; // Empty = %AppData%/sttify/endpoint-profile.json
+    public bool EnableUserDictionary { get; set; } = true; // Replace user-defined terms in partials and finals
+    public string UserDictionaryPath { get; set; } = ""; // Empty = %AppData%/sttify/user-dictionary.tsv
 }
 
 [ExcludeFromCodeCoverage] // Simple data container EventArgs class
@@ -1,10 +1,14 @@
 ﻿using Sttify.Corelib.Diagnostics;
+using Sttify.Corelib.Wake;
 
 namespace Sttify.Corelib.Session;
 
 // Additional methods for RecognitionSession - these would be added to the main class
 public static class RecognitionSessionExtensions
 {
+    // Matcher for the last wake-word set seen; callers pass the same set with every transcript
+    private static volatile CachedWakeMatcher? _wakeMatcher;
+
     public static void OnModeChanged(this RecognitionSession session, RecognitionMode oldMode, RecognitionMode newMode)
     {
         Telemetry.LogEvent("RecognitionModeChanged", new
@@ -41,20 +45,28 @@ public static class RecognitionSessionExtensions
         if (string.IsNullOrEmpty(text) || wakeWords.Length == 0)
             return false;
 
-        var lowerText = text.ToLowerInvariant();
+        var wakeWord = GetWakeMatcher(wakeWords).FindFirst(text);
+        if (wakeWord == null)
+            return false;
 
-        foreach (var wakeWord in wakeWords)
-        {
-            if (lowerText.Contains(wakeWord.ToLowerInvariant()))
-            {
-                Telemetry.LogEvent("WakeWordDetected", new { WakeWord = wakeWord, Text = text });
-                return true;
-            }
-        }
+        Telemetry.LogEvent("WakeWordDetected", new { WakeWord = wakeWord, Text = text });
+        return true;
+    }
 
-        return false;
+    private static WakePhraseMatcher GetWakeMatcher(string[] wakeWords)
+    {
+        var cached = _wakeMatcher;
+        if (cached != null && cached.WakeWords.AsSpan().SequenceEqual(wakeWords))
+            return cached.Matcher;
+
+        // Copy the set: the caller may change its array after this call
+        cached = new CachedWakeMatcher(wakeWords.ToArray(), new WakePhraseMatcher(wakeWords));
+        _wakeMatcher = cached;
+        return cached.Matcher;
     }
 
+    private sealed record CachedWakeMatcher(string[] WakeWords, WakePhraseMatcher Matcher);
+
     // Voice activity detection
     public static bool DetectVoiceActivity(this RecognitionSession session, ReadOnlySpan<byte> audioData, double threshold)
     {
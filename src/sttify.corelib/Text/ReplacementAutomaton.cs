@@ -0,0 +1,220 @@
+﻿using System.Text;
+
+namespace Sttify.Corelib.Text;
+
+/// <summary>
+/// Aho–Corasick automaton compiled into flat arrays, replacing every dictionary entry found in a
+/// text in one scan. Overlaps are resolved leftmost-longest, so "東京都" wins over "東京" and an
+/// entry is never matched inside the output of another. Instances are immutable and thread-safe;
+/// build a new one to change the entries.
+/// </summary>
+public sealed class ReplacementAutomaton
+{
+    private const int Root = 0;
+
+    public static readonly ReplacementAutomaton Empty = new([], ignoreCase: false);
+
+    // Node n owns edges [_edgeStart[n], _edgeStart[n + 1]), sorted by character for binary search
+    private readonly int[] _edgeStart;
+    private readonly char[] _edgeChars;
+    private readonly int[] _edgeTargets;
+    private readonly int[] _failure;
+    private readonly int[] _depth;
+    private readonly int[] _output; // Node of the longest entry ending at this node, or -1
+    private readonly string?[] _replacements;
+    private readonly bool _ignoreCase;
+
+    public ReplacementAutomaton(IEnumerable<KeyValuePair<string, string>> entries, bool ignoreCase = false)
+    {
+        ArgumentNullException.ThrowIfNull(entries);
+        _ignoreCase = ignoreCase;
+
+        // Build the trie with per-node maps, then flatten it breadth-first
+        var children = new List<Dictionary<char, int>> { new() };
+        var terminal = new List<string?> { null };
+        foreach (var (pattern, replacement) in entries)
+        {
+            if (string.IsNullOrEmpty(pattern))
+                continue;
+
+            var node = Root;
+            foreach (var raw in pattern)
+            {
+                var c = Fold(raw);
+                if (!children[node].TryGetValue(c, out var next))
+                {
+                    next = children.Count;
+                    children[node][c] = next;
+                    children.Add(new Dictionary<char, int>());
+                    terminal.Add(null);
+                }
+                node = next;
+            }
+
+            if (terminal[node] == null)
+                EntryCount++;
+            terminal[node] = replacement ?? string.Empty; // Later duplicates win
+        }
+
+        var count = children.Count;
+        _edgeStart = new int[count + 1];
+        _edgeChars = new char[count - 1];
+        _edgeTargets = new int[count - 1];
+        _failure = new int[count];
+        _depth = new int[count];
+        _output = new int[count];
+        _replacements = terminal.ToArray();
+
+        var edge = 0;
+        for (int n = 0; n < count; n++)
+        {
+            _edgeStart[n] = edge;
+            foreach (var pair in children[n].OrderBy(p => p.Key))
+            {
+                _edgeChars[edge] = pair.Key;
+                _edgeTargets[edge] = pair.Value;
+                edge++;
+            }
+        }
+        _edgeStart[count] = edge;
+
+        // Failure links and outputs in breadth-first order, so every shallower node is final before use
+        _output[Root] = -1;
+        var queue = new Queue<int>();
+        queue.Enqueue(Root);
+        while (queue.Count > 0)
+        {
+            var node = queue.Dequeue();
+            for (int e = _edgeStart[node]; e < _edgeStart[node + 1]; e++)
+            {
+                var child = _edgeTargets[e];
+                _depth[child] = _depth[node] + 1;
+                _failure[child] = node == Root ? Root : Step(_failure[node], _edgeChars[e]);
+                _output[child] = _replacements[child] != null ? child : _output[_failure[child]];
+                queue.Enqueue(child);
+            }
+        }
+
+        MaxEntryLength = _depth.Max();
+    }
+
+    public int EntryCount { get; }
+    public int NodeCount => _depth.Length;
+    public int MaxEntryLength { get; }
+
+    /// <summary>
+    /// Builds an automaton from dictionary text: one "pattern&lt;TAB&gt;replacement" entry per line,
+    /// blank lines and lines starting with '#' ignored.
+    /// </summary>
+    public static ReplacementAutomaton Parse(TextReader reader, bool ignoreCase = false)
+    {
+        ArgumentNullException.ThrowIfNull(reader);
+        return new ReplacementAutomaton(ParseEntries(reader), ignoreCase);
+    }
+
+    /// <summary>
+    /// Returns <paramref name="text"/> with every entry replaced, or the same instance when nothing matched.
+    /// </summary>
+    public string Replace(string text)
+    {
+        if (string.IsNullOrEmpty(text) || EntryCount == 0)
+            return text;
+
+        StringBuilder? builder = null;
+        AppendReplaced(text, ref builder);
+        return builder?.ToString() ?? text;
+    }
+
+    /// <summary>
+    /// Scans <paramref name="text"/> once. After a match the scan resumes at its end from the root, so
+    /// at most <see cref="MaxEntryLength"/> characters are examined again per replacement.
+    /// </summary>
+    private void AppendReplaced(ReadOnlySpan<char> text, ref StringBuilder? builder)
+    {
+        var copied = 0;
+        var candidateStart = -1;
+        var candidateNode = -1;
+        var state = Root;
+        var i = 0;
+
+        while (true)
+        {
+            int windowStart;
+            if (i < text.Length)
+            {
+                state = Step(state, Fold(text[i++]));
+                windowStart = i - _depth[state];
+            }
+            else if (candidateNode >= 0)
+            {
+                windowStart = int.MaxValue;
+            }
+            else
+            {
+                break;
+            }
+
+            // No match found later can start at or before the candidate, so it is final
+            if (candidateNode >= 0 && windowStart > candidateStart)
+            {
+                builder ??= new StringBuilder(text.Length + 16);
+                builder.Append(text[copied..candidateStart]);
+                builder.Append(_replacements[candidateNode]);
+                copied = candidateStart + _depth[candidateNode];
+
+                i = copied;
+                state = Root;
+                candidateNode = -1;
+                continue;
+            }
+
+            var match = _output[state];
+            if (match >= 0)
+            {
+                var start = i - _depth[match];
+                if (candidateNode < 0 || start < candidateStart ||
+                    (start == candidateStart && _depth[match] > _depth[candidateNode]))
+                {
+                    candidateStart = start;
+                    candidateNode = match;
+                }
+            }
+        }
+
+        if (builder != null)
+        {
+            builder.Append(text[copied..]);
+        }
+    }
+
+    private int Step(int state, char c)
+    {
+        while (true)
+        {
+            var start = _edgeStart[state];
+            var index = _edgeChars.AsSpan(start, _edgeStart[state + 1] - start).BinarySearch(c);
+            if (index >= 0)
+                return _edgeTargets[start + index];
+            if (state == Root)
+                return Root;
+            state = _failure[state];
+        }
+    }
+
+    private char Fold(char c) => _ignoreCase ? char.ToLowerInvariant(c) : c;
+
+    private static IEnumerable<KeyValuePair<string, string>> ParseEntries(TextReader reader)
+    {
+        while (reader.ReadLine() is { } line)
+        {
+            if (line.Length == 0 || line[0] == '#')
+                continue;
+
+            var tab = line.IndexOf('\t');
+            if (tab <= 0)
+                continue;
+
+            yield return new KeyValuePair<string, string>(line[..tab], line[(tab + 1)..]);
+        }
+    }
+}
@@ -0,0 +1,246 @@
+﻿using System.Buffers;
+using System.Collections.Concurrent;
+using System.Diagnostics.CodeAnalysis;
+
+namespace Sttify.Corelib.Text;
+
+/// <summary>
+/// Post-processes recognizer output in a single pass over the input: whitespace is trimmed and
+/// collapsed, spaces between CJK characters are dropped, characters are remapped through the
+/// replacement and width-folding tables, and sentence-final punctuation is appended on request.
+/// Runs of characters that need no work are located with <see cref="SearchValues{T}"/> and copied in bulk.
+/// </summary>
+public sealed class TextNormalizer
+{
+    private const string WhitespaceChars = " \t\r\n\f\v\u00A0\u3000";
+
+    // Halfwidth katakana U+FF61..U+FF9F and their fullwidth forms (NFKC, with the sound marks kept spacing)
+    private const char HalfwidthKanaFirst = '｡';
+    private const char HalfwidthKanaLast = 'ﾟ';
+    private const string FullwidthKana = "。「」、・ヲァィゥェォャュョッーアイウエオカキクケコサシスセソタチツテトナニヌネノハヒフヘホマミムメモヤユヨラリルレロワン゛゜";
+    private const char HalfwidthVoicedMark = 'ﾞ';
+    private const char HalfwidthSemiVoicedMark = 'ﾟ';
+    private const string VoiceableKana = "カキクケコサシスセソタチツテトハヒフヘホウワヲ";
+    private const string VoicedKana = "ガギグゲゴザジズゼゾダヂヅデドバビブベボヴヷヺ";
+    private const string SemiVoiceableKana = "ハヒフヘホ";
+    private const string SemiVoicedKana = "パピプペポ";
+
+    private static readonly ConcurrentDictionary<string, TextNormalizer> LanguageNormalizers = new(StringComparer.OrdinalIgnoreCase);
+
+    private readonly Dictionary<char, char> _characterMap;
+    private readonly bool _foldWidth;
+    private readonly bool _removeCjkSpacing;
+    private readonly string _sentenceEndings;
+    private readonly SearchValues<char> _specialChars;
+    private readonly char? _terminalPunctuation;
+
+    public TextNormalizer(TextNormalizationOptions options)
+    {
+        ArgumentNullException.ThrowIfNull(options);
+
+        _removeCjkSpacing = options.RemoveSpacesBetweenCjk;
+        _foldWidth = options.FoldWidth;
+        _terminalPunctuation = options.TerminalPunctuation;
+        _sentenceEndings = options.SentenceEndings ?? string.Empty;
+        _characterMap = new Dictionary<char, char>(options.CharacterMap ?? new Dictionary<char, char>());
+
+        if (_characterMap.Keys.Any(key => WhitespaceChars.Contains(key)) || _characterMap.Values.Any(char.IsWhiteSpace))
+            throw new ArgumentException("Character map entries cannot map to or from whitespace", nameof(options));
+
+        var special = new HashSet<char>(WhitespaceChars);
+        special.UnionWith(_characterMap.Keys);
+        if (_foldWidth)
+        {
+            for (char c = '０'; c <= '９'; c++) special.Add(c);
+            for (char c = 'Ａ'; c <= 'Ｚ'; c++) special.Add(c);
+            for (char c = 'ａ'; c <= 'ｚ'; c++) special.Add(c);
+            for (char c = HalfwidthKanaFirst; c <= HalfwidthKanaLast; c++) special.Add(c);
+        }
+        _specialChars = SearchValues.Create(special.ToArray());
+    }
+
+    /// <summary>
+    /// Shared normalizer for a recognizer language ("ja", "ja-JP", "en-US", ...). Japanese and Chinese
+    /// drop inter-character spaces and end sentences with "。"; other languages end them with ".".
+    /// </summary>
+    public static TextNormalizer ForLanguage(string? language)
+    {
+        var code = GetLanguageCode(language);
+        return LanguageNormalizers.GetOrAdd(code, static c => new TextNormalizer(TextNormalizationOptions.ForLanguage(c)));
+    }
+
+    /// <summary>
+    /// Normalizes <paramref name="text"/>; returns the same instance when nothing changed.
+    /// </summary>
+    public string Normalize(string? text, bool appendTerminalPunctuation = false)
+    {
+        if (string.IsNullOrEmpty(text))
+            return text ?? string.Empty;
+
+        var buffer = ArrayPool<char>.Shared.Rent(GetMaxOutputLength(text.Length));
+        try
+        {
+            var written = Normalize(text, buffer, appendTerminalPunctuation);
+            var result = buffer.AsSpan(0, written);
+            return result.SequenceEqual(text) ? text : new string(result);
+        }
+        finally
+        {
+            ArrayPool<char>.Shared.Return(buffer);
+        }
+    }
+
+    /// <summary>
+    /// Normalizes <paramref name="input"/> into <paramref name="destination"/>, which must hold at least
+    /// <see cref="GetMaxOutputLength"/> characters. Returns the number of characters written.
+    /// </summary>
+    public int Normalize(ReadOnlySpan<char> input, Span<char> destination, bool appendTerminalPunctuation = false)
+    {
+        if (destination.Length < GetMaxOutputLength(input.Length))
+            throw new ArgumentException("Destination is too small for the normalized text", nameof(destination));
+
+        input = input.Trim();
+        var written = 0;
+        var pendingSpace = false;
+
+        while (!input.IsEmpty)
+        {
+            var index = input.IndexOfAny(_specialChars);
+            var plain = index < 0 ? input : input[..index];
+            if (!plain.IsEmpty)
+            {
+                if (pendingSpace)
+                {
+                    WriteSpace(destination, ref written, plain[0]);
+                    pendingSpace = false;
+                }
+
+                plain.CopyTo(destination[written..]);
+                written += plain.Length;
+            }
+
+            if (index < 0)
+                break;
+
+            var c = input[index];
+            var consumed = 1;
+            if (WhitespaceChars.Contains(c))
+            {
+                pendingSpace = true;
+            }
+            else
+            {
+                var mapped = Map(input[index..], out consumed);
+                if (pendingSpace)
+                {
+                    WriteSpace(destination, ref written, mapped);
+                    pendingSpace = false;
+                }
+                destination[written++] = mapped;
+            }
+
+            input = input[(index + consumed)..];
+        }
+
+        if (appendTerminalPunctuation && _terminalPunctuation is { } terminal && written > 0 &&
+            !_sentenceEndings.Contains(destination[written - 1]))
+        {
+            destination[written++] = terminal;
+        }
+
+        return written;
+    }
+
+    public static int GetMaxOutputLength(int inputLength) => inputLength + 1;
+
+    /// <summary>
+    /// Hiragana, katakana, CJK symbols and punctuation, and CJK unified ideographs.
+    /// </summary>
+    public static bool IsCjk(char c)
+    {
+        return (c >= '、' && c <= 'ヿ') ||
+               (c >= 'ㇰ' && c <= 'ㇿ') ||
+               (c >= '㐀' && c <= '䶿') ||
+               (c >= '一' && c <= '鿿') ||
+               (c >= HalfwidthKanaFirst && c <= HalfwidthKanaLast);
+    }
+
+    internal static string GetLanguageCode(string? language)
+    {
+        if (string.IsNullOrWhiteSpace(language))
+            return string.Empty;
+
+        var separator = language.IndexOfAny(['-', '_']);
+        return (separator > 0 ? language[..separator] : language).ToLowerInvariant();
+    }
+
+    private void WriteSpace(Span<char> destination, ref int written, char next)
+    {
+        if (_removeCjkSpacing && written > 0 && IsCjk(destination[written - 1]) && IsCjk(next))
+            return;
+
+        destination[written++] = ' ';
+    }
+
+    private char Map(ReadOnlySpan<char> input, out int consumed)
+    {
+        consumed = 1;
+        var c = input[0];
+
+        if (_characterMap.TryGetValue(c, out var replacement))
+            return replacement;
+
+        if (!_foldWidth)
+            return c;
+
+        // Fullwidth digits and Latin letters fold to ASCII; fullwidth punctuation is left alone
+        if (c is >= '０' and <= '９' or >= 'Ａ' and <= 'Ｚ' or >= 'ａ' and <= 'ｚ')
+            return (char)(c - 0xFEE0);
+
+        if (c is >= HalfwidthKanaFirst and <= HalfwidthKanaLast)
+        {
+            var kana = FullwidthKana[c - HalfwidthKanaFirst];
+            if (input.Length > 1)
+            {
+                var composed = input[1] switch
+                {
+                    HalfwidthVoicedMark => Compose(kana, VoiceableKana, VoicedKana),
+                    HalfwidthSemiVoicedMark => Compose(kana, SemiVoiceableKana, SemiVoicedKana),
+                    _ => kana
+                };
+                if (composed != kana)
+                    consumed = 2;
+                return composed;
+            }
+            return kana;
+        }
+
+        return c;
+    }
+
+    private static char Compose(char kana, string bases, string composed)
+    {
+        var index = bases.IndexOf(kana);
+        return index >= 0 ? composed[index] : kana;
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple configuration class
+public class TextNormalizationOptions
+{
+    public bool RemoveSpacesBetweenCjk { get; set; } = true;
+    public bool FoldWidth { get; set; } = true; // Fullwidth alphanumerics to ASCII, halfwidth katakana to fullwidth
+    public char? TerminalPunctuation { get; set; } // Appended when the text does not already end a sentence
+    public string? SentenceEndings { get; set; }
+    public IReadOnlyDictionary<char, char>? CharacterMap { get; set; } // Applied before width folding
+
+    public static TextNormalizationOptions ForLanguage(string? language)
+    {
+        return TextNormalizer.GetLanguageCode(language) switch
+        {
+            "ja" or "zh" => new TextNormalizationOptions { TerminalPunctuation = '。', SentenceEndings = "。？！?!" },
+            "en" => new TextNormalizationOptions { RemoveSpacesBetweenCjk = false, TerminalPunctuation = '.', SentenceEndings = ".?!" },
+            _ => new TextNormalizationOptions { TerminalPunctuation = '.', SentenceEndings = ".。?!？！" }
+        };
+    }
+}
@@ -0,0 +1,150 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Diagnostics;
+
+namespace Sttify.Corelib.Text;
+
+/// <summary>
+/// User-maintained corrections for recognizer output (product names, preferred kanji), loaded from
+/// a tab-separated file and compiled once into a <see cref="ReplacementAutomaton"/>. When the file
+/// changes, a new automaton is built off the recognition path and swapped in atomically; until then
+/// the previous one keeps serving.
+/// </summary>
+public sealed class UserDictionary : IDisposable
+{
+    private const int DebounceMs = 500;
+
+    private readonly bool _ignoreCase;
+    private readonly object _lockObject = new();
+    private ReplacementAutomaton _automaton = ReplacementAutomaton.Empty;
+    private Timer? _debounceTimer;
+    private bool _disposed;
+    private FileSystemWatcher? _watcher;
+
+    public UserDictionary(string path, bool ignoreCase = false, bool watchForChanges = true)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(path);
+        FilePath = Path.GetFullPath(path);
+        _ignoreCase = ignoreCase;
+
+        Reload();
+        if (watchForChanges)
+        {
+            StartWatching();
+        }
+    }
+
+    public string FilePath { get; }
+    public ReplacementAutomaton Automaton => Volatile.Read(ref _automaton);
+    public int EntryCount => Automaton.EntryCount;
+
+    public event EventHandler? Reloaded;
+
+    public static string GetDefaultDictionaryPath()
+    {
+        var appDataPath = Environment.GetFolderPath(Environment.SpecialFolder.ApplicationData);
+        return Path.Combine(appDataPath, "sttify", "user-dictionary.tsv");
+    }
+
+    /// <summary>
+    /// Applies every entry to <paramref name="text"/> in a single scan; returns the same instance when nothing matched.
+    /// </summary>
+    public string Apply(string text) => Automaton.Replace(text);
+
+    /// <summary>
+    /// Rebuilds the automaton from the file. A missing file means an empty dictionary; a file that cannot
+    /// be read leaves the current entries in place.
+    /// </summary>
+    public void Reload()
+    {
+        var stopwatch = Stopwatch.StartNew();
+        ReplacementAutomaton automaton;
+        try
+        {
+            if (!File.Exists(FilePath))
+            {
+                automaton = ReplacementAutomaton.Empty;
+            }
+            else
+            {
+                using var reader = new StreamReader(new FileStream(FilePath, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete));
+                automaton = ReplacementAutomaton.Parse(reader, _ignoreCase);
+            }
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            // Editors often hold the file briefly while saving; the next change event retries
+            Telemetry.LogWarning("UserDictionaryLoadFailed", ex.Message, new { Path = FilePath });
+            return;
+        }
+
+        Volatile.Write(ref _automaton, automaton);
+        Telemetry.LogEvent("UserDictionaryLoaded", new
+        {
+            Path = FilePath,
+            automaton.EntryCount,
+            automaton.NodeCount,
+            ElapsedMs = stopwatch.Elapsed.TotalMilliseconds
+        });
+        Reloaded?.Invoke(this, EventArgs.Empty);
+    }
+
+    public void Dispose()
+    {
+        lock (_lockObject)
+        {
+            if (_disposed)
+                return;
+
+            _disposed = true;
+        }
+
+        _watcher?.Dispose();
+        _debounceTimer?.Dispose();
+    }
+
+    [ExcludeFromCodeCoverage] // File system watcher
+    private void StartWatching()
+    {
+        var directory = Path.GetDirectoryName(FilePath);
+        if (string.IsNullOrEmpty(directory) || !Directory.Exists(directory))
+            return;
+
+        try
+        {
+            // Watch the directory so that editors replacing the file via rename are seen too
+            _watcher = new FileSystemWatcher(directory, Path.GetFileName(FilePath))
+            {
+                NotifyFilter = NotifyFilters.FileName | NotifyFilters.LastWrite | NotifyFilters.Size
+            };
+            _watcher.Changed += (_, _) => ScheduleReload();
+            _watcher.Created += (_, _) => ScheduleReload();
+            _watcher.Deleted += (_, _) => ScheduleReload();
+            _watcher.Renamed += (_, _) => ScheduleReload();
+            _watcher.Error += (_, e) =>
+            {
+                Telemetry.LogWarning("UserDictionaryWatcherError", e.GetException().Message, new { Path = FilePath });
+                ScheduleReload();
+            };
+            _watcher.EnableRaisingEvents = true;
+        }
+        catch (Exception ex) when (ex is IOException or ArgumentException or UnauthorizedAccessException)
+        {
+            Telemetry.LogWarning("UserDictionaryWatcherFailed", ex.Message, new { Path = FilePath });
+        }
+    }
+
+    [ExcludeFromCodeCoverage] // File system watcher callback
+    private void ScheduleReload()
+    {
+        lock (_lockObject)
+        {
+            if (_disposed)
+                return;
+
+            // A save fires several events; rebuild once it settles
+            _debounceTimer ??= new Timer(_ => Reload(), null, Timeout.Infinite, Timeout.Infinite);
+            _debounceTimer.Change(DebounceMs, Timeout.Infinite);
+        }
+    }
+}
@@ -0,0 +1,14 @@
+﻿namespace Sttify.Corelib.Wake;
+
+/// <summary>
+/// Lightweight always-on detector that listens for wake phrases directly on audio,
+/// so the full dictation engine only has to run after a hit.
+/// </summary>
+public interface IKeywordSpotter : IDisposable
+{
+    event EventHandler<WakeWordDetectedEventArgs>? OnKeywordDetected;
+
+    Task StartAsync(CancellationToken cancellationToken = default);
+    void ProcessAudio(ReadOnlySpan<byte> audioData);
+    void Reset();
+}
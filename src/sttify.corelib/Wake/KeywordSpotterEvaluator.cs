@@ -0,0 +1,178 @@
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using Sttify.Corelib.Audio;
+using Sttify.Corelib.Engine;
+
+namespace Sttify.Corelib.Wake;
+
+/// <summary>
+/// Replays labelled recordings through a keyword spotter (or a full engine, for comparison)
+/// faster than real time and reports false-accept / false-reject rates and real-time factor.
+/// </summary>
+public static class KeywordSpotterEvaluator
+{
+    private const int BytesPerSample = 2;
+
+    public static KeywordSpotterEvaluation Evaluate(IKeywordSpotter spotter,
+        IEnumerable<KeywordSpotterSample> samples,
+        int frameSizeBytes = 3200,
+        int sampleRate = 16000)
+    {
+        ArgumentNullException.ThrowIfNull(spotter);
+        ArgumentNullException.ThrowIfNull(samples);
+        if (frameSizeBytes <= 0)
+            throw new ArgumentOutOfRangeException(nameof(frameSizeBytes), "Frame size must be positive");
+
+        var evaluation = new KeywordSpotterEvaluation();
+        var detections = 0;
+        EventHandler<WakeWordDetectedEventArgs> handler = (_, _) => detections++;
+        spotter.OnKeywordDetected += handler;
+
+        try
+        {
+            foreach (var sample in samples)
+            {
+                spotter.Reset();
+                detections = 0;
+
+                var stopwatch = Stopwatch.StartNew();
+                ReplayFrames(sample.AudioData, frameSizeBytes, frame => spotter.ProcessAudio(frame));
+                stopwatch.Stop();
+
+                evaluation.ProcessingTime += stopwatch.Elapsed;
+                evaluation.AudioDuration += GetDuration(sample.AudioData.Length, sampleRate);
+
+                var detected = detections > 0;
+                if (sample.ContainsKeyword)
+                {
+                    evaluation.PositiveCount++;
+                    if (!detected)
+                        evaluation.FalseRejects++;
+                }
+                else
+                {
+                    evaluation.NegativeCount++;
+                    if (detected)
+                        evaluation.FalseAccepts++;
+                }
+            }
+        }
+        finally
+        {
+            spotter.OnKeywordDetected -= handler;
+        }
+
+        return evaluation;
+    }
+
+    /// <summary>
+    /// Measures the real-time factor of a full recognizer over the same recordings, giving the
+    /// baseline cost the spotter avoids while waiting for a wake word.
+    /// </summary>
+    [ExcludeFromCodeCoverage] // Requires a running engine
+    public static async Task<double> MeasureEngineRealTimeFactorAsync(ISttEngine engine,
+        IEnumerable<KeywordSpotterSample> samples,
+        int frameSizeBytes = 3200,
+        int sampleRate = 16000,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(engine);
+
+        var processing = TimeSpan.Zero;
+        var audio = TimeSpan.Zero;
+
+        await engine.StartAsync(cancellationToken).ConfigureAwait(false);
+        try
+        {
+            foreach (var sample in samples)
+            {
+                cancellationToken.ThrowIfCancellationRequested();
+
+                var stopwatch = Stopwatch.StartNew();
+                ReplayFrames(sample.AudioData, frameSizeBytes, frame => engine.PushAudio(frame));
+                stopwatch.Stop();
+
+                processing += stopwatch.Elapsed;
+                audio += GetDuration(sample.AudioData.Length, sampleRate);
+            }
+        }
+        finally
+        {
+            await engine.StopAsync(cancellationToken).ConfigureAwait(false);
+        }
+
+        return audio > TimeSpan.Zero ? processing.TotalSeconds / audio.TotalSeconds : 0.0;
+    }
+
+    /// <summary>
+    /// Loads labelled samples from <c>positive</c> and <c>negative</c> sub-directories containing
+    /// WAV files (any format, converted to 16kHz mono 16-bit) or raw 16kHz mono PCM (<c>.pcm</c>/<c>.raw</c>).
+    /// </summary>
+    [ExcludeFromCodeCoverage] // File system I/O
+    public static List<KeywordSpotterSample> LoadSamples(string directory)
+    {
+        var samples = new List<KeywordSpotterSample>();
+        AddSamples(samples, Path.Combine(directory, "positive"), true);
+        AddSamples(samples, Path.Combine(directory, "negative"), false);
+        return samples;
+    }
+
+    private static void AddSamples(List<KeywordSpotterSample> samples, string directory, bool containsKeyword)
+    {
+        if (!Directory.Exists(directory))
+            return;
+
+        foreach (var file in Directory.EnumerateFiles(directory).OrderBy(f => f, StringComparer.Ordinal))
+        {
+            var pcm = AudioConverter.ReadFileAsVoskPcm(file);
+            if (pcm != null)
+            {
+                samples.Add(new KeywordSpotterSample(Path.GetFileName(file), pcm, containsKeyword));
+            }
+        }
+    }
+
+    private static void ReplayFrames(byte[] audioData, int frameSizeBytes, Action<ReadOnlySpan<byte>> consumer)
+    {
+        for (int offset = 0; offset < audioData.Length; offset += frameSizeBytes)
+        {
+            var length = Math.Min(frameSizeBytes, audioData.Length - offset);
+            consumer(audioData.AsSpan(offset, length));
+        }
+    }
+
+    private static TimeSpan GetDuration(int byteCount, int sampleRate)
+    {
+        return TimeSpan.FromSeconds((double)byteCount / (BytesPerSample * sampleRate));
+    }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class KeywordSpotterSample
+{
+    public KeywordSpotterSample(string name, byte[] audioData, bool containsKeyword)
+    {
+        Name = name;
+        AudioData = audioData;
+        ContainsKeyword = containsKeyword;
+    }
+
+    public string Name { get; }
+    public byte[] AudioData { get; }
+    public bool ContainsKeyword { get; }
+}
+
+[ExcludeFromCodeCoverage] // Simple data container class
+public class KeywordSpotterEvaluation
+{
+    public int PositiveCount { get; set; }
+    public int NegativeCount { get; set; }
+    public int FalseAccepts { get; set; }
+    public int FalseRejects { get; set; }
+    public TimeSpan AudioDuration { get; set; }
+    public TimeSpan ProcessingTime { get; set; }
+
+    public double FalseAcceptRate => NegativeCount > 0 ? (double)FalseAccepts / NegativeCount : 0.0;
+    public double FalseRejectRate => PositiveCount > 0 ? (double)FalseRejects / PositiveCount : 0.0;
+    public double RealTimeFactor => AudioDuration > TimeSpan.Zero ? ProcessingTime.TotalSeconds / AudioDuration.TotalSeconds : 0.0;
+}
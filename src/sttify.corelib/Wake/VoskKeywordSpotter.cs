@@ -0,0 +1,162 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using System.Text.Json;
+using Sttify.Corelib.Diagnostics;
+using Sttify.Corelib.Engine.Vosk;
+using Vosk;
+
+namespace Sttify.Corelib.Wake;
+
+/// <summary>
+/// Keyword spotter backed by a grammar-restricted Vosk recognizer. The decoder only
+/// considers the configured phrases plus an unknown token, which keeps it far cheaper
+/// than the large-vocabulary recognizer. Requires a model with a dynamic graph
+/// (e.g. the vosk-model-small-* family); static-graph models ignore the grammar.
+/// </summary>
+[ExcludeFromCodeCoverage] // Native Vosk dependency, requires an installed model
+public class VoskKeywordSpotter : IKeywordSpotter
+{
+    private const string UnknownToken = "[unk]";
+    private readonly object _lockObject = new();
+    private readonly WakePhraseMatcher _matcher;
+    private readonly string _modelPath;
+    private readonly string[] _phrases;
+    private readonly int _sampleRate;
+    private bool _disposed;
+    private Model? _model;
+    private VoskRecognizer? _recognizer;
+
+    public VoskKeywordSpotter(string modelPath, IEnumerable<string> phrases, int sampleRate = 16000)
+    {
+        if (string.IsNullOrEmpty(modelPath))
+            throw new ArgumentException("Model path is required for keyword spotting", nameof(modelPath));
+
+        _modelPath = modelPath;
+        _phrases = phrases
+            .Where(p => !string.IsNullOrWhiteSpace(p))
+            .Select(p => p.Trim())
+            .Distinct(StringComparer.OrdinalIgnoreCase)
+            .ToArray();
+        _sampleRate = sampleRate > 0 ? sampleRate : 16000;
+
+        if (_phrases.Length == 0)
+            throw new ArgumentException("At least one wake phrase is required", nameof(phrases));
+
+        // Vosk separates tokens with spaces and may emit kana variants; the matcher folds both
+        _matcher = new WakePhraseMatcher(_phrases);
+    }
+
+    public event EventHandler<WakeWordDetectedEventArgs>? OnKeywordDetected;
+
+    public Task StartAsync(CancellationToken cancellationToken = default)
+    {
+        return Task.Run(() =>
+        {
+            if (!Directory.Exists(_modelPath))
+                throw new DirectoryNotFoundException($"Keyword spotter model not found at: {_modelPath}");
+            if (!VoskModelManager.SupportsGrammar(_modelPath))
+                throw new NotSupportedException($"Keyword spotter model has a static graph and cannot be restricted to a grammar: {_modelPath}");
+
+            var startTime = DateTime.UtcNow;
+            global::Vosk.Vosk.SetLogLevel(0);
+
+            var model = new Model(_modelPath);
+            var grammar = JsonSerializer.Serialize(_phrases.Append(UnknownToken).ToArray(), VoskJsonContext.Default.StringArray);
+            var recognizer = new VoskRecognizer(model, _sampleRate, grammar);
+            recognizer.SetMaxAlternatives(0);
+
+            lock (_lockObject)
+            {
+                _model = model;
+                _recognizer = recognizer;
+            }
+
+            Telemetry.LogEvent("KeywordSpotterStarted", new
+            {
+                ModelPath = _modelPath,
+                PhraseCount = _phrases.Length,
+                LoadTimeMs = (DateTime.UtcNow - startTime).TotalMilliseconds
+            });
+        }, cancellationToken);
+    }
+
+    public void ProcessAudio(ReadOnlySpan<byte> audioData)
+    {
+        if (audioData.IsEmpty)
+            return;
+
+        string? detectedPhrase = null;
+        string recognizedText = string.Empty;
+
+        lock (_lockObject)
+        {
+            if (_recognizer == null)
+                return;
+
+            try
+            {
+                var isFinal = _recognizer.AcceptWaveform(audioData.ToArray(), audioData.Length);
+                recognizedText = isFinal
+                    ? ExtractText(_recognizer.Result(), "text")
+                    : ExtractText(_recognizer.PartialResult(), "partial");
+
+                detectedPhrase = _matcher.FindFirst(recognizedText);
+                if (detectedPhrase != null)
+                {
+                    // Start listening for the next hit from a clean decoder state
+                    _recognizer.Reset();
+                }
+            }
+            catch (Exception ex)
+            {
+                Telemetry.LogError("KeywordSpotterProcessingFailed", ex);
+                return;
+            }
+        }
+
+        if (detectedPhrase != null)
+        {
+            OnKeywordDetected?.Invoke(this, new WakeWordDetectedEventArgs(detectedPhrase, recognizedText));
+        }
+    }
+
+    public void Reset()
+    {
+        lock (_lockObject)
+        {
+            _recognizer?.Reset();
+        }
+    }
+
+    public void Dispose()
+    {
+        lock (_lockObject)
+        {
+            if (_disposed)
+                return;
+
+            _recognizer?.Dispose();
+            _recognizer = null;
+            _model?.Dispose();
+            _model = null;
+            _disposed = true;
+        }
+    }
+
+    private static string ExtractText(string json, string propertyName)
+    {
+        if (string.IsNullOrEmpty(json))
+            return string.Empty;
+
+        try
+        {
+            using var doc = JsonDocument.Parse(json);
+            return doc.RootElement.TryGetProperty(propertyName, out var element)
+                ? element.GetString() ?? string.Empty
+                : string.Empty;
+        }
+        catch (JsonException)
+        {
+            return string.Empty;
+        }
+    }
+}
@@ -0,0 +1,322 @@
+﻿namespace Sttify.Corelib.Wake;
+
+/// <summary>
+/// Aho–Corasick automaton over a folded form of the wake phrases. Hiragana and katakana,
+/// full and half width, upper and lower case, small and large kana all fold together;
+/// long-vowel marks, whitespace and punctuation are ignored, and voiced kana are decomposed
+/// so that half-width sequences such as "ｶﾞ" fold the same way as "ガ".
+/// Scanning costs O(characters) regardless of how many phrases are configured.
+/// </summary>
+public sealed class WakePhraseMatcher
+{
+    private const int Root = 0;
+    private const char VoicedMark = '\u309B';     // ゛
+    private const char SemiVoicedMark = '\u309C'; // ゜
+
+    // Half-width katakana U+FF66..U+FF9D mapped to full-width katakana
+    private const string HalfWidthKatakana =
+        "ヲァィゥェォャュョッーアイウエオカキクケコサシスセソタチツテトナニヌネノハヒフヘホマミムメモヤユヨラリルレロワン";
+
+    private readonly List<Dictionary<char, int>> _transitions = [];
+    private readonly List<int> _failure = [];
+    private readonly List<int> _output = [];
+    private readonly string[] _phrases;
+
+    public WakePhraseMatcher(IEnumerable<string> phrases)
+    {
+        ArgumentNullException.ThrowIfNull(phrases);
+
+        var accepted = new List<string>();
+        var seen = new HashSet<string>(StringComparer.Ordinal);
+        AddNode();
+
+        foreach (var phrase in phrases)
+        {
+            if (string.IsNullOrWhiteSpace(phrase))
+                continue;
+
+            var folded = Fold(phrase);
+            if (folded.Length == 0 || !seen.Add(folded))
+                continue;
+
+            accepted.Add(phrase.Trim());
+            Insert(folded, accepted.Count - 1);
+        }
+
+        _phrases = accepted.ToArray();
+        BuildFailureLinks();
+    }
+
+    public IReadOnlyList<string> Phrases => _phrases;
+
+    /// <summary>
+    /// Returns the first configured phrase found in <paramref name="text"/>, or null.
+    /// </summary>
+    public string? FindFirst(ReadOnlySpan<char> text)
+    {
+        var state = Root;
+        var match = Advance(ref state, text);
+        return match >= 0 ? _phrases[match] : null;
+    }
+
+    public bool ContainsAny(ReadOnlySpan<char> text) => FindFirst(text) != null;
+
+    public WakePhraseScanner CreateScanner() => new(this);
+
+    /// <summary>
+    /// Folds a string into the form used for matching; exposed for diagnostics and tests.
+    /// </summary>
+    public static string Fold(ReadOnlySpan<char> text)
+    {
+        var buffer = new System.Text.StringBuilder(text.Length);
+        foreach (var c in text)
+        {
+            var folded = FoldChar(c, out var mark);
+            if (folded != '\0')
+                buffer.Append(folded);
+            if (mark != '\0')
+                buffer.Append(mark);
+        }
+        return buffer.ToString();
+    }
+
+    internal int Advance(ref int state, ReadOnlySpan<char> text)
+    {
+        foreach (var c in text)
+        {
+            var folded = FoldChar(c, out var mark);
+            if (folded != '\0')
+            {
+                state = Step(state, folded);
+                if (_output[state] >= 0)
+                    return _output[state];
+            }
+            if (mark != '\0')
+            {
+                state = Step(state, mark);
+                if (_output[state] >= 0)
+                    return _output[state];
+            }
+        }
+        return -1;
+    }
+
+    internal string GetPhrase(int index) => _phrases[index];
+
+    private int Step(int state, char c)
+    {
+        while (true)
+        {
+            if (_transitions[state].TryGetValue(c, out var next))
+                return next;
+            if (state == Root)
+                return Root;
+            state = _failure[state];
+        }
+    }
+
+    private int AddNode()
+    {
+        _transitions.Add(new Dictionary<char, int>());
+        _failure.Add(Root);
+        _output.Add(-1);
+        return _transitions.Count - 1;
+    }
+
+    private void Insert(string folded, int phraseIndex)
+    {
+        var state = Root;
+        foreach (var c in folded)
+        {
+            if (!_transitions[state].TryGetValue(c, out var next))
+            {
+                next = AddNode();
+                _transitions[state][c] = next;
+            }
+            state = next;
+        }
+
+        if (_output[state] < 0)
+            _output[state] = phraseIndex;
+    }
+
+    private void BuildFailureLinks()
+    {
+        var queue = new Queue<int>();
+        foreach (var child in _transitions[Root].Values)
+        {
+            _failure[child] = Root;
+            queue.Enqueue(child);
+        }
+
+        while (queue.Count > 0)
+        {
+            var state = queue.Dequeue();
+            foreach (var (c, child) in _transitions[state])
+            {
+                var fallback = _failure[state];
+                while (fallback != Root && !_transitions[fallback].ContainsKey(c))
+                {
+                    fallback = _failure[fallback];
+                }
+
+                _failure[child] = _transitions[fallback].TryGetValue(c, out var target) && target != child
+                    ? target
+                    : Root;
+
+                // A phrase ending at the failure target also ends here
+                if (_output[child] < 0)
+                    _output[child] = _output[_failure[child]];
+
+                queue.Enqueue(child);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Folds one character. Returns '\0' for characters that are ignored; <paramref name="mark"/>
+    /// receives a trailing (semi-)voiced mark when a precomposed kana is decomposed.
+    /// </summary>
+    private static char FoldChar(char c, out char mark)
+    {
+        mark = '\0';
+
+        // Full-width ASCII variants
+        if (c >= '！' && c <= '～')
+            c = (char)(c - 0xFEE0);
+
+        if (c < 0x80)
+        {
+            if (char.IsAsciiLetterOrDigit(c))
+                return char.IsAsciiLetterUpper(c) ? (char)(c | 0x20) : c;
+            return '\0'; // whitespace, punctuation and '-' used as a long vowel
+        }
+
+        // Half-width katakana and marks
+        if (c >= 'ｦ' && c <= 'ﾝ')
+            c = HalfWidthKatakana[c - 0xFF66];
+        else if (c is '\uFF9E' or '\u3099') // half-width / combining voiced mark
+            return VoicedMark;
+        else if (c is '\uFF9F' or '\u309A') // half-width / combining semi-voiced mark
+            return SemiVoicedMark;
+
+        // Hiragana to katakana
+        if (c >= 'ぁ' && c <= 'ゖ')
+            c = (char)(c + 0x60);
+
+        if (c >= 'ァ' && c <= 'ヺ')
+            return FoldKatakana(c, out mark);
+
+        if (c == VoicedMark || c == SemiVoicedMark)
+            return c;
+
+        // Long vowels, wave dashes, CJK punctuation and other separators carry no phonetic content
+        if (c is 'ー' or '〜' or '～' or '・' || char.IsWhiteSpace(c) || char.IsPunctuation(c) || char.IsSymbol(c))
+            return '\0';
+
+        return char.ToLowerInvariant(c);
+    }
+
+    private static char FoldKatakana(char c, out char mark)
+    {
+        mark = '\0';
+        switch (c)
+        {
+            // Small kana fold to their full-size forms
+            case 'ァ': case 'ィ': case 'ゥ': case 'ェ': case 'ォ':
+            case 'ッ': case 'ャ': case 'ュ': case 'ョ': case 'ヮ':
+                return (char)(c + 1);
+            case 'ヵ':
+                return 'カ';
+            case 'ヶ':
+                return 'ケ';
+            case 'ヴ':
+                mark = VoicedMark;
+                return 'ウ';
+            case 'ヷ':
+                mark = VoicedMark;
+                return 'ワ';
+            case 'ヺ':
+                mark = VoicedMark;
+                return 'ヲ';
+        }
+
+        // カ..ヂ alternate base and voiced forms
+        if (c >= 'カ' && c <= 'ヂ')
+        {
+            if (((c - 'カ') & 1) == 1)
+            {
+                mark = VoicedMark;
+                return (char)(c - 1);
+            }
+            return c;
+        }
+
+        if (c is 'ヅ' or 'デ' or 'ド')
+        {
+            mark = VoicedMark;
+            return (char)(c - 1);
+        }
+
+        // ハ..ポ come in base / voiced / semi-voiced triples
+        if (c >= 'ハ' && c <= 'ポ')
+        {
+            var offset = (c - 'ハ') % 3;
+            mark = offset switch
+            {
+                1 => VoicedMark,
+                2 => SemiVoicedMark,
+                _ => '\0'
+            };
+            return (char)(c - offset);
+        }
+
+        return c;
+    }
+}
+
+/// <summary>
+/// Incremental scanner for streaming partial transcripts. When a partial extends the previous
+/// one only the appended characters run through the automaton; a revised partial is rescanned
+/// from the start.
+/// </summary>
+public sealed class WakePhraseScanner
+{
+    private readonly WakePhraseMatcher _matcher;
+    private string _consumed = string.Empty;
+    private int _state;
+
+    internal WakePhraseScanner(WakePhraseMatcher matcher)
+    {
+        _matcher = matcher;
+    }
+
+    /// <summary>
+    /// Feeds the latest full partial text and returns a phrase if one completes within it.
+    /// </summary>
+    public string? Feed(string text)
+    {
+        ArgumentNullException.ThrowIfNull(text);
+
+        ReadOnlySpan<char> delta;
+        if (_consumed.Length <= text.Length && text.AsSpan().StartsWith(_consumed, StringComparison.Ordinal))
+        {
+            delta = text.AsSpan(_consumed.Length);
+        }
+        else
+        {
+            _state = 0;
+            delta = text;
+        }
+
+        _consumed = text;
+        var match = _matcher.Advance(ref _state, delta);
+        return match >= 0 ? _matcher.GetPhrase(match) : null;
+    }
+
+    public void Reset()
+    {
+        _consumed = string.Empty;
+        _state = 0;
+    }
+}
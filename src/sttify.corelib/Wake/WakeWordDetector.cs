@@ -3,13 +3,21 @@
 public class WakeWordDetector
 {
     private const string DefaultWakeWord = "スティファイ";
+
+    // Common misrecognitions; kana/width/long-vowel variants are already folded by the matcher
+    private static readonly string[] PhoneticVariations = ["ステファイ"];
+
+    private readonly WakePhraseMatcher _matcher;
     private readonly int _maxHistorySize = 5;
+    private readonly WakePhraseScanner _partialScanner;
     private readonly Queue<string> _recentRecognitions = new();
     private readonly string _wakeWord;
 
     public WakeWordDetector(string? wakeWord = null)
     {
         _wakeWord = wakeWord ?? DefaultWakeWord;
+        _matcher = new WakePhraseMatcher(PhoneticVariations.Prepend(_wakeWord));
+        _partialScanner = _matcher.CreateScanner();
     }
 
     public event EventHandler<WakeWordDetectedEventArgs>? OnWakeWordDetected;
@@ -29,42 +37,26 @@ public class WakeWordDetector
             }
         }
 
-        if (ContainsWakeWord(recognizedText))
+        if (ContainsWakeWord(recognizedText, isFinal))
         {
             OnWakeWordDetected?.Invoke(this, new WakeWordDetectedEventArgs(_wakeWord, recognizedText));
         }
     }
 
-    private bool ContainsWakeWord(string text)
-    {
-        if (string.IsNullOrWhiteSpace(text))
-            return false;
-
-        return text.Contains(_wakeWord, StringComparison.OrdinalIgnoreCase) ||
-               IsPhoneticMatch(text);
-    }
-
-    private static bool IsPhoneticMatch(string text)
+    private bool ContainsWakeWord(string text, bool isFinal)
     {
-        var phoneticVariations = new[]
-        {
-            "すてぃふぁい",
-            "ステファイ",
-            "すてふぁい"
-        };
-
-        foreach (var variation in phoneticVariations)
-        {
-            if (text.Contains(variation, StringComparison.OrdinalIgnoreCase))
-                return true;
-        }
+        if (!isFinal)
+            return _partialScanner.Feed(text) != null;
 
-        return false;
+        // A final closes the utterance; the next partial starts a fresh one
+        _partialScanner.Reset();
+        return _matcher.ContainsAny(text);
     }
 
     public void Reset()
     {
         _recentRecognitions.Clear();
+        _partialScanner.Reset();
     }
 }
 
@@ -0,0 +1,168 @@
+﻿using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class AdaptiveEndpointProfileTests
+{
+    private static AdaptiveEndpointSettings CreateSettings() => new()
+    {
+        TargetCutoffRate = 0.1,
+        MinTimeoutMs = 200,
+        MaxTimeoutMs = 2000,
+        SafetyMarginMs = 0,
+        MinObservations = 10,
+        DecayFactor = 1.0,
+        BinWidthMs = 50
+    };
+
+    [Fact]
+    public void GetSilenceTimeoutMs_WithoutEnoughObservations_ShouldReturnFallback()
+    {
+        // Arrange
+        var profile = new AdaptiveEndpointProfile(CreateSettings());
+        for (int i = 0; i < 5; i++)
+        {
+            profile.RecordPause("notepad", TimeSpan.FromMilliseconds(300));
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("notepad", 800);
+
+        // Assert
+        Assert.Equal(800, timeout);
+    }
+
+    [Fact]
+    public void GetSilenceTimeoutMs_ForFastSpeaker_ShouldShortenTimeout()
+    {
+        // Arrange
+        var profile = new AdaptiveEndpointProfile(CreateSettings());
+        for (int i = 0; i < 20; i++)
+        {
+            profile.RecordPause("chat", TimeSpan.FromMilliseconds(220));
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("chat", 800);
+
+        // Assert - all pauses fall in the 200-250ms bin
+        Assert.Equal(250, timeout);
+    }
+
+    [Fact]
+    public void GetSilenceTimeoutMs_ShouldKeepCutoffRateUnderTarget()
+    {
+        // Arrange - 90% short pauses, 10% long ones; a 10% target may cut the long ones
+        var settings = CreateSettings();
+        settings.TargetCutoffRate = 0.05;
+        var profile = new AdaptiveEndpointProfile(settings);
+        for (int i = 0; i < 90; i++)
+        {
+            profile.RecordPause("document", TimeSpan.FromMilliseconds(300));
+        }
+        for (int i = 0; i < 10; i++)
+        {
+            profile.RecordPause("document", TimeSpan.FromMilliseconds(1200));
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("document", 800);
+
+        // Assert - only 5% may be cut off, so the long pauses must survive
+        Assert.Equal(1250, timeout);
+    }
+
+    [Fact]
+    public void GetSilenceTimeoutMs_ForUnknownContext_ShouldUseDefaultContext()
+    {
+        // Arrange
+        var profile = new AdaptiveEndpointProfile(CreateSettings());
+        for (int i = 0; i < 20; i++)
+        {
+            profile.RecordPause("chat", TimeSpan.FromMilliseconds(420));
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("word", 800);
+
+        // Assert
+        Assert.Equal(450, timeout);
+        Assert.Equal(20, profile.GetObservationCount(AdaptiveEndpointProfile.DefaultContext));
+    }
+
+    [Fact]
+    public void GetSilenceTimeoutMs_ShouldClampToConfiguredRange()
+    {
+        // Arrange
+        var profile = new AdaptiveEndpointProfile(CreateSettings());
+        for (int i = 0; i < 20; i++)
+        {
+            profile.RecordPause("slow", TimeSpan.FromMilliseconds(5000));
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("slow", 800);
+
+        // Assert
+        Assert.Equal(2000, timeout);
+    }
+
+    [Fact]
+    public void GetSilenceTimeoutMs_WithSentenceGaps_ShouldNotRaiseTimeout()
+    {
+        // Arrange - one mid-sentence pause and one ordinary gap between sentences per sentence
+        var profile = new AdaptiveEndpointProfile(CreateSettings());
+        for (int i = 0; i < 20; i++)
+        {
+            profile.RecordPause("mail", TimeSpan.FromMilliseconds(300));
+            profile.RecordPause("mail", TimeSpan.FromMilliseconds(1400), confirmed: false);
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("mail", 800);
+
+        // Assert - the sentence gaps carry too little weight to reach the upper quantile
+        Assert.Equal(350, timeout);
+    }
+
+    [Fact]
+    public void GetSilenceTimeoutMs_WithOnlySentenceGaps_ShouldReturnFallback()
+    {
+        // Arrange
+        var profile = new AdaptiveEndpointProfile(CreateSettings());
+        for (int i = 0; i < 40; i++)
+        {
+            profile.RecordPause("mail", TimeSpan.FromMilliseconds(1400), confirmed: false);
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("mail", 800);
+
+        // Assert
+        Assert.Equal(800, timeout);
+    }
+
+    [Fact]
+    public void RecordPause_WithDecay_ShouldFavourRecentBehaviour()
+    {
+        // Arrange
+        var settings = CreateSettings();
+        settings.DecayFactor = 0.8;
+        var profile = new AdaptiveEndpointProfile(settings);
+        for (int i = 0; i < 20; i++)
+        {
+            profile.RecordPause("app", TimeSpan.FromMilliseconds(1000));
+        }
+        for (int i = 0; i < 20; i++)
+        {
+            profile.RecordPause("app", TimeSpan.FromMilliseconds(300));
+        }
+
+        // Act
+        var timeout = profile.GetSilenceTimeoutMs("app", 800);
+
+        // Assert
+        Assert.Equal(350, timeout);
+    }
+}
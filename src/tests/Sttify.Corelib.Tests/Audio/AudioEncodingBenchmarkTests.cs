@@ -0,0 +1,38 @@
+﻿using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class AudioEncodingBenchmarkTests
+{
+    [Fact]
+    public void Measure_WithSpeechLikeAudio_ShouldReportSavingsAndCost()
+    {
+        // Arrange - one second of a tone followed by one second of silence
+        var pcm = new byte[16000 * 2 * 2];
+        for (int i = 0; i < 16000; i++)
+        {
+            var sample = (short)(6000 * Math.Sin(i * 0.07));
+            pcm[i * 2] = (byte)sample;
+            pcm[i * 2 + 1] = (byte)(sample >> 8);
+        }
+
+        // Act
+        var result = AudioEncodingBenchmark.Measure(pcm, iterations: 2);
+
+        // Assert
+        Assert.Equal(TimeSpan.FromSeconds(2), result.AudioDuration);
+        Assert.Equal(44 + pcm.Length, result.WavBytes);
+        Assert.True(result.FlacBytes < result.WavBytes / 2);
+        Assert.True(result.BandwidthSavedPercent > 50);
+        Assert.True(result.FlacBase64Bytes < result.WavBase64Bytes);
+        Assert.True(result.RealTimeFactor > 0);
+    }
+
+    [Fact]
+    public void Measure_WithNoIterations_ShouldThrow()
+    {
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => AudioEncodingBenchmark.Measure(new byte[320], iterations: 0));
+    }
+}
@@ -0,0 +1,249 @@
+﻿using System.Buffers;
+using System.Buffers.Binary;
+using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class FlacEncoderTests
+{
+    private const int StreamHeaderSize = 42;
+
+    [Fact]
+    public void Encode_ShouldWriteStreamInfo()
+    {
+        // Arrange
+        var pcm = ToPcm(CreateTone(10000));
+
+        // Act
+        var flac = FlacEncoder.Encode(pcm, 16000, 4096);
+
+        // Assert
+        Assert.Equal("fLaC"u8.ToArray(), flac[..4]);
+        Assert.Equal(0x80, flac[4]); // Last metadata block, STREAMINFO
+        Assert.Equal(4096, BinaryPrimitives.ReadUInt16BigEndian(flac.AsSpan(8)));
+
+        var packed = BinaryPrimitives.ReadUInt64BigEndian(flac.AsSpan(18));
+        Assert.Equal(16000UL, packed >> 44);
+        Assert.Equal(0UL, (packed >> 41) & 0x7); // Mono
+        Assert.Equal(16UL, ((packed >> 36) & 0x1F) + 1);
+        Assert.Equal(10000UL, packed & 0xF_FFFF_FFFFUL);
+    }
+
+    [Fact]
+    public void Encode_ThenDecode_ShouldBeLossless()
+    {
+        // Arrange
+        var random = new Random(42);
+        var signals = new[]
+        {
+            CreateTone(16000 * 2 + 123),
+            Enumerable.Range(0, 5000).Select(_ => (short)random.Next(short.MinValue, short.MaxValue + 1)).ToArray(),
+            new short[4096].Concat(CreateTone(4096)).Concat(new short[] { short.MinValue, short.MaxValue, 5 }).ToArray(),
+            new short[] { 7, -3 }
+        };
+
+        foreach (var signal in signals)
+        {
+            // Act
+            var decoded = Decode(FlacEncoder.Encode(ToPcm(signal), 16000, 1024));
+
+            // Assert
+            Assert.Equal(signal, decoded);
+        }
+    }
+
+    [Fact]
+    public void Encode_WithTonalAudio_ShouldCompress()
+    {
+        // Arrange
+        var pcm = ToPcm(CreateTone(16000 * 3));
+
+        // Act
+        var flac = FlacEncoder.Encode(pcm);
+
+        // Assert
+        Assert.True(flac.Length < pcm.Length * 0.6, $"Expected at least 40% saving, got {flac.Length} of {pcm.Length} bytes");
+    }
+
+    [Fact]
+    public void Encode_WithSilence_ShouldUseConstantSubframes()
+    {
+        // Arrange
+        var pcm = new byte[16000 * 2];
+
+        // Act
+        var flac = FlacEncoder.Encode(pcm);
+
+        // Assert - a few bytes per frame instead of 8KB
+        Assert.True(flac.Length < 200, $"Silence encoded to {flac.Length} bytes");
+        Assert.Equal(new short[16000], Decode(flac));
+    }
+
+    [Fact]
+    public void EncodeFrame_Incrementally_ShouldMatchWholeBufferEncoding()
+    {
+        // Arrange
+        var samples = CreateTone(5000);
+        var encoder = new FlacEncoder(16000, 1600);
+        var output = new ArrayBufferWriter<byte>();
+
+        // Act - as a stream of unknown length, one block at a time
+        encoder.WriteStreamHeader(output);
+        for (int offset = 0; offset < samples.Length; offset += 1600)
+        {
+            encoder.EncodeFrame(samples.AsSpan(offset, Math.Min(1600, samples.Length - offset)), output);
+        }
+
+        // Assert - identical frames; only the total sample count in STREAMINFO differs
+        var whole = FlacEncoder.Encode(ToPcm(samples), 16000, 1600);
+        Assert.Equal(4, encoder.FramesEncoded);
+        Assert.Equal(whole[StreamHeaderSize..], output.WrittenSpan[StreamHeaderSize..].ToArray());
+        Assert.Equal(samples, Decode(output.WrittenSpan.ToArray()));
+    }
+
+    [Fact]
+    public void EncodeFrame_WithMoreSamplesThanBlockSize_ShouldThrow()
+    {
+        // Arrange
+        var encoder = new FlacEncoder(16000, 256);
+
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => encoder.EncodeFrame(new short[257], new ArrayBufferWriter<byte>()));
+    }
+
+    private static short[] CreateTone(int length)
+    {
+        var random = new Random(7);
+        var samples = new short[length];
+        for (int i = 0; i < length; i++)
+        {
+            samples[i] = (short)(8000 * Math.Sin(i * 0.05) + 3000 * Math.Sin(i * 0.013) + random.Next(-20, 21));
+        }
+        return samples;
+    }
+
+    private static byte[] ToPcm(short[] samples)
+    {
+        var pcm = new byte[samples.Length * 2];
+        for (int i = 0; i < samples.Length; i++)
+        {
+            BinaryPrimitives.WriteInt16LittleEndian(pcm.AsSpan(i * 2), samples[i]);
+        }
+        return pcm;
+    }
+
+    /// <summary>
+    /// Minimal decoder for the subset the encoder produces (mono, 16-bit, CONSTANT/VERBATIM/FIXED).
+    /// </summary>
+    private static short[] Decode(byte[] flac)
+    {
+        var reader = new BitReader(flac, StreamHeaderSize);
+        var samples = new List<short>();
+
+        while (reader.BytePosition < flac.Length)
+        {
+            Assert.Equal(0b11111111111110u, reader.Read(14));
+            reader.Read(2); // Reserved, blocking strategy
+            Assert.Equal(0b0111u, reader.Read(4));
+            reader.Read(4); // Sample rate
+            Assert.Equal(0u, reader.Read(4));
+            Assert.Equal(0b100u, reader.Read(3));
+            reader.Read(1);
+
+            var lead = reader.Read(8);
+            var leadingOnes = 0;
+            while ((lead & (0x80u >> leadingOnes)) != 0)
+                leadingOnes++;
+            reader.Read(8 * Math.Max(0, leadingOnes - 1)); // Rest of the frame number
+
+            var blockSize = (int)reader.Read(16) + 1;
+            reader.Read(8); // CRC-8
+
+            reader.Read(1);
+            var type = reader.Read(6);
+            reader.Read(1);
+
+            var block = new int[blockSize];
+            if (type == 0)
+            {
+                Array.Fill(block, reader.ReadSigned(16));
+            }
+            else if (type == 1)
+            {
+                for (int i = 0; i < blockSize; i++)
+                    block[i] = reader.ReadSigned(16);
+            }
+            else
+            {
+                Assert.Equal(0b001000u, type & 0b111000);
+                var order = (int)(type & 0b111);
+                for (int i = 0; i < order; i++)
+                    block[i] = reader.ReadSigned(16);
+
+                Assert.Equal(0u, reader.Read(2));
+                var partitionOrder = (int)reader.Read(4);
+                var index = order;
+                for (int partition = 0; partition < 1 << partitionOrder; partition++)
+                {
+                    var parameter = (int)reader.Read(4);
+                    var count = (blockSize >> partitionOrder) - (partition == 0 ? order : 0);
+                    for (int j = 0; j < count; j++, index++)
+                    {
+                        uint quotient = 0;
+                        while (reader.Read(1) == 0)
+                            quotient++;
+                        var folded = (quotient << parameter) | reader.Read(parameter);
+                        var residual = (int)(folded >> 1) ^ -(int)(folded & 1);
+
+                        block[index] = residual + Predict(block, index, order);
+                    }
+                }
+            }
+
+            reader.AlignToByte();
+            reader.Read(16); // CRC-16
+            samples.AddRange(block.Select(value => (short)value));
+        }
+
+        return samples.ToArray();
+    }
+
+    private static int Predict(int[] x, int i, int order) => order switch
+    {
+        0 => 0,
+        1 => x[i - 1],
+        2 => 2 * x[i - 1] - x[i - 2],
+        3 => 3 * x[i - 1] - 3 * x[i - 2] + x[i - 3],
+        _ => 4 * x[i - 1] - 6 * x[i - 2] + 4 * x[i - 3] - x[i - 4]
+    };
+
+    private sealed class BitReader
+    {
+        private readonly byte[] _data;
+        private long _bitPosition;
+
+        public BitReader(byte[] data, int byteOffset)
+        {
+            _data = data;
+            _bitPosition = byteOffset * 8L;
+        }
+
+        public long BytePosition => _bitPosition / 8;
+
+        public uint Read(int count)
+        {
+            uint value = 0;
+            for (int i = 0; i < count; i++, _bitPosition++)
+            {
+                var bit = (_data[_bitPosition / 8] >> (7 - (int)(_bitPosition % 8))) & 1;
+                value = (value << 1) | (uint)bit;
+            }
+            return value;
+        }
+
+        public int ReadSigned(int count) => (int)(Read(count) << (32 - count)) >> (32 - count);
+
+        public void AlignToByte() => _bitPosition = (_bitPosition + 7) / 8 * 8;
+    }
+}
@@ -0,0 +1,83 @@
+﻿using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class FrameRechunkerTests
+{
+    [Theory]
+    [InlineData(10, 320)]
+    [InlineData(20, 640)]
+    [InlineData(30, 960)]
+    [InlineData(100, 3200)]
+    [InlineData(1, 320)] // Clamped to 10ms
+    public void GetFrameBytes_At16kHzMono_ShouldMatchFrameLength(int frameMs, int expectedBytes)
+    {
+        // Act
+        var bytes = FrameRechunker.GetFrameBytes(16000, 1, 16, frameMs);
+
+        // Assert
+        Assert.Equal(expectedBytes, bytes);
+    }
+
+    [Fact]
+    public void Write_WithUnevenBuffers_ShouldRaiseExactFramesInOrder()
+    {
+        // Arrange - 10ms frames fed from 7ms and 13ms device buffers
+        var rechunker = new FrameRechunker(320);
+        var source = Enumerable.Range(0, 1000).Select(i => (byte)i).ToArray();
+        var received = new List<byte[]>();
+
+        // Act
+        var frames = rechunker.Write(source.AsSpan(0, 224), f => received.Add(f.ToArray()));
+        frames += rechunker.Write(source.AsSpan(224, 416), f => received.Add(f.ToArray()));
+        frames += rechunker.Write(source.AsSpan(640, 360), f => received.Add(f.ToArray()));
+
+        // Assert
+        Assert.Equal(3, frames);
+        Assert.All(received, f => Assert.Equal(320, f.Length));
+        Assert.Equal(source.Take(960), received.SelectMany(f => f));
+        Assert.Equal(40, rechunker.PendingBytes);
+    }
+
+    [Fact]
+    public void Write_ShouldReuseTheFrameBuffer()
+    {
+        // Arrange
+        var rechunker = new FrameRechunker(4);
+        var frames = new List<ReadOnlyMemory<byte>>();
+
+        // Act
+        rechunker.Write(new byte[] { 1, 2, 3, 4, 5, 6, 7, 8 }, frames.Add);
+
+        // Assert - handlers must copy what they keep
+        Assert.Equal(2, frames.Count);
+        Assert.True(frames[0].Span.SequenceEqual(frames[1].Span));
+        Assert.Equal(new byte[] { 5, 6, 7, 8 }, frames[1].ToArray());
+    }
+
+    [Fact]
+    public void Flush_WithPartialFrame_ShouldRaiseWholeSamplesAndReset()
+    {
+        // Arrange
+        var rechunker = new FrameRechunker(8);
+        rechunker.Write(new byte[] { 1, 2, 3, 4, 5 }, _ => { });
+        byte[]? flushed = null;
+
+        // Act
+        var raised = rechunker.Flush(f => flushed = f.ToArray());
+
+        // Assert - the trailing half sample is dropped
+        Assert.True(raised);
+        Assert.Equal(new byte[] { 1, 2, 3, 4 }, flushed);
+        Assert.Equal(0, rechunker.PendingBytes);
+        Assert.False(rechunker.Flush(_ => Assert.Fail("Nothing should be pending")));
+    }
+
+    [Fact]
+    public void Constructor_WithPartialSampleFrame_ShouldThrow()
+    {
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => new FrameRechunker(321));
+    }
+}
@@ -0,0 +1,48 @@
+﻿using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class FrameSizeBenchmarkTests
+{
+    [Fact]
+    public void Measure_AcrossDefaultFrameSizes_ShouldReportCostAndLatency()
+    {
+        // Arrange - one second of a tone followed by one second of silence
+        var pcm = new byte[16000 * 2 * 2];
+        for (int i = 0; i < 16000; i++)
+        {
+            var sample = (short)(6000 * Math.Sin(i * 0.07));
+            pcm[i * 2] = (byte)sample;
+            pcm[i * 2 + 1] = (byte)(sample >> 8);
+        }
+
+        // Act
+        var results = FrameSizeBenchmark.Measure(pcm);
+
+        // Assert
+        Assert.Equal(FrameSizeBenchmark.DefaultFrameSizesMs, results.Select(r => r.FrameMs));
+        Assert.Equal(new[] { 200, 100, 66, 20 }, results.Select(r => r.Frames));
+        Assert.All(results, r =>
+        {
+            Assert.Equal(TimeSpan.FromSeconds(2), r.AudioDuration);
+            Assert.True(r.RealTimeFactor > 0);
+            Assert.True(r.WorstCaseLatency >= TimeSpan.FromMilliseconds(r.FrameMs));
+        });
+    }
+
+    [Fact]
+    public void Measure_WithCustomStage_ShouldFeedExactFrames()
+    {
+        // Arrange
+        var pcm = new byte[16000 * 2];
+        var frameLengths = new HashSet<int>();
+
+        // Act
+        var result = Assert.Single(FrameSizeBenchmark.Measure(pcm, [20], frame => frameLengths.Add(frame.Length)));
+
+        // Assert
+        Assert.Equal(50, result.Frames);
+        Assert.Equal(640, Assert.Single(frameLengths));
+    }
+}
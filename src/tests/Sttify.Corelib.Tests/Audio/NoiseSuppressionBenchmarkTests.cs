@@ -0,0 +1,45 @@
+﻿using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class NoiseSuppressionBenchmarkTests
+{
+    [Fact]
+    public void Measure_WithToneInWhiteNoise_ShouldImproveSnr()
+    {
+        // Arrange - one second of silence, a one second tone, one second of silence
+        var clean = new byte[16000 * 2 * 3];
+        for (int i = 16000; i < 32000; i++)
+        {
+            var sample = (short)(6000 * Math.Sin(i * 0.07));
+            clean[i * 2] = (byte)sample;
+            clean[i * 2 + 1] = (byte)(sample >> 8);
+        }
+
+        var random = new Random(7);
+        var noise = new byte[16000 * 2];
+        for (int i = 0; i < 16000; i++)
+        {
+            var sample = (short)random.Next(-3000, 3000);
+            noise[i * 2] = (byte)sample;
+            noise[i * 2 + 1] = (byte)(sample >> 8);
+        }
+
+        // Act
+        var result = NoiseSuppressionBenchmark.Measure(clean, noise);
+
+        // Assert
+        Assert.Equal(TimeSpan.FromSeconds(3), result.AudioDuration);
+        Assert.True(result.SnrImprovementDb > 5, $"SNR improved by {result.SnrImprovementDb:F1} dB");
+        Assert.True(result.RealTimeFactor > 0);
+        Assert.Equal(0, result.BypassedBlocks);
+    }
+
+    [Fact]
+    public void Measure_WithEmptyNoise_ShouldThrow()
+    {
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => NoiseSuppressionBenchmark.Measure(new byte[320], []));
+    }
+}
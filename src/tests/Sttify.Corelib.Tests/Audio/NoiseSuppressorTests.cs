@@ -0,0 +1,107 @@
+﻿using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class NoiseSuppressorTests
+{
+    [Fact]
+    public void Process_WithNoAttenuationAllowed_ShouldReconstructInputAfterLatency()
+    {
+        // Arrange
+        var suppressor = new NoiseSuppressor(new NoiseSuppressionSettings { MaxAttenuationDb = 0, CpuBudgetPercent = 0 });
+        var input = CreateNoise(16000, 8000, seed: 1);
+        var output = new byte[input.Length];
+
+        // Act - 20ms frames, which do not line up with the 128-sample hop
+        for (int offset = 0; offset < input.Length; offset += 640)
+        {
+            suppressor.Process(input.AsSpan(offset, 640), output.AsSpan(offset, 640));
+        }
+
+        // Assert
+        var latency = suppressor.LatencySamples;
+        for (int i = 0; i + latency < input.Length / 2; i++)
+        {
+            Assert.Equal(ReadSample(input, i), ReadSample(output, i + latency));
+        }
+    }
+
+    [Fact]
+    public void Process_WithStationaryNoise_ShouldAttenuateIt()
+    {
+        // Arrange
+        var suppressor = new NoiseSuppressor(new NoiseSuppressionSettings { CpuBudgetPercent = 0 });
+        var input = CreateNoise(32000, 3000, seed: 2);
+        var output = new byte[input.Length];
+
+        // Act
+        suppressor.Process(input, output);
+
+        // Assert - measured over the second half, once the noise spectrum has been learned
+        var attenuationDb = 10 * Math.Log10(Energy(input, 16000) / Energy(output, 16000));
+        Assert.True(attenuationDb > 6, $"Attenuation was {attenuationDb:F1} dB");
+    }
+
+    [Fact]
+    public void Process_OverCpuBudget_ShouldBypassAndKeepOutputLength()
+    {
+        // Arrange - a budget no block can meet
+        var suppressor = new NoiseSuppressor(new NoiseSuppressionSettings { CpuBudgetPercent = 0.00001 });
+        var input = CreateNoise(16000, 3000, seed: 3);
+        var output = new byte[input.Length];
+
+        // Act
+        suppressor.Process(input, output);
+
+        // Assert
+        Assert.True(suppressor.IsBypassed);
+        Assert.True(suppressor.BypassedBlocks > 0);
+        Assert.Equal(16000 / 128, suppressor.ProcessedBlocks);
+    }
+
+    [Fact]
+    public void Process_WithMismatchedOutput_ShouldThrow()
+    {
+        // Arrange
+        var suppressor = new NoiseSuppressor();
+
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => suppressor.Process(new byte[640], new byte[320]));
+    }
+
+    [Fact]
+    public void Constructor_WithNonPowerOfTwoFftSize_ShouldThrow()
+    {
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => new NoiseSuppressor(new NoiseSuppressionSettings { FftSize = 300 }));
+    }
+
+    private static byte[] CreateNoise(int samples, int amplitude, int seed)
+    {
+        var random = new Random(seed);
+        var pcm = new byte[samples * 2];
+        for (int i = 0; i < samples; i++)
+        {
+            var sample = (short)random.Next(-amplitude, amplitude);
+            pcm[i * 2] = (byte)sample;
+            pcm[i * 2 + 1] = (byte)(sample >> 8);
+        }
+
+        return pcm;
+    }
+
+    private static int ReadSample(byte[] pcm, int index) => (short)(pcm[index * 2] | (pcm[index * 2 + 1] << 8));
+
+    private static double Energy(byte[] pcm, int fromSample)
+    {
+        double energy = 0;
+        for (int i = fromSample; i < pcm.Length / 2; i++)
+        {
+            double sample = ReadSample(pcm, i);
+            energy += sample * sample;
+        }
+
+        return energy;
+    }
+}
@@ -0,0 +1,52 @@
+﻿using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class PcmSourceAddressTests
+{
+    [Theory]
+    [InlineData("stdin", PcmSourceKind.StandardInput, "")]
+    [InlineData("-", PcmSourceKind.StandardInput, "")]
+    [InlineData("file:/tmp/a.raw", PcmSourceKind.File, "/tmp/a.raw")]
+    [InlineData("pipe:sttify", PcmSourceKind.NamedPipe, "sttify")]
+    [InlineData("unix:/run/sttify.sock", PcmSourceKind.UnixSocket, "/run/sttify.sock")]
+    public void Parse_ShouldRecognizeSourceKinds(string address, PcmSourceKind kind, string path)
+    {
+        // Act
+        var parsed = PcmSourceAddress.Parse(address);
+
+        // Assert
+        Assert.Equal(kind, parsed.Kind);
+        Assert.Equal(path, parsed.Path);
+        Assert.Equal(16000, parsed.Format.SampleRate);
+        Assert.Equal(1, parsed.Format.Channels);
+        Assert.Equal(16, parsed.Format.BitsPerSample);
+    }
+
+    [Fact]
+    public void Parse_WithFormatOptions_ShouldDescribeStream()
+    {
+        // Act
+        var parsed = PcmSourceAddress.Parse("unix:/run/sttify.sock?rate=48000&channels=2&format=f32le");
+
+        // Assert
+        Assert.Equal(48000, parsed.Format.SampleRate);
+        Assert.Equal(2, parsed.Format.Channels);
+        Assert.Equal(32, parsed.Format.BitsPerSample);
+        Assert.Equal(NAudio.Wave.WaveFormatEncoding.IeeeFloat, parsed.Format.Encoding);
+        Assert.True(parsed.AcceptsReconnects);
+    }
+
+    [Theory]
+    [InlineData("tcp:localhost:9000")]
+    [InlineData("unix:")]
+    [InlineData("stdin?rate=1")]
+    [InlineData("stdin?bits=12")]
+    [InlineData("stdin?volume=2")]
+    public void Parse_InvalidAddress_ShouldThrow(string address)
+    {
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => PcmSourceAddress.Parse(address));
+    }
+}
@@ -0,0 +1,89 @@
+﻿using System.Buffers.Binary;
+using NAudio.Wave;
+using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class PcmStreamAudioSourceTests
+{
+    [Fact]
+    public async Task ProbeWaveHeaderAsync_RawPcm_ShouldReturnLeadingBytes()
+    {
+        // Arrange
+        var pcm = Enumerable.Range(0, 64).Select(i => (byte)i).ToArray();
+        using var stream = new MemoryStream(pcm);
+
+        // Act
+        var probe = await PcmStreamAudioSource.ProbeWaveHeaderAsync(stream);
+
+        // Assert
+        Assert.Null(probe.Format);
+        Assert.Equal(pcm.Take(12), probe.Leading.ToArray());
+        Assert.Equal(12, stream.Position);
+    }
+
+    [Fact]
+    public async Task ProbeWaveHeaderAsync_WaveFile_ShouldReturnFormatAndStopAtData()
+    {
+        // Arrange - 48 kHz stereo with an extra LIST chunk before the data
+        var wav = CreateWave(new WaveFormat(48000, 16, 2), extraChunk: true, dataLength: 8);
+        using var stream = new MemoryStream(wav);
+
+        // Act
+        var probe = await PcmStreamAudioSource.ProbeWaveHeaderAsync(stream);
+
+        // Assert
+        Assert.NotNull(probe.Format);
+        Assert.Equal(48000, probe.Format!.SampleRate);
+        Assert.Equal(2, probe.Format.Channels);
+        Assert.True(probe.Leading.IsEmpty);
+        Assert.Equal(wav.Length - 8, stream.Position);
+    }
+
+    [Fact]
+    public async Task ProbeWaveHeaderAsync_UnsupportedEncoding_ShouldThrow()
+    {
+        // Arrange - tag 6 is A-law
+        var wav = CreateWave(new WaveFormat(8000, 8, 1), extraChunk: false, dataLength: 0, formatTag: 6);
+        using var stream = new MemoryStream(wav);
+
+        // Act & Assert
+        await Assert.ThrowsAsync<InvalidDataException>(() => PcmStreamAudioSource.ProbeWaveHeaderAsync(stream));
+    }
+
+    private static byte[] CreateWave(WaveFormat format, bool extraChunk, int dataLength, ushort formatTag = 1)
+    {
+        using var buffer = new MemoryStream();
+        using var writer = new BinaryWriter(buffer);
+
+        writer.Write("RIFF"u8);
+        writer.Write(0); // Size is not checked
+        writer.Write("WAVE"u8);
+
+        writer.Write("fmt "u8);
+        writer.Write(16);
+        writer.Write(formatTag);
+        writer.Write((ushort)format.Channels);
+        writer.Write(format.SampleRate);
+        writer.Write(format.AverageBytesPerSecond);
+        writer.Write((ushort)format.BlockAlign);
+        writer.Write((ushort)format.BitsPerSample);
+
+        if (extraChunk)
+        {
+            writer.Write("LIST"u8);
+            writer.Write(3); // Odd size, padded to 4
+            writer.Write(new byte[4]);
+        }
+
+        writer.Write("data"u8);
+        writer.Write(dataLength);
+        writer.Write(new byte[dataLength]);
+        writer.Flush();
+
+        var bytes = buffer.ToArray();
+        BinaryPrimitives.WriteInt32LittleEndian(bytes.AsSpan(4), bytes.Length - 8);
+        return bytes;
+    }
+}
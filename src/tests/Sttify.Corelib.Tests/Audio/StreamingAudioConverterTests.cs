@@ -0,0 +1,71 @@
+﻿using System.Buffers.Binary;
+using NAudio.Wave;
+using Sttify.Corelib.Audio;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Audio;
+
+public class StreamingAudioConverterTests
+{
+    [Fact]
+    public void Convert_48kHzStereoInShortBuffers_ShouldKeepDurationAndStayContinuous()
+    {
+        // Arrange - one second of a 440 Hz tone, delivered as 10ms device buffers
+        var source = CreateTone(new WaveFormat(48000, 16, 2), seconds: 1);
+        var converter = new StreamingAudioConverter(new WaveFormat(48000, 16, 2));
+        var output = new List<byte>();
+
+        // Act
+        for (int offset = 0; offset < source.Length; offset += 1920)
+        {
+            output.AddRange(converter.Convert(source.AsSpan(offset, 1920)).ToArray());
+        }
+
+        // Assert - within 20ms of one second at 16kHz mono 16-bit
+        Assert.InRange(output.Count, 32000 - 640, 32000);
+
+        // A resampler rebuilt per buffer restarts its filter from silence every 10ms; the tone
+        // itself never moves more than ~2800 between adjacent 16kHz samples
+        var samples = output.ToArray();
+        var maxStep = 0;
+        for (int i = 640 + 2; i + 1 < samples.Length; i += 2)
+        {
+            var previous = BinaryPrimitives.ReadInt16LittleEndian(samples.AsSpan(i - 2));
+            var current = BinaryPrimitives.ReadInt16LittleEndian(samples.AsSpan(i));
+            maxStep = Math.Max(maxStep, Math.Abs(current - previous));
+        }
+        Assert.InRange(maxStep, 1, 4000);
+    }
+
+    [Fact]
+    public void Convert_WithPartialSampleFrame_ShouldThrow()
+    {
+        // Arrange
+        var converter = new StreamingAudioConverter(new WaveFormat(48000, 16, 2));
+
+        // Act & Assert
+        Assert.Throws<InvalidDataException>(() => converter.Convert(new byte[6]).ToArray());
+    }
+
+    [Fact]
+    public void Constructor_WithUnreadableFormat_ShouldThrow()
+    {
+        // Act & Assert
+        Assert.ThrowsAny<ArgumentException>(() => new StreamingAudioConverter(WaveFormat.CreateALawFormat(8000, 1)));
+    }
+
+    private static byte[] CreateTone(WaveFormat format, int seconds)
+    {
+        var frames = format.SampleRate * seconds;
+        var audio = new byte[frames * format.BlockAlign];
+        for (int i = 0; i < frames; i++)
+        {
+            var sample = (short)(Math.Sin(2 * Math.PI * 440 * i / format.SampleRate) * 16384);
+            for (int channel = 0; channel < format.Channels; channel++)
+            {
+                BinaryPrimitives.WriteInt16LittleEndian(audio.AsSpan(i * format.BlockAlign + channel * 2), sample);
+            }
+        }
+        return audio;
+    }
+}
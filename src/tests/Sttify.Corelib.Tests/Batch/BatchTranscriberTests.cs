@@ -0,0 +1,183 @@
+﻿using System.Text.Json;
+using Sttify.Corelib.Batch;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Batch;
+
+public class BatchTranscriberTests : IDisposable
+{
+    private readonly string _root;
+
+    public BatchTranscriberTests()
+    {
+        _root = Path.Combine(Path.GetTempPath(), $"sttify_batch_{Guid.NewGuid():N}");
+        Directory.CreateDirectory(_root);
+    }
+
+    public void Dispose()
+    {
+        try
+        {
+            Directory.Delete(_root, true);
+        }
+        catch
+        {
+            // Ignore cleanup errors
+        }
+    }
+
+    [Fact]
+    public async Task TranscribeAsync_WithSeveralFiles_ShouldDecodeEachOnceAndTotalTheAudio()
+    {
+        // Arrange
+        var inputs = new[] { CreatePcm("a.pcm", 3), CreatePcm("b.pcm", 1), CreatePcm("c.pcm", 2), CreatePcm("d.pcm", 2) };
+        var transcriber = new BatchTranscriber(() => new SecondCountingDecoder(),
+            new BatchTranscriptionSettings { MaxWorkers = 3, WriteTranscripts = false });
+
+        // Act
+        var report = await transcriber.TranscribeAsync(inputs);
+
+        // Assert
+        Assert.Equal(3, report.Workers);
+        Assert.Equal(0, report.FailedFiles);
+        Assert.Equal(TimeSpan.FromSeconds(8), report.AudioDuration);
+        Assert.Equal(inputs, report.Files.Select(f => f.InputPath));
+        Assert.Equal(new[] { 3, 1, 2, 2 }, report.Files.Select(f => f.Utterances).ToArray());
+        Assert.All(report.Files, f => Assert.Null(f.OutputPath));
+    }
+
+    [Fact]
+    public async Task TranscribeAsync_ShouldWriteTranscriptWithRecordingRelativeWordTimes()
+    {
+        // Arrange
+        var input = CreatePcm("talk.pcm", 2);
+        var outputDirectory = Path.Combine(_root, "out");
+        var transcriber = new BatchTranscriber(() => new SecondCountingDecoder(),
+            new BatchTranscriptionSettings { MaxWorkers = 1, OutputDirectory = outputDirectory });
+
+        // Act
+        var report = await transcriber.TranscribeAsync([input]);
+
+        // Assert
+        var outputPath = Path.Combine(outputDirectory, "talk.json");
+        Assert.Equal(outputPath, report.Files[0].OutputPath);
+
+        using var json = JsonDocument.Parse(File.ReadAllBytes(outputPath));
+        var utterances = json.RootElement.GetProperty("utterances");
+        Assert.Equal(2.0, json.RootElement.GetProperty("duration").GetDouble());
+        Assert.Equal(2, utterances.GetArrayLength());
+
+        var word = utterances[1].GetProperty("words")[0];
+        Assert.Equal("second2", word.GetProperty("word").GetString());
+        Assert.Equal(1.25, word.GetProperty("start").GetDouble());
+        Assert.Equal(1.75, word.GetProperty("end").GetDouble());
+    }
+
+    [Fact]
+    public async Task TranscribeAsync_WithMissingAndUnsupportedFiles_ShouldReportThemAndFinishTheRest()
+    {
+        // Arrange
+        var unsupported = Path.Combine(_root, "notes.txt");
+        File.WriteAllText(unsupported, "not audio");
+        var inputs = new[] { CreatePcm("ok.pcm", 1), Path.Combine(_root, "missing.pcm"), unsupported };
+        var transcriber = new BatchTranscriber(() => new SecondCountingDecoder(),
+            new BatchTranscriptionSettings { MaxWorkers = 2, WriteTranscripts = false });
+
+        // Act
+        var report = await transcriber.TranscribeAsync(inputs);
+
+        // Assert
+        Assert.Equal(2, report.FailedFiles);
+        Assert.True(report.Files[0].Succeeded);
+        Assert.False(report.Files[1].Succeeded);
+        Assert.False(report.Files[2].Succeeded);
+        Assert.Equal(TimeSpan.FromSeconds(1), report.AudioDuration);
+    }
+
+    [Fact]
+    public async Task TranscribeAsync_ShouldNeverShareADecoderBetweenWorkers()
+    {
+        // Arrange
+        var inputs = Enumerable.Range(0, 12).Select(i => CreatePcm($"{i}.pcm", 1)).ToArray();
+        var decoders = new List<SecondCountingDecoder>();
+        var transcriber = new BatchTranscriber(() =>
+        {
+            var decoder = new SecondCountingDecoder { DelayPerChunk = TimeSpan.FromMilliseconds(1) };
+            lock (decoders)
+            {
+                decoders.Add(decoder);
+            }
+            return decoder;
+        }, new BatchTranscriptionSettings { MaxWorkers = 4, WriteTranscripts = false });
+
+        // Act
+        var report = await transcriber.TranscribeAsync(inputs);
+
+        // Assert
+        Assert.Equal(0, report.FailedFiles);
+        Assert.True(decoders.Count <= 4);
+        Assert.All(decoders, d => Assert.False(d.WasUsedConcurrently));
+        Assert.All(decoders, d => Assert.True(d.IsDisposed));
+    }
+
+    private string CreatePcm(string name, int seconds)
+    {
+        var path = Path.Combine(_root, name);
+        File.WriteAllBytes(path, new byte[16000 * 2 * seconds]);
+        return path;
+    }
+
+    // Completes one utterance per second of audio with a single word in its middle half
+    private sealed class SecondCountingDecoder : IBatchDecoder
+    {
+        private const int BytesPerSecond = 32000;
+
+        private int _busy;
+        private long _bytes;
+
+        public TimeSpan DelayPerChunk { get; init; }
+        public bool WasUsedConcurrently { get; private set; }
+        public bool IsDisposed { get; private set; }
+
+        public void Accept(ReadOnlySpan<byte> pcm, List<TranscriptUtterance> utterances)
+        {
+            if (Interlocked.Exchange(ref _busy, 1) != 0)
+            {
+                WasUsedConcurrently = true;
+            }
+
+            if (DelayPerChunk > TimeSpan.Zero)
+            {
+                Thread.Sleep(DelayPerChunk);
+            }
+
+            var before = _bytes / BytesPerSecond;
+            _bytes += pcm.Length;
+            for (var second = before; second < _bytes / BytesPerSecond; second++)
+            {
+                var start = TimeSpan.FromSeconds(second + 0.25);
+                var end = TimeSpan.FromSeconds(second + 0.75);
+                utterances.Add(new TranscriptUtterance
+                {
+                    Text = $"second{second + 1}",
+                    Start = start,
+                    End = end,
+                    Confidence = 0.9,
+                    Words = [new TranscriptWord { Word = $"second{second + 1}", Start = start, End = end, Confidence = 0.9 }]
+                });
+            }
+
+            Volatile.Write(ref _busy, 0);
+        }
+
+        public void Complete(List<TranscriptUtterance> utterances)
+        {
+            _bytes = 0;
+        }
+
+        public void Dispose()
+        {
+            IsDisposed = true;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+﻿using Sttify.Corelib.Batch;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Batch;
+
+public class SegmentedTranscriberTests
+{
+    [Fact]
+    public async Task TranscribeAsync_ShouldDecodeSegmentsInParallelAndStitchThemInOrder()
+    {
+        // Arrange - three tones separated by a second of silence
+        var pcm = Concat(Silence(1), Tone(3), Silence(1), Tone(3), Silence(1), Tone(3));
+        var transcriber = new SegmentedTranscriber(() => new WholeSegmentDecoder(), new SegmentedTranscriptionSettings
+        {
+            MaxWorkers = 4,
+            Split = new SilenceSplitSettings { MinSegmentSeconds = 1 }
+        });
+
+        // Act
+        var report = await transcriber.TranscribeAsync(pcm, "long.wav");
+
+        // Assert
+        var utterances = report.Transcript.Utterances;
+        Assert.True(report.Segments >= 3, $"{report.Segments} segments");
+        Assert.Equal(report.Segments, utterances.Count);
+        Assert.Equal(TimeSpan.FromSeconds(12), report.AudioDuration);
+        Assert.Equal(TimeSpan.Zero, utterances[0].Start);
+        for (int i = 1; i < utterances.Count; i++)
+        {
+            Assert.Equal(utterances[i - 1].End, utterances[i].Start);
+            Assert.Equal(utterances[i].Start + TimeSpan.FromSeconds(0.5), utterances[i].Words[0].Start);
+        }
+        Assert.Equal(TimeSpan.FromSeconds(12), utterances[^1].End);
+    }
+
+    [Fact]
+    public async Task TranscribeAsync_WhenASegmentFails_ShouldFail()
+    {
+        // Arrange
+        var transcriber = new SegmentedTranscriber(() => new WholeSegmentDecoder { Fail = true });
+
+        // Act & Assert
+        await Assert.ThrowsAsync<InvalidOperationException>(() => transcriber.TranscribeAsync(Tone(1)));
+    }
+
+    private static byte[] Tone(int seconds)
+    {
+        var pcm = new byte[16000 * 2 * seconds];
+        for (int i = 0; i < pcm.Length / 2; i++)
+        {
+            var sample = (short)(5000 * Math.Sin(2 * Math.PI * 220 * i / 16000) + 2500 * Math.Sin(2 * Math.PI * 660 * i / 16000));
+            pcm[i * 2] = (byte)sample;
+            pcm[i * 2 + 1] = (byte)(sample >> 8);
+        }
+        return pcm;
+    }
+
+    private static byte[] Silence(int seconds) => new byte[16000 * 2 * seconds];
+
+    private static byte[] Concat(params byte[][] parts) => parts.SelectMany(p => p).ToArray();
+
+    // Reports each segment as one utterance spanning all of it, with a word half a second in
+    private sealed class WholeSegmentDecoder : IBatchDecoder
+    {
+        private long _bytes;
+
+        public bool Fail { get; init; }
+
+        public void Accept(ReadOnlySpan<byte> pcm, List<TranscriptUtterance> utterances)
+        {
+            if (Fail)
+                throw new InvalidOperationException("decoder failed");
+
+            _bytes += pcm.Length;
+        }
+
+        public void Complete(List<TranscriptUtterance> utterances)
+        {
+            var end = TimeSpan.FromSeconds(_bytes / 32000.0);
+            utterances.Add(new TranscriptUtterance
+            {
+                Text = "segment",
+                End = end,
+                Words = [new TranscriptWord { Word = "segment", Start = TimeSpan.FromSeconds(0.5), End = end }]
+            });
+            _bytes = 0;
+        }
+
+        public void Dispose()
+        {
+        }
+    }
+}
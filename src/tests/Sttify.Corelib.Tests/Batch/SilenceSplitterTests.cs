@@ -0,0 +1,85 @@
+﻿using Sttify.Corelib.Batch;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Batch;
+
+public class SilenceSplitterTests
+{
+    private const int FrameBytes = 960; // 30 ms
+
+    private static readonly SilenceSplitSettings Settings = new()
+    {
+        FrameMs = 30,
+        MinPauseMs = 300,
+        MinSegmentSeconds = 1,
+        MaxSegmentSeconds = 3
+    };
+
+    [Fact]
+    public void FindSegments_ShouldCutInTheMiddleOfLongPauses()
+    {
+        // Arrange - 40 voiced frames, a 20 frame pause, 40 voiced frames
+        var voiced = Frames((true, 40), (false, 20), (true, 40));
+
+        // Act
+        var segments = SilenceSplitter.FindSegments(voiced, voiced.Length * FrameBytes, Settings);
+
+        // Assert
+        Assert.Equal(2, segments.Count);
+        Assert.Equal(new AudioSegment(0, 50 * FrameBytes), segments[0]);
+        Assert.Equal(new AudioSegment(50 * FrameBytes, 50 * FrameBytes), segments[1]);
+    }
+
+    [Fact]
+    public void FindSegments_ShouldNotCutBeforeTheMinimumSegmentLength()
+    {
+        // Arrange - the first pause is long enough but comes after only 0.6 s
+        var voiced = Frames((true, 10), (false, 20), (true, 40), (false, 20), (true, 10));
+
+        // Act
+        var segments = SilenceSplitter.FindSegments(voiced, voiced.Length * FrameBytes, Settings);
+
+        // Assert
+        Assert.Equal(2, segments.Count);
+        Assert.Equal(80 * FrameBytes, segments[0].Length);
+    }
+
+    [Fact]
+    public void FindSegments_WithoutLongPauses_ShouldCutAtTheLongestShortPauseWithinTheMaximum()
+    {
+        // Arrange - 4 s of speech with two short pauses, the second one longer
+        var voiced = Frames((true, 40), (false, 4), (true, 30), (false, 8), (true, 51));
+
+        // Act
+        var segments = SilenceSplitter.FindSegments(voiced, voiced.Length * FrameBytes, Settings);
+
+        // Assert
+        Assert.Equal(2, segments.Count);
+        Assert.Equal(78 * FrameBytes, segments[0].Length);
+    }
+
+    [Fact]
+    public void FindSegments_ShouldCoverTheWholeRecordingIncludingAPartialFrame()
+    {
+        // Arrange - 10 s of continuous speech forces hard cuts
+        var voiced = Frames((true, 334));
+        var totalBytes = voiced.Length * FrameBytes + 100;
+
+        // Act
+        var segments = SilenceSplitter.FindSegments(voiced, totalBytes, Settings);
+
+        // Assert
+        Assert.Equal(0, segments[0].Offset);
+        for (int i = 1; i < segments.Count; i++)
+        {
+            Assert.Equal(segments[i - 1].Offset + segments[i - 1].Length, segments[i].Offset);
+        }
+        Assert.Equal(totalBytes, segments[^1].Offset + segments[^1].Length);
+        Assert.All(segments, s => Assert.True(s.Duration <= TimeSpan.FromSeconds(3.1)));
+    }
+
+    private static bool[] Frames(params (bool Voiced, int Count)[] runs)
+    {
+        return runs.SelectMany(r => Enumerable.Repeat(r.Voiced, r.Count)).ToArray();
+    }
+}
@@ -0,0 +1,135 @@
+﻿using Sttify.Corelib.Collections;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Collections;
+
+public class AudioHistoryRingTests
+{
+    [Fact]
+    public void Constructor_WithInvalidCapacity_ShouldThrow()
+    {
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => new AudioHistoryRing(0));
+        Assert.Throws<ArgumentOutOfRangeException>(() => new AudioHistoryRing(1, blockAlign: 2));
+    }
+
+    [Fact]
+    public void CopyLatest_BeforeWrap_ShouldReturnMostRecentBytesInOrder()
+    {
+        // Arrange
+        var ring = new AudioHistoryRing(8);
+        ring.Write(new byte[] { 1, 2, 3, 4, 5, 6 });
+        var destination = new byte[4];
+
+        // Act
+        var copied = ring.CopyLatest(destination, 4);
+
+        // Assert
+        Assert.Equal(4, copied);
+        Assert.Equal(new byte[] { 3, 4, 5, 6 }, destination);
+    }
+
+    [Fact]
+    public void CopyLatest_AfterWrap_ShouldStitchAcrossBoundary()
+    {
+        // Arrange
+        var ring = new AudioHistoryRing(8);
+        ring.Write(new byte[] { 1, 2, 3, 4, 5, 6 });
+        ring.Write(new byte[] { 7, 8, 9, 10 });
+        var destination = new byte[8];
+
+        // Act
+        var copied = ring.CopyLatest(destination, 100);
+
+        // Assert
+        Assert.Equal(8, copied);
+        Assert.Equal(new byte[] { 3, 4, 5, 6, 7, 8, 9, 10 }, destination);
+        Assert.Equal(10, ring.TotalWritten);
+    }
+
+    [Fact]
+    public void CopyBefore_WithPastPosition_ShouldEndAtThatPositionAndSkipLostBytes()
+    {
+        // Arrange
+        var ring = new AudioHistoryRing(8);
+        ring.Write(new byte[] { 1, 2, 3, 4, 5, 6 });
+        var position = ring.TotalWritten;
+        ring.Write(new byte[] { 7, 8, 9, 10 });
+        var destination = new byte[8];
+
+        // Act
+        var copied = ring.CopyBefore(destination, 100, position);
+
+        // Assert - bytes 1 and 2 were already overwritten
+        Assert.Equal(4, copied);
+        Assert.Equal(new byte[] { 3, 4, 5, 6 }, destination[..copied]);
+    }
+
+    [Fact]
+    public void CopyRange_FromKeywordEnd_ShouldReplayOnlyWhatFollowedIt()
+    {
+        // Arrange - the wake phrase, then the command the engine has not heard yet
+        var ring = new AudioHistoryRing(16);
+        ring.Write(new byte[] { 1, 2, 3, 4 });
+        var keywordEnd = ring.TotalWritten;
+        ring.Write(new byte[] { 5, 6, 7, 8 });
+        var liveFrameStart = ring.TotalWritten;
+        ring.Write(new byte[] { 9, 10 });
+        var destination = new byte[16];
+
+        // Act
+        var copied = ring.CopyRange(destination, keywordEnd, liveFrameStart);
+
+        // Assert
+        Assert.Equal(4, copied);
+        Assert.Equal(new byte[] { 5, 6, 7, 8 }, destination[..copied]);
+        Assert.Equal(0, ring.CopyRange(destination, liveFrameStart, keywordEnd));
+    }
+
+    [Fact]
+    public void Write_LargerThanCapacity_ShouldKeepTail()
+    {
+        // Arrange
+        var ring = new AudioHistoryRing(4);
+        var destination = new byte[4];
+
+        // Act
+        ring.Write(new byte[] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+        var copied = ring.CopyLatest(destination, 4);
+
+        // Assert
+        Assert.Equal(4, copied);
+        Assert.Equal(new byte[] { 7, 8, 9, 10 }, destination);
+    }
+
+    [Fact]
+    public void CopyLatest_ShouldRoundDownToBlockAlign()
+    {
+        // Arrange
+        var ring = new AudioHistoryRing(16, blockAlign: 2);
+        ring.Write(new byte[] { 1, 2, 3, 4, 5, 6 });
+        var destination = new byte[16];
+
+        // Act
+        var copied = ring.CopyLatest(destination, 5);
+
+        // Assert
+        Assert.Equal(4, copied);
+        Assert.Equal(new byte[] { 3, 4, 5, 6 }, destination[..4]);
+    }
+
+    [Fact]
+    public void Clear_ShouldDiscardHistory()
+    {
+        // Arrange
+        var ring = new AudioHistoryRing(8);
+        ring.Write(new byte[] { 1, 2, 3, 4 });
+
+        // Act
+        ring.Clear();
+
+        // Assert
+        Assert.Equal(0, ring.Available);
+        Assert.Equal(0, ring.CopyLatest(new byte[8], 8));
+    }
+}
@@ -0,0 +1,95 @@
+﻿using Sttify.Corelib.Collections;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Collections;
+
+public class RingBufferTests
+{
+    [Fact]
+    public void Constructor_WithInvalidCapacity_ShouldThrow()
+    {
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => new RingBuffer<int>(0));
+    }
+
+    [Fact]
+    public void Add_BelowCapacity_ShouldNotEvict()
+    {
+        // Arrange
+        var buffer = new RingBuffer<int>(3);
+
+        // Act
+        var evicted1 = buffer.Add(1, out _);
+        var evicted2 = buffer.Add(2, out _);
+
+        // Assert
+        Assert.False(evicted1);
+        Assert.False(evicted2);
+        Assert.Equal(2, buffer.Count);
+        Assert.Equal(1, buffer.Oldest);
+        Assert.Equal(2, buffer.Newest);
+    }
+
+    [Fact]
+    public void Add_WhenFull_ShouldEvictOldest()
+    {
+        // Arrange
+        var buffer = new RingBuffer<int>(3);
+        buffer.Add(1);
+        buffer.Add(2);
+        buffer.Add(3);
+
+        // Act
+        var wasEvicted = buffer.Add(4, out var evicted);
+
+        // Assert
+        Assert.True(wasEvicted);
+        Assert.Equal(1, evicted);
+        Assert.True(buffer.IsFull);
+        Assert.Equal(new[] { 2, 3, 4 }, new[] { buffer[0], buffer[1], buffer[2] });
+    }
+
+    [Fact]
+    public void RemoveOldest_ShouldReturnItemsInInsertionOrder()
+    {
+        // Arrange
+        var buffer = new RingBuffer<int>(2);
+        buffer.Add(1);
+        buffer.Add(2);
+        buffer.Add(3);
+
+        // Act & Assert
+        Assert.Equal(2, buffer.RemoveOldest());
+        Assert.Equal(3, buffer.RemoveOldest());
+        Assert.Equal(0, buffer.Count);
+        Assert.Throws<InvalidOperationException>(() => buffer.RemoveOldest());
+    }
+
+    [Fact]
+    public void Indexer_OutOfRange_ShouldThrow()
+    {
+        // Arrange
+        var buffer = new RingBuffer<int>(2);
+        buffer.Add(1);
+
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => buffer[1]);
+    }
+
+    [Fact]
+    public void Clear_ShouldResetCount()
+    {
+        // Arrange
+        var buffer = new RingBuffer<int>(2);
+        buffer.Add(1);
+        buffer.Add(2);
+
+        // Act
+        buffer.Clear();
+        buffer.Add(5);
+
+        // Assert
+        Assert.Equal(1, buffer.Count);
+        Assert.Equal(5, buffer.Oldest);
+    }
+}
@@ -0,0 +1,75 @@
+﻿using Sttify.Corelib.Collections;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Collections;
+
+public class SequenceReorderBufferTests
+{
+    [Fact]
+    public void TryTakeNext_WithGap_ShouldHoldLaterItems()
+    {
+        // Arrange
+        var buffer = new SequenceReorderBuffer<string>();
+        buffer.Add(1, "b");
+        buffer.Add(2, "c");
+
+        // Act
+        var released = buffer.TryTakeNext(out _);
+
+        // Assert
+        Assert.False(released);
+        Assert.Equal(0, buffer.NextSequence);
+        Assert.Equal(2, buffer.PendingCount);
+    }
+
+    [Fact]
+    public void TryTakeNext_WhenGapFilled_ShouldReleaseInOrder()
+    {
+        // Arrange
+        var buffer = new SequenceReorderBuffer<string>();
+        buffer.Add(2, "c");
+        buffer.Add(1, "b");
+        buffer.Add(0, "a");
+
+        // Act
+        var released = new List<string>();
+        while (buffer.TryTakeNext(out var item))
+        {
+            released.Add(item);
+        }
+
+        // Assert
+        Assert.Equal(new[] { "a", "b", "c" }, released);
+        Assert.Equal(3, buffer.NextSequence);
+        Assert.Equal(0, buffer.PendingCount);
+    }
+
+    [Fact]
+    public void Add_WithReleasedOrDuplicateSequence_ShouldThrow()
+    {
+        // Arrange
+        var buffer = new SequenceReorderBuffer<string>();
+        buffer.Add(0, "a");
+        buffer.TryTakeNext(out _);
+        buffer.Add(1, "b");
+
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => buffer.Add(0, "again"));
+        Assert.Throws<ArgumentException>(() => buffer.Add(1, "again"));
+    }
+
+    [Fact]
+    public void Clear_ShouldDropPendingAndRestartSequence()
+    {
+        // Arrange
+        var buffer = new SequenceReorderBuffer<string>();
+        buffer.Add(3, "d");
+
+        // Act
+        buffer.Clear(10);
+
+        // Assert
+        Assert.Equal(10, buffer.NextSequence);
+        Assert.Equal(0, buffer.PendingCount);
+    }
+}
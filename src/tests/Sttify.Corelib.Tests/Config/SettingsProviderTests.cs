@@ -105,4 +105,39 @@ public class SettingsProviderTests : IDisposable
         // Assert
         Assert.Same(settings1, settings2); // Should return cached instance
     }
+
+    [Fact]
+    public async Task CustomConfigPath_ShouldRoundTripThroughSourceGeneratedSerializer()
+    {
+        // Arrange
+        var directory = Path.Combine(Path.GetTempPath(), "sttify-tests", Guid.NewGuid().ToString("N"));
+        var configPath = Path.Combine(directory, "headless.json");
+        var settings = new SttifySettings();
+        settings.Engine.Profile = "hybrid";
+        settings.Engine.Hybrid.MaxPendingRefinements = 7;
+        settings.Engine.Cloud.AdditionalSettings["region"] = "westeurope";
+
+        try
+        {
+            using (var writer = new SettingsProvider(configPath, watchForChanges: false))
+            {
+                await writer.SaveSettingsAsync(settings);
+            }
+
+            // Act
+            using var reader = new SettingsProvider(configPath, watchForChanges: false);
+            var loaded = reader.GetSettingsSync();
+
+            // Assert
+            Assert.Equal(configPath, reader.ConfigPath);
+            Assert.Contains("\"maxPendingRefinements\": 7", await File.ReadAllTextAsync(configPath));
+            Assert.Equal("hybrid", loaded.Engine.Profile);
+            Assert.Equal(7, loaded.Engine.Hybrid.MaxPendingRefinements);
+            Assert.Equal("westeurope", loaded.Engine.Cloud.AdditionalSettings["region"].ToString());
+        }
+        finally
+        {
+            Directory.Delete(directory, recursive: true);
+        }
+    }
 }
@@ -0,0 +1,68 @@
+﻿using Sttify.Corelib.Diagnostics;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Diagnostics;
+
+public class LatencyHistogramTests
+{
+    [Fact]
+    public void GetPercentile_WhenEmpty_ShouldReturnNull()
+    {
+        // Arrange
+        var histogram = new LatencyHistogram();
+
+        // Act & Assert
+        Assert.Null(histogram.GetPercentile(0.9));
+    }
+
+    [Fact]
+    public void GetPercentile_ShouldBeWithinBucketResolution()
+    {
+        // Arrange - 1..100 ms
+        var histogram = new LatencyHistogram();
+        for (int ms = 1; ms <= 100; ms++)
+        {
+            histogram.Record(TimeSpan.FromMilliseconds(ms));
+        }
+
+        // Act
+        var p50 = histogram.GetPercentile(0.5)!.Value.TotalMilliseconds;
+        var p90 = histogram.GetPercentile(0.9)!.Value.TotalMilliseconds;
+
+        // Assert - buckets are 20% wide and reported by their upper bound
+        Assert.Equal(100, histogram.Count);
+        Assert.InRange(p50, 50, 60);
+        Assert.InRange(p90, 90, 108);
+    }
+
+    [Fact]
+    public void Record_BeyondMaxSamples_ShouldFadeOldLatencies()
+    {
+        // Arrange
+        var histogram = new LatencyHistogram(maxSamples: 100);
+        for (int i = 0; i < 99; i++)
+        {
+            histogram.Record(TimeSpan.FromSeconds(2));
+        }
+
+        // Act - the service gets faster
+        for (int i = 0; i < 300; i++)
+        {
+            histogram.Record(TimeSpan.FromMilliseconds(100));
+        }
+
+        // Assert
+        Assert.True(histogram.Count < 100);
+        Assert.InRange(histogram.GetPercentile(0.9)!.Value.TotalMilliseconds, 100, 120);
+    }
+
+    [Fact]
+    public void GetPercentile_OutOfRange_ShouldThrow()
+    {
+        // Arrange
+        var histogram = new LatencyHistogram();
+
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() => histogram.GetPercentile(1.5));
+    }
+}
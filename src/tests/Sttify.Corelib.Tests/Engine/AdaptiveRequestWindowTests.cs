@@ -0,0 +1,60 @@
+﻿using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class AdaptiveRequestWindowTests
+{
+    [Fact]
+    public void Size_BeforeMeasurement_ShouldAllowOneOverlap()
+    {
+        // Act
+        var window = new AdaptiveRequestWindow(TimeSpan.FromSeconds(1), minSize: 1, maxSize: 4);
+
+        // Assert
+        Assert.Equal(2, window.Size);
+        Assert.Null(window.SmoothedRoundTrip);
+    }
+
+    [Fact]
+    public void RecordRoundTrip_WithSlowLink_ShouldWidenWindow()
+    {
+        // Arrange
+        var window = new AdaptiveRequestWindow(TimeSpan.FromSeconds(1), minSize: 1, maxSize: 8);
+
+        // Act - 2.5s per request needs three chunks in flight, plus one for jitter
+        window.RecordRoundTrip(TimeSpan.FromMilliseconds(2500));
+
+        // Assert
+        Assert.Equal(4, window.Size);
+        Assert.Equal(TimeSpan.FromMilliseconds(2500), window.SmoothedRoundTrip);
+    }
+
+    [Fact]
+    public void RecordRoundTrip_ShouldClampToMaximum()
+    {
+        // Arrange
+        var window = new AdaptiveRequestWindow(TimeSpan.FromSeconds(1), minSize: 1, maxSize: 3);
+
+        // Act
+        window.RecordRoundTrip(TimeSpan.FromSeconds(30));
+
+        // Assert
+        Assert.Equal(3, window.Size);
+    }
+
+    [Fact]
+    public void RecordRoundTrip_ShouldSmoothOutliers()
+    {
+        // Arrange
+        var window = new AdaptiveRequestWindow(TimeSpan.FromSeconds(1), minSize: 1, maxSize: 8, smoothing: 0.25);
+        window.RecordRoundTrip(TimeSpan.FromMilliseconds(400));
+
+        // Act - a single 4.4s spike moves the average by a quarter of the difference
+        window.RecordRoundTrip(TimeSpan.FromMilliseconds(4400));
+
+        // Assert
+        Assert.Equal(TimeSpan.FromMilliseconds(1400), window.SmoothedRoundTrip);
+        Assert.Equal(3, window.Size);
+    }
+}
@@ -0,0 +1,70 @@
+﻿using System.Text;
+using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class AwsEventStreamTests
+{
+    [Fact]
+    public void Crc32_WithCheckString_ShouldMatchIeeeValue()
+    {
+        // Act
+        var crc = AwsEventStream.Crc32("123456789"u8);
+
+        // Assert
+        Assert.Equal(0xCBF43926u, crc);
+    }
+
+    [Fact]
+    public void Encode_ThenTryDecode_ShouldRoundTripHeadersAndPayload()
+    {
+        // Arrange
+        var date = DateTimeOffset.FromUnixTimeMilliseconds(1_700_000_000_123);
+        var headers = new[]
+        {
+            AwsEventStreamHeader.String(":message-type", "event"),
+            AwsEventStreamHeader.Bytes(":chunk-signature", [1, 2, 3, 4]),
+            AwsEventStreamHeader.Timestamp(":date", date)
+        };
+        var payload = Encoding.UTF8.GetBytes("{\"Transcript\":{}}");
+
+        // Act
+        var encoded = AwsEventStream.Encode(headers, payload);
+        var decoded = AwsEventStream.TryDecode(encoded, out var message, out var consumed);
+
+        // Assert
+        Assert.True(decoded);
+        Assert.Equal(encoded.Length, consumed);
+        Assert.Equal("event", message!.GetString(":message-type"));
+        Assert.Equal(new byte[] { 1, 2, 3, 4 }, message.GetHeader(":chunk-signature")!.BytesValue);
+        Assert.Equal(date, message.GetHeader(":date")!.TimestampValue);
+        Assert.Equal(payload, message.Payload);
+    }
+
+    [Fact]
+    public void TryDecode_WithPartialMessage_ShouldRequestMoreData()
+    {
+        // Arrange
+        var encoded = AwsEventStream.Encode([AwsEventStreamHeader.String("a", "b")], new byte[100]);
+
+        // Act
+        var decoded = AwsEventStream.TryDecode(encoded.AsSpan(0, encoded.Length - 1), out var message, out var consumed);
+
+        // Assert
+        Assert.False(decoded);
+        Assert.Null(message);
+        Assert.Equal(0, consumed);
+    }
+
+    [Fact]
+    public void TryDecode_WithCorruptPayload_ShouldThrow()
+    {
+        // Arrange
+        var encoded = AwsEventStream.Encode([AwsEventStreamHeader.String("a", "b")], new byte[16]);
+        encoded[^6] ^= 0xFF;
+
+        // Act & Assert
+        Assert.Throws<InvalidDataException>(() => AwsEventStream.TryDecode(encoded, out _, out _));
+    }
+}
@@ -0,0 +1,51 @@
+﻿using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class AwsSigV4SignerTests
+{
+    [Fact]
+    public void ComputeSignature_WithAwsGetVanillaVector_ShouldMatchPublishedSignature()
+    {
+        // Arrange - "get-vanilla" from the AWS SigV4 test suite
+        var signer = new AwsSigV4Signer("AKIDEXAMPLE", "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY", "us-east-1", "service");
+        var time = new DateTimeOffset(2015, 8, 30, 12, 36, 0, TimeSpan.Zero);
+        var headers = new Dictionary<string, string>
+        {
+            ["Host"] = "example.amazonaws.com",
+            ["X-Amz-Date"] = "20150830T123600Z"
+        };
+
+        // Act
+        var signature = signer.ComputeSignature("GET", "/", "", headers,
+            AwsSigV4Signer.HashHex([]), time, out var signedHeaders);
+
+        // Assert
+        Assert.Equal("5fa00fa31553b73ebf1942676e86291e8372ff2a2260956d9b8aae1d763fbf31", signature);
+        Assert.Equal("host;x-amz-date", signedHeaders);
+        Assert.Equal(
+            "AWS4-HMAC-SHA256 Credential=AKIDEXAMPLE/20150830/us-east-1/service/aws4_request, SignedHeaders=host;x-amz-date, Signature=" + signature,
+            signer.BuildAuthorizationHeader(signature, signedHeaders, time));
+    }
+
+    [Fact]
+    public void SignChunk_ShouldChainOnPriorSignature()
+    {
+        // Arrange
+        var signer = new AwsSigV4Signer("AKIDEXAMPLE", "secret", "us-west-2", "transcribe");
+        var time = new DateTimeOffset(2024, 1, 2, 3, 4, 5, TimeSpan.Zero);
+        var headers = AwsEventStream.EncodeHeaders([AwsEventStreamHeader.Timestamp(":date", time)]);
+        var payload = new byte[] { 1, 2, 3 };
+
+        // Act
+        var first = signer.SignChunk(headers, payload, "seed-a", time);
+        var repeated = signer.SignChunk(headers, payload, "seed-a", time);
+        var chained = signer.SignChunk(headers, payload, "seed-b", time);
+
+        // Assert
+        Assert.Equal(32, first.Length);
+        Assert.Equal(first, repeated);
+        Assert.NotEqual(first, chained);
+    }
+}
@@ -0,0 +1,196 @@
+﻿using System.Net;
+using System.Text;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Engine;
+using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class AwsTranscribeStreamingEngineTests
+{
+    private const string AccessKeyId = "AKIDEXAMPLE";
+    private const string SecretKey = "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY";
+
+    private static CloudEngineSettings CreateSettings() => new()
+    {
+        Provider = "aws-streaming",
+        Endpoint = "http://localhost:8443/stream-transcription",
+        Region = "us-west-2",
+        ApiKey = AccessKeyId,
+        SecretKey = SecretKey,
+        Language = "ja-JP"
+    };
+
+    [Fact]
+    public async Task StopAsync_ShouldSendSignedAudioEventsAndRaiseResults()
+    {
+        // Arrange
+        var handler = new StubTranscribeHandler(
+            CreateTranscriptEvent("こん", isPartial: true),
+            CreateTranscriptEvent("こんにちは", isPartial: false));
+        using var engine = new AwsTranscribeStreamingEngine(CreateSettings(), handler);
+
+        var partials = new List<string>();
+        var finals = new List<FinalRecognitionEventArgs>();
+        var errors = new List<SttErrorEventArgs>();
+        engine.OnPartial += (_, e) => partials.Add(e.Text);
+        engine.OnFinal += (_, e) => finals.Add(e);
+        engine.OnError += (_, e) => errors.Add(e);
+
+        // Act - 250ms of audio: two full 100ms events and one 50ms remainder
+        await engine.StartAsync();
+        engine.PushAudio(new byte[4800]);
+        engine.PushAudio(new byte[3200]);
+        await engine.StopAsync();
+
+        // Assert
+        Assert.Empty(errors);
+        Assert.Equal(new[] { "こん" }, partials);
+        var final = Assert.Single(finals);
+        Assert.Equal("こんにちは", final.Text);
+        Assert.Equal(0.9, final.Confidence, 3);
+        Assert.Equal(TimeSpan.FromSeconds(1.5), final.Duration);
+
+        var request = handler.Request!;
+        Assert.Equal(HttpVersion.Version20, request.Version);
+        Assert.Equal("ja-JP", GetHeader(request, "x-amz-transcribe-language-code"));
+        Assert.Equal("16000", GetHeader(request, "x-amz-transcribe-sample-rate"));
+        Assert.StartsWith($"AWS4-HMAC-SHA256 Credential={AccessKeyId}/", GetHeader(request, "Authorization"));
+
+        // Every frame is signed against the previous one, ending with an empty frame
+        var signer = new AwsSigV4Signer(AccessKeyId, SecretKey, "us-west-2", "transcribe");
+        var priorSignature = GetHeader(request, "Authorization")!.Split("Signature=")[1];
+        var audioLengths = new List<int>();
+        foreach (var frame in handler.Frames)
+        {
+            var dateHeader = frame.GetHeader(":date")!;
+            var expected = signer.SignChunk(AwsEventStream.EncodeHeaders([dateHeader]), frame.Payload, priorSignature, dateHeader.TimestampValue);
+            Assert.Equal(expected, frame.GetHeader(":chunk-signature")!.BytesValue);
+            priorSignature = Convert.ToHexStringLower(expected);
+
+            if (frame.Payload.Length > 0)
+            {
+                Assert.True(AwsEventStream.TryDecode(frame.Payload, out var audioEvent, out _));
+                Assert.Equal("AudioEvent", audioEvent!.GetString(":event-type"));
+                audioLengths.Add(audioEvent.Payload.Length);
+            }
+        }
+
+        Assert.Equal(new[] { 3200, 3200, 1600 }, audioLengths);
+        Assert.Empty(handler.Frames[^1].Payload);
+    }
+
+    [Fact]
+    public async Task StopAsync_WithExceptionEvent_ShouldRaiseError()
+    {
+        // Arrange
+        var exception = AwsEventStream.Encode(
+        [
+            AwsEventStreamHeader.String(":message-type", "exception"),
+            AwsEventStreamHeader.String(":exception-type", "BadRequestException")
+        ], "{\"Message\":\"Invalid sample rate\"}"u8);
+        using var engine = new AwsTranscribeStreamingEngine(CreateSettings(), new StubTranscribeHandler(exception));
+
+        var errors = new List<SttErrorEventArgs>();
+        engine.OnError += (_, e) => errors.Add(e);
+
+        // Act
+        await engine.StartAsync();
+        engine.PushAudio(new byte[3200]);
+        await engine.StopAsync();
+
+        // Assert
+        var error = Assert.Single(errors);
+        Assert.Contains("BadRequestException", error.Message);
+        Assert.Contains("Invalid sample rate", error.Message);
+    }
+
+    [Fact]
+    public async Task PushAudio_AfterStreamFailure_ShouldReconnectAndSendQueuedAudio()
+    {
+        // Arrange - the first connection is reset before any audio is read
+        var handler = new StubTranscribeHandler(CreateTranscriptEvent("こんにちは", isPartial: false)) { FailedAttempts = 1 };
+        using var engine = new AwsTranscribeStreamingEngine(CreateSettings(), handler);
+
+        var finals = new List<string>();
+        var errors = new List<SttErrorEventArgs>();
+        engine.OnFinal += (_, e) => finals.Add(e.Text);
+        engine.OnError += (_, e) => errors.Add(e);
+
+        // Act
+        await engine.StartAsync();
+        engine.PushAudio(new byte[3200]);
+        await handler.Connected.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        await engine.StopAsync();
+
+        // Assert - the audio queued while reconnecting went out on the second stream
+        Assert.Equal(2, handler.Attempts);
+        Assert.Single(errors);
+        Assert.Equal(new[] { "こんにちは" }, finals);
+        Assert.Equal(2, handler.Frames.Count);
+        Assert.Equal(TimeSpan.Zero, engine.DroppedAudio);
+    }
+
+    private static byte[] CreateTranscriptEvent(string text, bool isPartial)
+    {
+        var items = isPartial ? "" : ",\"Items\":[{\"Content\":\"x\",\"Confidence\":0.8},{\"Content\":\"y\",\"Confidence\":1.0}]";
+        var json = $"{{\"Transcript\":{{\"Results\":[{{\"ResultId\":\"r1\",\"StartTime\":0.5,\"EndTime\":2.0,\"IsPartial\":{(isPartial ? "true" : "false")},\"Alternatives\":[{{\"Transcript\":\"{text}\"{items}}}]}}]}}}}";
+
+        return AwsEventStream.Encode(
+        [
+            AwsEventStreamHeader.String(":message-type", "event"),
+            AwsEventStreamHeader.String(":event-type", "TranscriptEvent"),
+            AwsEventStreamHeader.String(":content-type", "application/json")
+        ], Encoding.UTF8.GetBytes(json));
+    }
+
+    private static string? GetHeader(HttpRequestMessage request, string name) =>
+        request.Headers.TryGetValues(name, out var values) ? values.FirstOrDefault() : null;
+
+    /// <summary>
+    /// Local stand-in for the Transcribe endpoint: consumes the whole event-stream request body, then
+    /// answers with canned event-stream messages. The first <see cref="FailedAttempts"/> requests fail
+    /// as if the connection had been reset.
+    /// </summary>
+    private sealed class StubTranscribeHandler : HttpMessageHandler
+    {
+        private readonly byte[][] _responseMessages;
+
+        public StubTranscribeHandler(params byte[][] responseMessages)
+        {
+            _responseMessages = responseMessages;
+        }
+
+        public int FailedAttempts { get; init; }
+        public int Attempts { get; private set; }
+        public TaskCompletionSource Connected { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public HttpRequestMessage? Request { get; private set; }
+        public List<AwsEventStreamMessage> Frames { get; } = new();
+
+        protected override async Task<HttpResponseMessage> SendAsync(HttpRequestMessage request, CancellationToken cancellationToken)
+        {
+            if (++Attempts <= FailedAttempts)
+                throw new HttpRequestException("Connection reset by peer");
+
+            Request = request;
+            Connected.TrySetResult();
+
+            using var body = new MemoryStream();
+            await request.Content!.CopyToAsync(body, cancellationToken);
+
+            var buffer = body.ToArray();
+            var offset = 0;
+            while (AwsEventStream.TryDecode(buffer.AsSpan(offset), out var frame, out var consumed))
+            {
+                Frames.Add(frame!);
+                offset += consumed;
+            }
+
+            return new HttpResponseMessage(HttpStatusCode.OK)
+            {
+                Content = new ByteArrayContent(_responseMessages.SelectMany(m => m).ToArray())
+            };
+        }
+    }
+}
@@ -0,0 +1,127 @@
+﻿using Sttify.Corelib.Config;
+using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class CloudSttEnginePipelineTests
+{
+    private const int OneSecondOfAudio = 32000;
+
+    [Fact]
+    public async Task ProcessAudioLoop_WithOverlappingRequests_ShouldDeliverFinalsInOrder()
+    {
+        // Arrange - the first request is much slower than the second
+        using var engine = new DelayedCloudEngine(TimeSpan.FromMilliseconds(400), TimeSpan.FromMilliseconds(10));
+        var finals = new List<string>();
+        var bothDelivered = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        engine.OnFinal += (_, e) =>
+        {
+            lock (finals)
+            {
+                finals.Add(e.Text);
+                if (finals.Count == 2)
+                    bothDelivered.TrySetResult();
+            }
+        };
+
+        // Act
+        await engine.StartAsync();
+        engine.PushAudio(CreateAudio(OneSecondOfAudio, 1));
+        engine.PushAudio(CreateAudio(OneSecondOfAudio, 2));
+        await bothDelivered.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        await engine.StopAsync();
+
+        // Assert - both were in flight together, yet results arrive in submission order
+        Assert.Equal(2, engine.MaxConcurrentRequests);
+        Assert.Equal(new[] { "chunk0", "chunk1" }, finals);
+
+        var statistics = engine.PipelineStatistics;
+        Assert.Equal(2, statistics.ChunksSubmitted);
+        Assert.Equal(2, statistics.ChunksCompleted);
+        Assert.NotNull(statistics.SmoothedRoundTrip);
+        Assert.Equal(0, statistics.DroppedAudioBytes);
+    }
+
+    [Fact]
+    public async Task ProcessAudioLoop_WhenSubscriberThrows_ShouldStillDeliverLaterResultsAndStop()
+    {
+        // Arrange - the second result is ready first and waits behind the one whose subscriber throws
+        using var engine = new DelayedCloudEngine(TimeSpan.FromMilliseconds(200), TimeSpan.FromMilliseconds(10));
+        var finals = new List<string>();
+        var bothDelivered = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        engine.OnFinal += (_, e) =>
+        {
+            lock (finals)
+            {
+                finals.Add(e.Text);
+                if (finals.Count == 2)
+                    bothDelivered.TrySetResult();
+            }
+
+            if (e.Text == "chunk0")
+                throw new InvalidOperationException("Subscriber failed");
+        };
+
+        // Act
+        await engine.StartAsync();
+        engine.PushAudio(CreateAudio(OneSecondOfAudio, 1));
+        engine.PushAudio(CreateAudio(OneSecondOfAudio, 2));
+        await bothDelivered.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        var exception = await Record.ExceptionAsync(() => engine.StopAsync());
+
+        // Assert
+        Assert.Null(exception);
+        Assert.Equal(new[] { "chunk0", "chunk1" }, finals);
+    }
+
+    private static byte[] CreateAudio(int length, byte value)
+    {
+        var audio = new byte[length];
+        Array.Fill(audio, value);
+        return audio;
+    }
+
+    private sealed class DelayedCloudEngine : CloudSttEngine
+    {
+        private readonly TimeSpan[] _delays;
+        private int _active;
+        private int _requestCount;
+
+        public DelayedCloudEngine(params TimeSpan[] delays)
+            : base(new CloudEngineSettings { Provider = "test", Endpoint = "" })
+        {
+            _delays = delays;
+        }
+
+        public int MaxConcurrentRequests { get; private set; }
+
+        protected override void ConfigureHttpClient()
+        {
+        }
+
+        protected override async Task<CloudRecognitionResult> ProcessAudioChunkAsync(byte[] audioData, CancellationToken cancellationToken)
+        {
+            var index = Interlocked.Increment(ref _requestCount) - 1;
+            var active = Interlocked.Increment(ref _active);
+            lock (_delays)
+            {
+                MaxConcurrentRequests = Math.Max(MaxConcurrentRequests, active);
+            }
+
+            try
+            {
+                await Task.Delay(_delays[Math.Min(index, _delays.Length - 1)], cancellationToken);
+                return new CloudRecognitionResult { Text = $"chunk{index}", IsFinal = true, Confidence = 1.0 };
+            }
+            finally
+            {
+                Interlocked.Decrement(ref _active);
+            }
+        }
+
+        protected override Task ValidateConnectionAsync(CancellationToken cancellationToken) => Task.CompletedTask;
+
+        protected override string GetProviderName() => "Test";
+    }
+}
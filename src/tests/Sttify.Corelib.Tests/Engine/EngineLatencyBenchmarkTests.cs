@@ -0,0 +1,84 @@
+﻿using Sttify.Corelib.Engine;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class EngineLatencyBenchmarkTests
+{
+    [Fact]
+    public async Task MeasureAsync_ShouldCountResultsAndCollectTranscript()
+    {
+        // Arrange - the fake engine emits a partial per second of audio and a final on stop
+        var engine = new FakeEngine();
+        var options = new EngineLatencyOptions
+        {
+            RealTime = false,
+            TrailingSilence = TimeSpan.Zero,
+            SettleTime = TimeSpan.Zero
+        };
+
+        // Act
+        var result = await EngineLatencyBenchmark.MeasureAsync(engine, new byte[64000], options);
+
+        // Assert
+        Assert.Equal(TimeSpan.FromSeconds(2), result.AudioDuration);
+        Assert.Equal(2, result.PartialCount);
+        Assert.Equal(1, result.FinalCount);
+        Assert.Equal("final", result.Transcript);
+        Assert.NotNull(result.FirstResult);
+        Assert.NotNull(result.FinalLatency);
+        Assert.Equal(64000, engine.BytesReceived);
+    }
+
+    [Fact]
+    public async Task MeasureAsync_ShouldAppendTrailingSilence()
+    {
+        // Arrange
+        var engine = new FakeEngine();
+        var options = new EngineLatencyOptions
+        {
+            RealTime = false,
+            TrailingSilence = TimeSpan.FromMilliseconds(500),
+            SettleTime = TimeSpan.Zero
+        };
+
+        // Act
+        await EngineLatencyBenchmark.MeasureAsync(engine, new byte[32000], options);
+
+        // Assert
+        Assert.Equal(32000 + 16000, engine.BytesReceived);
+    }
+
+    private sealed class FakeEngine : ISttEngine
+    {
+        public event EventHandler<PartialRecognitionEventArgs>? OnPartial;
+        public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
+        public event EventHandler<SttErrorEventArgs>? OnError;
+
+        public int BytesReceived { get; private set; }
+
+        public Task StartAsync(CancellationToken cancellationToken = default) => Task.CompletedTask;
+
+        public Task StopAsync(CancellationToken cancellationToken = default)
+        {
+            OnFinal?.Invoke(this, new FinalRecognitionEventArgs("final", 1.0, TimeSpan.Zero));
+            return Task.CompletedTask;
+        }
+
+        public void PushAudio(ReadOnlySpan<byte> audioData)
+        {
+            var before = BytesReceived / 32000;
+            BytesReceived += audioData.Length;
+            if (BytesReceived / 32000 > before)
+            {
+                OnPartial?.Invoke(this, new PartialRecognitionEventArgs("partial", 0.5));
+            }
+        }
+
+        public void Dispose()
+        {
+            // Suppress the unused-event warning for the error event
+            OnError = null;
+        }
+    }
+}
@@ -0,0 +1,218 @@
+﻿using System.Buffers.Binary;
+using System.Net;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Engine;
+using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class GoogleStreamingSpeechEngineTests
+{
+    private static CloudEngineSettings CreateSettings() => new()
+    {
+        Provider = "google-streaming",
+        Endpoint = "http://localhost:50051/",
+        ApiKey = "token",
+        Language = "ja-JP"
+    };
+
+    [Fact]
+    public async Task StopAsync_ShouldStreamConfigThenAudioAndRaiseInterimAndFinalResults()
+    {
+        // Arrange
+        var handler = new StubSpeechHandler(
+            CreateResultResponse("こん", isFinal: false, stability: 0.5f),
+            CreateEndOfUtteranceResponse(),
+            CreateResultResponse("こんにちは", isFinal: true, confidence: 0.9f));
+        using var engine = new GoogleStreamingSpeechEngine(CreateSettings(), handler);
+
+        var partials = new List<PartialRecognitionEventArgs>();
+        var finals = new List<FinalRecognitionEventArgs>();
+        var errors = new List<SttErrorEventArgs>();
+        engine.OnPartial += (_, e) => partials.Add(e);
+        engine.OnFinal += (_, e) => finals.Add(e);
+        engine.OnError += (_, e) => errors.Add(e);
+
+        // Act
+        await engine.StartAsync();
+        engine.PushAudio(new byte[3200]);
+        engine.PushAudio(new byte[1600]);
+        await engine.StopAsync();
+
+        // Assert
+        Assert.Empty(errors);
+        var partial = Assert.Single(partials);
+        Assert.Equal("こん", partial.Text);
+        Assert.Equal(0.5, partial.Confidence, 3);
+        var final = Assert.Single(finals);
+        Assert.Equal("こんにちは", final.Text);
+        Assert.Equal(0.9, final.Confidence, 3);
+        Assert.Equal(TimeSpan.FromSeconds(1.25), final.Duration);
+
+        var request = handler.Request!;
+        Assert.Equal(HttpVersion.Version20, request.Version);
+        Assert.Equal("/google.cloud.speech.v1.Speech/StreamingRecognize", request.RequestUri!.AbsolutePath);
+        Assert.Equal("application/grpc", handler.ContentType);
+        Assert.Equal("Bearer token", request.Headers.Authorization!.ToString());
+
+        // First message is the streaming config, then one message per pushed chunk
+        Assert.Equal(3, handler.Messages.Count);
+        Assert.Equal("ja-JP", ReadLanguageCode(handler.Messages[0]));
+        Assert.Equal(new[] { 3200, 1600 }, handler.Messages.Skip(1).Select(ReadAudioLength));
+    }
+
+    [Fact]
+    public async Task StopAsync_WithGrpcErrorStatus_ShouldRaiseError()
+    {
+        // Arrange
+        var handler = new StubSpeechHandler { GrpcStatus = "16", GrpcMessage = "Request%20had%20invalid%20credentials" };
+        using var engine = new GoogleStreamingSpeechEngine(CreateSettings(), handler);
+
+        var errors = new List<SttErrorEventArgs>();
+        engine.OnError += (_, e) => errors.Add(e);
+
+        // Act
+        await engine.StartAsync();
+        engine.PushAudio(new byte[3200]);
+        await engine.StopAsync();
+
+        // Assert
+        var error = Assert.Single(errors);
+        Assert.Contains("status 16", error.Message);
+        Assert.Contains("Request had invalid credentials", error.Message);
+    }
+
+    [Fact]
+    public async Task PushAudio_WhenStreamFallsBehind_ShouldCountDroppedAudio()
+    {
+        // Arrange - the service does not read the stream until released
+        var release = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var handler = new StubSpeechHandler(CreateResultResponse("こんにちは", isFinal: true, confidence: 0.9f)) { ReadGate = release.Task };
+        using var engine = new GoogleStreamingSpeechEngine(CreateSettings(), handler);
+
+        // Act - 151 chunks of 100ms against a 100-chunk queue
+        await engine.StartAsync();
+        engine.PushAudio(new byte[3200]);
+        await handler.Opened.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        for (int i = 0; i < 150; i++)
+        {
+            engine.PushAudio(new byte[3200]);
+        }
+        release.SetResult();
+        await engine.StopAsync();
+
+        // Assert - the oldest 51 chunks were dropped and the rest were sent
+        Assert.Equal(TimeSpan.FromMilliseconds(5100), engine.DroppedAudio);
+        Assert.Equal(101, handler.Messages.Count);
+    }
+
+    private static byte[] CreateResultResponse(string transcript, bool isFinal, float confidence = 0f, float stability = 0f)
+    {
+        var alternative = new ProtobufWriter().WriteString(1, transcript).WriteFloat(2, confidence);
+        var endTime = new ProtobufWriter().WriteVarint(1, 1).WriteVarint(2, 250_000_000);
+        var result = new ProtobufWriter()
+            .WriteMessage(1, alternative)
+            .WriteBool(2, isFinal)
+            .WriteFloat(3, stability)
+            .WriteMessage(4, endTime);
+        return new ProtobufWriter().WriteMessage(2, result).ToArray();
+    }
+
+    private static byte[] CreateEndOfUtteranceResponse() => new ProtobufWriter().WriteVarint(4, 1).ToArray();
+
+    private static string? ReadLanguageCode(byte[] request)
+    {
+        var reader = new ProtobufReader(request);
+        Assert.True(reader.TryReadTag(out var field, out _));
+        Assert.Equal(1, field); // streaming_config
+
+        var streamingConfig = new ProtobufReader(reader.ReadLengthDelimited());
+        while (streamingConfig.TryReadTag(out field, out var wireType))
+        {
+            if (field != 1)
+            {
+                streamingConfig.Skip(wireType);
+                continue;
+            }
+
+            var config = new ProtobufReader(streamingConfig.ReadLengthDelimited());
+            while (config.TryReadTag(out field, out wireType))
+            {
+                if (field == 3)
+                    return config.ReadString();
+                config.Skip(wireType);
+            }
+        }
+        return null;
+    }
+
+    private static int ReadAudioLength(byte[] request)
+    {
+        var reader = new ProtobufReader(request);
+        Assert.True(reader.TryReadTag(out var field, out _));
+        Assert.Equal(2, field); // audio_content
+        return reader.ReadLengthDelimited().Length;
+    }
+
+    private static byte[] FrameGrpc(byte[] message)
+    {
+        var frame = new byte[5 + message.Length];
+        BinaryPrimitives.WriteInt32BigEndian(frame.AsSpan(1), message.Length);
+        message.CopyTo(frame, 5);
+        return frame;
+    }
+
+    /// <summary>
+    /// Local stand-in for the Speech gRPC endpoint: consumes the request stream, then replies with
+    /// canned responses and a grpc-status trailer.
+    /// </summary>
+    private sealed class StubSpeechHandler : HttpMessageHandler
+    {
+        private readonly byte[][] _responses;
+
+        public StubSpeechHandler(params byte[][] responses)
+        {
+            _responses = responses;
+        }
+
+        public string GrpcStatus { get; init; } = "0";
+        public string? GrpcMessage { get; init; }
+        public Task? ReadGate { get; init; }
+        public TaskCompletionSource Opened { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public HttpRequestMessage? Request { get; private set; }
+        public string? ContentType { get; private set; }
+        public List<byte[]> Messages { get; } = new();
+
+        protected override async Task<HttpResponseMessage> SendAsync(HttpRequestMessage request, CancellationToken cancellationToken)
+        {
+            Request = request;
+            ContentType = request.Content!.Headers.ContentType?.MediaType;
+            Opened.TrySetResult();
+            if (ReadGate != null)
+            {
+                await ReadGate;
+            }
+
+            var body = await request.Content.ReadAsByteArrayAsync(cancellationToken);
+            for (int offset = 0; offset + 5 <= body.Length;)
+            {
+                var length = BinaryPrimitives.ReadInt32BigEndian(body.AsSpan(offset + 1));
+                Messages.Add(body.AsSpan(offset + 5, length).ToArray());
+                offset += 5 + length;
+            }
+
+            var response = new HttpResponseMessage(HttpStatusCode.OK)
+            {
+                Version = HttpVersion.Version20,
+                Content = new ByteArrayContent(_responses.SelectMany(FrameGrpc).ToArray())
+            };
+            response.TrailingHeaders.Add("grpc-status", GrpcStatus);
+            if (GrpcMessage != null)
+            {
+                response.TrailingHeaders.Add("grpc-message", GrpcMessage);
+            }
+            return response;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+﻿using Sttify.Corelib.Config;
+using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class HedgedCloudEngineTests
+{
+    [Fact]
+    public void HedgeDelay_BeforeEnoughSamples_ShouldUseInitialDelay()
+    {
+        // Arrange
+        using var engine = CreateEngine(TimeSpan.Zero, TimeSpan.Zero, new HedgedEngineSettings { InitialHedgeDelayMs = 1200 });
+
+        // Act & Assert
+        Assert.Equal(TimeSpan.FromMilliseconds(1200), engine.HedgeDelay);
+    }
+
+    [Fact]
+    public async Task Recognize_WhenPrimaryIsSlow_ShouldDeliverSecondaryAndCountCost()
+    {
+        // Arrange
+        using var engine = CreateEngine(TimeSpan.FromSeconds(30), TimeSpan.FromMilliseconds(10),
+            new HedgedEngineSettings { InitialHedgeDelayMs = 50, MinHedgeDelayMs = 10 });
+
+        // Act
+        var result = await engine.RecognizeAsync(new byte[32000]);
+
+        // Assert
+        Assert.Equal("Secondary", result.Text);
+        Assert.Equal("Secondary", result.Metadata["provider"]);
+
+        var statistics = engine.ProviderStatistics;
+        Assert.Equal(1, statistics[0].Requests);
+        Assert.Equal(0, statistics[0].Wins);
+        Assert.Equal(1, statistics[1].Wins);
+        Assert.Equal(1.0, statistics[0].BilledAudioSeconds, 3);
+        Assert.Equal(1.0, statistics[1].BilledAudioSeconds, 3);
+        Assert.NotNull(statistics[1].P90);
+    }
+
+    [Fact]
+    public async Task HedgeDelay_AfterSamples_ShouldFollowPrimaryLatency()
+    {
+        // Arrange
+        using var engine = CreateEngine(TimeSpan.FromMilliseconds(20), TimeSpan.FromSeconds(30),
+            new HedgedEngineSettings { InitialHedgeDelayMs = 5000, MinHedgeDelayMs = 1, MinSamples = 3 });
+
+        // Act
+        for (int i = 0; i < 3; i++)
+        {
+            await engine.RecognizeAsync(new byte[3200]);
+        }
+
+        // Assert
+        Assert.InRange(engine.HedgeDelay.TotalMilliseconds, 20, 1000);
+        Assert.Equal(3, engine.ProviderStatistics[0].Wins);
+        Assert.Equal(0, engine.ProviderStatistics[1].Requests);
+    }
+
+    [Fact]
+    public async Task HedgeDelay_WhenPrimaryTurnsConsistentlySlow_ShouldNotShrink()
+    {
+        // Arrange - three fast answers set the delay, then the primary only ever loses the race
+        var primary = new FakeProvider("Primary", call => call < 3 ? TimeSpan.FromMilliseconds(20) : TimeSpan.FromSeconds(30));
+        using var engine = new TestableHedgedEngine(
+            new HedgedEngineSettings { InitialHedgeDelayMs = 5000, MinHedgeDelayMs = 1, MinSamples = 3 },
+            primary, new FakeProvider("Secondary", TimeSpan.FromMilliseconds(50)));
+        for (int i = 0; i < 3; i++)
+        {
+            await engine.RecognizeAsync(new byte[3200]);
+        }
+        var delayBefore = engine.HedgeDelay;
+
+        // Act
+        for (int i = 0; i < 10; i++)
+        {
+            await engine.RecognizeAsync(new byte[3200]);
+        }
+        SpinWait.SpinUntil(() => engine.ProviderStatistics[0].Cancelled == 10, TimeSpan.FromSeconds(5));
+
+        // Assert - cancelled primaries count as at least the delay they were hedged after
+        Assert.Equal(10, engine.ProviderStatistics[0].Cancelled);
+        Assert.True(engine.HedgeDelay > delayBefore, $"Hedge delay {engine.HedgeDelay} fell back to {delayBefore} or below");
+    }
+
+    private static TestableHedgedEngine CreateEngine(TimeSpan primaryDelay, TimeSpan secondaryDelay, HedgedEngineSettings settings)
+    {
+        return new TestableHedgedEngine(settings, new FakeProvider("Primary", primaryDelay), new FakeProvider("Secondary", secondaryDelay));
+    }
+
+    private sealed class TestableHedgedEngine : HedgedCloudEngine
+    {
+        public TestableHedgedEngine(HedgedEngineSettings settings, CloudSttEngine primary, CloudSttEngine secondary)
+            : base(new CloudEngineSettings { Provider = "test", Endpoint = "" }, settings, primary, secondary)
+        {
+        }
+
+        public Task<CloudRecognitionResult> RecognizeAsync(byte[] audioData) => ProcessAudioChunkAsync(audioData, CancellationToken.None);
+    }
+
+    private sealed class FakeProvider : CloudSttEngine
+    {
+        private readonly Func<int, TimeSpan> _delay;
+        private readonly string _name;
+        private int _calls;
+
+        public FakeProvider(string name, TimeSpan delay)
+            : this(name, _ => delay)
+        {
+        }
+
+        public FakeProvider(string name, Func<int, TimeSpan> delay)
+            : base(new CloudEngineSettings { Provider = "test", Endpoint = "" })
+        {
+            _name = name;
+            _delay = delay;
+        }
+
+        protected override void ConfigureHttpClient()
+        {
+        }
+
+        protected override async Task<CloudRecognitionResult> ProcessAudioChunkAsync(byte[] audioData, CancellationToken cancellationToken)
+        {
+            await Task.Delay(_delay(Interlocked.Increment(ref _calls) - 1), cancellationToken);
+            return new CloudRecognitionResult { Text = _name, IsFinal = true, Confidence = 1.0 };
+        }
+
+        protected override Task ValidateConnectionAsync(CancellationToken cancellationToken) => Task.CompletedTask;
+
+        protected override string GetProviderName() => _name;
+    }
+}
@@ -0,0 +1,142 @@
+﻿using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class HedgedRequestTests
+{
+    [Fact]
+    public async Task RunAsync_WhenPrimaryIsFast_ShouldNotHedge()
+    {
+        // Arrange
+        var secondaryCalled = false;
+
+        // Act
+        var outcome = await HedgedRequest.RunAsync(
+            _ => Task.FromResult("primary"),
+            _ =>
+            {
+                secondaryCalled = true;
+                return Task.FromResult("secondary");
+            },
+            TimeSpan.FromSeconds(5),
+            _ => true);
+
+        // Assert
+        Assert.Equal("primary", outcome.Result);
+        Assert.Equal(HedgedWinner.Primary, outcome.Winner);
+        Assert.False(outcome.Hedged);
+        Assert.False(secondaryCalled);
+    }
+
+    [Fact]
+    public async Task RunAsync_WhenPrimaryIsSlow_ShouldTakeSecondaryAndCancelPrimary()
+    {
+        // Arrange
+        var primaryCancelled = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        // Act
+        var outcome = await HedgedRequest.RunAsync(
+            async token =>
+            {
+                try
+                {
+                    await Task.Delay(TimeSpan.FromSeconds(30), token);
+                    return "primary";
+                }
+                catch (OperationCanceledException)
+                {
+                    primaryCancelled.TrySetResult(true);
+                    throw;
+                }
+            },
+            _ => Task.FromResult("secondary"),
+            TimeSpan.FromMilliseconds(50),
+            _ => true);
+
+        // Assert
+        Assert.Equal("secondary", outcome.Result);
+        Assert.Equal(HedgedWinner.Secondary, outcome.Winner);
+        Assert.True(outcome.Hedged);
+        Assert.True(await primaryCancelled.Task.WaitAsync(TimeSpan.FromSeconds(5)));
+    }
+
+    [Fact]
+    public async Task RunAsync_WhenPrimaryFailsEarly_ShouldHedgeImmediately()
+    {
+        // Act
+        var outcome = await HedgedRequest.RunAsync<string>(
+            _ => throw new HttpRequestException("unavailable"),
+            _ => Task.FromResult("secondary"),
+            TimeSpan.FromSeconds(30),
+            _ => true).WaitAsync(TimeSpan.FromSeconds(5));
+
+        // Assert
+        Assert.Equal("secondary", outcome.Result);
+        Assert.Equal(HedgedWinner.Secondary, outcome.Winner);
+    }
+
+    [Fact]
+    public async Task RunAsync_WhenHedgedPrimaryFinishesFirst_ShouldPreferPrimary()
+    {
+        // Arrange
+        var secondaryCancelled = false;
+
+        // Act
+        var outcome = await HedgedRequest.RunAsync(
+            async token =>
+            {
+                await Task.Delay(100, token);
+                return "primary";
+            },
+            async token =>
+            {
+                try
+                {
+                    await Task.Delay(TimeSpan.FromSeconds(30), token);
+                    return "secondary";
+                }
+                catch (OperationCanceledException)
+                {
+                    secondaryCancelled = true;
+                    throw;
+                }
+            },
+            TimeSpan.FromMilliseconds(10),
+            _ => true);
+
+        // Assert
+        Assert.Equal(HedgedWinner.Primary, outcome.Winner);
+        Assert.True(outcome.Hedged);
+        await Task.Delay(100);
+        Assert.True(secondaryCancelled);
+    }
+
+    [Fact]
+    public async Task RunAsync_WhenBothUnsuccessful_ShouldReturnPrimaryResult()
+    {
+        // Act
+        var outcome = await HedgedRequest.RunAsync(
+            _ => Task.FromResult("primary-error"),
+            _ => Task.FromResult("secondary-error"),
+            TimeSpan.FromSeconds(5),
+            _ => false);
+
+        // Assert
+        Assert.Equal("primary-error", outcome.Result);
+        Assert.Equal(HedgedWinner.None, outcome.Winner);
+        Assert.True(outcome.Hedged);
+    }
+
+    [Fact]
+    public async Task RunAsync_WhenBothThrow_ShouldRethrowPrimaryException()
+    {
+        // Act & Assert
+        var ex = await Assert.ThrowsAsync<InvalidOperationException>(() => HedgedRequest.RunAsync<string>(
+            _ => throw new InvalidOperationException("primary"),
+            _ => throw new HttpRequestException("secondary"),
+            TimeSpan.FromSeconds(5),
+            _ => true));
+        Assert.Equal("primary", ex.Message);
+    }
+}
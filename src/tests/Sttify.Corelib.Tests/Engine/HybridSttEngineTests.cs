@@ -0,0 +1,218 @@
+﻿using Sttify.Corelib.Config;
+using Sttify.Corelib.Engine;
+using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class HybridSttEngineTests
+{
+    [Theory]
+    [InlineData("hello world", "Hello world.", true)]
+    [InlineData("こんにちは 世界", "こんにちは、世界。", true)]
+    [InlineData("hello word", "hello world", false)]
+    [InlineData("", "", true)]
+    [InlineData("hello", "", false)]
+    public void IsEquivalent_ShouldIgnoreCaseSpacingAndPunctuation(string local, string refined, bool expected)
+    {
+        // Act & Assert
+        Assert.Equal(expected, HybridSttEngine.IsEquivalent(local, refined));
+    }
+
+    [Fact]
+    public async Task LocalFinal_ShouldBeForwardedAndThenRefined()
+    {
+        // Arrange
+        var local = new FakeLocalEngine();
+        using var engine = new HybridSttEngine(local, new FakeCloud("hello world"), new HybridEngineSettings { MinUtteranceMs = 100 });
+        var finals = new List<string>();
+        var refined = new TaskCompletionSource<RefinedRecognitionEventArgs>(TaskCreationOptions.RunContinuationsAsynchronously);
+        engine.OnFinal += (_, e) => finals.Add(e.Text);
+        engine.OnRefined += (_, e) => refined.TrySetResult(e);
+        await engine.StartAsync();
+
+        // Act
+        engine.PushAudio(new byte[16000]);
+        local.RaiseFinal("hello word");
+
+        // Assert
+        Assert.Equal("hello word", Assert.Single(finals));
+        var result = await refined.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        Assert.Equal("hello word", result.OriginalText);
+        Assert.Equal("hello world", result.RefinedText);
+        Assert.Equal(1, engine.RefinedCount);
+    }
+
+    [Fact]
+    public async Task EquivalentCloudResult_ShouldNotRaiseRefined()
+    {
+        // Arrange
+        var local = new FakeLocalEngine();
+        var cloud = new FakeCloud("Hello world.");
+        using var engine = new HybridSttEngine(local, cloud, new HybridEngineSettings { MinUtteranceMs = 100 });
+        var refinedRaised = false;
+        engine.OnRefined += (_, _) => refinedRaised = true;
+        await engine.StartAsync();
+
+        // Act
+        engine.PushAudio(new byte[16000]);
+        local.RaiseFinal("hello world");
+        await engine.StopAsync();
+
+        // Assert
+        Assert.Equal(1, cloud.Requests);
+        Assert.False(refinedRaised);
+    }
+
+    [Fact]
+    public async Task ShortUtterance_ShouldNotBeSentToCloud()
+    {
+        // Arrange
+        var local = new FakeLocalEngine();
+        var cloud = new FakeCloud("yes");
+        using var engine = new HybridSttEngine(local, cloud, new HybridEngineSettings { MinUtteranceMs = 300 });
+        await engine.StartAsync();
+
+        // Act - 100 ms of audio
+        engine.PushAudio(new byte[3200]);
+        local.RaiseFinal("yeah");
+        await engine.StopAsync();
+
+        // Assert
+        Assert.Equal(0, cloud.Requests);
+    }
+
+    [Fact]
+    public async Task FullRefinementQueue_ShouldDropOldestUtterance()
+    {
+        // Arrange
+        var local = new FakeLocalEngine();
+        var cloud = new FakeCloud("refined") { Gate = new TaskCompletionSource() };
+        using var engine = new HybridSttEngine(local, cloud,
+            new HybridEngineSettings { MinUtteranceMs = 100, MaxPendingRefinements = 1, StopDrainSeconds = 0 });
+        await engine.StartAsync();
+
+        // Act - the first utterance occupies the cloud, the next two compete for one queue slot
+        for (int i = 0; i < 3; i++)
+        {
+            engine.PushAudio(new byte[16000]);
+            local.RaiseFinal($"utterance {i}");
+            await cloud.FirstRequest.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        }
+
+        // Assert
+        Assert.Equal(1, engine.DroppedRefinements);
+        cloud.Gate!.SetResult();
+        await engine.StopAsync();
+    }
+
+    [Fact]
+    public async Task LateFinal_ShouldRefineOnlyTheAudioItCovers()
+    {
+        // Arrange
+        var local = new FakeLocalEngine();
+        var cloud = new FakeCloud("refined");
+        using var engine = new HybridSttEngine(local, cloud, new HybridEngineSettings { MinUtteranceMs = 100 });
+        await engine.StartAsync();
+
+        // Act - the decoder reports the first final after the second utterance has started arriving
+        engine.PushAudio(new byte[16000]);
+        engine.PushAudio(new byte[6400]);
+        local.RaiseFinal("first", audioEndOffset: 16000);
+        engine.PushAudio(new byte[9600]);
+        local.RaiseFinal("second", audioEndOffset: 32000);
+        await engine.StopAsync();
+
+        // Assert - the 200 ms pushed before the first final went out with the second utterance
+        Assert.Equal(new[] { 16000, 16000 }, cloud.AudioLengths);
+    }
+
+    [Fact]
+    public async Task UnavailableCloud_ShouldKeepLocalRecognition()
+    {
+        // Arrange
+        var local = new FakeLocalEngine();
+        var cloud = new FakeCloud("unused") { FailValidation = true };
+        using var engine = new HybridSttEngine(local, cloud, new HybridEngineSettings { MinUtteranceMs = 100 });
+        var finals = new List<string>();
+        engine.OnFinal += (_, e) => finals.Add(e.Text);
+
+        // Act
+        await engine.StartAsync();
+        engine.PushAudio(new byte[16000]);
+        local.RaiseFinal("local only");
+        await engine.StopAsync();
+
+        // Assert
+        Assert.Equal("local only", Assert.Single(finals));
+        Assert.Equal(0, cloud.Requests);
+    }
+
+    private sealed class FakeLocalEngine : ISttEngine
+    {
+        public event EventHandler<PartialRecognitionEventArgs>? OnPartial { add { } remove { } }
+        public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
+        public event EventHandler<SttErrorEventArgs>? OnError { add { } remove { } }
+
+        public Task StartAsync(CancellationToken cancellationToken = default) => Task.CompletedTask;
+
+        public Task StopAsync(CancellationToken cancellationToken = default) => Task.CompletedTask;
+
+        public void PushAudio(ReadOnlySpan<byte> audioData)
+        {
+        }
+
+        public void RaiseFinal(string text, long? audioEndOffset = null)
+        {
+            OnFinal?.Invoke(this, new FinalRecognitionEventArgs(text, 0.8, TimeSpan.Zero, audioEndOffset));
+        }
+
+        public void Dispose()
+        {
+        }
+    }
+
+    private sealed class FakeCloud : CloudSttEngine
+    {
+        private readonly string _text;
+        private int _requests;
+
+        public FakeCloud(string text)
+            : base(new CloudEngineSettings { Provider = "test", Endpoint = "" })
+        {
+            _text = text;
+        }
+
+        public bool FailValidation { get; init; }
+        public TaskCompletionSource? Gate { get; init; }
+        public TaskCompletionSource FirstRequest { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public List<int> AudioLengths { get; } = new();
+        public int Requests => Volatile.Read(ref _requests);
+
+        protected override void ConfigureHttpClient()
+        {
+        }
+
+        protected override async Task<CloudRecognitionResult> ProcessAudioChunkAsync(byte[] audioData, CancellationToken cancellationToken)
+        {
+            Interlocked.Increment(ref _requests);
+            lock (AudioLengths)
+            {
+                AudioLengths.Add(audioData.Length);
+            }
+            FirstRequest.TrySetResult();
+            if (Gate != null)
+            {
+                await Gate.Task.WaitAsync(cancellationToken);
+            }
+            return new CloudRecognitionResult { Text = _text, IsFinal = true, Confidence = 0.95 };
+        }
+
+        protected override Task ValidateConnectionAsync(CancellationToken cancellationToken)
+        {
+            return FailValidation ? Task.FromException(new HttpRequestException("offline")) : Task.CompletedTask;
+        }
+
+        protected override string GetProviderName() => "Fake";
+    }
+}
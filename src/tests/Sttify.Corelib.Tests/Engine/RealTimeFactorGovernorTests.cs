@@ -0,0 +1,151 @@
+﻿using Sttify.Corelib.Engine.Vosk;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class RealTimeFactorGovernorTests
+{
+    private static readonly TimeSpan Second = TimeSpan.FromSeconds(1);
+
+    [Fact]
+    public void RecordDecode_WithSustainedSlowDecoding_ShouldAskForTheFallback()
+    {
+        // Arrange - 1 s windows, two slow windows in a row needed
+        var governor = new RealTimeFactorGovernor(CreateSettings());
+
+        // Act
+        Feed(governor, windows: 1, rtf: 1.3);
+        var afterOne = governor.SwitchPending;
+        Feed(governor, windows: 1, rtf: 1.3);
+
+        // Assert
+        Assert.False(afterOne);
+        Assert.True(governor.SwitchPending);
+        Assert.Equal(ModelTier.Fallback, governor.TargetTier);
+        Assert.Equal(1.3, governor.RealTimeFactor, 6);
+    }
+
+    [Fact]
+    public void RecordDecode_WithAnIsolatedSlowWindow_ShouldStayOnThePrimary()
+    {
+        // Arrange
+        var governor = new RealTimeFactorGovernor(CreateSettings());
+
+        // Act
+        Feed(governor, windows: 1, rtf: 1.5);
+        Feed(governor, windows: 1, rtf: 0.5);
+        Feed(governor, windows: 1, rtf: 1.5);
+
+        // Assert
+        Assert.False(governor.SwitchPending);
+        Assert.Equal(1.5, governor.MaxRealTimeFactor, 6);
+    }
+
+    [Fact]
+    public void RecordDecode_WithALargeBacklog_ShouldAskForTheFallbackImmediately()
+    {
+        // Arrange
+        var governor = new RealTimeFactorGovernor(CreateSettings());
+
+        // Act
+        governor.RecordDecode(TimeSpan.FromMilliseconds(100), TimeSpan.FromMilliseconds(50), TimeSpan.FromMilliseconds(3500));
+
+        // Assert
+        Assert.Equal(ModelTier.Fallback, governor.TargetTier);
+        Assert.Equal(TimeSpan.FromMilliseconds(3500), governor.MaxQueuedAudio);
+    }
+
+    [Fact]
+    public void RecordDecode_OnTheFallback_ShouldSwitchBackOnlyWhenThePrimaryWouldKeepUp()
+    {
+        // Arrange - the primary ran at 1.2, the fallback at 0.3 under the same load: a 4x cost ratio
+        var governor = new RealTimeFactorGovernor(CreateSettings());
+        Feed(governor, windows: 2, rtf: 1.2);
+        governor.OnSwitched(ModelTier.Fallback);
+        Feed(governor, windows: 1, rtf: 0.3);
+
+        // Act - 0.2 on the fallback still estimates 0.8 on the primary; 0.1 estimates 0.4
+        Feed(governor, windows: 5, rtf: 0.2);
+        var pendingWhileBusy = governor.SwitchPending;
+        Feed(governor, windows: 2, rtf: 0.1);
+        var pendingAfterTwo = governor.SwitchPending;
+        Feed(governor, windows: 1, rtf: 0.1);
+
+        // Assert
+        Assert.False(pendingWhileBusy);
+        Assert.False(pendingAfterTwo);
+        Assert.Equal(ModelTier.Primary, governor.TargetTier);
+        Assert.Equal(0.4, governor.EstimatedPrimaryRealTimeFactor, 6);
+    }
+
+    [Fact]
+    public void OnSwitched_WhenFallingBehindSoonAfterSwitchingBack_ShouldDoubleTheWaitBeforeTheNextUpgrade()
+    {
+        // Arrange
+        var governor = new RealTimeFactorGovernor(CreateSettings());
+        governor.OnSwitched(ModelTier.Fallback);
+        governor.OnSwitched(ModelTier.Primary);
+
+        // Act
+        Feed(governor, windows: 2, rtf: 1.5);
+        governor.OnSwitched(ModelTier.Fallback);
+
+        // Assert
+        Assert.Equal(6, governor.CurrentUpgradeWindows);
+        Assert.Equal(2, governor.Downgrades);
+        Assert.Equal(1, governor.Upgrades);
+    }
+
+    [Fact]
+    public void CancelSwitch_ShouldDropThePendingSwitch()
+    {
+        // Arrange
+        var governor = new RealTimeFactorGovernor(CreateSettings());
+        Feed(governor, windows: 2, rtf: 2.0);
+
+        // Act
+        governor.CancelSwitch();
+
+        // Assert
+        Assert.False(governor.SwitchPending);
+        Assert.Equal(ModelTier.Primary, governor.ActiveTier);
+    }
+
+    [Fact]
+    public void SetFallbackAvailable_WhenFallbackModelIsMissing_ShouldStayOnPrimary()
+    {
+        // Arrange - the fallback path did not exist, so the preload failed
+        var governor = new RealTimeFactorGovernor(CreateSettings());
+        Feed(governor, windows: 2, rtf: 2.0);
+        Assert.True(governor.SwitchPending);
+
+        // Act
+        governor.SetFallbackAvailable(false);
+        Feed(governor, windows: 4, rtf: 2.0);
+        governor.RecordDecode(Second / 10, Second / 10, TimeSpan.FromSeconds(5));
+
+        // Assert
+        Assert.False(governor.SwitchPending);
+        Assert.Equal(ModelTier.Primary, governor.TargetTier);
+        Assert.Equal(0, governor.Downgrades);
+    }
+
+    private static RealTimeFactorGovernorSettings CreateSettings() => new()
+    {
+        Enabled = true,
+        WindowMs = 1000,
+        SustainWindows = 2,
+        MaxQueuedAudioMs = 3000,
+        UpgradeRtf = 0.7,
+        UpgradeWindows = 3,
+        FlapWindows = 10
+    };
+
+    private static void Feed(RealTimeFactorGovernor governor, int windows, double rtf)
+    {
+        for (int i = 0; i < windows * 10; i++)
+        {
+            governor.RecordDecode(Second / 10, Second / 10 * rtf, TimeSpan.Zero);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+﻿using Sttify.Corelib.Engine.Vosk;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class RecognizerPoolTests
+{
+    [Fact]
+    public void Recycle_WhenResetSucceeds_ShouldReuseInstance()
+    {
+        // Arrange
+        using var pool = new RecognizerPool<FakeRecognizer>(() => new FakeRecognizer(), r => r.ResetCalls++, "test", spareTarget: 0);
+        var recognizer = pool.Acquire();
+
+        // Act
+        var recycled = pool.Recycle(recognizer);
+
+        // Assert
+        Assert.Same(recognizer, recycled);
+        Assert.Equal(1, recognizer.ResetCalls);
+        Assert.False(recognizer.IsDisposed);
+        Assert.Equal(1, pool.ConstructionCount);
+        Assert.Equal(1, pool.ResetCount);
+    }
+
+    [Fact]
+    public void Recycle_WhenResetFails_ShouldDisposeAndReplace()
+    {
+        // Arrange
+        using var pool = new RecognizerPool<FakeRecognizer>(() => new FakeRecognizer(),
+            r => throw new InvalidOperationException("native failure"), "test", spareTarget: 0);
+        var recognizer = pool.Acquire();
+
+        // Act
+        var replacement = pool.Recycle(recognizer);
+
+        // Assert
+        Assert.NotSame(recognizer, replacement);
+        Assert.True(recognizer.IsDisposed);
+        Assert.Equal(2, pool.ConstructionCount);
+    }
+
+    [Fact]
+    public async Task Acquire_ShouldPreferWarmSpare()
+    {
+        // Arrange
+        using var pool = new RecognizerPool<FakeRecognizer>(() => new FakeRecognizer(), _ => { }, "test", spareTarget: 1);
+        pool.Replenish();
+        await WaitForSparesAsync(pool, 1);
+
+        // Act
+        var recognizer = pool.Acquire();
+
+        // Assert - the spare was built ahead of time and a new one is on its way
+        Assert.NotNull(recognizer);
+        await WaitForSparesAsync(pool, 1);
+        Assert.Equal(2, pool.ConstructionCount);
+    }
+
+    [Fact]
+    public async Task Dispose_ShouldDisposeSpares()
+    {
+        // Arrange
+        var created = new List<FakeRecognizer>();
+        var pool = new RecognizerPool<FakeRecognizer>(() =>
+        {
+            var recognizer = new FakeRecognizer();
+            lock (created)
+            {
+                created.Add(recognizer);
+            }
+            return recognizer;
+        }, _ => { }, "test", spareTarget: 2);
+        pool.Replenish();
+        await WaitForSparesAsync(pool, 2);
+
+        // Act
+        pool.Dispose();
+
+        // Assert
+        Assert.Equal(0, pool.SpareCount);
+        Assert.All(created, r => Assert.True(r.IsDisposed));
+        Assert.Throws<ObjectDisposedException>(() => pool.Acquire());
+    }
+
+    private static async Task WaitForSparesAsync(RecognizerPool<FakeRecognizer> pool, int count)
+    {
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        while (pool.SpareCount < count && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(10);
+        }
+        Assert.Equal(count, pool.SpareCount);
+    }
+
+    private sealed class FakeRecognizer : IDisposable
+    {
+        public int ResetCalls { get; set; }
+        public bool IsDisposed { get; private set; }
+
+        public void Dispose() => IsDisposed = true;
+    }
+}
@@ -0,0 +1,49 @@
+﻿using System.Net;
+using Sttify.Corelib.Engine;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class SharedHttpHandlerTests
+{
+    [Fact]
+    public void CreateClient_ShouldPreferHttp2WithFallback()
+    {
+        // Act
+        using var client = SharedHttpHandler.CreateClient(TimeSpan.FromSeconds(12));
+
+        // Assert
+        Assert.Equal(TimeSpan.FromSeconds(12), client.Timeout);
+        Assert.Equal(HttpVersion.Version20, client.DefaultRequestVersion);
+        Assert.Equal(HttpVersionPolicy.RequestVersionOrLower, client.DefaultVersionPolicy);
+    }
+
+    [Fact]
+    public void CreateClient_DisposingClient_ShouldKeepSharedHandlerUsable()
+    {
+        // Arrange
+        var client = SharedHttpHandler.CreateClient(TimeSpan.FromSeconds(5));
+
+        // Act
+        client.Dispose();
+        using var next = SharedHttpHandler.CreateClient(TimeSpan.FromSeconds(5));
+
+        // Assert
+        Assert.Same(SharedHttpHandler.Handler, SharedHttpHandler.Handler);
+        Assert.True(SharedHttpHandler.Handler.PooledConnectionLifetime > TimeSpan.Zero);
+        Assert.Equal(DecompressionMethods.All, SharedHttpHandler.Handler.AutomaticDecompression);
+    }
+
+    [Theory]
+    [InlineData(null)]
+    [InlineData("")]
+    [InlineData("not a uri")]
+    public async Task WarmUpAsync_WithoutUsableEndpoint_ShouldDoNothing(string? endpoint)
+    {
+        // Arrange
+        using var client = SharedHttpHandler.CreateClient(TimeSpan.FromSeconds(5));
+
+        // Act & Assert - returns without attempting a connection
+        await SharedHttpHandler.WarmUpAsync(client, endpoint);
+    }
+}
@@ -0,0 +1,61 @@
+﻿using Sttify.Corelib.Engine.Cloud;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class StreamingAudioQueueTests
+{
+    private const int BytesPerSecond = 32000;
+
+    [Fact]
+    public void TryWrite_WhenFull_ShouldDropOldestAndCountIt()
+    {
+        // Arrange
+        var queue = new StreamingAudioQueue(2, BytesPerSecond, "TestAudioDropped");
+
+        // Act - the third chunk pushes out the first 100ms
+        queue.TryWrite(CreateAudio(3200, 1));
+        queue.TryWrite(CreateAudio(3200, 2));
+        queue.TryWrite(CreateAudio(1600, 3));
+
+        // Assert
+        Assert.Equal(1, queue.DroppedChunks);
+        Assert.Equal(TimeSpan.FromMilliseconds(100), queue.DroppedAudio);
+
+        Assert.True(queue.Reader.TryRead(out var first));
+        Assert.Equal(3200, first.Length);
+        Assert.Equal(2, first.Span[0]);
+        first.Return();
+
+        Assert.True(queue.Reader.TryRead(out var second));
+        Assert.Equal(1600, second.Span.Length);
+        Assert.Equal(3, second.Span[0]);
+        second.Return();
+    }
+
+    [Fact]
+    public void TryWrite_AfterComplete_ShouldRejectAudio()
+    {
+        // Arrange
+        var queue = new StreamingAudioQueue(4, BytesPerSecond, "TestAudioDropped");
+        queue.TryWrite(CreateAudio(320, 1));
+
+        // Act
+        queue.Complete();
+        var accepted = queue.TryWrite(CreateAudio(320, 2));
+        queue.Clear();
+
+        // Assert
+        Assert.False(accepted);
+        Assert.False(queue.Reader.TryRead(out _));
+        Assert.True(queue.Reader.Completion.IsCompleted);
+        Assert.Equal(0, queue.DroppedChunks);
+    }
+
+    private static byte[] CreateAudio(int length, byte value)
+    {
+        var audio = new byte[length];
+        Array.Fill(audio, value);
+        return audio;
+    }
+}
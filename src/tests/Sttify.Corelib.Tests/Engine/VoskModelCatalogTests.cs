@@ -0,0 +1,161 @@
+﻿using Sttify.Corelib.Engine.Vosk;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class VoskModelCatalogTests : IDisposable
+{
+    private readonly string _root;
+
+    public VoskModelCatalogTests()
+    {
+        _root = Path.Combine(Path.GetTempPath(), $"sttify_catalog_{Guid.NewGuid():N}");
+        Directory.CreateDirectory(_root);
+    }
+
+    public void Dispose()
+    {
+        try
+        {
+            Directory.Delete(_root, true);
+        }
+        catch
+        {
+            // Ignore cleanup errors
+        }
+    }
+
+    [Fact]
+    public void GetModel_WithValidModel_ShouldIndexSizeLanguageAndHash()
+    {
+        // Arrange
+        var modelPath = CreateModel("vosk-model-small-ja-0.22");
+        using var catalog = new VoskModelCatalog(enableWatchers: false);
+
+        // Act
+        var entry = catalog.GetModel(modelPath);
+
+        // Assert
+        Assert.NotNull(entry);
+        Assert.True(entry.IsValid);
+        Assert.Equal("ja", entry.Language);
+        Assert.Equal(30, entry.SizeBytes);
+        Assert.Equal(64, entry.ContentHash.Length);
+    }
+
+    [Fact]
+    public void GetModel_WithIncompleteModel_ShouldBeInvalid()
+    {
+        // Arrange
+        var modelPath = Path.Combine(_root, "broken-model");
+        Directory.CreateDirectory(Path.Combine(modelPath, "am"));
+        File.WriteAllText(Path.Combine(modelPath, "am", "final.mdl"), "acoustic");
+        using var catalog = new VoskModelCatalog(enableWatchers: false);
+
+        // Act
+        var entry = catalog.GetModel(modelPath);
+
+        // Assert
+        Assert.NotNull(entry);
+        Assert.False(entry.IsValid);
+        Assert.Null(catalog.GetModel(Path.Combine(_root, "missing")));
+    }
+
+    [Fact]
+    public void GetModel_ShouldServeCachedEntryUntilInvalidated()
+    {
+        // Arrange
+        var modelPath = CreateModel("vosk-model-en-us-0.22");
+        using var catalog = new VoskModelCatalog(enableWatchers: false);
+        var first = catalog.GetModel(modelPath);
+        File.WriteAllText(Path.Combine(modelPath, "graph", "words.txt"), "words-txt!words-txt!");
+
+        // Act
+        var cached = catalog.GetModel(modelPath);
+        catalog.Invalidate(modelPath);
+        var refreshed = catalog.GetModel(modelPath);
+
+        // Assert
+        Assert.Same(first, cached);
+        Assert.NotSame(first, refreshed);
+        Assert.Equal(first!.SizeBytes + 10, refreshed!.SizeBytes);
+        Assert.NotEqual(first.ContentHash, refreshed.ContentHash);
+    }
+
+    [Fact]
+    public void GetModels_ShouldReturnOnlyValidModels()
+    {
+        // Arrange
+        CreateModel("vosk-model-small-en-us-0.15");
+        CreateModel("vosk-model-ja-0.22");
+        Directory.CreateDirectory(Path.Combine(_root, "not-a-model"));
+        using var catalog = new VoskModelCatalog(enableWatchers: false);
+
+        // Act
+        var models = catalog.GetModels(_root);
+
+        // Assert
+        Assert.Equal(new[] { "vosk-model-ja-0.22", "vosk-model-small-en-us-0.15" }, models.Select(m => m.Name).ToArray());
+    }
+
+    [Fact]
+    public void Load_WithUnchangedModel_ShouldReusePersistedEntry()
+    {
+        // Arrange
+        var modelPath = CreateModel("vosk-model-small-ja-0.22");
+        var catalogPath = Path.Combine(_root, "catalog.json");
+        using (var catalog = new VoskModelCatalog(catalogPath, enableWatchers: false))
+        {
+            catalog.GetModel(modelPath);
+            catalog.Save();
+        }
+
+        // Act
+        using var reloaded = VoskModelCatalog.Load(catalogPath, enableWatchers: false);
+        var entry = reloaded.GetModel(modelPath);
+
+        // Assert - the stamp matched, so nothing was re-walked
+        Assert.NotNull(entry);
+        Assert.Equal(30, entry.SizeBytes);
+        Assert.Equal(VoskModelCatalog.ComputeStamp(modelPath), entry.Stamp);
+    }
+
+    [Theory]
+    [InlineData("vosk-model-small-ja-0.22", "ja")]
+    [InlineData("vosk-model-fr-0.6-linto", "fr")]
+    [InlineData("vosk-model-small-de-0.15", "de")]
+    [InlineData("custom-english-model", "en")]
+    [InlineData("my-model", "")]
+    public void DetectLanguage_ShouldUseKnownModelsThenNameTokens(string name, string expected)
+    {
+        // Act & Assert
+        Assert.Equal(expected, VoskModelCatalog.DetectLanguage(name));
+    }
+
+    [Fact]
+    public void SupportsGrammar_ShouldRequireADynamicGraph()
+    {
+        // Arrange
+        var smallModel = CreateModel("vosk-model-small-ja-0.22");
+        File.WriteAllText(Path.Combine(smallModel, "graph", "Gr.fst"), "grammar");
+        var largeModel = Path.Combine(_root, "vosk-model-ja-0.22");
+        Directory.CreateDirectory(Path.Combine(largeModel, "graph"));
+        File.WriteAllText(Path.Combine(largeModel, "graph", "HCLG.fst"), "static-graph");
+
+        // Act & Assert
+        Assert.True(VoskModelManager.SupportsGrammar(smallModel));
+        Assert.False(VoskModelManager.SupportsGrammar(largeModel));
+        Assert.False(VoskModelManager.SupportsGrammar(""));
+    }
+
+    private string CreateModel(string name)
+    {
+        var modelPath = Path.Combine(_root, name);
+        Directory.CreateDirectory(Path.Combine(modelPath, "am"));
+        Directory.CreateDirectory(Path.Combine(modelPath, "graph"));
+        File.WriteAllText(Path.Combine(modelPath, "am", "final.mdl"), "acoustic-1"); // 10 bytes
+        File.WriteAllText(Path.Combine(modelPath, "graph", "words.txt"), "words-txt!"); // 10 bytes
+        File.WriteAllText(Path.Combine(modelPath, "graph", "HCLR.fst"), "graph-fst!"); // 10 bytes
+        return modelPath;
+    }
+}
@@ -0,0 +1,96 @@
+﻿using System.Text.Json;
+using Sttify.Corelib.Batch;
+using Sttify.Corelib.Engine.Vosk;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Engine;
+
+public class VoskResultReaderTests
+{
+    [Fact]
+    public void TryReadFinal_WithWordResults_ShouldAverageConfidence()
+    {
+        // Arrange
+        var json = """
+            {
+              "result" : [{ "conf" : 0.8, "end" : 0.5, "start" : 0.1, "word" : "今日" },
+                          { "conf" : 0.6, "end" : 0.9, "start" : 0.5, "word" : "は" }],
+              "text" : " 今日 は "
+            }
+            """u8;
+
+        // Act
+        var found = VoskResultReader.TryReadFinal(json, out var text, out var confidence);
+
+        // Assert
+        Assert.True(found);
+        Assert.Equal("今日 は", text);
+        Assert.Equal(0.7, confidence, 6);
+    }
+
+    [Fact]
+    public void TryReadFinal_WithWordList_ShouldReadWordTimings()
+    {
+        // Arrange
+        var words = new List<TranscriptWord>();
+        var json = """
+            {"result" : [{ "conf" : 1.0, "end" : 12.48, "start" : 12.06, "word" : "hello", "extra" : [1] }], "text" : "hello"}
+            """u8;
+
+        // Act
+        var found = VoskResultReader.TryReadFinal(json, out _, out _, words);
+
+        // Assert
+        Assert.True(found);
+        var word = Assert.Single(words);
+        Assert.Equal("hello", word.Word);
+        Assert.Equal(TimeSpan.FromSeconds(12.06), word.Start);
+        Assert.Equal(TimeSpan.FromSeconds(12.48), word.End);
+        Assert.Equal(1.0, word.Confidence);
+    }
+
+    [Fact]
+    public void TryReadFinal_WithoutWordResults_ShouldUseTopLevelOrDefaultConfidence()
+    {
+        // Act
+        var withTopLevel = VoskResultReader.TryReadFinal("""{"confidence": 1.7, "text": "hello"}"""u8, out _, out var clamped);
+        var withoutAny = VoskResultReader.TryReadFinal("""{"text": "hello"}"""u8, out _, out var fallback);
+
+        // Assert
+        Assert.True(withTopLevel);
+        Assert.Equal(1.0, clamped);
+        Assert.True(withoutAny);
+        Assert.Equal(VoskResultReader.DefaultConfidence, fallback);
+    }
+
+    [Theory]
+    [InlineData("""{"text" : ""}""")]
+    [InlineData("""{"result" : []}""")]
+    [InlineData("""[]""")]
+    public void TryReadFinal_WithoutText_ShouldReturnFalse(string json)
+    {
+        // Act
+        var found = VoskResultReader.TryReadFinal(System.Text.Encoding.UTF8.GetBytes(json), out var text, out _);
+
+        // Assert
+        Assert.False(found);
+        Assert.Equal("", text);
+    }
+
+    [Fact]
+    public void ReadPartial_ShouldUnescapeAndSkipOtherMembers()
+    {
+        // Act
+        var partial = VoskResultReader.ReadPartial("""{"partial_result": [{"word": "x"}], "partial" : "say \"hi\""}"""u8);
+
+        // Assert
+        Assert.Equal("say \"hi\"", partial);
+    }
+
+    [Fact]
+    public void ReadPartial_WithMalformedJson_ShouldThrowJsonException()
+    {
+        // Act & Assert
+        Assert.ThrowsAny<JsonException>(() => VoskResultReader.ReadPartial("""{"partial" : "unterminated"""u8));
+    }
+}
@@ -0,0 +1,251 @@
+﻿using Moq;
+using Sttify.Corelib.Audio;
+using Sttify.Corelib.Config;
+using Sttify.Corelib.Engine;
+using Sttify.Corelib.Output;
+using Sttify.Corelib.Session;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Session;
+
+public class RecognitionSessionEventLoopTests : IDisposable
+{
+    private const int FrameMs = 20;
+    private const int FrameCount = 50; // One second of 16kHz mono 16-bit audio
+
+    private readonly string _directory = Path.Combine(Path.GetTempPath(), "sttify-session-" + Guid.NewGuid().ToString("N"));
+
+    public RecognitionSessionEventLoopTests()
+    {
+        Directory.CreateDirectory(_directory);
+    }
+
+    public void Dispose()
+    {
+        try
+        {
+            Directory.Delete(_directory, recursive: true);
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            // Capture may still hold the file briefly after the session is disposed
+        }
+    }
+
+    [Fact]
+    public async Task Finals_WithSlowSink_ShouldReachSinkInUtteranceOrderWithoutStallingAudio()
+    {
+        // Arrange - an utterance every 10 frames, and a sink that takes 300 ms per utterance
+        var engine = new FakeEngine { FramesPerUtterance = 10 };
+        var sink = new SlowSink(TimeSpan.FromMilliseconds(300), expected: 5);
+        using var session = await CreateSessionAsync(engine, sink);
+
+        // Act
+        await session.StartAsync();
+        await engine.AllFramesReceived.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        var deliveredWhenAudioDone = sink.DeliveredCount;
+        await sink.AllDelivered.Task.WaitAsync(TimeSpan.FromSeconds(10));
+
+        // Assert - the engine heard all the audio while the sink was still working through the finals
+        Assert.True(deliveredWhenAudioDone < 5, $"Audio was held up until {deliveredWhenAudioDone} finals were typed");
+        Assert.Equal(new[] { "utterance 1", "utterance 2", "utterance 3", "utterance 4", "utterance 5" }, sink.Delivered);
+    }
+
+    [Fact]
+    public async Task EngineEvents_RaisedWhileHandlingAFrame_ShouldBeHandledBeforeTheNextFrame()
+    {
+        // Arrange - the first frame is slow, so the rest of the audio queues up behind it
+        var log = new List<string>();
+        var engine = new FakeEngine { Log = log, RaisePartials = true, FirstFrameDelay = TimeSpan.FromMilliseconds(200) };
+        using var session = await CreateSessionAsync(engine, new SlowSink(TimeSpan.Zero, expected: 0));
+        var lastPartial = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        session.OnTextRecognized += (_, e) =>
+        {
+            log.Add(e.Text);
+            if (e.Text == $"partial {FrameCount}")
+                lastPartial.TrySetResult();
+        };
+
+        // Act
+        await session.StartAsync();
+        await lastPartial.Task.WaitAsync(TimeSpan.FromSeconds(5));
+
+        // Assert - each partial follows its own frame rather than the frames already queued
+        var expected = Enumerable.Range(1, FrameCount).SelectMany(i => new[] { $"frame {i}", $"partial {i}" });
+        Assert.Equal(expected, log);
+    }
+
+    [Fact]
+    public async Task StartAndStop_ShouldCompleteOnlyOnceTheLoopHasRunThem()
+    {
+        // Arrange
+        var engine = new FakeEngine { StartGate = new TaskCompletionSource(), StopGate = new TaskCompletionSource() };
+        using var session = await CreateSessionAsync(engine, new SlowSink(TimeSpan.Zero, expected: 0));
+
+        // Act & Assert - start waits for the engine
+        var start = session.StartAsync();
+        await engine.StartEntered.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        Assert.False(start.IsCompleted);
+        Assert.Equal(SessionState.Starting, session.CurrentState);
+
+        engine.StartGate.SetResult();
+        await start.WaitAsync(TimeSpan.FromSeconds(5));
+        Assert.Equal(SessionState.Listening, session.CurrentState);
+
+        // Stop likewise waits for the engine to stop
+        var stop = session.StopAsync();
+        await engine.StopEntered.Task.WaitAsync(TimeSpan.FromSeconds(5));
+        Assert.False(stop.IsCompleted);
+        Assert.Equal(SessionState.Stopping, session.CurrentState);
+
+        engine.StopGate.SetResult();
+        await stop.WaitAsync(TimeSpan.FromSeconds(5));
+        Assert.Equal(SessionState.Idle, session.CurrentState);
+    }
+
+    private async Task<RecognitionSession> CreateSessionAsync(FakeEngine engine, ITextOutputSink sink)
+    {
+        // Capture reads the audio from a raw PCM file, as a headless host would
+        var audioPath = Path.Combine(_directory, "audio.raw");
+        await File.WriteAllBytesAsync(audioPath, new byte[FrameCount * FrameMs * 32]);
+
+        var settingsProvider = new SettingsProvider(Path.Combine(_directory, "config.json"), watchForChanges: false);
+        await settingsProvider.SaveSettingsAsync(new SttifySettings
+        {
+            Audio = { Source = "file:" + audioPath, FrameMs = FrameMs }
+        });
+
+        var sinkProvider = new Mock<IOutputSinkProvider>();
+        sinkProvider.Setup(p => p.GetSinks()).Returns(new[] { sink });
+
+        return new RecognitionSession(
+            new AudioCapture(),
+            settingsProvider,
+            sinkProvider.Object,
+            new RecognitionSessionSettings { EnableLearnedEndpointing = false, EnableUserDictionary = false },
+            engineFactory: _ => engine)
+        {
+            CurrentMode = RecognitionMode.Continuous
+        };
+    }
+
+    private sealed class FakeEngine : ISttEngine
+    {
+        private int _frames;
+
+        public event EventHandler<PartialRecognitionEventArgs>? OnPartial;
+        public event EventHandler<FinalRecognitionEventArgs>? OnFinal;
+        public event EventHandler<SttErrorEventArgs>? OnError { add { } remove { } }
+
+        public int FramesPerUtterance { get; init; } = int.MaxValue;
+        public bool RaisePartials { get; init; }
+        public TimeSpan FirstFrameDelay { get; init; }
+        public List<string>? Log { get; init; }
+        public TaskCompletionSource? StartGate { get; init; }
+        public TaskCompletionSource? StopGate { get; init; }
+        public TaskCompletionSource StartEntered { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public TaskCompletionSource StopEntered { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public TaskCompletionSource AllFramesReceived { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public async Task StartAsync(CancellationToken cancellationToken = default)
+        {
+            StartEntered.TrySetResult();
+            if (StartGate != null)
+            {
+                await StartGate.Task;
+            }
+        }
+
+        public async Task StopAsync(CancellationToken cancellationToken = default)
+        {
+            StopEntered.TrySetResult();
+            if (StopGate != null)
+            {
+                await StopGate.Task;
+            }
+        }
+
+        public void PushAudio(ReadOnlySpan<byte> audioData)
+        {
+            // Called from the session loop only
+            var frame = ++_frames;
+            Log?.Add($"frame {frame}");
+            if (frame == 1 && FirstFrameDelay > TimeSpan.Zero)
+            {
+                Thread.Sleep(FirstFrameDelay);
+            }
+
+            if (RaisePartials)
+            {
+                OnPartial?.Invoke(this, new PartialRecognitionEventArgs($"partial {frame}", 0.5));
+            }
+
+            if (frame % FramesPerUtterance == 0)
+            {
+                OnFinal?.Invoke(this, new FinalRecognitionEventArgs($"utterance {frame / FramesPerUtterance}", 0.9, TimeSpan.Zero));
+            }
+
+            if (frame == FrameCount)
+            {
+                AllFramesReceived.TrySetResult();
+            }
+        }
+
+        public void Dispose()
+        {
+        }
+    }
+
+    private sealed class SlowSink : ITextOutputSink
+    {
+        private readonly TimeSpan _delay;
+        private readonly int _expected;
+        private readonly List<string> _delivered = new();
+
+        public SlowSink(TimeSpan delay, int expected)
+        {
+            _delay = delay;
+            _expected = expected;
+        }
+
+        public string Id => "slow";
+        public string Name => "Slow";
+        public bool IsAvailable => true;
+        public TaskCompletionSource AllDelivered { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public int DeliveredCount
+        {
+            get
+            {
+                lock (_delivered)
+                {
+                    return _delivered.Count;
+                }
+            }
+        }
+
+        public string[] Delivered
+        {
+            get
+            {
+                lock (_delivered)
+                {
+                    return _delivered.ToArray();
+                }
+            }
+        }
+
+        public Task<bool> CanSendAsync(CancellationToken cancellationToken = default) => Task.FromResult(true);
+
+        public async Task SendAsync(string text, CancellationToken cancellationToken = default)
+        {
+            await Task.Delay(_delay, cancellationToken);
+            lock (_delivered)
+            {
+                _delivered.Add(text);
+                if (_delivered.Count == _expected)
+                    AllDelivered.TrySetResult();
+            }
+        }
+    }
+}
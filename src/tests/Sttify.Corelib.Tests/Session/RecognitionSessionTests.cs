@@ -70,6 +70,27 @@ public class RecognitionSessionTests
         Assert.Equal(RecognitionMode.Continuous, session.CurrentMode);
     }
 
+    [Fact]
+    public void DetectWakeWord_WhenWakeWordsChange_ShouldMatchTheCurrentSet()
+    {
+        // Arrange
+        var mockSinkProvider = new Mock<IOutputSinkProvider>();
+        mockSinkProvider.Setup(p => p.GetSinks()).Returns(new List<ITextOutputSink>());
+        using var session = new RecognitionSession(
+            new Mock<AudioCapture>().Object,
+            new Mock<Sttify.Corelib.Config.SettingsProvider>().Object,
+            mockSinkProvider.Object,
+            new RecognitionSessionSettings());
+        var wakeWords = new[] { "sttify" };
+
+        // Act & Assert - the matcher is cached per set, so edits to the set must still be seen
+        Assert.True(session.DetectWakeWord("hey sttify", wakeWords));
+        Assert.False(session.DetectWakeWord("hey sttify", ["computer"]));
+        wakeWords[0] = "computer";
+        Assert.True(session.DetectWakeWord("ok computer", wakeWords));
+        Assert.False(session.DetectWakeWord("hey sttify", wakeWords));
+    }
+
     [Fact]
     public void Dispose_ShouldNotThrow()
     {
@@ -0,0 +1,147 @@
+﻿using Sttify.Corelib.Text;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Text;
+
+public class ReplacementAutomatonTests
+{
+    private static ReplacementAutomaton Create(params (string Pattern, string Replacement)[] entries)
+    {
+        return new ReplacementAutomaton(entries.Select(e => new KeyValuePair<string, string>(e.Pattern, e.Replacement)));
+    }
+
+    [Fact]
+    public void Replace_ShouldReplaceEveryOccurrence()
+    {
+        // Arrange
+        var automaton = Create(("すてぃふぁい", "Sttify"), ("ぼすく", "Vosk"));
+
+        // Act
+        var result = automaton.Replace("すてぃふぁいはぼすくで動くすてぃふぁい");
+
+        // Assert
+        Assert.Equal("SttifyはVoskで動くSttify", result);
+    }
+
+    [Fact]
+    public void Replace_ShouldPreferLongestMatchAtSameStart()
+    {
+        // Arrange
+        var automaton = Create(("東京", "トウキョウ"), ("東京都", "Tokyo Metropolis"));
+
+        // Act
+        var result = automaton.Replace("東京都と東京");
+
+        // Assert
+        Assert.Equal("Tokyo Metropolisとトウキョウ", result);
+    }
+
+    [Fact]
+    public void Replace_ShouldPreferLeftmostMatchOverLaterOverlap()
+    {
+        // Arrange - "bcd" is found first, but "abcde" starts further left
+        var automaton = Create(("bcd", "1"), ("abcde", "2"), ("ef", "3"));
+
+        // Act
+        var result = automaton.Replace("xabcdefbcd");
+
+        // Assert
+        Assert.Equal("x2f1", result);
+    }
+
+    [Fact]
+    public void Replace_AfterAbandonedLongerPrefix_ShouldFindMatchesInsideIt()
+    {
+        // Arrange - "abcx" is never completed, so "ab" wins and "cd" must still be found
+        var automaton = Create(("ab", "1"), ("abcx", "2"), ("cd", "3"));
+
+        // Act
+        var result = automaton.Replace("abcd");
+
+        // Assert
+        Assert.Equal("13", result);
+    }
+
+    [Fact]
+    public void Replace_ShouldNotRematchInsideReplacement()
+    {
+        // Arrange
+        var automaton = Create(("a", "aa"));
+
+        // Act
+        var result = automaton.Replace("aba");
+
+        // Assert
+        Assert.Equal("aabaa", result);
+    }
+
+    [Fact]
+    public void Replace_WithNoMatch_ShouldReturnSameInstance()
+    {
+        // Arrange
+        var automaton = Create(("会議", "ミーティング"));
+        var text = "資料を送ります";
+
+        // Act
+        var result = automaton.Replace(text);
+
+        // Assert
+        Assert.Same(text, result);
+    }
+
+    [Fact]
+    public void Replace_WithIgnoreCase_ShouldMatchAnyCase()
+    {
+        // Arrange
+        var automaton = new ReplacementAutomaton(new[] { new KeyValuePair<string, string>("github", "GitHub") }, ignoreCase: true);
+
+        // Act
+        var result = automaton.Replace("push to GITHUB and Github");
+
+        // Assert
+        Assert.Equal("push to GitHub and GitHub", result);
+    }
+
+    [Fact]
+    public void Constructor_WithDuplicates_ShouldKeepLastReplacement()
+    {
+        // Act
+        var automaton = Create(("きしゃ", "記者"), ("きしゃ", "貴社"), ("", "ignored"));
+
+        // Assert
+        Assert.Equal(1, automaton.EntryCount);
+        Assert.Equal("貴社", automaton.Replace("きしゃ"));
+    }
+
+    [Fact]
+    public void Parse_ShouldReadTabSeparatedEntries()
+    {
+        // Arrange
+        var text = "# product names\nすてぃふぁい\tSttify\n\nno tab line\nぼすく\tVosk\n";
+
+        // Act
+        var automaton = ReplacementAutomaton.Parse(new StringReader(text));
+
+        // Assert
+        Assert.Equal(2, automaton.EntryCount);
+        Assert.Equal("Sttify on Vosk", automaton.Replace("すてぃふぁい on ぼすく"));
+    }
+
+    [Fact]
+    public void Replace_WithManyEntries_ShouldMatchAll()
+    {
+        // Arrange - tens of thousands of entries sharing prefixes
+        var entries = Enumerable.Range(0, 30000)
+            .Select(i => new KeyValuePair<string, string>($"用語{i:D5}", $"T{i}"))
+            .ToList();
+        var automaton = new ReplacementAutomaton(entries);
+
+        // Act
+        var result = automaton.Replace("用語00042と用語29999と用語");
+
+        // Assert
+        Assert.Equal(30000, automaton.EntryCount);
+        Assert.Equal(7, automaton.MaxEntryLength);
+        Assert.Equal("T42とT29999と用語", result);
+    }
+}
@@ -0,0 +1,36 @@
+﻿using Sttify.Corelib.Text;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Text;
+
+public class TextNormalizationBenchmarkTests
+{
+    [Fact]
+    public void CreateJapaneseDictation_ShouldProduceSpacedWordsOfRequestedLength()
+    {
+        // Act
+        var text = TextNormalizationBenchmark.CreateJapaneseDictation(2000);
+
+        // Assert
+        Assert.InRange(text.Length, 1990, 2000);
+        Assert.Contains("会議 の 資料", text);
+    }
+
+    [Fact]
+    public void Measure_WithLongJapaneseDictation_ShouldReportThroughputAndAllocation()
+    {
+        // Arrange
+        var text = TextNormalizationBenchmark.CreateJapaneseDictation(20000);
+        var normalizer = TextNormalizer.ForLanguage("ja");
+
+        // Act
+        var result = TextNormalizationBenchmark.Measure(t => normalizer.Normalize(t, true), text, iterations: 10);
+
+        // Assert
+        Assert.Equal(text.Length, result.InputLength);
+        Assert.Equal(text.Replace(" ", "").Length + 1, result.OutputLength);
+        Assert.True(result.CharactersPerSecond > 0);
+        // Only the result string is allocated; the working buffer comes from the pool
+        Assert.InRange(result.AllocatedBytesPerCall, 1, (result.OutputLength + 64) * sizeof(char) + 64);
+    }
+}
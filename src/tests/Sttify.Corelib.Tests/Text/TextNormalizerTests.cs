@@ -0,0 +1,130 @@
+﻿using Sttify.Corelib.Text;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Text;
+
+public class TextNormalizerTests
+{
+    [Theory]
+    [InlineData("今日 は 会議 です", "今日は会議です")]
+    [InlineData("  資料 を   送り ます  ", "資料を送ります")]
+    [InlineData("Vosk は 速い", "Vosk は速い")]
+    [InlineData("hello   world", "hello world")]
+    [InlineData("確認　します", "確認します")]
+    public void Normalize_Japanese_ShouldRemoveSpacesBetweenCjkOnly(string input, string expected)
+    {
+        // Arrange
+        var normalizer = TextNormalizer.ForLanguage("ja");
+
+        // Act
+        var result = normalizer.Normalize(input);
+
+        // Assert
+        Assert.Equal(expected, result);
+    }
+
+    [Theory]
+    [InlineData("ja", "会議 です", "会議です。")]
+    [InlineData("ja-JP", "本当 です か？", "本当ですか？")]
+    [InlineData("zh", "你好", "你好。")]
+    [InlineData("en", "hello world", "hello world.")]
+    [InlineData("en-US", "really?", "really?")]
+    [InlineData("fr", "bonjour", "bonjour.")]
+    public void Normalize_WithTerminalPunctuation_ShouldCloseSentenceOnce(string language, string input, string expected)
+    {
+        // Act
+        var result = TextNormalizer.ForLanguage(language).Normalize(input, appendTerminalPunctuation: true);
+
+        // Assert
+        Assert.Equal(expected, result);
+    }
+
+    [Fact]
+    public void Normalize_WithoutTerminalPunctuation_ShouldNotAppend()
+    {
+        // Act
+        var result = TextNormalizer.ForLanguage("ja").Normalize("会議です");
+
+        // Assert
+        Assert.Equal("会議です", result);
+    }
+
+    [Theory]
+    [InlineData("ｶﾞｲﾄﾞﾌﾞｯｸ", "ガイドブック")]
+    [InlineData("ﾊﾟｿｺﾝ", "パソコン")]
+    [InlineData("ｳﾞｫｲｽ", "ヴォイス")]
+    [InlineData("ＡＢＣ１２３ｘｙｚ", "ABC123xyz")]
+    [InlineData("何？！", "何？！")]
+    public void Normalize_ShouldFoldWidth(string input, string expected)
+    {
+        // Act
+        var result = TextNormalizer.ForLanguage("ja").Normalize(input);
+
+        // Assert
+        Assert.Equal(expected, result);
+    }
+
+    [Fact]
+    public void Normalize_WithCharacterMap_ShouldReplaceBeforeFolding()
+    {
+        // Arrange
+        var normalizer = new TextNormalizer(new TextNormalizationOptions
+        {
+            CharacterMap = new Dictionary<char, char> { ['、'] = '，', ['Ａ'] = 'α' }
+        });
+
+        // Act
+        var result = normalizer.Normalize("Ａ、Ｂ");
+
+        // Assert
+        Assert.Equal("α，B", result);
+    }
+
+    [Fact]
+    public void Normalize_WhenUnchanged_ShouldReturnSameInstance()
+    {
+        // Arrange
+        var text = "すでに正規化済みの文章です。";
+
+        // Act
+        var result = TextNormalizer.ForLanguage("ja").Normalize(text, appendTerminalPunctuation: true);
+
+        // Assert
+        Assert.Same(text, result);
+    }
+
+    [Fact]
+    public void Normalize_Span_ShouldWriteIntoDestination()
+    {
+        // Arrange
+        var normalizer = TextNormalizer.ForLanguage("ja");
+        var input = " 会議 を 始め ます ".AsSpan();
+        var destination = new char[TextNormalizer.GetMaxOutputLength(input.Length)];
+
+        // Act
+        var written = normalizer.Normalize(input, destination, appendTerminalPunctuation: true);
+
+        // Assert
+        Assert.Equal("会議を始めます。", new string(destination, 0, written));
+    }
+
+    [Fact]
+    public void Normalize_Span_WithSmallDestination_ShouldThrow()
+    {
+        // Arrange
+        var normalizer = TextNormalizer.ForLanguage("ja");
+
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => normalizer.Normalize("会議".AsSpan(), new char[2]));
+    }
+
+    [Fact]
+    public void Constructor_WithWhitespaceMapping_ShouldThrow()
+    {
+        // Arrange
+        var options = new TextNormalizationOptions { CharacterMap = new Dictionary<char, char> { ['_'] = ' ' } };
+
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => new TextNormalizer(options));
+    }
+}
@@ -0,0 +1,72 @@
+﻿using Sttify.Corelib.Text;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Text;
+
+public class UserDictionaryTests : IDisposable
+{
+    private readonly string _path;
+
+    public UserDictionaryTests()
+    {
+        _path = Path.Combine(Path.GetTempPath(), $"sttify_dictionary_{Guid.NewGuid():N}.tsv");
+    }
+
+    public void Dispose()
+    {
+        if (File.Exists(_path))
+        {
+            File.Delete(_path);
+        }
+    }
+
+    [Fact]
+    public void Apply_WithMissingFile_ShouldReturnTextUnchanged()
+    {
+        // Arrange
+        using var dictionary = new UserDictionary(_path, watchForChanges: false);
+
+        // Act
+        var result = dictionary.Apply("すてぃふぁい");
+
+        // Assert
+        Assert.Equal(0, dictionary.EntryCount);
+        Assert.Equal("すてぃふぁい", result);
+    }
+
+    [Fact]
+    public void Reload_ShouldSwapInNewEntries()
+    {
+        // Arrange
+        File.WriteAllText(_path, "すてぃふぁい\tSttify\n");
+        using var dictionary = new UserDictionary(_path, watchForChanges: false);
+        var before = dictionary.Apply("すてぃふぁいとぼすく");
+        var reloaded = false;
+        dictionary.Reloaded += (_, _) => reloaded = true;
+
+        // Act
+        File.WriteAllText(_path, "すてぃふぁい\tSttify\nぼすく\tVosk\n");
+        dictionary.Reload();
+
+        // Assert
+        Assert.Equal("Sttifyとぼすく", before);
+        Assert.True(reloaded);
+        Assert.Equal(2, dictionary.EntryCount);
+        Assert.Equal("SttifyとVosk", dictionary.Apply("すてぃふぁいとぼすく"));
+    }
+
+    [Fact]
+    public void Reload_AfterFileDeleted_ShouldClearEntries()
+    {
+        // Arrange
+        File.WriteAllText(_path, "ぼすく\tVosk\n");
+        using var dictionary = new UserDictionary(_path, watchForChanges: false);
+
+        // Act
+        File.Delete(_path);
+        dictionary.Reload();
+
+        // Assert
+        Assert.Equal(0, dictionary.EntryCount);
+    }
+}
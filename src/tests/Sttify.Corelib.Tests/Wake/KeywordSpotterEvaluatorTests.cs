@@ -0,0 +1,114 @@
+﻿using Sttify.Corelib.Wake;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Wake;
+
+public class KeywordSpotterEvaluatorTests
+{
+    [Fact]
+    public void Evaluate_WithPerfectSpotter_ShouldReportZeroErrorRates()
+    {
+        // Arrange
+        var spotter = new MarkerSpotter();
+        var samples = new[]
+        {
+            new KeywordSpotterSample("pos1", CreateAudio(marker: true), true),
+            new KeywordSpotterSample("pos2", CreateAudio(marker: true), true),
+            new KeywordSpotterSample("neg1", CreateAudio(marker: false), false)
+        };
+
+        // Act
+        var result = KeywordSpotterEvaluator.Evaluate(spotter, samples);
+
+        // Assert
+        Assert.Equal(2, result.PositiveCount);
+        Assert.Equal(1, result.NegativeCount);
+        Assert.Equal(0.0, result.FalseAcceptRate);
+        Assert.Equal(0.0, result.FalseRejectRate);
+        Assert.Equal(TimeSpan.FromSeconds(1.5), result.AudioDuration);
+    }
+
+    [Fact]
+    public void Evaluate_WithMislabelledSamples_ShouldCountFalseAcceptsAndRejects()
+    {
+        // Arrange
+        var spotter = new MarkerSpotter();
+        var samples = new[]
+        {
+            new KeywordSpotterSample("missed", CreateAudio(marker: false), true),
+            new KeywordSpotterSample("hit", CreateAudio(marker: true), true),
+            new KeywordSpotterSample("false-alarm", CreateAudio(marker: true), false),
+            new KeywordSpotterSample("quiet", CreateAudio(marker: false), false)
+        };
+
+        // Act
+        var result = KeywordSpotterEvaluator.Evaluate(spotter, samples);
+
+        // Assert
+        Assert.Equal(1, result.FalseRejects);
+        Assert.Equal(1, result.FalseAccepts);
+        Assert.Equal(0.5, result.FalseRejectRate);
+        Assert.Equal(0.5, result.FalseAcceptRate);
+    }
+
+    [Fact]
+    public void Evaluate_ShouldResetSpotterBeforeEachSample()
+    {
+        // Arrange
+        var spotter = new MarkerSpotter();
+        var samples = new[]
+        {
+            new KeywordSpotterSample("a", CreateAudio(marker: false), false),
+            new KeywordSpotterSample("b", CreateAudio(marker: false), false)
+        };
+
+        // Act
+        KeywordSpotterEvaluator.Evaluate(spotter, samples);
+
+        // Assert
+        Assert.Equal(2, spotter.ResetCount);
+    }
+
+    [Fact]
+    public void Evaluate_WithInvalidFrameSize_ShouldThrow()
+    {
+        // Arrange
+        var spotter = new MarkerSpotter();
+
+        // Act & Assert
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            KeywordSpotterEvaluator.Evaluate(spotter, Array.Empty<KeywordSpotterSample>(), frameSizeBytes: 0));
+    }
+
+    private static byte[] CreateAudio(bool marker)
+    {
+        // 0.5 seconds of 16kHz 16-bit mono audio; a non-zero byte marks the "keyword"
+        var audio = new byte[16000];
+        if (marker)
+            audio[8000] = 1;
+        return audio;
+    }
+
+    private sealed class MarkerSpotter : IKeywordSpotter
+    {
+        public int ResetCount { get; private set; }
+
+        public event EventHandler<WakeWordDetectedEventArgs>? OnKeywordDetected;
+
+        public Task StartAsync(CancellationToken cancellationToken = default) => Task.CompletedTask;
+
+        public void ProcessAudio(ReadOnlySpan<byte> audioData)
+        {
+            if (audioData.IndexOfAnyExcept((byte)0) >= 0)
+            {
+                OnKeywordDetected?.Invoke(this, new WakeWordDetectedEventArgs("marker", "marker"));
+            }
+        }
+
+        public void Reset() => ResetCount++;
+
+        public void Dispose()
+        {
+        }
+    }
+}
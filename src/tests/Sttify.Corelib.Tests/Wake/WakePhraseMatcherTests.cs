@@ -0,0 +1,141 @@
+﻿using Sttify.Corelib.Wake;
+using Xunit;
+
+namespace Sttify.Corelib.Tests.Wake;
+
+public class WakePhraseMatcherTests
+{
+    [Theory]
+    [InlineData("スティファイ、メモを取って")]
+    [InlineData("すてぃふぁい")]
+    [InlineData("ｽﾃｨﾌｧｲ")]
+    [InlineData("ス ティ ファイ")]
+    [InlineData("スティファーイ")]
+    public void FindFirst_WithKanaWidthAndSpacingVariants_ShouldMatch(string text)
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["スティファイ"]);
+
+        // Act
+        var result = matcher.FindFirst(text);
+
+        // Assert
+        Assert.Equal("スティファイ", result);
+    }
+
+    [Fact]
+    public void FindFirst_WithHalfWidthVoicedKana_ShouldMatchPrecomposedForm()
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["ガイド"]);
+
+        // Act & Assert
+        Assert.Equal("ガイド", matcher.FindFirst("ｶﾞｲﾄﾞ"));
+        Assert.Null(matcher.FindFirst("カイト"));
+    }
+
+    [Fact]
+    public void FindFirst_WithFullWidthLatin_ShouldMatchCaseInsensitively()
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["sttify"]);
+
+        // Act & Assert
+        Assert.Equal("sttify", matcher.FindFirst("ｓｔｔｉｆｙ start"));
+        Assert.Equal("sttify", matcher.FindFirst("Hey STTIFY"));
+    }
+
+    [Fact]
+    public void FindFirst_WithOverlappingPhrases_ShouldFindPhraseEndingEarliest()
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["abcd", "bc"]);
+
+        // Act
+        var result = matcher.FindFirst("xabcd");
+
+        // Assert
+        Assert.Equal("bc", result);
+    }
+
+    [Fact]
+    public void FindFirst_WithoutPhrase_ShouldReturnNull()
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["スティファイ", "sttify"]);
+
+        // Act & Assert
+        Assert.Null(matcher.FindFirst("今日はいい天気です"));
+        Assert.Null(matcher.FindFirst(string.Empty));
+    }
+
+    [Fact]
+    public void Constructor_ShouldDeduplicateFoldedPhrases()
+    {
+        // Act
+        var matcher = new WakePhraseMatcher(["スティファイ", "すてぃふぁい", "", "  "]);
+
+        // Assert
+        Assert.Single(matcher.Phrases);
+    }
+
+    [Fact]
+    public void Scanner_Feed_ShouldDetectPhraseSpanningPartials()
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["スティファイ"]);
+        var scanner = matcher.CreateScanner();
+
+        // Act & Assert
+        Assert.Null(scanner.Feed("ス"));
+        Assert.Null(scanner.Feed("ス ティ"));
+        Assert.Equal("スティファイ", scanner.Feed("ス ティ ファイ"));
+    }
+
+    [Fact]
+    public void Scanner_Feed_WithRevisedPartial_ShouldRescan()
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["スティファイ"]);
+        var scanner = matcher.CreateScanner();
+
+        // Act
+        scanner.Feed("ステファ");
+        var result = scanner.Feed("スティファイ");
+
+        // Assert
+        Assert.Equal("スティファイ", result);
+    }
+
+    [Fact]
+    public void Scanner_Reset_ShouldForgetPreviousText()
+    {
+        // Arrange
+        var matcher = new WakePhraseMatcher(["abc"]);
+        var scanner = matcher.CreateScanner();
+        scanner.Feed("ab");
+
+        // Act
+        scanner.Reset();
+        var result = scanner.Feed("c");
+
+        // Assert
+        Assert.Null(result);
+    }
+
+    [Fact]
+    public void WakeWordDetector_ShouldRaiseEventForPhoneticVariant()
+    {
+        // Arrange
+        var detector = new WakeWordDetector();
+        WakeWordDetectedEventArgs? detected = null;
+        detector.OnWakeWordDetected += (_, e) => detected = e;
+
+        // Act
+        detector.ProcessRecognition("すてふぁい", true);
+
+        // Assert
+        Assert.NotNull(detected);
+        Assert.Equal("スティファイ", detected!.WakeWord);
+    }
+}